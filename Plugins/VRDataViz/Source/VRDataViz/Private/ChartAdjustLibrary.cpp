@@ -2,6 +2,8 @@
 #include "Charts/BarChartActor.h"
 #include "Charts/LineGraphActor.h"
 #include "Charts/ScatterActor.h"
+#include "Data/ChartDatasetDiff.h"
+#include "Data/ChartSelection.h"
 
 void UChartAdjustLibrary::SetActorScale(AActor* ChartActor, const FVector& NewUnitScale)
 {
@@ -41,3 +43,126 @@ void UChartAdjustLibrary::SetAxisRanges(AActor* ChartActor, bool bUseCustom, flo
         return;
     }
 }
+
+void UChartAdjustLibrary::SetPercentileClip(AActor* ChartActor, bool bClip, float LowPercentile, float HighPercentile)
+{
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor))
+    {
+        A->bClipToPercentiles = bClip;
+        A->LowPercentile = LowPercentile; A->HighPercentile = HighPercentile;
+        A->Rebuild();
+        return;
+    }
+    if (AScatterActor* A = Cast<AScatterActor>(ChartActor))
+    {
+        A->bClipToPercentiles = bClip;
+        A->LowPercentile = LowPercentile; A->HighPercentile = HighPercentile;
+        A->Rebuild();
+    }
+}
+
+void UChartAdjustLibrary::SetStatsOverlay(AActor* ChartActor, bool bMean, bool bSigmaBand, bool bRegression, float SigmaBandWidth)
+{
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor))
+    {
+        A->bShowMeanOverlay = bMean; A->bShowSigmaBand = bSigmaBand; A->bShowRegressionOverlay = bRegression;
+        A->SigmaBandWidth = SigmaBandWidth;
+        A->UpdateOverlay();
+        return;
+    }
+    if (AScatterActor* A = Cast<AScatterActor>(ChartActor))
+    {
+        A->bShowMeanOverlay = bMean; A->bShowSigmaBand = bSigmaBand; A->bShowRegressionOverlay = bRegression;
+        A->SigmaBandWidth = SigmaBandWidth;
+        A->UpdateOverlay();
+    }
+}
+
+void UChartAdjustLibrary::SetLineOrder(AActor* ChartActor, ELineGraphOrder Order, FName Column)
+{
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor))
+    {
+        A->LineOrder = Order;
+        A->OrderColumn = Column;
+        A->Rebuild();
+    }
+}
+
+void UChartAdjustLibrary::SetLineXRange(AActor* ChartActor, float MinX, float MaxX)
+{
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor))
+    {
+        A->SetXRange(MinX, MaxX);
+    }
+}
+
+void UChartAdjustLibrary::SetBarGroupBy(AActor* ChartActor, const FChartGroupBy& GroupBy)
+{
+    if (ABarChartActor* A = Cast<ABarChartActor>(ChartActor))
+    {
+        A->GroupBy = GroupBy;
+        A->Rebuild();
+    }
+}
+
+void UChartAdjustLibrary::SetPreviewFidelity(AActor* ChartActor, bool bPreview, int32 MaxPrimitives)
+{
+    if (ABarChartActor* A = Cast<ABarChartActor>(ChartActor)) { A->bPreviewFidelity = bPreview; A->MaxPreviewPrimitives = MaxPrimitives; A->Rebuild(); return; }
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor)) { A->bPreviewFidelity = bPreview; A->MaxPreviewPrimitives = MaxPrimitives; A->Rebuild(); return; }
+    if (AScatterActor* A = Cast<AScatterActor>(ChartActor)) { A->bPreviewFidelity = bPreview; A->MaxPreviewPrimitives = MaxPrimitives; A->Rebuild(); return; }
+}
+
+bool UChartAdjustLibrary::SetFilter(AActor* ChartActor, const FString& Expression)
+{
+    if (ABarChartActor* A = Cast<ABarChartActor>(ChartActor)) { return A->SetFilter(Expression); }
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor)) { return A->SetFilter(Expression); }
+    if (AScatterActor* A = Cast<AScatterActor>(ChartActor)) { return A->SetFilter(Expression); }
+    return false;
+}
+
+int32 UChartAdjustLibrary::LinkSelection(const TArray<AActor*>& ChartActors)
+{
+    TSharedPtr<FChartSelection> Selection;
+    int32 NumLinked = 0;
+    for (AActor* ChartActor : ChartActors)
+    {
+        const TSharedPtr<const FChartDataset> Dataset = GetChartDataset(ChartActor);
+        const ABarChartActor* BarChart = Cast<ABarChartActor>(ChartActor);
+        if (!Dataset.IsValid() || (BarChart && !BarChart->HasBarRows()))
+        {
+            continue;
+        }
+        if (!Selection.IsValid())
+        {
+            Selection = MakeShared<FChartSelection>(Dataset->NumRows);
+        }
+        if (Dataset->NumRows == Selection->GetNumRows())
+        {
+            SetSelection(ChartActor, Selection);
+            ++NumLinked;
+        }
+    }
+    return NumLinked;
+}
+
+void UChartAdjustLibrary::SetSelection(AActor* ChartActor, TSharedPtr<FChartSelection> Selection)
+{
+    if (ABarChartActor* A = Cast<ABarChartActor>(ChartActor)) { A->SetSelection(MoveTemp(Selection)); return; }
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor)) { A->SetSelection(MoveTemp(Selection)); return; }
+    if (AScatterActor* A = Cast<AScatterActor>(ChartActor)) { A->SetSelection(MoveTemp(Selection)); return; }
+}
+
+TSharedPtr<const FChartDataset> UChartAdjustLibrary::GetChartDataset(AActor* ChartActor)
+{
+    if (ABarChartActor* A = Cast<ABarChartActor>(ChartActor)) { return A->GetRuntimeDataset(); }
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor)) { return A->GetRuntimeDataset(); }
+    if (AScatterActor* A = Cast<AScatterActor>(ChartActor)) { return A->GetRuntimeDataset(); }
+    return nullptr;
+}
+
+void UChartAdjustLibrary::ApplyDatasetUpdate(AActor* ChartActor, TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff)
+{
+    if (ABarChartActor* A = Cast<ABarChartActor>(ChartActor)) { A->ApplyDatasetUpdate(MoveTemp(NewDataset), Diff); return; }
+    if (ALineGraphActor* A = Cast<ALineGraphActor>(ChartActor)) { A->ApplyDatasetUpdate(MoveTemp(NewDataset), Diff); return; }
+    if (AScatterActor* A = Cast<AScatterActor>(ChartActor)) { A->ApplyDatasetUpdate(MoveTemp(NewDataset), Diff); return; }
+}
@@ -7,6 +7,8 @@
 #include "Charts/BarChartActor.h"
 #include "Charts/LineGraphActor.h"
 #include "Charts/ScatterActor.h"
+#include "Data/ChartDatasetLoader.h"
+#include "Data/RowIngestionPlan.h"
 #include "HAL/PlatformFilemanager.h"
 
 static UDataTable* CreateTransientDataTable(UScriptStruct* RowStruct)
@@ -39,6 +41,23 @@ bool UChartSpawnLibrary::ParseCSVToDataTable(const FString& CSVText, UScriptStru
         return false;
     }
 
+    // The CSV tokenizer and a per-struct ingestion plan fill the rows without looking up properties per cell. Column
+    // types come from the fields, and the row names and unknown columns stay text, so nothing is reformatted.
+    const TSharedRef<const FRowIngestionPlan> Plan = FRowIngestionPlan::Get(RowStruct);
+    FCSVParseOptions Options;
+    Options.ColumnTypes = Plan->GetColumnTypes();
+    Options.DefaultColumnType = EChartColumnType::String;
+    const FTCHARToUTF8 Utf8(*CSVText);
+    const TSharedPtr<FChartDataset> Dataset = FChartDatasetLoader::ParseCSV(TConstArrayView64<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), Options);
+    if (Dataset.IsValid() && Plan->FillDataTable(*Dataset, DataTable))
+    {
+        OutDataTable = DataTable;
+        UE_LOG(LogTemp, Log, TEXT("ParseCSVToDataTable - Success! Created DataTable with %d rows"), DataTable->GetRowMap().Num());
+        return true;
+    }
+
+    // Fall back to the engine importer, which reports exactly what it could not read
+    UE_LOG(LogTemp, Warning, TEXT("ParseCSVToDataTable - Columns do not match %s; retrying with the DataTable importer"), *RowStruct->GetName());
 #if (ENGINE_MAJOR_VERSION >= 5)
     {
         const TArray<FString> Problems = DataTable->CreateTableFromCSVString(CSVText);
@@ -65,7 +84,7 @@ bool UChartSpawnLibrary::ParseCSVToDataTable(const FString& CSVText, UScriptStru
     return true;
 }
 
-AActor* UChartSpawnLibrary::SpawnChartFromCSV(UObject* WorldContextObject, EChartType ChartType, const FString& CSVText, const FTransform& SpawnTransform)
+AActor* UChartSpawnLibrary::SpawnChartFromCSV(UObject* WorldContextObject, EChartType ChartType, const FString& CSVText, const FTransform& SpawnTransform, int32 PreviewPrimitiveBudget)
 {
     if (!WorldContextObject)
     {
@@ -120,6 +139,8 @@ AActor* UChartSpawnLibrary::SpawnChartFromCSV(UObject* WorldContextObject, EChar
         if (ABarChartActor* Chart = World->SpawnActor<ABarChartActor>(ABarChartActor::StaticClass(), SpawnTransform, Params))
         {
             Chart->BarDataTable = DataTable;
+            Chart->bPreviewFidelity = PreviewPrimitiveBudget > 0;
+            Chart->MaxPreviewPrimitives = PreviewPrimitiveBudget;
             Chart->Rebuild();
             Spawned = Chart;
             UE_LOG(LogTemp, Warning, TEXT("SpawnChartFromCSV - Successfully spawned BarChartActor"));
@@ -134,6 +155,8 @@ AActor* UChartSpawnLibrary::SpawnChartFromCSV(UObject* WorldContextObject, EChar
         if (ALineGraphActor* Chart = World->SpawnActor<ALineGraphActor>(ALineGraphActor::StaticClass(), SpawnTransform, Params))
         { 
             Chart->LineDataTable = DataTable; 
+            Chart->bPreviewFidelity = PreviewPrimitiveBudget > 0;
+            Chart->MaxPreviewPrimitives = PreviewPrimitiveBudget;
             Chart->Rebuild();
             Spawned = Chart;
             UE_LOG(LogTemp, Warning, TEXT("SpawnChartFromCSV - Successfully spawned LineGraphActor"));
@@ -148,6 +171,8 @@ AActor* UChartSpawnLibrary::SpawnChartFromCSV(UObject* WorldContextObject, EChar
         if (AScatterActor* Chart = World->SpawnActor<AScatterActor>(AScatterActor::StaticClass(), SpawnTransform, Params))
         { 
             Chart->ScatterDataTable = DataTable; 
+            Chart->bPreviewFidelity = PreviewPrimitiveBudget > 0;
+            Chart->MaxPreviewPrimitives = PreviewPrimitiveBudget;
             Chart->Rebuild();
             Spawned = Chart;
             UE_LOG(LogTemp, Warning, TEXT("SpawnChartFromCSV - Successfully spawned ScatterActor"));
@@ -163,4 +188,64 @@ AActor* UChartSpawnLibrary::SpawnChartFromCSV(UObject* WorldContextObject, EChar
     return Spawned;
 }
 
+AActor* UChartSpawnLibrary::SpawnChartFromDataset(UObject* WorldContextObject, EChartType ChartType, TSharedPtr<const FChartDataset> Dataset, const FTransform& SpawnTransform, int32 PreviewPrimitiveBudget)
+{
+    if (!WorldContextObject || !Dataset.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpawnChartFromDataset - WorldContextObject or Dataset is null"));
+        return nullptr;
+    }
+
+    UWorld* World = WorldContextObject->GetWorld();
+    if (!World)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpawnChartFromDataset - World is null"));
+        return nullptr;
+    }
+
+    FActorSpawnParameters Params;
+    AActor* Spawned = nullptr;
+
+    switch (ChartType)
+    {
+    case EChartType::Bar:
+        if (ABarChartActor* Chart = World->SpawnActor<ABarChartActor>(ABarChartActor::StaticClass(), SpawnTransform, Params))
+        {
+            Chart->SetRuntimeDataset(Dataset);
+            Chart->bPreviewFidelity = PreviewPrimitiveBudget > 0;
+            Chart->MaxPreviewPrimitives = PreviewPrimitiveBudget;
+            Chart->Rebuild();
+            Spawned = Chart;
+        }
+        break;
+    case EChartType::Line:
+        if (ALineGraphActor* Chart = World->SpawnActor<ALineGraphActor>(ALineGraphActor::StaticClass(), SpawnTransform, Params))
+        {
+            Chart->SetRuntimeDataset(Dataset);
+            Chart->bPreviewFidelity = PreviewPrimitiveBudget > 0;
+            Chart->MaxPreviewPrimitives = PreviewPrimitiveBudget;
+            Chart->Rebuild();
+            Spawned = Chart;
+        }
+        break;
+    case EChartType::Scatter:
+        if (AScatterActor* Chart = World->SpawnActor<AScatterActor>(AScatterActor::StaticClass(), SpawnTransform, Params))
+        {
+            Chart->SetRuntimeDataset(Dataset);
+            Chart->bPreviewFidelity = PreviewPrimitiveBudget > 0;
+            Chart->MaxPreviewPrimitives = PreviewPrimitiveBudget;
+            Chart->Rebuild();
+            Spawned = Chart;
+        }
+        break;
+    default:
+        UE_LOG(LogTemp, Error, TEXT("SpawnChartFromDataset - Invalid ChartType: %d"), (int32)ChartType);
+        return nullptr;
+    }
 
+    if (!Spawned)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SpawnChartFromDataset - Failed to spawn chart actor"));
+    }
+    return Spawned;
+}
@@ -7,6 +7,13 @@
 #include "Charts/GridLineActor.h"
 #include "Charts/BarActor.h"
 #include "Charts/GridMath.h"
+#include "Charts/ChartSampling.h"
+#include "Data/ChartDatasetDiff.h"
+#include "Data/ChartDatasetAsset.h"
+
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#endif
 
 ABarChartActor::ABarChartActor()
 {
@@ -21,19 +28,118 @@ ABarChartActor::ABarChartActor()
     }
 }
 
+#if WITH_EDITOR
+void ABarChartActor::PreSave(FObjectPreSaveContext SaveContext)
+{
+    Super::PreSave(SaveContext);
+    UChartDatasetAsset::PackForCook(SaveContext, this, BarDataTable, DatasetAsset);
+}
+
+void ABarChartActor::Serialize(FArchive& Ar)
+{
+    FChartCookedTableScope CookedTable(Ar, this, BarDataTable, DatasetAsset);
+    Super::Serialize(Ar);
+}
+#endif
+
 void ABarChartActor::BeginPlay()
 {
     Super::BeginPlay();
+
+    // The chart builds once the asset's columns have been read
+    if (DatasetAsset && !RuntimeDataset.IsValid())
+    {
+        TWeakObjectPtr<ABarChartActor> WeakThis(this);
+        DatasetAsset->LoadDataset([WeakThis](TSharedPtr<const FChartDataset> Dataset)
+        {
+            ABarChartActor* This = WeakThis.Get();
+            if (This && Dataset.IsValid())
+            {
+                This->SetRuntimeDataset(Dataset);
+                This->Rebuild();
+            }
+        });
+        return;
+    }
+
     Rebuild();
 }
 
 void ABarChartActor::LoadBarData()
 {
     BarPoints.Empty();
+    BarRowStarts.Empty();
+    BarRows.Empty();
+    BarOfRow.Reset();
+    bBarsAreRows = false;
 
     if (RuntimeBarPoints.Num() > 0)
     {
         BarPoints = RuntimeBarPoints;
+        if (RuntimeDataset.IsValid() && RuntimeBarOfRow.Num() == RuntimeDataset->NumRows)
+        {
+            SetBarRows(RuntimeBarOfRow);
+        }
+        else if (RuntimeBarOfRow.Num() > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("BarChartActor - Bars were given for %d rows but the dataset has %d; filters and linked selections are off"),
+                RuntimeBarOfRow.Num(), RuntimeDataset.IsValid() ? RuntimeDataset->NumRows : 0);
+        }
+        return;
+    }
+
+    if (RuntimeDataset.IsValid() && GroupBy.IsSet())
+    {
+        FString Error;
+        if (!FChartAggregation::GroupBy(*RuntimeDataset, GroupBy, BarPoints, Error, &BarOfRow))
+        {
+            UE_LOG(LogTemp, Error, TEXT("BarChartActor - Cannot group the dataset rows: %s"), *Error);
+            return;
+        }
+        SetBarRows(BarOfRow);
+        return;
+    }
+
+    if (RuntimeDataset.IsValid())
+    {
+        const FChartColumn* XIndexColumn = RuntimeDataset->GetColumn(TEXT("XIndex"));
+        const FChartColumn* YIndexColumn = RuntimeDataset->GetColumn(TEXT("YIndex"));
+        const FChartColumn* ValueColumn = RuntimeDataset->GetColumn(TEXT("Value"));
+        if (!XIndexColumn || !YIndexColumn || !ValueColumn)
+        {
+            UE_LOG(LogTemp, Error, TEXT("BarChartActor - Dataset needs XIndex, YIndex and Value columns"));
+            return;
+        }
+
+        // Text labels stay in the dataset's dictionary; UpdateAxisLayout reads them by code, once per axis index
+        const FChartColumn* XLabelColumn = RuntimeDataset->GetColumn(TEXT("XLabel"));
+        const FChartColumn* YLabelColumn = RuntimeDataset->GetColumn(TEXT("YLabel"));
+        XLabelColumn = XLabelColumn && XLabelColumn->Type == EChartColumnType::Float ? XLabelColumn : nullptr;
+        YLabelColumn = YLabelColumn && YLabelColumn->Type == EChartColumnType::Float ? YLabelColumn : nullptr;
+        BarPoints.Reserve(RuntimeDataset->NumRows);
+        BarRowStarts.Reserve(RuntimeDataset->NumRows + 1);
+        BarRows.Reserve(RuntimeDataset->NumRows);
+        BarRowStarts.Add(0);
+        bBarsAreRows = true;
+        for (int32 Row = 0; Row < RuntimeDataset->NumRows; ++Row)
+        {
+            const float XIndex = XIndexColumn->GetFloat(Row);
+            const float YIndex = YIndexColumn->GetFloat(Row);
+            if (FMath::IsNaN(XIndex) || FMath::IsNaN(YIndex))
+            {
+                continue;
+            }
+
+            BarRows.Add(Row);
+            BarRowStarts.Add(BarRows.Num());
+            FVRBarData& Bar = BarPoints.AddDefaulted_GetRef();
+            Bar.XIndex = FMath::RoundToInt(XIndex);
+            Bar.YIndex = FMath::RoundToInt(YIndex);
+            const float Value = ValueColumn->GetFloat(Row);
+            Bar.Value = FMath::IsNaN(Value) ? 0.0f : Value;
+            Bar.XLabel = XLabelColumn ? XLabelColumn->GetString(Row) : FString();
+            Bar.YLabel = YLabelColumn ? YLabelColumn->GetString(Row) : FString();
+        }
         return;
     }
 
@@ -68,51 +174,94 @@ FLinearColor ABarChartActor::GetBarColor(int32 BarIndex)
     );
 }
 
-void ABarChartActor::GenerateBars()
+FVector ABarChartActor::GetLayoutScale() const
 {
-    if (BarPoints.Num() == 0) return;
+    // Apply GraphScale to all dimensions
+    return FVector(
+        FMath::Max(GraphScale.X, 0.001f),
+        FMath::Max(GraphScale.Y, 0.001f),
+        FMath::Max(GraphScale.Z, 0.001f)
+    );
+}
+
+FQuat ABarChartActor::GetGraphRotation() const
+{
+    return GetActorQuat() * AdditionalRotation.Quaternion();
+}
 
-    // Collect unique labels and find data bounds
+void ABarChartActor::ConfigureText(AAxisTickActor* Tick) const
+{
+    if (!Tick) return;
+    if (UTextRenderComponent* TextComp = Tick->FindComponentByClass<UTextRenderComponent>())
+    {
+        TextComp->SetWorldSize(TextWorldSize);
+        TextComp->SetHorizontalAlignment(EHTA_Center);
+        TextComp->SetVerticalAlignment(EVRTA_TextCenter);
+    }
+}
+
+const FChartColumn* ABarChartActor::GetLabelCodes(FName ColumnName) const
+{
+    const FChartColumn* Column = bBarsAreRows && RuntimeDataset.IsValid() ? RuntimeDataset->GetColumn(ColumnName) : nullptr;
+    return Column && Column->Type == EChartColumnType::String ? Column : nullptr;
+}
+
+bool ABarChartActor::UpdateAxisLayout()
+{
+    // Collect unique labels and find data bounds. Dataset text labels are taken from the column's dictionary,
+    // so a label is only copied once per axis index rather than once per bar.
     TMap<int32, FString> XIndexToLabel;
     TMap<int32, FString> YIndexToLabel;
     float MaxValue = 0.0f;
     int32 MinXIndex = INT32_MAX;
-    int32 MaxXIndex = INT32_MIN;
     int32 MinYIndex = INT32_MAX;
-    int32 MaxYIndex = INT32_MIN;
     int32 MaxLabelLength = 1;
 
-    for (const FVRBarData& Row : BarPoints)
+    const FChartColumn* XLabelCodes = GetLabelCodes(TEXT("XLabel"));
+    const FChartColumn* YLabelCodes = GetLabelCodes(TEXT("YLabel"));
+    for (int32 BarIndex = 0; BarIndex < BarPoints.Num(); ++BarIndex)
     {
+        const FVRBarData& Row = BarPoints[BarIndex];
         MaxValue = FMath::Max(MaxValue, Row.Value);
         MinXIndex = FMath::Min(MinXIndex, Row.XIndex);
-        MaxXIndex = FMath::Max(MaxXIndex, Row.XIndex);
         MinYIndex = FMath::Min(MinYIndex, Row.YIndex);
-        MaxYIndex = FMath::Max(MaxYIndex, Row.YIndex);
 
         if (!XIndexToLabel.Contains(Row.XIndex))
         {
-            XIndexToLabel.Add(Row.XIndex, Row.XLabel);
-            MaxLabelLength = FMath::Max(MaxLabelLength, Row.XLabel.Len());
+            const FString& Label = XLabelCodes ? XLabelCodes->GetLabel(BarRows[BarRowStarts[BarIndex]]) : Row.XLabel;
+            XIndexToLabel.Add(Row.XIndex, Label);
+            MaxLabelLength = FMath::Max(MaxLabelLength, Label.Len());
         }
         if (!YIndexToLabel.Contains(Row.YIndex))
         {
-            YIndexToLabel.Add(Row.YIndex, Row.YLabel);
-            MaxLabelLength = FMath::Max(MaxLabelLength, Row.YLabel.Len());
+            const FString& Label = YLabelCodes ? YLabelCodes->GetLabel(BarRows[BarRowStarts[BarIndex]]) : Row.YLabel;
+            YIndexToLabel.Add(Row.YIndex, Label);
+            MaxLabelLength = FMath::Max(MaxLabelLength, Label.Len());
         }
     }
 
     if (MinXIndex == INT32_MAX) MinXIndex = 0;
-    if (MaxXIndex == INT32_MIN) MaxXIndex = 0;
     if (MinYIndex == INT32_MAX) MinYIndex = 0;
-    if (MaxYIndex == INT32_MIN) MaxYIndex = 0;
 
-    // Apply GraphScale to all dimensions
-    const FVector Scale(
-        FMath::Max(GraphScale.X, 0.001f),
-        FMath::Max(GraphScale.Y, 0.001f),
-        FMath::Max(GraphScale.Z, 0.001f)
-    );
+    const FAxisGridConfig ZConfig = DataVizGrid::ComputeAxisGrid(0.0f, bUseCustomRange ? ZMax : MaxValue, ZTickCount);
+    const bool bChanged = !DataVizGrid::IsSameAxis(ZConfig, ZAxisMin, ZAxisMax, ZAxisStep)
+        || MinXIndex != AxisMinXIndex || MinYIndex != AxisMinYIndex || MaxLabelLength != AxisMaxLabelLength
+        || !XIndexToLabel.OrderIndependentCompareEqual(XAxisLabels) || !YIndexToLabel.OrderIndependentCompareEqual(YAxisLabels);
+
+    ZAxisMin = ZConfig.AxisMin; ZAxisMax = ZConfig.AxisMax; ZAxisStep = ZConfig.TickStep;
+    AxisMaxValue = MaxValue;
+    AxisMinXIndex = MinXIndex;
+    AxisMinYIndex = MinYIndex;
+    AxisMaxLabelLength = MaxLabelLength;
+    XAxisLabels = MoveTemp(XIndexToLabel);
+    YAxisLabels = MoveTemp(YIndexToLabel);
+    return bChanged;
+}
+
+void ABarChartActor::PlaceBar(int32 BarIndex, ABarActor* Bar, AAxisTickActor* ValueLabel)
+{
+    const FVRBarData& Row = BarPoints[BarIndex];
+    const FVector Scale = GetLayoutScale();
 
     // Scaled dimensions
     const float ScaledCellX = CellSizeX * Scale.X;
@@ -120,12 +269,122 @@ void ABarChartActor::GenerateBars()
     const float ScaledBarWidth = BarWidth * Scale.X;
     const float ScaledBarDepth = BarDepth * Scale.Y;
     const float ScaledHeightScale = HeightScale * Scale.Z;
+    const float EffectiveTextSize = TextWorldSize * TextScale;
+    const float BasePadding = 15.0f * FMath::Max(Scale.X, Scale.Y);
+
+    const FVector Origin = GetActorLocation();
+    const FQuat GraphRotation = GetGraphRotation();
+
+    float ValueForHeight = Row.Value;
+    if (bUseCustomRange)
+    {
+        ValueForHeight = FMath::Clamp(Row.Value, ZMin, ZMax);
+    }
+    ValueForHeight = FMath::Max(0.0f, ValueForHeight);
+
+    const float BarHeight = ValueForHeight * ScaledHeightScale;
+
+    // Bar center position
+    const FVector LocalPos(
+        Row.XIndex * ScaledCellX,
+        Row.YIndex * ScaledCellY,
+        BarHeight * 0.5f
+    );
+    const FVector WorldPos = Origin + GraphRotation.RotateVector(LocalPos);
+
+    // Get deterministic color for this bar
+    const FLinearColor CurrentBarColor = IsBarSelected(BarIndex) ? SelectionColor : (bUniqueBarColors ? GetBarColor(BarIndex) : BarColor);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Owner = this;
+
+    if (!Bar)
+    {
+        Bar = GetWorld()->SpawnActor<ABarActor>(ABarActor::StaticClass(), FTransform(GraphRotation, WorldPos), SpawnParams);
+        if (Bar)
+        {
+            Bar->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+        }
+    }
+    if (Bar)
+    {
+        Bar->InitializeBar(WorldPos, GraphRotation, ScaledBarWidth, ScaledBarDepth, BarHeight, BarColorMaterial, CurrentBarColor);
+    }
+    BarActors[BarIndex] = Bar;
+
+    // Value label on top of bar
+    if (!bShowValueLabels)
+    {
+        if (ValueLabel)
+        {
+            ValueLabel->Destroy();
+        }
+        ValueLabels[BarIndex] = nullptr;
+        return;
+    }
+
+    const float ValueLabelZ = BarHeight + EffectiveTextSize + BasePadding;
+    const FVector LabelLocalPos(
+        Row.XIndex * ScaledCellX,
+        Row.YIndex * ScaledCellY,
+        ValueLabelZ
+    );
+    const FVector LabelWorldPos = Origin + GraphRotation.RotateVector(LabelLocalPos);
+
+    if (!ValueLabel)
+    {
+        ValueLabel = GetWorld()->SpawnActor<AAxisTickActor>(AAxisTickActor::StaticClass(), FTransform(GraphRotation, LabelWorldPos), SpawnParams);
+        if (ValueLabel)
+        {
+            ValueLabel->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+        }
+    }
+    if (ValueLabel)
+    {
+        const FRotator ValueLabelRot(0.0f, 90.0f, 0.0f);
+        ValueLabel->InitializeTick(LabelWorldPos, FString::Printf(TEXT("%.1f"), Row.Value), (GraphRotation * ValueLabelRot.Quaternion()).Rotator());
+        ValueLabel->SetFaceCamera(true);
+        ValueLabel->SetActorScale3D(FVector(TextScale));
+        ConfigureText(ValueLabel);
+    }
+    ValueLabels[BarIndex] = ValueLabel;
+}
+
+void ABarChartActor::GenerateBars()
+{
+    if (BarPoints.Num() == 0) return;
+
+    UpdateAxisLayout();
+
+    // Spawn bars and value labels (sampled while previewing)
+    TArray<int32> DrawIndices;
+    DataVizSampling::StratifiedIndices(BarPoints.Num(), DataVizSampling::RowBudget(bPreviewFidelity, MaxPreviewPrimitives, bShowValueLabels ? 2 : 1), DrawIndices);
+    BarActors.Init(nullptr, BarPoints.Num());
+    ValueLabels.Init(nullptr, BarPoints.Num());
+    for (const int32 BarIndex : DrawIndices)
+    {
+        PlaceBar(BarIndex, nullptr, nullptr);
+    }
+
+    GenerateAxisLabels();
+    ApplyFilter();
+}
+
+void ABarChartActor::GenerateAxisLabels()
+{
+    const FVector Scale = GetLayoutScale();
+
+    // Scaled dimensions
+    const float ScaledCellX = CellSizeX * Scale.X;
+    const float ScaledCellY = CellSizeY * Scale.Y;
+    const float ScaledBarWidth = BarWidth * Scale.X;
+    const float ScaledBarDepth = BarDepth * Scale.Y;
     
     // Text size in world units
     const float EffectiveTextSize = TextWorldSize * TextScale;
     
     // Estimate text width based on character count (rough approximation: width ~= 0.6 * height per char)
-    const float EstimatedTextWidth = EffectiveTextSize * 0.6f * MaxLabelLength;
+    const float EstimatedTextWidth = EffectiveTextSize * 0.6f * AxisMaxLabelLength;
     
     // Padding to prevent overlap
     const float BasePadding = 15.0f * FMath::Max(Scale.X, Scale.Y);
@@ -140,7 +399,7 @@ void ABarChartActor::GenerateBars()
     const float LabelZHeight = EffectiveTextSize + BasePadding;
 
     const FVector Origin = GetActorLocation();
-    const FQuat GraphRotation = GetActorQuat() * AdditionalRotation.Quaternion();
+    const FQuat GraphRotation = GetGraphRotation();
 
     auto LocalToWorld = [&](const FVector& Local) -> FVector
     {
@@ -152,92 +411,23 @@ void ABarChartActor::GenerateBars()
         return (GraphRotation * LocalRot.Quaternion()).Rotator();
     };
 
-    auto ConfigureText = [this](AAxisTickActor* Tick)
-    {
-        if (!Tick) return;
-        if (UTextRenderComponent* TextComp = Tick->FindComponentByClass<UTextRenderComponent>())
-        {
-            TextComp->SetWorldSize(TextWorldSize);
-            TextComp->SetHorizontalAlignment(EHTA_Center);
-            TextComp->SetVerticalAlignment(EVRTA_TextCenter);
-        }
-    };
-
     FActorSpawnParameters SpawnParams;
     SpawnParams.Owner = this;
-    
-    const FRotator ValueLabelRot(0.0f, 90.0f, 0.0f);
-
-    // Spawn bars and value labels
-    int32 BarIndex = 0;
-    for (const FVRBarData& Row : BarPoints)
-    {
-        float ValueForHeight = Row.Value;
-        if (bUseCustomRange)
-        {
-            ValueForHeight = FMath::Clamp(Row.Value, ZMin, ZMax);
-        }
-        ValueForHeight = FMath::Max(0.0f, ValueForHeight);
-
-        const float BarHeight = ValueForHeight * ScaledHeightScale;
-
-        // Bar center position
-        const FVector LocalPos(
-            Row.XIndex * ScaledCellX,
-            Row.YIndex * ScaledCellY,
-            BarHeight * 0.5f
-        );
-        const FVector WorldPos = LocalToWorld(LocalPos);
-
-        // Get deterministic color for this bar
-        const FLinearColor CurrentBarColor = bUniqueBarColors ? GetBarColor(BarIndex) : BarColor;
-
-        if (ABarActor* Bar = GetWorld()->SpawnActor<ABarActor>(ABarActor::StaticClass(), FTransform(GraphRotation, WorldPos), SpawnParams))
-        {
-            Bar->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-            Bar->InitializeBar(WorldPos, GraphRotation, ScaledBarWidth, ScaledBarDepth, BarHeight, BarColorMaterial, CurrentBarColor);
-            SpawnedChildren.Add(Bar);
-        }
-
-        // Value label on top of bar
-        if (bShowValueLabels)
-        {
-            const float ValueLabelZ = BarHeight + EffectiveTextSize + BasePadding;
-            const FVector LabelLocalPos(
-                Row.XIndex * ScaledCellX,
-                Row.YIndex * ScaledCellY,
-                ValueLabelZ
-            );
-            const FVector LabelWorldPos = LocalToWorld(LabelLocalPos);
-
-            if (AAxisTickActor* Tick = GetWorld()->SpawnActor<AAxisTickActor>(AAxisTickActor::StaticClass(), FTransform(GraphRotation, LabelWorldPos), SpawnParams))
-            {
-                Tick->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-                Tick->InitializeTick(LabelWorldPos, FString::Printf(TEXT("%.1f"), Row.Value), RotateLabel(ValueLabelRot));
-                Tick->SetFaceCamera(true);
-                Tick->SetActorScale3D(FVector(TextScale));
-                ConfigureText(Tick);
-                SpawnedChildren.Add(Tick);
-            }
-        }
-        
-        BarIndex++;
-    }
 
     // X-axis labels (placed along Y edge)
     TArray<int32> SortedXIndices;
-    XIndexToLabel.GetKeys(SortedXIndices);
+    XAxisLabels.GetKeys(SortedXIndices);
     SortedXIndices.Sort();
 
     const FRotator XLabelRot(0.0f, 180.0f, 0.0f);
 
     for (int32 XIdx : SortedXIndices)
     {
-        const FString& Label = XIndexToLabel[XIdx];
+        const FString& Label = XAxisLabels[XIdx];
         
         const FVector LocalLabelPos(
             XIdx * ScaledCellX,
-            MinYIndex * ScaledCellY - XLabelOffset,
+            AxisMinYIndex * ScaledCellY - XLabelOffset,
             LabelZHeight
         );
         const FVector WorldLabelPos = LocalToWorld(LocalLabelPos);
@@ -255,17 +445,17 @@ void ABarChartActor::GenerateBars()
 
     // Y-axis labels (placed along X edge)
     TArray<int32> SortedYIndices;
-    YIndexToLabel.GetKeys(SortedYIndices);
+    YAxisLabels.GetKeys(SortedYIndices);
     SortedYIndices.Sort();
 
     const FRotator YLabelRot(0.0f, -90.0f, 0.0f);
 
     for (int32 YIdx : SortedYIndices)
     {
-        const FString& Label = YIndexToLabel[YIdx];
+        const FString& Label = YAxisLabels[YIdx];
         
         const FVector LocalLabelPos(
-            MinXIndex * ScaledCellX - YLabelOffset,
+            AxisMinXIndex * ScaledCellX - YLabelOffset,
             YIdx * ScaledCellY,
             LabelZHeight
         );
@@ -284,11 +474,11 @@ void ABarChartActor::GenerateBars()
 
     // Z-axis ticks (closer to the chart)
     const FVector AxisOrigin(
-        MinXIndex * ScaledCellX - HalfScaledBarWidth - BasePadding,
-        MinYIndex * ScaledCellY - HalfScaledBarDepth - BasePadding,
+        AxisMinXIndex * ScaledCellX - HalfScaledBarWidth - BasePadding,
+        AxisMinYIndex * ScaledCellY - HalfScaledBarDepth - BasePadding,
         0.0f
     );
-    GenerateZAxisTicks(MaxValue, AxisOrigin, GraphRotation, ScaledBarWidth, ScaledBarDepth);
+    GenerateZAxisTicks(AxisMaxValue, AxisOrigin, GraphRotation, ScaledBarWidth, ScaledBarDepth);
 }
 
 void ABarChartActor::GenerateZAxisTicks(float MaxValue, const FVector& AxisOrigin, const FQuat& GraphRotation, float ScaledBarWidth, float ScaledBarDepth)
@@ -313,17 +503,6 @@ void ABarChartActor::GenerateZAxisTicks(float MaxValue, const FVector& AxisOrigi
         return (GraphRotation * LocalRot.Quaternion()).Rotator();
     };
 
-    auto ConfigureText = [this](AAxisTickActor* Tick)
-    {
-        if (!Tick) return;
-        if (UTextRenderComponent* TextComp = Tick->FindComponentByClass<UTextRenderComponent>())
-        {
-            TextComp->SetWorldSize(TextWorldSize);
-            TextComp->SetHorizontalAlignment(EHTA_Center);
-            TextComp->SetVerticalAlignment(EVRTA_TextCenter);
-        }
-    };
-
     const float DataMax = bUseCustomRange ? ZMax : MaxValue;
     const FAxisGridConfig ZConfig = DataVizGrid::ComputeAxisGrid(0.0f, DataMax, ZTickCount);
 
@@ -381,7 +560,7 @@ void ABarChartActor::GenerateZAxisTicks(float MaxValue, const FVector& AxisOrigi
     }
 }
 
-void ABarChartActor::ClearChildrenActors()
+void ABarChartActor::ClearAxisActors()
 {
     for (AActor* Child : SpawnedChildren)
     {
@@ -393,9 +572,334 @@ void ABarChartActor::ClearChildrenActors()
     SpawnedChildren.Empty();
 }
 
+void ABarChartActor::ClearChildrenActors()
+{
+    for (ABarActor* Bar : BarActors)
+    {
+        if (IsValid(Bar))
+        {
+            Bar->Destroy();
+        }
+    }
+    for (AAxisTickActor* Label : ValueLabels)
+    {
+        if (IsValid(Label))
+        {
+            Label->Destroy();
+        }
+    }
+    BarActors.Empty();
+    ValueLabels.Empty();
+    ClearAxisActors();
+}
+
+bool ABarChartActor::SetFilter(const FString& Expression)
+{
+    FChartFilter NewFilter;
+    FString Error;
+    if (!FChartFilter::Compile(Expression, NewFilter, Error))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BarChartActor - Filter \"%s\" not applied: %s"), *Expression, *Error);
+        return false;
+    }
+    Filter = MoveTemp(NewFilter);
+    return ApplyFilter();
+}
+
+bool ABarChartActor::ApplyFilter()
+{
+    FilterMask.Reset();
+    bool bApplied = true;
+    if (!Filter.IsEmpty())
+    {
+        FString Error = TEXT("filters need bars built from the rows of a runtime dataset");
+        bApplied = RuntimeDataset.IsValid() && HasBarRows() && BarActors.Num() == BarPoints.Num() && Filter.Evaluate(*RuntimeDataset, FilterMask, Error);
+        if (!bApplied)
+        {
+            FilterMask.Reset();
+            UE_LOG(LogTemp, Warning, TEXT("BarChartActor - Filter \"%s\" not applied: %s"), *Filter.GetExpression(), *Error);
+        }
+    }
+
+    // Only bars whose visibility changes are touched, so narrowing or widening a filter costs one pass over the mask.
+    // A bar stays while any of its rows is kept.
+    for (int32 BarIndex = 0; BarIndex < BarActors.Num(); ++BarIndex)
+    {
+        bool bHidden = !FilterMask.IsEmpty();
+        for (const int32 Row : bHidden ? GetBarRows(BarIndex) : TConstArrayView<int32>())
+        {
+            if (FilterMask[Row])
+            {
+                bHidden = false;
+                break;
+            }
+        }
+        ABarActor* Bar = BarActors[BarIndex];
+        if (IsValid(Bar) && Bar->IsHidden() != bHidden)
+        {
+            Bar->SetActorHiddenInGame(bHidden);
+            Bar->SetActorEnableCollision(!bHidden);
+        }
+        AAxisTickActor* ValueLabel = ValueLabels.IsValidIndex(BarIndex) ? ValueLabels[BarIndex] : nullptr;
+        if (IsValid(ValueLabel) && ValueLabel->IsHidden() != bHidden)
+        {
+            ValueLabel->SetActorHiddenInGame(bHidden);
+        }
+    }
+    return bApplied;
+}
+
+void ABarChartActor::SetBarRows(TConstArrayView<int32> InBarOfRow)
+{
+    // Rows are bucketed by bar in one counting pass, ascending within each bar
+    BarRowStarts.Init(0, BarPoints.Num() + 1);
+    for (const int32 BarIndex : InBarOfRow)
+    {
+        if (BarPoints.IsValidIndex(BarIndex))
+        {
+            ++BarRowStarts[BarIndex + 1];
+        }
+    }
+    for (int32 BarIndex = 0; BarIndex < BarPoints.Num(); ++BarIndex)
+    {
+        BarRowStarts[BarIndex + 1] += BarRowStarts[BarIndex];
+    }
+    TArray<int32> NextRow(BarRowStarts.GetData(), BarPoints.Num());
+    BarRows.SetNumUninitialized(BarRowStarts.Last());
+    for (int32 Row = 0; Row < InBarOfRow.Num(); ++Row)
+    {
+        if (BarPoints.IsValidIndex(InBarOfRow[Row]))
+        {
+            BarRows[NextRow[InBarOfRow[Row]]++] = Row;
+        }
+    }
+}
+
+TConstArrayView<int32> ABarChartActor::GetBarRows(int32 BarIndex) const
+{
+    return HasBarRows() && BarPoints.IsValidIndex(BarIndex)
+        ? TConstArrayView<int32>(BarRows.GetData() + BarRowStarts[BarIndex], BarRowStarts[BarIndex + 1] - BarRowStarts[BarIndex])
+        : TConstArrayView<int32>();
+}
+
+void ABarChartActor::SetSelection(TSharedPtr<FChartSelection> InSelection)
+{
+    if (Selection.IsValid())
+    {
+        Selection->OnChanged.Remove(SelectionChangedHandle);
+    }
+    Selection = MoveTemp(InSelection);
+    SelectionChangedHandle = Selection.IsValid() ? Selection->OnChanged.AddUObject(this, &ABarChartActor::OnSelectionChanged) : FDelegateHandle();
+
+    // Bar colors are not tracked per bar, so every placed bar is redrawn
+    for (int32 BarIndex = 0; BarIndex < BarActors.Num(); ++BarIndex)
+    {
+        if (IsValid(BarActors[BarIndex]))
+        {
+            PlaceBar(BarIndex, BarActors[BarIndex], ValueLabels.IsValidIndex(BarIndex) ? ValueLabels[BarIndex] : nullptr);
+        }
+    }
+}
+
+void ABarChartActor::SelectBars(const TArray<int32>& BarIndices, bool bAddToSelection)
+{
+    if (!Selection.IsValid())
+    {
+        SetSelection(MakeShared<FChartSelection>(RuntimeDataset.IsValid() && HasBarRows() ? RuntimeDataset->NumRows : BarPoints.Num()));
+    }
+
+    // Bars without source rows stand for themselves
+    TArray<int32> Rows;
+    Rows.Reserve(BarIndices.Num());
+    for (const int32 BarIndex : BarIndices)
+    {
+        if (!BarPoints.IsValidIndex(BarIndex))
+        {
+            continue;
+        }
+        if (HasBarRows())
+        {
+            const TConstArrayView<int32> BarRowsOfBar = GetBarRows(BarIndex);
+            Rows.Append(BarRowsOfBar.GetData(), BarRowsOfBar.Num());
+        }
+        else
+        {
+            Rows.Add(BarIndex);
+        }
+    }
+    Selection->SelectRows(Rows, bAddToSelection ? EChartSelectionOp::Add : EChartSelectionOp::Replace);
+}
+
+void ABarChartActor::ClearSelection()
+{
+    if (Selection.IsValid())
+    {
+        Selection->Clear();
+    }
+}
+
+bool ABarChartActor::IsBarSelected(int32 BarIndex) const
+{
+    if (!Selection.IsValid() || !BarPoints.IsValidIndex(BarIndex))
+    {
+        return false;
+    }
+    if (!HasBarRows())
+    {
+        return Selection->IsSelected(BarIndex);
+    }
+    for (const int32 Row : GetBarRows(BarIndex))
+    {
+        if (Selection->IsSelected(Row))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ABarChartActor::OnSelectionChanged(const FChartSelectionChange& Change)
+{
+    if (BarOfRow.Num() == 0 && !HasBarRows())
+    {
+        BarOfRow.SetNumUninitialized(BarPoints.Num());
+        for (int32 BarIndex = 0; BarIndex < BarPoints.Num(); ++BarIndex)
+        {
+            BarOfRow[BarIndex] = BarIndex;
+        }
+    }
+    else if (BarOfRow.Num() == 0)
+    {
+        int32 NumRows = 0;
+        for (const int32 Row : BarRows)
+        {
+            NumRows = FMath::Max(NumRows, Row + 1);
+        }
+        BarOfRow.Init(INDEX_NONE, NumRows);
+        for (int32 BarIndex = 0; BarIndex < BarPoints.Num(); ++BarIndex)
+        {
+            for (const int32 Row : GetBarRows(BarIndex))
+            {
+                BarOfRow[Row] = BarIndex;
+            }
+        }
+    }
+
+    // A bar of many rows is redrawn once however many of them flipped
+    TBitArray<> Redrawn(false, BarActors.Num());
+    Change.ForEachRow([this, &Redrawn](int32 Row)
+    {
+        const int32 BarIndex = BarOfRow.IsValidIndex(Row) ? BarOfRow[Row] : INDEX_NONE;
+        if (BarActors.IsValidIndex(BarIndex) && !Redrawn[BarIndex] && IsValid(BarActors[BarIndex]))
+        {
+            Redrawn[BarIndex] = true;
+            PlaceBar(BarIndex, BarActors[BarIndex], ValueLabels.IsValidIndex(BarIndex) ? ValueLabels[BarIndex] : nullptr);
+        }
+    });
+}
+
 void ABarChartActor::Rebuild()
 {
     ClearChildrenActors();
     LoadBarData();
     GenerateBars();
 }
+
+void ABarChartActor::ApplyDatasetUpdate(TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff)
+{
+    // A preview sample picks bars by position, and grouped or SetRuntimeData bars are not the dataset's rows
+    const bool bCanPatch = RuntimeDataset.IsValid() && NewDataset.IsValid() && !bPreviewFidelity && !Diff.bSchemaChanged
+        && bBarsAreRows && HasBarRows() && Diff.NewToOld.Num() == NewDataset->NumRows && BarPoints.Num() > 0
+        && BarActors.Num() == BarPoints.Num() && ValueLabels.Num() == BarPoints.Num();
+    if (!bCanPatch)
+    {
+        SetRuntimeDataset(MoveTemp(NewDataset));
+        Rebuild();
+        return;
+    }
+
+    // Bars read from the dataset's rows hold one row each, so BarRows lines up with the bars
+    TArray<int32> OldBarOfRow;
+    OldBarOfRow.Init(INDEX_NONE, RuntimeDataset->NumRows);
+    for (int32 BarIndex = 0; BarIndex < BarRows.Num(); ++BarIndex)
+    {
+        OldBarOfRow[BarRows[BarIndex]] = BarIndex;
+    }
+    const TArray<FVRBarData> OldBars = MoveTemp(BarPoints);
+    const TArray<ABarActor*> OldBarActors = MoveTemp(BarActors);
+    const TArray<AAxisTickActor*> OldValueLabels = MoveTemp(ValueLabels);
+
+    RuntimeDataset = MoveTemp(NewDataset);
+    LoadBarData();
+    const bool bAxesChanged = BarPoints.Num() == 0 || UpdateAxisLayout();
+
+    // Bars of rows that survived stay as they are unless their cell, value or (index-seeded) color changed
+    BarActors.Init(nullptr, BarPoints.Num());
+    ValueLabels.Init(nullptr, BarPoints.Num());
+    TBitArray<> OldKept(false, OldBars.Num());
+    TArray<int32> Unplaced;
+    int32 NumUpdated = 0;
+    for (int32 BarIndex = 0; BarIndex < BarPoints.Num(); ++BarIndex)
+    {
+        const int32 OldRow = Diff.NewToOld[BarRows[BarIndex]];
+        const int32 OldBar = OldRow != INDEX_NONE ? OldBarOfRow[OldRow] : INDEX_NONE;
+        if (OldBar == INDEX_NONE || !IsValid(OldBarActors[OldBar]))
+        {
+            Unplaced.Add(BarIndex);
+            continue;
+        }
+
+        OldKept[OldBar] = true;
+        const FVRBarData& Old = OldBars[OldBar];
+        const FVRBarData& New = BarPoints[BarIndex];
+        const bool bSame = Old.XIndex == New.XIndex && Old.YIndex == New.YIndex && Old.Value == New.Value
+            && (!bUniqueBarColors || OldBar == BarIndex);
+        if (bSame)
+        {
+            BarActors[BarIndex] = OldBarActors[OldBar];
+            ValueLabels[BarIndex] = OldValueLabels[OldBar];
+        }
+        else
+        {
+            PlaceBar(BarIndex, OldBarActors[OldBar], OldValueLabels[OldBar]);
+            ++NumUpdated;
+        }
+    }
+
+    // Bars of removed rows are reused for appended ones before anything is spawned or destroyed
+    TArray<int32> FreeBars;
+    for (int32 OldBar = 0; OldBar < OldBars.Num(); ++OldBar)
+    {
+        if (!OldKept[OldBar] && IsValid(OldBarActors[OldBar]))
+        {
+            FreeBars.Add(OldBar);
+        }
+    }
+    for (const int32 BarIndex : Unplaced)
+    {
+        const int32 OldBar = FreeBars.Num() > 0 ? FreeBars.Pop() : INDEX_NONE;
+        PlaceBar(BarIndex, OldBar != INDEX_NONE ? OldBarActors[OldBar] : nullptr, OldBar != INDEX_NONE ? OldValueLabels[OldBar] : nullptr);
+    }
+    for (const int32 OldBar : FreeBars)
+    {
+        OldBarActors[OldBar]->Destroy();
+        if (IsValid(OldValueLabels[OldBar]))
+        {
+            OldValueLabels[OldBar]->Destroy();
+        }
+    }
+
+    if (bAxesChanged)
+    {
+        ClearAxisActors();
+        if (BarPoints.Num() > 0)
+        {
+            GenerateAxisLabels();
+        }
+    }
+    ApplyFilter();
+
+    UE_LOG(LogTemp, Log, TEXT("BarChartActor - Applied %d modified, %d appended and %d removed rows: %d bars updated, %d placed, %d destroyed; axes %s"),
+        Diff.ModifiedRows.Num(), Diff.AppendedRows.Num(), Diff.RemovedRows.Num(), NumUpdated, Unplaced.Num(), FreeBars.Num(),
+        bAxesChanged ? TEXT("rebuilt") : TEXT("kept"));
+}
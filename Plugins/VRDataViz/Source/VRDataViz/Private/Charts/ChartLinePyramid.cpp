@@ -0,0 +1,176 @@
+#include "Charts/ChartLinePyramid.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    // Leaf buckets one worker summarizes
+    constexpr int32 BlockBuckets = 4 * 1024;
+
+    int64 GetBucketSize(int32 Level)
+    {
+        return static_cast<int64>(FChartLinePyramid::LeafPoints) << Level;
+    }
+}
+
+void FChartLinePyramid::Reset()
+{
+    NumPoints = 0;
+    NumSeries = 0;
+    Levels.Reset();
+}
+
+void FChartLinePyramid::Build(TConstArrayView<TConstArrayView<float>> Series)
+{
+    Reset();
+    if (Series.Num() == 0 || Series[0].Num() == 0)
+    {
+        return;
+    }
+    NumSeries = Series.Num();
+    NumPoints = Series[0].Num();
+    for (const TConstArrayView<float>& Values : Series)
+    {
+        check(Values.Num() == NumPoints);
+    }
+
+    // Earlier positions win ties, so equal plateaus draw from their start
+    const auto IsLower = [](TConstArrayView<float> Values, int32 A, int32 B)
+    {
+        return Values[A] < Values[B] || (FMath::IsNaN(Values[B]) && !FMath::IsNaN(Values[A]));
+    };
+    const auto IsHigher = [](TConstArrayView<float> Values, int32 A, int32 B)
+    {
+        return Values[A] > Values[B] || (FMath::IsNaN(Values[B]) && !FMath::IsNaN(Values[A]));
+    };
+
+    const int32 NumLeaves = FMath::DivideAndRoundUp(NumPoints, LeafPoints);
+    TArray<FExtremes>& Leaves = Levels.AddDefaulted_GetRef();
+    Leaves.SetNumUninitialized(NumLeaves * NumSeries);
+    ParallelFor(FMath::DivideAndRoundUp(NumLeaves, BlockBuckets), [this, Series, NumLeaves, &Leaves, &IsLower, &IsHigher](int32 Block)
+    {
+        const int32 EndBucket = FMath::Min(NumLeaves, (Block + 1) * BlockBuckets);
+        for (int32 Bucket = Block * BlockBuckets; Bucket < EndBucket; ++Bucket)
+        {
+            const int32 First = Bucket * LeafPoints;
+            const int32 End = FMath::Min(NumPoints, First + LeafPoints);
+            for (int32 SeriesIndex = 0; SeriesIndex < NumSeries; ++SeriesIndex)
+            {
+                const TConstArrayView<float> Values = Series[SeriesIndex];
+                FExtremes Extremes{ First, First };
+                for (int32 Position = First + 1; Position < End; ++Position)
+                {
+                    Extremes.Min = IsLower(Values, Position, Extremes.Min) ? Position : Extremes.Min;
+                    Extremes.Max = IsHigher(Values, Position, Extremes.Max) ? Position : Extremes.Max;
+                }
+                Leaves[Bucket * NumSeries + SeriesIndex] = Extremes;
+            }
+        }
+    });
+
+    while (Levels.Last().Num() > NumSeries)
+    {
+        TArray<FExtremes> Above;
+        {
+            const TArray<FExtremes>& Below = Levels.Last();
+            const int32 BelowBuckets = Below.Num() / NumSeries;
+            const int32 AboveBuckets = FMath::DivideAndRoundUp(BelowBuckets, 2);
+            Above.SetNumUninitialized(AboveBuckets * NumSeries);
+            for (int32 Bucket = 0; Bucket < AboveBuckets; ++Bucket)
+            {
+                for (int32 SeriesIndex = 0; SeriesIndex < NumSeries; ++SeriesIndex)
+                {
+                    const TConstArrayView<float> Values = Series[SeriesIndex];
+                    FExtremes Extremes = Below[Bucket * 2 * NumSeries + SeriesIndex];
+                    if (Bucket * 2 + 1 < BelowBuckets)
+                    {
+                        const FExtremes& Right = Below[(Bucket * 2 + 1) * NumSeries + SeriesIndex];
+                        Extremes.Min = IsLower(Values, Right.Min, Extremes.Min) ? Right.Min : Extremes.Min;
+                        Extremes.Max = IsHigher(Values, Right.Max, Extremes.Max) ? Right.Max : Extremes.Max;
+                    }
+                    Above[Bucket * NumSeries + SeriesIndex] = Extremes;
+                }
+            }
+        }
+        Levels.Add(MoveTemp(Above));
+    }
+}
+
+void FChartLinePyramid::Select(int32 Begin, int32 End, int32 MaxPoints, TArray<int32>& OutPositions) const
+{
+    OutPositions.Reset();
+    Begin = FMath::Max(Begin, 0);
+    End = FMath::Min(End, NumPoints);
+    if (Begin >= End)
+    {
+        return;
+    }
+
+    const int32 Count = End - Begin;
+    if (MaxPoints <= 0 || Count <= MaxPoints)
+    {
+        OutPositions.Reserve(Count);
+        for (int32 Position = Begin; Position < End; ++Position)
+        {
+            OutPositions.Add(Position);
+        }
+        return;
+    }
+
+    // The finest level whose buckets across the range draw no more than MaxPoints at GetPointsPerBucket() each
+    const int64 MaxBuckets = FMath::Max(1, MaxPoints / GetPointsPerBucket());
+    int32 Level = 0;
+    while (Level + 1 < Levels.Num() && (Count + GetBucketSize(Level) - 1) / GetBucketSize(Level) > MaxBuckets)
+    {
+        ++Level;
+    }
+
+    // Whole buckets of that level, and at the ends of the range the largest smaller buckets that fit, then single
+    // positions where not even a leaf bucket does
+    OutPositions.Reserve(MaxPoints + 2 * GetPointsPerBucket() * Level + 2 * LeafPoints);
+    TArray<int32, TInlineAllocator<8>> Picks;
+    int32 Position = Begin;
+    while (Position < End)
+    {
+        int32 BucketLevel = Level;
+        while (BucketLevel >= 0 && (Position % GetBucketSize(BucketLevel) != 0 || FMath::Min<int64>(Position + GetBucketSize(BucketLevel), NumPoints) > End))
+        {
+            --BucketLevel;
+        }
+        if (BucketLevel < 0)
+        {
+            OutPositions.Add(Position++);
+            continue;
+        }
+
+        const int32 BucketEnd = static_cast<int32>(FMath::Min<int64>(Position + GetBucketSize(BucketLevel), NumPoints));
+        const int32 Bucket = static_cast<int32>(Position / GetBucketSize(BucketLevel));
+        Picks.Reset();
+        Picks.Add(Position);
+        for (int32 SeriesIndex = 0; SeriesIndex < NumSeries; ++SeriesIndex)
+        {
+            const FExtremes& Extremes = Levels[BucketLevel][Bucket * NumSeries + SeriesIndex];
+            Picks.Add(Extremes.Min);
+            Picks.Add(Extremes.Max);
+        }
+        Picks.Add(BucketEnd - 1);
+        Picks.Sort();
+        for (const int32 Pick : Picks)
+        {
+            if (OutPositions.Num() == 0 || Pick > OutPositions.Last())
+            {
+                OutPositions.Add(Pick);
+            }
+        }
+        Position = BucketEnd;
+    }
+}
+
+SIZE_T FChartLinePyramid::GetAllocatedSize() const
+{
+    SIZE_T Size = Levels.GetAllocatedSize();
+    for (const TArray<FExtremes>& Level : Levels)
+    {
+        Size += Level.GetAllocatedSize();
+    }
+    return Size;
+}
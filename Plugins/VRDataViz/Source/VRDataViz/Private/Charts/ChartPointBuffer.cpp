@@ -0,0 +1,330 @@
+#include "Charts/ChartPointBuffer.h"
+#include "Data/ChartDatasetDiff.h"
+#include "Data/QuantileSketch.h"
+#include "Data/ChartSortOrder.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    constexpr double MaxCode = 65535.0;
+    // Points one worker reads back in a parallel pass over the buffer
+    constexpr int32 BlockPoints = 16 * 1024;
+
+    uint16 Quantize(double Value, double Min, double Step)
+    {
+        return Step > 0.0 ? static_cast<uint16>(FMath::Clamp(FMath::RoundToDouble((Value - Min) / Step), 0.0, MaxCode)) : 0;
+    }
+
+    bool IsFinitePoint(const FVector& Point)
+    {
+        return !Point.ContainsNaN() && FMath::IsFinite(Point.X) && FMath::IsFinite(Point.Y) && FMath::IsFinite(Point.Z);
+    }
+
+    // Spreads 16 bits out to every third bit of 48
+    uint64 SpreadBits(uint16 Value)
+    {
+        uint64 Bits = Value;
+        Bits = (Bits | (Bits << 16)) & 0x0000FF0000FFull;
+        Bits = (Bits | (Bits << 8)) & 0x00F00F00F00Full;
+        Bits = (Bits | (Bits << 4)) & 0x0C30C30C30C3ull;
+        Bits = (Bits | (Bits << 2)) & 0x249249249249ull;
+        return Bits;
+    }
+
+    uint64 MortonCode(uint16 X, uint16 Y, uint16 Z)
+    {
+        return SpreadBits(X) | (SpreadBits(Y) << 1) | (SpreadBits(Z) << 2);
+    }
+}
+
+void FChartPointBuffer::Reset()
+{
+    NumPoints = 0;
+    Bounds = FBox(ForceInit);
+    Origin = FVector::ZeroVector;
+    Step = FVector::ZeroVector;
+    Quantized.Reset();
+    Floats.Reset();
+}
+
+void FChartPointBuffer::Assign(TConstArrayView<FVector> Points, bool bQuantize)
+{
+    Reset();
+    NumPoints = Points.Num();
+
+    bool bFinite = true;
+    for (const FVector& Point : Points)
+    {
+        if (!IsFinitePoint(Point))
+        {
+            bFinite = false;
+            continue;
+        }
+        Bounds += Point;
+    }
+
+    if (!bQuantize || !bFinite || NumPoints == 0)
+    {
+        Floats.Reserve(NumPoints);
+        for (const FVector& Point : Points)
+        {
+            Floats.Add(FVector3f(Point));
+        }
+        return;
+    }
+
+    Origin = Bounds.Min;
+    Step = (Bounds.Max - Bounds.Min) / MaxCode;
+    Quantized.SetNumUninitialized(NumPoints * 3);
+    uint16* Code = Quantized.GetData();
+    for (const FVector& Point : Points)
+    {
+        *Code++ = Quantize(Point.X, Origin.X, Step.X);
+        *Code++ = Quantize(Point.Y, Origin.Y, Step.Y);
+        *Code++ = Quantize(Point.Z, Origin.Z, Step.Z);
+    }
+}
+
+void FChartPointBuffer::Append(TConstArrayView<FVector> Points)
+{
+    const int32 NumOld = NumPoints;
+    NumPoints += Points.Num();
+    bool bFinite = true;
+    for (const FVector& Point : Points)
+    {
+        if (!IsFinitePoint(Point))
+        {
+            bFinite = false;
+            continue;
+        }
+        Bounds += Point;
+    }
+
+    // Non-finite points cannot be quantized, so they turn the stored points into floats
+    if (IsQuantized() && !bFinite)
+    {
+        Floats.Reserve(NumPoints);
+        for (int32 Index = 0; Index < NumOld; ++Index)
+        {
+            Floats.Add(FVector3f((*this)[Index]));
+        }
+        Quantized.Empty();
+        Origin = FVector::ZeroVector;
+        Step = FVector::ZeroVector;
+    }
+    if (!IsQuantized())
+    {
+        Floats.Reserve(NumPoints);
+        for (const FVector& Point : Points)
+        {
+            Floats.Add(FVector3f(Point));
+        }
+        return;
+    }
+
+    // Values within half a step of the frame still round onto its first or last step
+    const FVector FrameMax = Origin + Step * MaxCode;
+    const FVector Slack = Step * 0.5;
+    bool bInFrame = true;
+    FVector NewOrigin = Origin;
+    FVector NewFrameMax = FrameMax;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const double Span = Bounds.Max[Axis] - Bounds.Min[Axis];
+        if (Bounds.Min[Axis] < Origin[Axis] - Slack[Axis])
+        {
+            NewOrigin[Axis] = Bounds.Min[Axis] - Span * 0.5;
+            bInFrame = false;
+        }
+        if (Bounds.Max[Axis] > FrameMax[Axis] + Slack[Axis])
+        {
+            NewFrameMax[Axis] = Bounds.Max[Axis] + Span * 0.5;
+            bInFrame = false;
+        }
+    }
+    if (!bInFrame)
+    {
+        const FVector NewStep = (NewFrameMax - NewOrigin) / MaxCode;
+        ParallelFor(FMath::DivideAndRoundUp(NumOld, BlockPoints), [this, NumOld, &NewOrigin, &NewStep](int32 Block)
+        {
+            const int32 End = FMath::Min(NumOld, (Block + 1) * BlockPoints);
+            for (int32 Index = Block * BlockPoints; Index < End; ++Index)
+            {
+                uint16* Code = Quantized.GetData() + Index * 3;
+                for (int32 Axis = 0; Axis < 3; ++Axis)
+                {
+                    Code[Axis] = Quantize(Origin[Axis] + Code[Axis] * Step[Axis], NewOrigin[Axis], NewStep[Axis]);
+                }
+            }
+        });
+        Origin = NewOrigin;
+        Step = NewStep;
+    }
+
+    Quantized.SetNumUninitialized(NumPoints * 3);
+    uint16* Code = Quantized.GetData() + NumOld * 3;
+    for (const FVector& Point : Points)
+    {
+        *Code++ = Quantize(Point.X, Origin.X, Step.X);
+        *Code++ = Quantize(Point.Y, Origin.Y, Step.Y);
+        *Code++ = Quantize(Point.Z, Origin.Z, Step.Z);
+    }
+}
+
+FVector FChartPointBuffer::operator[](int32 Index) const
+{
+    checkSlow(Index >= 0 && Index < NumPoints);
+    if (!IsQuantized())
+    {
+        return FVector(Floats[Index]);
+    }
+    const uint16* Code = Quantized.GetData() + Index * 3;
+    return Origin + FVector(Code[0], Code[1], Code[2]) * Step;
+}
+
+void FChartPointBuffer::GetQuantileRange(double LowQ, double HighQ, FVector& OutMin, FVector& OutMax) const
+{
+    FQuantileSketch Sketches[3];
+    for (int32 Index = 0; Index < NumPoints; ++Index)
+    {
+        const FVector Point = (*this)[Index];
+        Sketches[0].Add(static_cast<float>(Point.X));
+        Sketches[1].Add(static_cast<float>(Point.Y));
+        Sketches[2].Add(static_cast<float>(Point.Z));
+    }
+
+    OutMin = Bounds.Min;
+    OutMax = Bounds.Max;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        if (!Sketches[Axis].IsEmpty())
+        {
+            OutMin[Axis] = Sketches[Axis].GetQuantile(LowQ);
+            OutMax[Axis] = Sketches[Axis].GetQuantile(HighQ);
+        }
+    }
+}
+
+FChartMoments FChartPointBuffer::ComputeMoments() const
+{
+    const int32 NumBlocks = FMath::DivideAndRoundUp(NumPoints, BlockPoints);
+    TArray<FChartMoments> BlockMoments;
+    BlockMoments.SetNum(NumBlocks);
+    ParallelFor(NumBlocks, [this, &BlockMoments](int32 Block)
+    {
+        const int32 First = Block * BlockPoints;
+        TArray<FVector> Points;
+        Points.SetNumUninitialized(FMath::Min(BlockPoints, NumPoints - First));
+        for (int32 Index = 0; Index < Points.Num(); ++Index)
+        {
+            Points[Index] = (*this)[First + Index];
+        }
+        BlockMoments[Block] = FChartMoments::FromPoints(Points);
+    });
+
+    FChartMoments Moments;
+    for (const FChartMoments& Block : BlockMoments)
+    {
+        Moments.Merge(Block);
+    }
+    return Moments;
+}
+
+void FChartPointBuffer::PatchMoments(FChartMoments& Moments, const FChartPointBuffer& OldPoints, const FChartPointBuffer& NewPoints, const FChartDatasetDiff& Diff,
+    TFunctionRef<int32(int32)> OldPointOfRow, TFunctionRef<int32(int32)> NewPointOfRow)
+{
+    for (const int32 OldRow : Diff.RemovedRows)
+    {
+        const int32 OldPoint = OldPointOfRow(OldRow);
+        if (OldPoint != INDEX_NONE)
+        {
+            Moments.Remove(OldPoints[OldPoint]);
+        }
+    }
+    for (const int32 NewRow : Diff.ModifiedRows)
+    {
+        const int32 OldPoint = OldPointOfRow(Diff.NewToOld[NewRow]);
+        const int32 NewPoint = NewPointOfRow(NewRow);
+        if (OldPoint != INDEX_NONE && NewPoint != INDEX_NONE && IsSamePoint(OldPoints, OldPoint, NewPoints, NewPoint))
+        {
+            continue;
+        }
+        if (OldPoint != INDEX_NONE)
+        {
+            Moments.Remove(OldPoints[OldPoint]);
+        }
+        if (NewPoint != INDEX_NONE)
+        {
+            Moments.Add(NewPoints[NewPoint]);
+        }
+    }
+    for (const int32 NewRow : Diff.AppendedRows)
+    {
+        const int32 NewPoint = NewPointOfRow(NewRow);
+        if (NewPoint != INDEX_NONE)
+        {
+            Moments.Add(NewPoints[NewPoint]);
+        }
+    }
+}
+
+void FChartPointBuffer::GetMortonOrder(TArray<int32>& OutOrder) const
+{
+    // Float points are stepped over the same bounds as quantized ones would be
+    const FVector FloatStep = IsQuantized() ? Step : (Bounds.Max - Bounds.Min) / MaxCode;
+    TArray<uint64> Codes;
+    Codes.SetNumUninitialized(NumPoints);
+    ParallelFor(FMath::DivideAndRoundUp(NumPoints, BlockPoints), [this, &Codes, &FloatStep](int32 Block)
+    {
+        const int32 End = FMath::Min(NumPoints, (Block + 1) * BlockPoints);
+        for (int32 Index = Block * BlockPoints; Index < End; ++Index)
+        {
+            if (IsQuantized())
+            {
+                const uint16* Code = Quantized.GetData() + Index * 3;
+                Codes[Index] = MortonCode(Code[0], Code[1], Code[2]);
+                continue;
+            }
+            const FVector Point(Floats[Index]);
+            Codes[Index] = !FMath::IsFinite(Point.X) || !FMath::IsFinite(Point.Y) || !FMath::IsFinite(Point.Z) ? MAX_uint64
+                : MortonCode(Quantize(Point.X, Bounds.Min.X, FloatStep.X), Quantize(Point.Y, Bounds.Min.Y, FloatStep.Y), Quantize(Point.Z, Bounds.Min.Z, FloatStep.Z));
+        }
+    });
+    FChartSortOrder::SortIndices(Codes, OutOrder);
+}
+
+void FChartPointBuffer::Permute(TConstArrayView<int32> Order)
+{
+    check(Order.Num() == NumPoints);
+    if (IsQuantized())
+    {
+        TArray<uint16> Sorted;
+        Sorted.SetNumUninitialized(Quantized.Num());
+        for (int32 Index = 0; Index < NumPoints; ++Index)
+        {
+            FMemory::Memcpy(&Sorted[Index * 3], &Quantized[Order[Index] * 3], 3 * sizeof(uint16));
+        }
+        Quantized = MoveTemp(Sorted);
+        return;
+    }
+    TArray<FVector3f> Sorted;
+    Sorted.SetNumUninitialized(Floats.Num());
+    for (int32 Index = 0; Index < NumPoints; ++Index)
+    {
+        Sorted[Index] = Floats[Order[Index]];
+    }
+    Floats = MoveTemp(Sorted);
+}
+
+bool FChartPointBuffer::IsSamePoint(const FChartPointBuffer& A, int32 AIndex, const FChartPointBuffer& B, int32 BIndex)
+{
+    if (A.IsQuantized() && B.IsQuantized() && A.Origin == B.Origin && A.Step == B.Step)
+    {
+        return FMemory::Memcmp(A.Quantized.GetData() + AIndex * 3, B.Quantized.GetData() + BIndex * 3, 3 * sizeof(uint16)) == 0;
+    }
+
+    // Each side is within half a step of its source value; the margin covers rounding in the read back
+    const FVector Tolerance = (A.Step + B.Step) * 0.51;
+    const FVector Delta = (A[AIndex] - B[BIndex]).GetAbs();
+    return Delta.X <= Tolerance.X && Delta.Y <= Tolerance.Y && Delta.Z <= Tolerance.Z;
+}
@@ -1,19 +1,32 @@
 #include "Charts/LineGraphActor.h"
 #include "Engine/World.h"
 #include "Engine/StaticMeshActor.h"
+#include "GameFramework/PlayerController.h"
 #include "Components/StaticMeshComponent.h"
 #include "Charts/LineSegmentActor.h"
 #include "Charts/GridLineActor.h"
 #include "Charts/AxisTickActor.h"
 #include "Charts/GridMath.h"
+#include "Charts/ChartSampling.h"
+#include "Data/ChartDatasetDiff.h"
+#include "Data/ChartDatasetAsset.h"
+#include "Data/ChartSortOrder.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Materials/MaterialInterface.h"
 #include "Materials/MaterialInstanceDynamic.h"
 
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#endif
+
 namespace
 {
     constexpr int32 TargetTicks = 6;
+    // Decimated points drawn even when the X axis covers only a few pixels, seen edge-on or from afar
+    constexpr int32 MinProjectedPoints = 256;
+    // Most a pixel column shows of the decimated line: its first and last point and the lowest and highest Y and Z
+    constexpr int32 PointsPerPixelColumn = 6;
 }
 
 ALineGraphActor::ALineGraphActor()
@@ -35,142 +48,488 @@ ALineGraphActor::ALineGraphActor()
     }
 }
 
+#if WITH_EDITOR
+void ALineGraphActor::PreSave(FObjectPreSaveContext SaveContext)
+{
+    Super::PreSave(SaveContext);
+    UChartDatasetAsset::PackForCook(SaveContext, this, LineDataTable, DatasetAsset);
+}
+
+void ALineGraphActor::Serialize(FArchive& Ar)
+{
+    FChartCookedTableScope CookedTable(Ar, this, LineDataTable, DatasetAsset);
+    Super::Serialize(Ar);
+}
+#endif
+
 void ALineGraphActor::BeginPlay()
 {
     Super::BeginPlay();
+
+    // The chart builds once the asset's columns have been read
+    if (DatasetAsset && !RuntimeDataset.IsValid())
+    {
+        TWeakObjectPtr<ALineGraphActor> WeakThis(this);
+        DatasetAsset->LoadDataset([WeakThis](TSharedPtr<const FChartDataset> Dataset)
+        {
+            ALineGraphActor* This = WeakThis.Get();
+            if (This && Dataset.IsValid())
+            {
+                This->SetRuntimeDataset(Dataset);
+                This->Rebuild();
+            }
+        });
+        return;
+    }
+
     Rebuild();
 }
 
 void ALineGraphActor::LoadData()
 {
-    DataPoints.Empty();
-    if (!LineDataTable) return;
+    DataPoints.Reset();
+    PointOfRow.Reset();
+    PointRows.Empty();
+    TableRowNames.Empty();
+    PointOrder.Reset();
+    bLineAlongX = false;
+    LinePyramid.Reset();
+    bMomentsValid = false;
 
-    TArray<FVRLineData*> AllRows;
-    LineDataTable->GetAllRows(TEXT("VR LineGraph"), AllRows);
-    for (FVRLineData* RowPtr : AllRows)
+    if (RuntimeDataset.IsValid())
     {
-        if (RowPtr)
+        TArray<FVector> Points;
+        if (!RuntimeDataset->GatherPoints(TEXT("X"), TEXT("Y"), TEXT("Z"), Points, &PointRows))
         {
-            DataPoints.Add(FVector(RowPtr->X, RowPtr->Y, RowPtr->Z));
+            UE_LOG(LogTemp, Error, TEXT("LineGraphActor - Dataset needs X, Y and Z columns"));
+            return;
         }
+        DataPoints.Assign(Points, bQuantizePoints);
+        // Rows only need storing when rows without a point were skipped
+        if (PointRows.Num() == RuntimeDataset->NumRows)
+        {
+            PointRows.Empty();
+        }
+        return;
+    }
+
+    if (!LineDataTable) return;
+
+    // Rows are read in place, so they must be laid out as FVRLineData
+    const UScriptStruct* RowStruct = LineDataTable->GetRowStruct();
+    if (!RowStruct || !RowStruct->IsChildOf(FVRLineData::StaticStruct()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LineGraphActor - %s rows are not FVRLineData"), *LineDataTable->GetName());
+        return;
     }
+
+    TArray<FVector> Points;
+    Points.Reserve(LineDataTable->GetRowMap().Num());
+    for (const TPair<FName, uint8*>& Row : LineDataTable->GetRowMap())
+    {
+        const FVRLineData* RowPtr = reinterpret_cast<const FVRLineData*>(Row.Value);
+        TableRowNames.Add(Row.Key);
+        Points.Add(FVector(RowPtr->X, RowPtr->Y, RowPtr->Z));
+    }
+    DataPoints.Assign(Points, bQuantizePoints);
 }
 
-void ALineGraphActor::GeneratePoints()
+void ALineGraphActor::AppendData(int32 FirstRow)
 {
-    if (DataPoints.Num() == 0) return;
+    PointOfRow.Reset();
+    PointOrder.Reset();
+    bLineAlongX = false;
+    LinePyramid.Reset();
 
+    TArray<FVector> Points;
+    TArray<int32> Rows;
+    RuntimeDataset->GatherPoints(TEXT("X"), TEXT("Y"), TEXT("Z"), Points, &Rows, FirstRow);
+    if (PointRows.Num() == 0 && Rows.Num() < RuntimeDataset->NumRows - FirstRow)
+    {
+        PointRows.SetNumUninitialized(DataPoints.Num());
+        for (int32 PointIndex = 0; PointIndex < DataPoints.Num(); ++PointIndex)
+        {
+            PointRows[PointIndex] = PointIndex;
+        }
+    }
+    if (PointRows.Num() > 0)
+    {
+        PointRows.Append(Rows);
+    }
+    DataPoints.Append(Points);
+}
+
+FLinearColor ALineGraphActor::GetPointColor(int32 PointIndex) const
+{
+    if (IsPointSelected(PointIndex))
+    {
+        return SelectionColor;
+    }
     const float ColorMinZ = bUseCustomRange ? ZMin : DataMinZ;
     const float ColorMaxZ = bUseCustomRange ? ZMax : DataMaxZ;
     const float ZRange = ColorMaxZ - ColorMinZ;
-    
-    for (const FVector& Point : DataPoints)
+
+    FLinearColor PointColor = FLinearColor::White;
+    if (ZRange > 0.001f)
     {
-        FVector WorldLoc = MapDataToWorld(Point);
-        float OriginalZ = Point.Z;
-        
-        FLinearColor PointColor = FLinearColor::White;
-        if (ZRange > 0.001f)
+        // Clamped, since a clipped or custom range leaves points outside it
+        float NormalizedZ = FMath::Clamp((DataPoints[PointIndex].Z - ColorMinZ) / ZRange, 0.0f, 1.0f);
+        FLinearColor Cyan(0.0f, 1.0f, 1.0f, 1.0f);
+        if (NormalizedZ < 0.33f)
         {
-            float NormalizedZ = (OriginalZ - ColorMinZ) / ZRange;
-            FLinearColor Cyan(0.0f, 1.0f, 1.0f, 1.0f);
-            if (NormalizedZ < 0.33f)
-            {
-                PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Blue, Cyan, NormalizedZ / 0.33f);
-            }
-            else if (NormalizedZ < 0.66f)
+            PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Blue, Cyan, NormalizedZ / 0.33f);
+        }
+        else if (NormalizedZ < 0.66f)
+        {
+            PointColor = UKismetMathLibrary::LinearColorLerp(Cyan, FLinearColor::Green, (NormalizedZ - 0.33f) / 0.33f);
+        }
+        else
+        {
+            float T = (NormalizedZ - 0.66f) / 0.34f;
+            if (T < 0.5f)
+                PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Green, FLinearColor::Yellow, T * 2.0f);
+            else
+                PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Yellow, FLinearColor::Red, (T - 0.5f) * 2.0f);
+        }
+    }
+    return PointColor;
+}
+
+void ALineGraphActor::PlacePoint(int32 PointIndex, AStaticMeshActor* SphereActor)
+{
+    const FVector WorldLoc = MapDataToWorld(DataPoints[PointIndex]);
+    const FLinearColor PointColor = GetPointColor(PointIndex);
+
+    if (!SphereActor)
+    {
+        FActorSpawnParameters Params;
+        Params.Owner = this;
+        SphereActor = GetWorld()->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, WorldLoc), Params);
+        if (!SphereActor || !SphereActor->GetStaticMeshComponent())
+        {
+            return;
+        }
+        SphereActor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+        SphereActor->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+        SphereActor->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere")));
+        SphereActor->GetStaticMeshComponent()->SetWorldScale3D(FVector(PointScale));
+        SphereActor->GetStaticMeshComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+    else
+    {
+        SphereActor->SetActorLocation(WorldLoc);
+    }
+
+    UMaterialInterface* Mat = PointColorMaterial ? PointColorMaterial : SphereActor->GetStaticMeshComponent()->GetMaterial(0);
+    if (!Mat)
+    {
+        Mat = LoadObject<UMaterialInterface>(nullptr, TEXT("/Game/Materials/M_Color"));
+    }
+    if (!Mat)
+    {
+        Mat = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
+    }
+    if (Mat)
+    {
+        SphereActor->GetStaticMeshComponent()->SetMaterial(0, Mat);
+        UMaterialInstanceDynamic* DynMat = SphereActor->GetStaticMeshComponent()->CreateDynamicMaterialInstance(0, Mat);
+        if (DynMat)
+        {
+            DynMat->SetVectorParameterValue(TEXT("BaseColor"), PointColor);
+            DynMat->SetVectorParameterValue(TEXT("Color"), PointColor);
+            DynMat->SetVectorParameterValue(TEXT("Tint"), PointColor);
+            DynMat->SetVectorParameterValue(TEXT("EmissiveColor"), PointColor);
+        }
+    }
+    PointActors[PointIndex] = SphereActor;
+    PointActorColors[PointIndex] = PointColor;
+}
+
+void ALineGraphActor::PlaceSegment(int32 SegmentIndex, ALineSegmentActor* Segment)
+{
+    const FVector Start = MapDataToWorld(DataPoints[DrawIndices[SegmentIndex]]);
+    const FVector End = MapDataToWorld(DataPoints[DrawIndices[SegmentIndex + 1]]);
+
+    // Black lines connecting the colored data points
+    if (Segment && (End - Start).Size() >= KINDA_SMALL_NUMBER)
+    {
+        Segment->InitializeSegment(Start, End, FLinearColor::Black, FMath::Max(2.0f, PointScale * 20.0f));
+    }
+    else
+    {
+        if (Segment)
+        {
+            Segment->Destroy();
+        }
+        Segment = CreateLineSegmentCylinder(Start, End, FLinearColor::Black);
+    }
+    SegmentActors[SegmentIndex] = Segment;
+}
+
+void ALineGraphActor::GeneratePoints()
+{
+    PointActors.Init(nullptr, DataPoints.Num());
+    PointActorColors.Init(FLinearColor::White, DataPoints.Num());
+    for (const int32 PointIndex : DrawIndices)
+    {
+        PlacePoint(PointIndex, nullptr);
+    }
+}
+
+void ALineGraphActor::GenerateLines()
+{
+    SegmentActors.Init(nullptr, FMath::Max(0, DrawIndices.Num() - 1));
+    for (int32 i = 0; i < SegmentActors.Num(); ++i)
+    {
+        PlaceSegment(i, nullptr);
+    }
+}
+
+void ALineGraphActor::UpdateLineOrder()
+{
+    PointOrder.Reset();
+    if (LineOrder != ELineGraphOrder::FileOrder)
+    {
+        const FName Column = LineOrder == ELineGraphOrder::ByX ? FName(TEXT("X")) : OrderColumn;
+        if (RuntimeDataset.IsValid())
+        {
+            if (const TSharedPtr<const TArray<int32>> RowOrder = FChartSortOrder::ForColumn(RuntimeDataset, Column))
             {
-                PointColor = UKismetMathLibrary::LinearColorLerp(Cyan, FLinearColor::Green, (NormalizedZ - 0.33f) / 0.33f);
+                // Rows skipped for a missing coordinate have no point and drop out of the order
+                TArray<int32> PointOfSourceRow;
+                PointOfSourceRow.Init(INDEX_NONE, RuntimeDataset->NumRows);
+                for (int32 PointIndex = 0; PointIndex < DataPoints.Num(); ++PointIndex)
+                {
+                    PointOfSourceRow[GetPointRow(PointIndex)] = PointIndex;
+                }
+                PointOrder.Reserve(DataPoints.Num());
+                for (const int32 Row : *RowOrder)
+                {
+                    if (PointOfSourceRow[Row] != INDEX_NONE)
+                    {
+                        PointOrder.Add(PointOfSourceRow[Row]);
+                    }
+                }
             }
-            else
+        }
+        else
+        {
+            // DataTable rows only have the point coordinates to sort by
+            const int32 Axis = Column == TEXT("X") ? 0 : Column == TEXT("Y") ? 1 : Column == TEXT("Z") ? 2 : INDEX_NONE;
+            if (Axis != INDEX_NONE)
             {
-                float T = (NormalizedZ - 0.66f) / 0.34f;
-                if (T < 0.5f)
-                    PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Green, FLinearColor::Yellow, T * 2.0f);
-                else
-                    PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Yellow, FLinearColor::Red, (T - 0.5f) * 2.0f);
+                TArray<float> Keys;
+                Keys.SetNumUninitialized(DataPoints.Num());
+                for (int32 PointIndex = 0; PointIndex < Keys.Num(); ++PointIndex)
+                {
+                    Keys[PointIndex] = DataPoints[PointIndex][Axis];
+                }
+                FChartSortOrder::SortIndices(Keys, PointOrder);
             }
         }
-        
-        FActorSpawnParameters Params;
-        Params.Owner = this;
-        AStaticMeshActor* SphereActor = GetWorld()->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FTransform(FRotator::ZeroRotator, WorldLoc), Params);
-        if (SphereActor && SphereActor->GetStaticMeshComponent())
-        {
-            SphereActor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
-            SphereActor->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-            SphereActor->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere")));
-            SphereActor->GetStaticMeshComponent()->SetWorldScale3D(FVector(PointScale));
-            SphereActor->GetStaticMeshComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-            
-            UMaterialInterface* Mat = PointColorMaterial ? PointColorMaterial : SphereActor->GetStaticMeshComponent()->GetMaterial(0);
-            if (!Mat)
+        if (PointOrder.Num() != DataPoints.Num())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("LineGraphActor - No column '%s' to order the line by, drawing in file order"), *Column.ToString());
+            PointOrder.Reset();
+        }
+    }
+
+    // Comparisons with NaN pass, so a line sorted by X, which puts NaN last, runs along X
+    bLineAlongX = true;
+    for (int32 Position = 1; Position < DataPoints.Num() && bLineAlongX; ++Position)
+    {
+        bLineAlongX = !(DataPoints[GetPointAt(Position)].X < DataPoints[GetPointAt(Position - 1)].X);
+    }
+}
+
+void ALineGraphActor::GetXRangePositions(int32& OutBegin, int32& OutEnd) const
+{
+    OutBegin = 0;
+    OutEnd = DataPoints.Num();
+    if (!bXRangeSet || !bLineAlongX)
+    {
+        return;
+    }
+
+    // Binary searches along the line; NaN X (sorted last) counts as past either end
+    const auto FindFirst = [this](TFunctionRef<bool(float)> IsPast)
+    {
+        int32 Low = 0, High = DataPoints.Num();
+        while (Low < High)
+        {
+            const int32 Mid = Low + (High - Low) / 2;
+            if (IsPast(DataPoints[GetPointAt(Mid)].X))
             {
-                Mat = LoadObject<UMaterialInterface>(nullptr, TEXT("/Game/Materials/M_Color"));
+                High = Mid;
             }
-            if (!Mat)
+            else
             {
-                Mat = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
+                Low = Mid + 1;
             }
-            if (Mat)
+        }
+        return Low;
+    };
+    OutBegin = FindFirst([this](float X) { return !(X < XRangeMin); });
+    OutEnd = FMath::Max(OutBegin, FindFirst([this](float X) { return !(X <= XRangeMax); }));
+}
+
+void ALineGraphActor::UpdateDrawIndices(int32 MaxCount)
+{
+    int32 Begin, End;
+    GetXRangePositions(Begin, End);
+
+    TArray<int32> Positions;
+    if (bDecimateLine && MaxCount > 0 && End - Begin > MaxCount)
+    {
+        if (LinePyramid.Num() != DataPoints.Num())
+        {
+            // Extremes of both axes across X, so a spike in either is drawn
+            TArray<float> YValues, ZValues;
+            YValues.SetNumUninitialized(DataPoints.Num());
+            ZValues.SetNumUninitialized(DataPoints.Num());
+            for (int32 Position = 0; Position < DataPoints.Num(); ++Position)
             {
-                SphereActor->GetStaticMeshComponent()->SetMaterial(0, Mat);
-                UMaterialInstanceDynamic* DynMat = SphereActor->GetStaticMeshComponent()->CreateDynamicMaterialInstance(0, Mat);
-                if (DynMat)
-                {
-                    DynMat->SetVectorParameterValue(TEXT("BaseColor"), PointColor);
-                    DynMat->SetVectorParameterValue(TEXT("Color"), PointColor);
-                    DynMat->SetVectorParameterValue(TEXT("Tint"), PointColor);
-                    DynMat->SetVectorParameterValue(TEXT("EmissiveColor"), PointColor);
-                }
+                const FVector Point = DataPoints[GetPointAt(Position)];
+                YValues[Position] = Point.Y;
+                ZValues[Position] = Point.Z;
             }
-            SpawnedChildren.Add(SphereActor);
+            const TConstArrayView<float> Series[] = { YValues, ZValues };
+            LinePyramid.Build(Series);
+        }
+        LinePyramid.Select(Begin, End, MaxCount, Positions);
+    }
+    else
+    {
+        // Sampling along the sorted order keeps a preview spread evenly over the line
+        DataVizSampling::StratifiedIndices(End - Begin, MaxCount, Positions);
+        for (int32& Position : Positions)
+        {
+            Position += Begin;
         }
     }
+
+    DrawIndices.SetNumUninitialized(Positions.Num());
+    for (int32 Index = 0; Index < Positions.Num(); ++Index)
+    {
+        DrawIndices[Index] = GetPointAt(Positions[Index]);
+    }
 }
 
-void ALineGraphActor::GenerateLines()
+int32 ALineGraphActor::GetDrawBudget() const
 {
-    if (DataPoints.Num() < 2) return;
-    
-    for (int32 i = 0; i < DataPoints.Num() - 1; ++i)
+    const int32 PreviewBudget = DataVizSampling::RowBudget(bPreviewFidelity, MaxPreviewPrimitives, 2);
+    if (!bDecimateLine)
     {
-        FVector Start = MapDataToWorld(DataPoints[i]);
-        FVector End = MapDataToWorld(DataPoints[i + 1]);
-        
-        // Black lines connecting the colored data points
-        CreateLineSegmentCylinder(Start, End, FLinearColor::Black);
+        return PreviewBudget;
+    }
+
+    int32 Budget = FMath::Max(4, MaxLinePoints);
+    const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+    FVector2D AxisStart, AxisEnd;
+    if (PlayerController && PlayerController->ProjectWorldLocationToScreen(MapDataToWorld(FVector(AxisMinX, AxisMinY, AxisMinZ)), AxisStart)
+        && PlayerController->ProjectWorldLocationToScreen(MapDataToWorld(FVector(AxisMaxX, AxisMinY, AxisMinZ)), AxisEnd))
+    {
+        const int32 ProjectedPoints = PointsPerPixelColumn * FMath::CeilToInt(FVector2D::Distance(AxisStart, AxisEnd));
+        Budget = FMath::Clamp(ProjectedPoints, FMath::Min(MinProjectedPoints, Budget), Budget);
     }
+    return PreviewBudget > 0 ? FMath::Min(PreviewBudget, Budget) : Budget;
+}
+
+void ALineGraphActor::RedrawLine()
+{
+    TArray<AStaticMeshActor*> FreePoints;
+    for (AStaticMeshActor* Point : PointActors)
+    {
+        if (IsValid(Point))
+        {
+            FreePoints.Add(Point);
+        }
+    }
+    TArray<ALineSegmentActor*> FreeSegments;
+    for (ALineSegmentActor* Segment : SegmentActors)
+    {
+        if (IsValid(Segment))
+        {
+            FreeSegments.Add(Segment);
+        }
+    }
+
+    PointActors.Init(nullptr, DataPoints.Num());
+    PointActorColors.Init(FLinearColor::White, DataPoints.Num());
+    for (const int32 PointIndex : DrawIndices)
+    {
+        PlacePoint(PointIndex, FreePoints.Num() > 0 ? FreePoints.Pop() : nullptr);
+    }
+    SegmentActors.Init(nullptr, FMath::Max(0, DrawIndices.Num() - 1));
+    for (int32 SegmentIndex = 0; SegmentIndex < SegmentActors.Num(); ++SegmentIndex)
+    {
+        PlaceSegment(SegmentIndex, FreeSegments.Num() > 0 ? FreeSegments.Pop() : nullptr);
+    }
+
+    for (AStaticMeshActor* Unused : FreePoints)
+    {
+        Unused->Destroy();
+    }
+    for (ALineSegmentActor* Unused : FreeSegments)
+    {
+        Unused->Destroy();
+    }
+}
+
+void ALineGraphActor::SetXRange(float MinX, float MaxX)
+{
+    bXRangeSet = MinX < MaxX;
+    XRangeMin = MinX;
+    XRangeMax = MaxX;
+    if (DataPoints.Num() == 0)
+    {
+        return;
+    }
+    if (bXRangeSet && !bLineAlongX)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LineGraphActor - X range needs a line whose X ascends; order it by X to zoom"));
+    }
+
+    if (UpdateAxes())
+    {
+        ClearGridActors();
+        GenerateAxes();
+        GenerateGridlines();
+    }
+    UpdateDrawIndices(GetDrawBudget());
+    RedrawLine();
+    UpdateOverlay();
+    ApplyFilter();
 }
 
 FVector ALineGraphActor::MapDataToWorld(const FVector& In) const
 {
     const FQuat GraphRotation = GetActorQuat() * AdditionalRotation.Quaternion();
-    const FVector Local = In * GraphScale;
+    const FVector Local = FVector(In.X * XViewScale + XViewShift, In.Y, In.Z) * GraphScale;
     return GraphOrigin + GraphRotation.RotateVector(Local);
 }
 
-void ALineGraphActor::CreateLineSegmentCylinder(const FVector& Start, const FVector& End, const FLinearColor& Color)
+ALineSegmentActor* ALineGraphActor::CreateLineSegmentCylinder(const FVector& Start, const FVector& End, const FLinearColor& Color)
 {
     FVector Direction = End - Start;
     float Length = Direction.Size();
-    if (Length < KINDA_SMALL_NUMBER) return;
+    if (Length < KINDA_SMALL_NUMBER) return nullptr;
 
     // Line thickness relative to point size
     float LineThickness = FMath::Max(2.0f, PointScale * 20.0f);
 
     FActorSpawnParameters Params;
     Params.Owner = this;
-    if (ALineSegmentActor* Segment = GetWorld()->SpawnActor<ALineSegmentActor>(ALineSegmentActor::StaticClass(), FTransform::Identity, Params))
+    ALineSegmentActor* Segment = GetWorld()->SpawnActor<ALineSegmentActor>(ALineSegmentActor::StaticClass(), FTransform::Identity, Params);
+    if (Segment)
     {
         Segment->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
         Segment->InitializeSegment(Start, End, Color, LineThickness);
-        SpawnedChildren.Add(Segment);
     }
+    return Segment;
 }
 
-void ALineGraphActor::ClearChildrenActors()
+void ALineGraphActor::ClearGridActors()
 {
     for (AActor* Child : SpawnedChildren)
     {
@@ -182,6 +541,29 @@ void ALineGraphActor::ClearChildrenActors()
     SpawnedChildren.Empty();
 }
 
+void ALineGraphActor::ClearChildrenActors()
+{
+    for (AStaticMeshActor* Point : PointActors)
+    {
+        if (IsValid(Point))
+        {
+            Point->Destroy();
+        }
+    }
+    for (ALineSegmentActor* Segment : SegmentActors)
+    {
+        if (IsValid(Segment))
+        {
+            Segment->Destroy();
+        }
+    }
+    PointActors.Empty();
+    PointActorColors.Empty();
+    SegmentActors.Empty();
+    ClearGridActors();
+    ClearOverlayActors();
+}
+
 void ALineGraphActor::GenerateAxes()
 {
     FActorSpawnParameters AxisParams;
@@ -246,23 +628,42 @@ void ALineGraphActor::GenerateAxes()
     }
 }
 
-void ALineGraphActor::Rebuild()
+bool ALineGraphActor::UpdateAxes()
 {
-    ClearChildrenActors();
-    LoadData();
-
-    if (DataPoints.Num() == 0)
-        return;
+    const FBox& Bounds = DataPoints.GetBounds();
+    DataMinX = Bounds.Min.X; DataMaxX = Bounds.Max.X;
+    DataMinY = Bounds.Min.Y; DataMaxY = Bounds.Max.Y;
+    DataMinZ = Bounds.Min.Z; DataMaxZ = Bounds.Max.Z;
 
-    DataMinX = DataMaxX = DataPoints[0].X;
-    DataMinY = DataMaxY = DataPoints[0].Y;
-    DataMinZ = DataMaxZ = DataPoints[0].Z;
+    // A streamed dataset holds a row sample; its column stats still span the whole file
+    if (RuntimeDataset.IsValid())
+    {
+        RuntimeDataset->GetColumnRange(TEXT("X"), DataMinX, DataMaxX);
+        RuntimeDataset->GetColumnRange(TEXT("Y"), DataMinY, DataMaxY);
+        RuntimeDataset->GetColumnRange(TEXT("Z"), DataMinZ, DataMaxZ);
+    }
 
-    for (const FVector& P : DataPoints)
+    // Whole-file sketches of a streamed dataset, else sketches of the loaded points
+    if (bClipToPercentiles && !bUseCustomRange)
     {
-        DataMinX = FMath::Min(DataMinX, P.X); DataMaxX = FMath::Max(DataMaxX, P.X);
-        DataMinY = FMath::Min(DataMinY, P.Y); DataMaxY = FMath::Max(DataMaxY, P.Y);
-        DataMinZ = FMath::Min(DataMinZ, P.Z); DataMaxZ = FMath::Max(DataMaxZ, P.Z);
+        const double LowQ = FMath::Clamp(LowPercentile, 0.0f, 100.0f) / 100.0;
+        const double HighQ = FMath::Clamp(HighPercentile, LowPercentile, 100.0f) / 100.0;
+        FVector ClipMin, ClipMax;
+        float ClipMinX, ClipMaxX, ClipMinY, ClipMaxY, ClipMinZ, ClipMaxZ;
+        if (RuntimeDataset.IsValid() && RuntimeDataset->GetColumnQuantileRange(TEXT("X"), LowQ, HighQ, ClipMinX, ClipMaxX)
+            && RuntimeDataset->GetColumnQuantileRange(TEXT("Y"), LowQ, HighQ, ClipMinY, ClipMaxY)
+            && RuntimeDataset->GetColumnQuantileRange(TEXT("Z"), LowQ, HighQ, ClipMinZ, ClipMaxZ))
+        {
+            ClipMin = FVector(ClipMinX, ClipMinY, ClipMinZ);
+            ClipMax = FVector(ClipMaxX, ClipMaxY, ClipMaxZ);
+        }
+        else
+        {
+            DataPoints.GetQuantileRange(LowQ, HighQ, ClipMin, ClipMax);
+        }
+        DataMinX = ClipMin.X; DataMaxX = ClipMax.X;
+        DataMinY = ClipMin.Y; DataMaxY = ClipMax.Y;
+        DataMinZ = ClipMin.Z; DataMaxZ = ClipMax.Z;
     }
 
     const float RangeMinX = bUseCustomRange ? XMin : DataMinX;
@@ -272,19 +673,451 @@ void ALineGraphActor::Rebuild()
     const float RangeMinZ = bUseCustomRange ? ZMin : DataMinZ;
     const float RangeMaxZ = bUseCustomRange ? ZMax : DataMaxZ;
 
-    const FAxisGridConfig XConfig = DataVizGrid::ComputeAxisGrid(RangeMinX, RangeMaxX, TargetTicks);
+    FAxisGridConfig XConfig = DataVizGrid::ComputeAxisGrid(RangeMinX, RangeMaxX, TargetTicks);
     const FAxisGridConfig YConfig = DataVizGrid::ComputeAxisGrid(RangeMinY, RangeMaxY, TargetTicks);
     const FAxisGridConfig ZConfig = DataVizGrid::ComputeAxisGrid(RangeMinZ, RangeMaxZ, TargetTicks);
 
+    // A zoomed X range gets its own grid, stretched over the width the X axis of the whole data has
+    double NewXViewScale = 1.0, NewXViewShift = 0.0;
+    if (bXRangeSet && bLineAlongX)
+    {
+        const FAxisGridConfig RangeConfig = DataVizGrid::ComputeAxisGrid(XRangeMin, XRangeMax, TargetTicks);
+        if (RangeConfig.AxisMax > RangeConfig.AxisMin && XConfig.AxisMax > XConfig.AxisMin)
+        {
+            NewXViewScale = static_cast<double>(XConfig.AxisMax - XConfig.AxisMin) / (RangeConfig.AxisMax - RangeConfig.AxisMin);
+            NewXViewShift = XConfig.AxisMin - RangeConfig.AxisMin * NewXViewScale;
+            XConfig = RangeConfig;
+        }
+    }
+
+    const bool bChanged = NewXViewScale != XViewScale || NewXViewShift != XViewShift
+        || !DataVizGrid::IsSameAxis(XConfig, AxisMinX, AxisMaxX, AxisStepX)
+        || !DataVizGrid::IsSameAxis(YConfig, AxisMinY, AxisMaxY, AxisStepY)
+        || !DataVizGrid::IsSameAxis(ZConfig, AxisMinZ, AxisMaxZ, AxisStepZ);
+
     AxisMinX = XConfig.AxisMin; AxisMaxX = XConfig.AxisMax; AxisStepX = XConfig.TickStep;
+    XViewScale = NewXViewScale;
+    XViewShift = NewXViewShift;
     AxisMinY = YConfig.AxisMin; AxisMaxY = YConfig.AxisMax; AxisStepY = YConfig.TickStep;
     AxisMinZ = ZConfig.AxisMin; AxisMaxZ = ZConfig.AxisMax; AxisStepZ = ZConfig.TickStep;
+    return bChanged;
+}
+
+FVector ALineGraphActor::GetPointValue(int32 PointIndex) const
+{
+    if (!FMath::IsWithin(PointIndex, 0, DataPoints.Num()))
+    {
+        return FVector::ZeroVector;
+    }
+
+    const int32 Row = GetPointRow(PointIndex);
+    if (RuntimeDataset.IsValid())
+    {
+        const FChartColumn* X = RuntimeDataset->GetColumn(TEXT("X"));
+        const FChartColumn* Y = RuntimeDataset->GetColumn(TEXT("Y"));
+        const FChartColumn* Z = RuntimeDataset->GetColumn(TEXT("Z"));
+        if (X && Y && Z)
+        {
+            return FVector(X->GetFloat(Row), Y->GetFloat(Row), Z->GetFloat(Row));
+        }
+    }
+    else if (LineDataTable)
+    {
+        if (const FVRLineData* RowPtr = TableRowNames.IsValidIndex(Row) ? LineDataTable->FindRow<FVRLineData>(TableRowNames[Row], TEXT("VR LineGraph"), false) : nullptr)
+        {
+            return FVector(RowPtr->X, RowPtr->Y, RowPtr->Z);
+        }
+    }
+    return DataPoints[PointIndex];
+}
 
+bool ALineGraphActor::SetFilter(const FString& Expression)
+{
+    FChartFilter NewFilter;
+    FString Error;
+    if (!FChartFilter::Compile(Expression, NewFilter, Error))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LineGraphActor - Filter \"%s\" not applied: %s"), *Expression, *Error);
+        return false;
+    }
+    Filter = MoveTemp(NewFilter);
+    return ApplyFilter();
+}
+
+bool ALineGraphActor::ApplyFilter()
+{
+    FilterMask.Reset();
+    bool bApplied = true;
+    if (!Filter.IsEmpty())
+    {
+        FString Error = TEXT("filters need a runtime dataset");
+        bApplied = RuntimeDataset.IsValid() && Filter.Evaluate(*RuntimeDataset, FilterMask, Error);
+        if (!bApplied)
+        {
+            FilterMask.Reset();
+            UE_LOG(LogTemp, Warning, TEXT("LineGraphActor - Filter \"%s\" not applied: %s"), *Filter.GetExpression(), *Error);
+        }
+    }
+
+    // Only primitives whose visibility changes are touched, so narrowing or widening a filter costs one pass over the mask
+    const auto IsRowHidden = [this](int32 PointIndex) { return !FilterMask.IsEmpty() && !FilterMask[GetPointRow(PointIndex)]; };
+    for (int32 PointIndex = 0; PointIndex < PointActors.Num(); ++PointIndex)
+    {
+        AStaticMeshActor* Sphere = PointActors[PointIndex];
+        const bool bHidden = IsRowHidden(PointIndex);
+        if (IsValid(Sphere) && Sphere->IsHidden() != bHidden)
+        {
+            Sphere->SetActorHiddenInGame(bHidden);
+            Sphere->SetActorEnableCollision(!bHidden);
+        }
+    }
+    for (int32 SegmentIndex = 0; SegmentIndex < SegmentActors.Num(); ++SegmentIndex)
+    {
+        ALineSegmentActor* Segment = SegmentActors[SegmentIndex];
+        const bool bHidden = IsRowHidden(DrawIndices[SegmentIndex]) || IsRowHidden(DrawIndices[SegmentIndex + 1]);
+        if (IsValid(Segment) && Segment->IsHidden() != bHidden)
+        {
+            Segment->SetActorHiddenInGame(bHidden);
+            Segment->SetActorEnableCollision(!bHidden);
+        }
+    }
+    return bApplied;
+}
+
+void ALineGraphActor::SetSelection(TSharedPtr<FChartSelection> InSelection)
+{
+    if (Selection.IsValid())
+    {
+        Selection->OnChanged.Remove(SelectionChangedHandle);
+    }
+    Selection = MoveTemp(InSelection);
+    SelectionChangedHandle = Selection.IsValid() ? Selection->OnChanged.AddUObject(this, &ALineGraphActor::OnSelectionChanged) : FDelegateHandle();
+
+    // Points whose selection state differs from how they were drawn pick up the new selection
+    for (int32 PointIndex = 0; PointIndex < PointActors.Num(); ++PointIndex)
+    {
+        if (IsValid(PointActors[PointIndex]) && PointActorColors[PointIndex] != GetPointColor(PointIndex))
+        {
+            PlacePoint(PointIndex, PointActors[PointIndex]);
+        }
+    }
+}
+
+void ALineGraphActor::SelectPoints(const TArray<int32>& PointIndices, bool bAddToSelection)
+{
+    if (!Selection.IsValid())
+    {
+        SetSelection(MakeShared<FChartSelection>(RuntimeDataset.IsValid() ? RuntimeDataset->NumRows : DataPoints.Num()));
+    }
+
+    TArray<int32> Rows;
+    Rows.Reserve(PointIndices.Num());
+    for (const int32 PointIndex : PointIndices)
+    {
+        if (FMath::IsWithin(PointIndex, 0, DataPoints.Num()))
+        {
+            Rows.Add(GetPointRow(PointIndex));
+        }
+    }
+    Selection->SelectRows(Rows, bAddToSelection ? EChartSelectionOp::Add : EChartSelectionOp::Replace);
+}
+
+void ALineGraphActor::ClearSelection()
+{
+    if (Selection.IsValid())
+    {
+        Selection->Clear();
+    }
+}
+
+bool ALineGraphActor::IsPointSelected(int32 PointIndex) const
+{
+    return Selection.IsValid() && FMath::IsWithin(PointIndex, 0, DataPoints.Num()) && Selection->IsSelected(GetPointRow(PointIndex));
+}
+
+int32 ALineGraphActor::GetRowPoint(int32 Row)
+{
+    if (PointRows.Num() == 0)
+    {
+        return FMath::IsWithin(Row, 0, DataPoints.Num()) ? Row : INDEX_NONE;
+    }
+    if (PointOfRow.Num() == 0)
+    {
+        PointOfRow.Init(INDEX_NONE, PointRows.Last() + 1);
+        for (int32 PointIndex = 0; PointIndex < PointRows.Num(); ++PointIndex)
+        {
+            PointOfRow[PointRows[PointIndex]] = PointIndex;
+        }
+    }
+    return PointOfRow.IsValidIndex(Row) ? PointOfRow[Row] : INDEX_NONE;
+}
+
+void ALineGraphActor::OnSelectionChanged(const FChartSelectionChange& Change)
+{
+    Change.ForEachRow([this](int32 Row)
+    {
+        const int32 PointIndex = GetRowPoint(Row);
+        if (PointActors.IsValidIndex(PointIndex) && IsValid(PointActors[PointIndex]))
+        {
+            PlacePoint(PointIndex, PointActors[PointIndex]);
+        }
+    });
+}
+
+void ALineGraphActor::ClearOverlayActors()
+{
+    for (AGridLineActor* Line : OverlayActors)
+    {
+        if (IsValid(Line))
+        {
+            Line->Destroy();
+        }
+    }
+    OverlayActors.Empty();
+}
+
+void ALineGraphActor::UpdateOverlay()
+{
+    ClearOverlayActors();
+    if (!(bShowMeanOverlay || bShowSigmaBand || bShowRegressionOverlay) || DataPoints.Num() == 0)
+    {
+        return;
+    }
+    if (!bMomentsValid)
+    {
+        Moments = DataPoints.ComputeMoments();
+        bMomentsValid = true;
+    }
+
+    FActorSpawnParameters Params;
+    Params.Owner = this;
+    // Line Z = A + B * X along the X axis, in the plane of the mean Y
+    const double MeanY = Moments.Mean.Y;
+    const auto SpawnLine = [this, &Params, MeanY](double A, double B)
+    {
+        const FVector Start = MapDataToWorld(FVector(AxisMinX, MeanY, A + B * AxisMinX));
+        if (AGridLineActor* Line = GetWorld()->SpawnActor<AGridLineActor>(AGridLineActor::StaticClass(), FTransform(Start), Params))
+        {
+            Line->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+            Line->InitializeLine(Start, MapDataToWorld(FVector(AxisMaxX, MeanY, A + B * AxisMaxX)), OverlayColor, 3.0f);
+            OverlayActors.Add(Line);
+        }
+    };
+
+    const double MeanZ = Moments.Mean.Z;
+    const double BandZ = SigmaBandWidth * Moments.GetStdDev().Z;
+    if (bShowMeanOverlay)
+    {
+        SpawnLine(MeanZ, 0.0);
+    }
+    if (bShowSigmaBand)
+    {
+        SpawnLine(MeanZ - BandZ, 0.0);
+        SpawnLine(MeanZ + BandZ, 0.0);
+    }
+    double Intercept, Slope;
+    if (bShowRegressionOverlay && Moments.FitLine(Intercept, Slope))
+    {
+        SpawnLine(Intercept, Slope);
+    }
+}
+
+void ALineGraphActor::Rebuild()
+{
+    ClearChildrenActors();
+    LoadData();
+
+    if (DataPoints.Num() == 0)
+        return;
+
+    UpdateLineOrder();
+    UpdateAxes();
     GraphOrigin = GetActorLocation();
+    UpdateDrawIndices(GetDrawBudget());
+
     GeneratePoints();
     GenerateLines();
     GenerateAxes();
     GenerateGridlines();
+    UpdateOverlay();
+    ApplyFilter();
+}
+
+void ALineGraphActor::ApplyDatasetUpdate(TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff)
+{
+    // A preview or decimated sample picks points by position, so only a full, unzoomed build over the same columns can
+    // be patched
+    const bool bCanPatch = RuntimeDataset.IsValid() && NewDataset.IsValid() && !bPreviewFidelity && !bXRangeSet && !Diff.bSchemaChanged
+        && (!bDecimateLine || NewDataset->NumRows <= GetDrawBudget())
+        && Diff.NewToOld.Num() == NewDataset->NumRows && DataPoints.Num() > 0 && PointActors.Num() == DataPoints.Num()
+        && SegmentActors.Num() == DataPoints.Num() - 1;
+    if (!bCanPatch)
+    {
+        SetRuntimeDataset(MoveTemp(NewDataset));
+        Rebuild();
+        return;
+    }
+
+    TArray<int32> OldPointOfRow;
+    OldPointOfRow.Init(INDEX_NONE, RuntimeDataset->NumRows);
+    for (int32 PointIndex = 0; PointIndex < DataPoints.Num(); ++PointIndex)
+    {
+        OldPointOfRow[GetPointRow(PointIndex)] = PointIndex;
+    }
+    // Rows streamed onto the end extend the points in place, and the old points are the first ones of the new
+    const bool bAppendOnly = Diff.IsAppendOnly();
+    FChartPointBuffer OldPointStorage;
+    if (!bAppendOnly)
+    {
+        OldPointStorage = MoveTemp(DataPoints);
+    }
+    const FChartPointBuffer& OldPoints = bAppendOnly ? DataPoints : OldPointStorage;
+    const TArray<AStaticMeshActor*> OldActors = MoveTemp(PointActors);
+    const TArray<FLinearColor> OldColors = MoveTemp(PointActorColors);
+    const TArray<ALineSegmentActor*> OldSegments = MoveTemp(SegmentActors);
+    const TArray<int32> OldDrawIndices = MoveTemp(DrawIndices);
+    const bool bHadMoments = bMomentsValid;
+    FChartMoments PatchedMoments = Moments;
+
+    const int32 OldNumRows = RuntimeDataset->NumRows;
+    RuntimeDataset = MoveTemp(NewDataset);
+    if (bAppendOnly)
+    {
+        AppendData(OldNumRows);
+    }
+    else
+    {
+        LoadData();
+    }
+    if (DataPoints.Num() == 0)
+    {
+        PointActors = OldActors;
+        SegmentActors = OldSegments;
+        ClearChildrenActors();
+        return;
+    }
+    if (bHadMoments)
+    {
+        FChartPointBuffer::PatchMoments(PatchedMoments, OldPoints, DataPoints, Diff,
+            [&OldPointOfRow](int32 OldRow) { return OldPointOfRow[OldRow]; },
+            [this](int32 NewRow) { return GetRowPoint(NewRow); });
+        Moments = PatchedMoments;
+        bMomentsValid = true;
+    }
+    UpdateLineOrder();
+    const bool bGridChanged = UpdateAxes();
+    UpdateDrawIndices(0);
+
+    // Spheres of rows that survived stay in place unless their position or color changed
+    PointActors.Init(nullptr, DataPoints.Num());
+    PointActorColors.Init(FLinearColor::White, DataPoints.Num());
+    TArray<int32> OldPointOfNew;
+    OldPointOfNew.Init(INDEX_NONE, DataPoints.Num());
+    TBitArray<> OldKept(false, OldActors.Num());
+    TArray<int32> Unplaced;
+    int32 NumUpdated = 0;
+    for (int32 PointIndex = 0; PointIndex < DataPoints.Num(); ++PointIndex)
+    {
+        const int32 OldRow = Diff.NewToOld[GetPointRow(PointIndex)];
+        const int32 OldPoint = OldRow != INDEX_NONE ? OldPointOfRow[OldRow] : INDEX_NONE;
+        if (OldPoint == INDEX_NONE || !IsValid(OldActors[OldPoint]))
+        {
+            Unplaced.Add(PointIndex);
+            continue;
+        }
+
+        OldKept[OldPoint] = true;
+        OldPointOfNew[PointIndex] = OldPoint;
+        if (FChartPointBuffer::IsSamePoint(OldPoints, OldPoint, DataPoints, PointIndex) && OldColors[OldPoint] == GetPointColor(PointIndex))
+        {
+            PointActors[PointIndex] = OldActors[OldPoint];
+            PointActorColors[PointIndex] = OldColors[OldPoint];
+        }
+        else
+        {
+            PlacePoint(PointIndex, OldActors[OldPoint]);
+            ++NumUpdated;
+        }
+    }
+
+    TArray<AStaticMeshActor*> FreePoints;
+    for (int32 OldPoint = 0; OldPoint < OldActors.Num(); ++OldPoint)
+    {
+        if (!OldKept[OldPoint] && IsValid(OldActors[OldPoint]))
+        {
+            FreePoints.Add(OldActors[OldPoint]);
+        }
+    }
+    for (const int32 PointIndex : Unplaced)
+    {
+        PlacePoint(PointIndex, FreePoints.Num() > 0 ? FreePoints.Pop() : nullptr);
+    }
+    for (AStaticMeshActor* Unused : FreePoints)
+    {
+        Unused->Destroy();
+    }
+
+    // A segment is kept when it still joins the same two unmoved points. Segment i runs from DrawIndices[i] to the
+    // point after it in line order, in the old build as in the new one.
+    TArray<int32> OldSegmentOfStart;
+    OldSegmentOfStart.Init(INDEX_NONE, OldPoints.Num());
+    for (int32 OldSegment = 0; OldSegment < OldSegments.Num(); ++OldSegment)
+    {
+        OldSegmentOfStart[OldDrawIndices[OldSegment]] = OldSegment;
+    }
+    SegmentActors.Init(nullptr, DataPoints.Num() - 1);
+    TBitArray<> OldSegmentKept(false, OldSegments.Num());
+    TArray<int32> UnplacedSegments;
+    for (int32 SegmentIndex = 0; SegmentIndex < SegmentActors.Num(); ++SegmentIndex)
+    {
+        const int32 Start = DrawIndices[SegmentIndex];
+        const int32 End = DrawIndices[SegmentIndex + 1];
+        const int32 OldStart = OldPointOfNew[Start];
+        const int32 OldSegment = OldStart != INDEX_NONE ? OldSegmentOfStart[OldStart] : INDEX_NONE;
+        const int32 OldEnd = OldSegment != INDEX_NONE ? OldDrawIndices[OldSegment + 1] : INDEX_NONE;
+        const bool bSameSegment = OldEnd != INDEX_NONE && OldPointOfNew[End] == OldEnd
+            && FChartPointBuffer::IsSamePoint(OldPoints, OldStart, DataPoints, Start)
+            && FChartPointBuffer::IsSamePoint(OldPoints, OldEnd, DataPoints, End);
+        if (bSameSegment)
+        {
+            SegmentActors[SegmentIndex] = OldSegments[OldSegment];
+            OldSegmentKept[OldSegment] = true;
+        }
+        else
+        {
+            UnplacedSegments.Add(SegmentIndex);
+        }
+    }
+
+    TArray<ALineSegmentActor*> FreeSegments;
+    for (int32 OldSegment = 0; OldSegment < OldSegments.Num(); ++OldSegment)
+    {
+        if (!OldSegmentKept[OldSegment] && IsValid(OldSegments[OldSegment]))
+        {
+            FreeSegments.Add(OldSegments[OldSegment]);
+        }
+    }
+    for (const int32 SegmentIndex : UnplacedSegments)
+    {
+        PlaceSegment(SegmentIndex, FreeSegments.Num() > 0 ? FreeSegments.Pop() : nullptr);
+    }
+    for (ALineSegmentActor* Unused : FreeSegments)
+    {
+        Unused->Destroy();
+    }
+
+    if (bGridChanged)
+    {
+        ClearGridActors();
+        GenerateAxes();
+        GenerateGridlines();
+    }
+    UpdateOverlay();
+    ApplyFilter();
+
+    UE_LOG(LogTemp, Log, TEXT("LineGraphActor - Applied %d modified, %d appended and %d removed rows: %d points updated, %d placed, %d segments placed; grid %s"),
+        Diff.ModifiedRows.Num(), Diff.AppendedRows.Num(), Diff.RemovedRows.Num(), NumUpdated, Unplaced.Num(), UnplacedSegments.Num(),
+        bGridChanged ? TEXT("rebuilt") : TEXT("kept"));
 }
 
 void ALineGraphActor::GenerateGridlines()
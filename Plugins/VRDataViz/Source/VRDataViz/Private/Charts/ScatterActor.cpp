@@ -4,8 +4,55 @@
 #include "Charts/GridLineActor.h"
 #include "Charts/AxisTickActor.h"
 #include "Charts/GridMath.h"
+#include "Charts/ChartSampling.h"
+#include "Data/ChartDatasetDiff.h"
+#include "Data/ChartDatasetAsset.h"
 #include "Kismet/KismetMathLibrary.h"
 
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+namespace
+{
+    // Blue (low) -> Cyan -> Green -> Yellow -> Red (high)
+    FLinearColor HeatColor(float Normalized)
+    {
+        const FLinearColor Cyan(0.0f, 1.0f, 1.0f, 1.0f);
+        if (Normalized < 0.33f)
+        {
+            return UKismetMathLibrary::LinearColorLerp(FLinearColor::Blue, Cyan, Normalized / 0.33f);
+        }
+        if (Normalized < 0.66f)
+        {
+            return UKismetMathLibrary::LinearColorLerp(Cyan, FLinearColor::Green, (Normalized - 0.33f) / 0.33f);
+        }
+        const float T = (Normalized - 0.66f) / 0.34f;
+        if (T < 0.5f)
+        {
+            return UKismetMathLibrary::LinearColorLerp(FLinearColor::Green, FLinearColor::Yellow, T * 2.0f);
+        }
+        return UKismetMathLibrary::LinearColorLerp(FLinearColor::Yellow, FLinearColor::Red, (T - 0.5f) * 2.0f);
+    }
+
+    // Range of a column over the whole file when streamed, else over the given rows; false when it is empty or flat
+    bool GetValueRange(const FChartDataset& Dataset, const FChartColumn& Column, const TArray<int32>& SourceRows, float& OutMin, float& OutMax)
+    {
+        OutMin = TNumericLimits<float>::Max();
+        OutMax = TNumericLimits<float>::Lowest();
+        if (!Dataset.GetColumnRange(Column.Name, OutMin, OutMax))
+        {
+            for (const int32 Row : SourceRows)
+            {
+                const float Value = Column.GetFloat(Row);
+                OutMin = FMath::IsNaN(Value) ? OutMin : FMath::Min(OutMin, Value);
+                OutMax = FMath::IsNaN(Value) ? OutMax : FMath::Max(OutMax, Value);
+            }
+        }
+        return OutMax > OutMin;
+    }
+}
+
 AScatterActor::AScatterActor()
 {
     PrimaryActorTick.bCanEverTick = false;
@@ -13,48 +60,260 @@ AScatterActor::AScatterActor()
     RootComponent = Root;
 }
 
+#if WITH_EDITOR
+void AScatterActor::PreSave(FObjectPreSaveContext SaveContext)
+{
+    Super::PreSave(SaveContext);
+    UChartDatasetAsset::PackForCook(SaveContext, this, ScatterDataTable, DatasetAsset);
+}
+
+void AScatterActor::Serialize(FArchive& Ar)
+{
+    FChartCookedTableScope CookedTable(Ar, this, ScatterDataTable, DatasetAsset);
+    Super::Serialize(Ar);
+}
+#endif
+
 void AScatterActor::BeginPlay()
 {
     Super::BeginPlay();
+
+    // The chart builds once the asset's columns have been read
+    if (DatasetAsset && !RuntimeDataset.IsValid())
+    {
+        TWeakObjectPtr<AScatterActor> WeakThis(this);
+        DatasetAsset->LoadDataset([WeakThis](TSharedPtr<const FChartDataset> Dataset)
+        {
+            AScatterActor* This = WeakThis.Get();
+            if (This && Dataset.IsValid())
+            {
+                This->SetRuntimeDataset(Dataset);
+                This->Rebuild();
+            }
+        });
+        return;
+    }
+
     LoadSampleData();
     GenerateScatterplot();
 }
 
 void AScatterActor::LoadSampleData()
 {
-    DataPoints.Empty();
+    DataPoints.Reset();
+    PointOfRow.Reset();
+    PointColors.Empty();
+    PointSizes.Empty();
+    PointRows.Empty();
+    TableRowNames.Empty();
+    bMomentsValid = false;
+
+    if (RuntimeDataset.IsValid())
+    {
+        TArray<FVector> Points;
+        if (!RuntimeDataset->GatherPoints(TEXT("X"), TEXT("Y"), TEXT("Z"), Points, &PointRows))
+        {
+            UE_LOG(LogTemp, Error, TEXT("ScatterActor - Dataset needs X, Y and Z columns"));
+            return;
+        }
+        DataPoints.Assign(Points, bQuantizePoints);
+        SortPointsSpatially();
+        LoadPointColors(PointRows);
+        LoadPointSizes(PointRows);
+
+        // Rows only need storing when points skipped or reordered them
+        bool bIdentity = true;
+        for (int32 PointIndex = 0; PointIndex < PointRows.Num() && bIdentity; ++PointIndex)
+        {
+            bIdentity = PointRows[PointIndex] == PointIndex;
+        }
+        if (bIdentity)
+        {
+            PointRows.Empty();
+        }
+        return;
+    }
+
     if (!ScatterDataTable) return;
 
-    TArray<FVRScatterData*> AllRows;
-    ScatterDataTable->GetAllRows(TEXT("VR Scatter"), AllRows);
-    for (FVRScatterData* RowPtr : AllRows)
+    // Rows are read in place, so they must be laid out as FVRScatterData
+    const UScriptStruct* RowStruct = ScatterDataTable->GetRowStruct();
+    if (!RowStruct || !RowStruct->IsChildOf(FVRScatterData::StaticStruct()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ScatterActor - %s rows are not FVRScatterData"), *ScatterDataTable->GetName());
+        return;
+    }
+
+    TArray<FVector> Points;
+    Points.Reserve(ScatterDataTable->GetRowMap().Num());
+    for (const TPair<FName, uint8*>& Row : ScatterDataTable->GetRowMap())
     {
-        if (RowPtr)
+        const FVRScatterData* RowPtr = reinterpret_cast<const FVRScatterData*>(Row.Value);
+        TableRowNames.Add(Row.Key);
+        Points.Add(FVector(RowPtr->X, RowPtr->Y, RowPtr->Z));
+    }
+    DataPoints.Assign(Points, bQuantizePoints);
+    SortPointsSpatially();
+}
+
+void AScatterActor::AppendSampleData(int32 FirstRow)
+{
+    PointOfRow.Reset();
+    TArray<FVector> Points;
+    TArray<int32> Rows;
+    RuntimeDataset->GatherPoints(TEXT("X"), TEXT("Y"), TEXT("Z"), Points, &Rows, FirstRow);
+    if (PointRows.Num() == 0 && Rows.Num() < RuntimeDataset->NumRows - FirstRow)
+    {
+        PointRows.SetNumUninitialized(DataPoints.Num());
+        for (int32 PointIndex = 0; PointIndex < DataPoints.Num(); ++PointIndex)
         {
-            DataPoints.Add(FVector(RowPtr->X, RowPtr->Y, RowPtr->Z));
+            PointRows[PointIndex] = PointIndex;
         }
     }
+    if (PointRows.Num() > 0)
+    {
+        PointRows.Append(Rows);
+    }
+    DataPoints.Append(Points);
 }
 
-void AScatterActor::GenerateScatterplot()
+void AScatterActor::SortPointsSpatially()
 {
-    if (DataPoints.Num() == 0) return;
-    
-    // Find min/max for axis and color mapping
-    float DataMinX = DataPoints[0].X;
-    float DataMaxX = DataPoints[0].X;
-    float DataMinY = DataPoints[0].Y;
-    float DataMaxY = DataPoints[0].Y;
-    float DataMinZ = DataPoints[0].Z;
-    float DataMaxZ = DataPoints[0].Z;
-    for (const FVector& Point : DataPoints)
-    {
-        DataMinX = FMath::Min(DataMinX, Point.X);
-        DataMaxX = FMath::Max(DataMaxX, Point.X);
-        DataMinY = FMath::Min(DataMinY, Point.Y);
-        DataMaxY = FMath::Max(DataMaxY, Point.Y);
-        DataMinZ = FMath::Min(DataMinZ, Point.Z);
-        DataMaxZ = FMath::Max(DataMaxZ, Point.Z);
+    if (!bSpatialOrder || DataPoints.Num() < 2)
+    {
+        return;
+    }
+
+    TArray<int32> Order;
+    DataPoints.GetMortonOrder(Order);
+    DataPoints.Permute(Order);
+    TArray<int32> SortedRows;
+    SortedRows.SetNumUninitialized(Order.Num());
+    for (int32 PointIndex = 0; PointIndex < Order.Num(); ++PointIndex)
+    {
+        SortedRows[PointIndex] = GetPointRow(Order[PointIndex]);
+    }
+    PointRows = MoveTemp(SortedRows);
+}
+
+void AScatterActor::LoadPointColors(const TArray<int32>& SourceRows)
+{
+    const FChartColumn* Red = RuntimeDataset->GetColumn(TEXT("R"));
+    const FChartColumn* Green = RuntimeDataset->GetColumn(TEXT("G"));
+    const FChartColumn* Blue = RuntimeDataset->GetColumn(TEXT("B"));
+    const FChartColumn* Intensity = RuntimeDataset->GetColumn(TEXT("Intensity"));
+    const FChartColumn* ColorValue = RuntimeDataset->GetColumn(TEXT("Color"));
+    const auto Channel = [](const FChartColumn* Column, int32 Row)
+    {
+        const float Value = Column->GetFloat(Row);
+        return FMath::IsNaN(Value) ? 0.0f : FMath::Clamp(Value, 0.0f, 1.0f);
+    };
+
+    PointColors.Reserve(SourceRows.Num());
+
+    // A mapped color column goes through the same heat ramp as Z
+    float ValueMin = 0.0f;
+    float ValueMax = 0.0f;
+    if (ColorValue && GetValueRange(*RuntimeDataset, *ColorValue, SourceRows, ValueMin, ValueMax))
+    {
+        for (const int32 Row : SourceRows)
+        {
+            const float Level = (ColorValue->GetFloat(Row) - ValueMin) / (ValueMax - ValueMin);
+            PointColors.Add(FMath::IsNaN(Level) ? FLinearColor::White : HeatColor(FMath::Clamp(Level, 0.0f, 1.0f)));
+        }
+        return;
+    }
+
+    if (Red && Green && Blue)
+    {
+        // Point cloud colors are sRGB; quantizing to FColor converts them to linear like texture colors
+        for (const int32 Row : SourceRows)
+        {
+            PointColors.Add(FLinearColor(FLinearColor(Channel(Red, Row), Channel(Green, Row), Channel(Blue, Row)).QuantizeRound()));
+        }
+        return;
+    }
+
+    if (!Intensity)
+    {
+        return;
+    }
+
+    // Grayscale over the intensity range of the whole file when streamed, else of the loaded rows
+    float IntensityMin = 0.0f;
+    float IntensityMax = 0.0f;
+    if (!GetValueRange(*RuntimeDataset, *Intensity, SourceRows, IntensityMin, IntensityMax))
+    {
+        return;
+    }
+
+    for (const int32 Row : SourceRows)
+    {
+        const float Level = (Intensity->GetFloat(Row) - IntensityMin) / (IntensityMax - IntensityMin);
+        const float Gray = FMath::IsNaN(Level) ? 0.0f : FMath::Clamp(Level, 0.0f, 1.0f);
+        PointColors.Add(FLinearColor(Gray, Gray, Gray));
+    }
+}
+
+void AScatterActor::LoadPointSizes(const TArray<int32>& SourceRows)
+{
+    const FChartColumn* Size = RuntimeDataset->GetColumn(TEXT("Size"));
+    float SizeMin = 0.0f;
+    float SizeMax = 0.0f;
+    if (!Size || !GetValueRange(*RuntimeDataset, *Size, SourceRows, SizeMin, SizeMax))
+    {
+        return;
+    }
+
+    // The smallest value draws at half PointScale, the largest at twice it
+    PointSizes.Reserve(SourceRows.Num());
+    for (const int32 Row : SourceRows)
+    {
+        const float Level = (Size->GetFloat(Row) - SizeMin) / (SizeMax - SizeMin);
+        PointSizes.Add(FMath::IsNaN(Level) ? 1.0f : FMath::Lerp(0.5f, 2.0f, FMath::Clamp(Level, 0.0f, 1.0f)));
+    }
+}
+
+bool AScatterActor::UpdateAxes()
+{
+    // Min/max for axis and color mapping, kept exact by the point buffer
+    const FBox& Bounds = DataPoints.GetBounds();
+    float DataMinX = Bounds.Min.X;
+    float DataMaxX = Bounds.Max.X;
+    float DataMinY = Bounds.Min.Y;
+    float DataMaxY = Bounds.Max.Y;
+    float DataMinZ = Bounds.Min.Z;
+    float DataMaxZ = Bounds.Max.Z;
+
+    // A streamed dataset holds a row sample; its column stats still span the whole file
+    if (RuntimeDataset.IsValid())
+    {
+        RuntimeDataset->GetColumnRange(TEXT("X"), DataMinX, DataMaxX);
+        RuntimeDataset->GetColumnRange(TEXT("Y"), DataMinY, DataMaxY);
+        RuntimeDataset->GetColumnRange(TEXT("Z"), DataMinZ, DataMaxZ);
+    }
+
+    // Whole-file sketches of a streamed dataset, else sketches of the loaded points
+    if (bClipToPercentiles && !bUseCustomRange)
+    {
+        const double LowQ = FMath::Clamp(LowPercentile, 0.0f, 100.0f) / 100.0;
+        const double HighQ = FMath::Clamp(HighPercentile, LowPercentile, 100.0f) / 100.0;
+        FVector ClipMin, ClipMax;
+        float ClipMinX, ClipMaxX, ClipMinY, ClipMaxY, ClipMinZ, ClipMaxZ;
+        if (RuntimeDataset.IsValid() && RuntimeDataset->GetColumnQuantileRange(TEXT("X"), LowQ, HighQ, ClipMinX, ClipMaxX)
+            && RuntimeDataset->GetColumnQuantileRange(TEXT("Y"), LowQ, HighQ, ClipMinY, ClipMaxY)
+            && RuntimeDataset->GetColumnQuantileRange(TEXT("Z"), LowQ, HighQ, ClipMinZ, ClipMaxZ))
+        {
+            ClipMin = FVector(ClipMinX, ClipMinY, ClipMinZ);
+            ClipMax = FVector(ClipMaxX, ClipMaxY, ClipMaxZ);
+        }
+        else
+        {
+            DataPoints.GetQuantileRange(LowQ, HighQ, ClipMin, ClipMax);
+        }
+        DataMinX = ClipMin.X; DataMaxX = ClipMax.X;
+        DataMinY = ClipMin.Y; DataMaxY = ClipMax.Y;
+        DataMinZ = ClipMin.Z; DataMaxZ = ClipMax.Z;
     }
 
     const float RangeMinX = bUseCustomRange ? XMin : DataMinX;
@@ -68,74 +327,213 @@ void AScatterActor::GenerateScatterplot()
     const FAxisGridConfig YConfig = DataVizGrid::ComputeAxisGrid(RangeMinY, RangeMaxY, 6);
     const FAxisGridConfig ZConfig = DataVizGrid::ComputeAxisGrid(RangeMinZ, RangeMaxZ, 6);
 
+    const bool bChanged = !DataVizGrid::IsSameAxis(XConfig, AxisMinX, AxisMaxX, AxisStepX)
+        || !DataVizGrid::IsSameAxis(YConfig, AxisMinY, AxisMaxY, AxisStepY)
+        || !DataVizGrid::IsSameAxis(ZConfig, AxisMinZ, AxisMaxZ, AxisStepZ);
+
     AxisMinX = XConfig.AxisMin; AxisMaxX = XConfig.AxisMax; AxisStepX = XConfig.TickStep;
     AxisMinY = YConfig.AxisMin; AxisMaxY = YConfig.AxisMax; AxisStepY = YConfig.TickStep;
     AxisMinZ = ZConfig.AxisMin; AxisMaxZ = ZConfig.AxisMax; AxisStepZ = ZConfig.TickStep;
 
-    const float ZColorMin = bUseCustomRange ? ZMin : DataMinZ;
-    const float ZColorMax = bUseCustomRange ? ZMax : DataMaxZ;
-    const float ZRange = ZColorMax - ZColorMin;
+    ColorMinZ = bUseCustomRange ? ZMin : DataMinZ;
+    ColorMaxZ = bUseCustomRange ? ZMax : DataMaxZ;
+    return bChanged;
+}
 
-    const FQuat GraphRotation = GetActorQuat() * AdditionalRotation.Quaternion();
-    const auto GraphToWorld = [this, GraphRotation](const FVector& Local)
+FLinearColor AScatterActor::GetPointColor(int32 PointIndex) const
+{
+    if (IsPointSelected(PointIndex))
     {
-        return GetActorLocation() + GraphRotation.RotateVector(Local * GraphScale);
-    };
+        return SelectionColor;
+    }
+    if (PointColors.IsValidIndex(PointIndex))
+    {
+        return PointColors[PointIndex];
+    }
 
-    // Generate scatter points with color based on Z value
-    for (const FVector& Point : DataPoints)
+    // Color mapping: Blue (low) -> Green -> Yellow -> Red (high)
+    const float ZRange = ColorMaxZ - ColorMinZ;
+    if (ZRange > 0.001f)
+    {
+        // Clamped, since a clipped or custom range leaves points outside it
+        return HeatColor(FMath::Clamp((DataPoints[PointIndex].Z - ColorMinZ) / ZRange, 0.0f, 1.0f));
+    }
+    return FLinearColor::White;
+}
+
+float AScatterActor::GetPointSize(int32 PointIndex) const
+{
+    return PointScale * (PointSizes.IsValidIndex(PointIndex) ? PointSizes[PointIndex] : 1.0f);
+}
+
+FVector AScatterActor::GraphToWorld(const FVector& Local) const
+{
+    const FQuat GraphRotation = GetActorQuat() * AdditionalRotation.Quaternion();
+    return GetActorLocation() + GraphRotation.RotateVector(Local * GraphScale);
+}
+
+void AScatterActor::PlacePoint(int32 PointIndex, AScatterPointActor* Point)
+{
+    const FVector WorldLoc = GraphToWorld(DataPoints[PointIndex]);
+    const FLinearColor PointColor = GetPointColor(PointIndex);
+    if (!Point)
     {
-        float OriginalZ = Point.Z;
-        const FVector WorldLoc = GraphToWorld(Point);
-        
-        // Color mapping: Blue (low) -> Green -> Yellow -> Red (high)
-        FLinearColor PointColor = FLinearColor::White;
-        if (ZRange > 0.001f)
-        {
-            float NormalizedZ = (OriginalZ - ZColorMin) / ZRange;
-            FLinearColor Cyan(0.0f, 1.0f, 1.0f, 1.0f); // Define Cyan color
-            if (NormalizedZ < 0.33f)
-            {
-                // Blue to Cyan
-                PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Blue, Cyan, NormalizedZ / 0.33f);
-            }
-            else if (NormalizedZ < 0.66f)
-            {
-                // Cyan to Green
-                PointColor = UKismetMathLibrary::LinearColorLerp(Cyan, FLinearColor::Green, (NormalizedZ - 0.33f) / 0.33f);
-            }
-            else
-            {
-                // Green to Yellow to Red
-                float T = (NormalizedZ - 0.66f) / 0.34f;
-                if (T < 0.5f)
-                    PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Green, FLinearColor::Yellow, T * 2.0f);
-                else
-                    PointColor = UKismetMathLibrary::LinearColorLerp(FLinearColor::Yellow, FLinearColor::Red, (T - 0.5f) * 2.0f);
-            }
-        }
-        
         FActorSpawnParameters Params;
         Params.Owner = this;
-        if (AScatterPointActor* SP = GetWorld()->SpawnActor<AScatterPointActor>(AScatterPointActor::StaticClass(), FTransform(WorldLoc), Params))
+        Point = GetWorld()->SpawnActor<AScatterPointActor>(AScatterPointActor::StaticClass(), FTransform(WorldLoc), Params);
+        if (!Point)
         {
-            SP->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
-            SP->InitializePoint(WorldLoc, PointColor, PointScale);
-            SpawnedChildren.Add(SP);
+            return;
         }
+        Point->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+    }
+    Point->InitializePoint(WorldLoc, PointColor, GetPointSize(PointIndex));
+    PointActors[PointIndex] = Point;
+    PointActorColors[PointIndex] = PointColor;
+}
+
+void AScatterActor::GenerateScatterplot()
+{
+    if (DataPoints.Num() == 0) return;
+
+    UpdateAxes();
+
+    // Generate scatter points with color based on Z value (sampled while previewing)
+    TArray<int32> DrawIndices;
+    DataVizSampling::StratifiedIndices(DataPoints.Num(), DataVizSampling::RowBudget(bPreviewFidelity, MaxPreviewPrimitives, 1), DrawIndices);
+    PointActors.Init(nullptr, DataPoints.Num());
+    PointActorColors.Init(FLinearColor::White, DataPoints.Num());
+    for (const int32 PointIndex : DrawIndices)
+    {
+        PlacePoint(PointIndex, nullptr);
     }
 
     // Generate gridlines and axis labels
     GenerateGridlinesAndLabels();
+    UpdateOverlay();
+    ApplyFilter();
+}
+
+void AScatterActor::ApplyDatasetUpdate(TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff)
+{
+    // A preview sample picks points by position, so only a full build over the same columns can be patched
+    const bool bCanPatch = RuntimeDataset.IsValid() && NewDataset.IsValid() && !bPreviewFidelity && !Diff.bSchemaChanged
+        && Diff.NewToOld.Num() == NewDataset->NumRows && PointActors.Num() == DataPoints.Num() && DataPoints.Num() > 0;
+    if (!bCanPatch)
+    {
+        SetRuntimeDataset(MoveTemp(NewDataset));
+        Rebuild();
+        return;
+    }
+
+    TArray<int32> OldPointOfRow;
+    OldPointOfRow.Init(INDEX_NONE, RuntimeDataset->NumRows);
+    for (int32 PointIndex = 0; PointIndex < DataPoints.Num(); ++PointIndex)
+    {
+        OldPointOfRow[GetPointRow(PointIndex)] = PointIndex;
+    }
+    // Rows streamed onto the end extend the points in place, and the old points are the first ones of the new
+    const bool bAppendOnly = Diff.IsAppendOnly() && !bSpatialOrder && PointColors.Num() == 0 && PointSizes.Num() == 0;
+    FChartPointBuffer OldPointStorage;
+    if (!bAppendOnly)
+    {
+        OldPointStorage = MoveTemp(DataPoints);
+    }
+    const FChartPointBuffer& OldPoints = bAppendOnly ? DataPoints : OldPointStorage;
+    const TArray<AScatterPointActor*> OldActors = MoveTemp(PointActors);
+    const TArray<FLinearColor> OldColors = MoveTemp(PointActorColors);
+    const TArray<float> OldSizes = PointSizes;
+    const auto OldSize = [this, &OldSizes](int32 OldPoint) { return PointScale * (OldSizes.IsValidIndex(OldPoint) ? OldSizes[OldPoint] : 1.0f); };
+    const bool bHadMoments = bMomentsValid;
+    FChartMoments PatchedMoments = Moments;
+
+    const int32 OldNumRows = RuntimeDataset->NumRows;
+    RuntimeDataset = MoveTemp(NewDataset);
+    if (bAppendOnly)
+    {
+        AppendSampleData(OldNumRows);
+    }
+    else
+    {
+        LoadSampleData();
+    }
+    if (bHadMoments)
+    {
+        FChartPointBuffer::PatchMoments(PatchedMoments, OldPoints, DataPoints, Diff,
+            [&OldPointOfRow](int32 OldRow) { return OldPointOfRow[OldRow]; },
+            [this](int32 NewRow) { return GetRowPoint(NewRow); });
+        Moments = PatchedMoments;
+        bMomentsValid = true;
+    }
+    const bool bGridChanged = DataPoints.Num() == 0 || UpdateAxes();
+
+    // Points of rows that survived stay in place unless their position or color changed
+    PointActors.Init(nullptr, DataPoints.Num());
+    PointActorColors.Init(FLinearColor::White, DataPoints.Num());
+    TBitArray<> OldKept(false, OldActors.Num());
+    TArray<int32> Unplaced;
+    int32 NumUpdated = 0;
+    for (int32 PointIndex = 0; PointIndex < DataPoints.Num(); ++PointIndex)
+    {
+        const int32 OldRow = Diff.NewToOld[GetPointRow(PointIndex)];
+        const int32 OldPoint = OldRow != INDEX_NONE ? OldPointOfRow[OldRow] : INDEX_NONE;
+        if (OldPoint == INDEX_NONE || !IsValid(OldActors[OldPoint]))
+        {
+            Unplaced.Add(PointIndex);
+            continue;
+        }
+
+        OldKept[OldPoint] = true;
+        if (FChartPointBuffer::IsSamePoint(OldPoints, OldPoint, DataPoints, PointIndex) && OldColors[OldPoint] == GetPointColor(PointIndex) && OldSize(OldPoint) == GetPointSize(PointIndex))
+        {
+            PointActors[PointIndex] = OldActors[OldPoint];
+            PointActorColors[PointIndex] = OldColors[OldPoint];
+        }
+        else
+        {
+            PlacePoint(PointIndex, OldActors[OldPoint]);
+            ++NumUpdated;
+        }
+    }
+
+    // Points of removed rows are reused for appended ones before anything is spawned or destroyed
+    TArray<AScatterPointActor*> FreePoints;
+    for (int32 OldPoint = 0; OldPoint < OldActors.Num(); ++OldPoint)
+    {
+        if (!OldKept[OldPoint] && IsValid(OldActors[OldPoint]))
+        {
+            FreePoints.Add(OldActors[OldPoint]);
+        }
+    }
+    const int32 NumReused = FMath::Min(FreePoints.Num(), Unplaced.Num());
+    for (const int32 PointIndex : Unplaced)
+    {
+        PlacePoint(PointIndex, FreePoints.Num() > 0 ? FreePoints.Pop() : nullptr);
+    }
+    for (AScatterPointActor* Unused : FreePoints)
+    {
+        Unused->Destroy();
+    }
+
+    if (bGridChanged)
+    {
+        ClearGridActors();
+        if (DataPoints.Num() > 0)
+        {
+            GenerateGridlinesAndLabels();
+        }
+    }
+    UpdateOverlay();
+    ApplyFilter();
+
+    UE_LOG(LogTemp, Log, TEXT("ScatterActor - Applied %d modified, %d appended and %d removed rows: %d points updated, %d reused, %d spawned, %d destroyed; grid %s"),
+        Diff.ModifiedRows.Num(), Diff.AppendedRows.Num(), Diff.RemovedRows.Num(), NumUpdated, NumReused, Unplaced.Num() - NumReused, FreePoints.Num(),
+        bGridChanged ? TEXT("rebuilt") : TEXT("kept"));
 }
 
 void AScatterActor::GenerateGridlinesAndLabels()
 {
     const FQuat GraphRotation = GetActorQuat() * AdditionalRotation.Quaternion();
-    const auto GraphToWorld = [this, GraphRotation](const FVector& Local)
-    {
-        return GetActorLocation() + GraphRotation.RotateVector(Local * GraphScale);
-    };
     const auto RotateLabel = [GraphRotation](const FRotator& LocalRot)
     {
         return (GraphRotation * LocalRot.Quaternion()).Rotator();
@@ -247,7 +645,7 @@ void AScatterActor::GenerateGridlinesAndLabels()
     });
 }
 
-void AScatterActor::ClearChildrenActors()
+void AScatterActor::ClearGridActors()
 {
     for (AActor* Child : SpawnedChildren)
     {
@@ -259,6 +657,246 @@ void AScatterActor::ClearChildrenActors()
     SpawnedChildren.Empty();
 }
 
+void AScatterActor::ClearChildrenActors()
+{
+    for (AScatterPointActor* Point : PointActors)
+    {
+        if (IsValid(Point))
+        {
+            Point->Destroy();
+        }
+    }
+    PointActors.Empty();
+    PointActorColors.Empty();
+    ClearGridActors();
+    ClearOverlayActors();
+}
+
+FVector AScatterActor::GetPointValue(int32 PointIndex) const
+{
+    if (!FMath::IsWithin(PointIndex, 0, DataPoints.Num()))
+    {
+        return FVector::ZeroVector;
+    }
+
+    const int32 Row = GetPointRow(PointIndex);
+    if (RuntimeDataset.IsValid())
+    {
+        const FChartColumn* X = RuntimeDataset->GetColumn(TEXT("X"));
+        const FChartColumn* Y = RuntimeDataset->GetColumn(TEXT("Y"));
+        const FChartColumn* Z = RuntimeDataset->GetColumn(TEXT("Z"));
+        if (X && Y && Z)
+        {
+            return FVector(X->GetFloat(Row), Y->GetFloat(Row), Z->GetFloat(Row));
+        }
+    }
+    else if (ScatterDataTable)
+    {
+        if (const FVRScatterData* RowPtr = TableRowNames.IsValidIndex(Row) ? ScatterDataTable->FindRow<FVRScatterData>(TableRowNames[Row], TEXT("VR Scatter"), false) : nullptr)
+        {
+            return FVector(RowPtr->X, RowPtr->Y, RowPtr->Z);
+        }
+    }
+    return DataPoints[PointIndex];
+}
+
+bool AScatterActor::SetFilter(const FString& Expression)
+{
+    FChartFilter NewFilter;
+    FString Error;
+    if (!FChartFilter::Compile(Expression, NewFilter, Error))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ScatterActor - Filter \"%s\" not applied: %s"), *Expression, *Error);
+        return false;
+    }
+    Filter = MoveTemp(NewFilter);
+    return ApplyFilter();
+}
+
+bool AScatterActor::ApplyFilter()
+{
+    FilterMask.Reset();
+    bool bApplied = true;
+    if (!Filter.IsEmpty())
+    {
+        FString Error = TEXT("filters need a runtime dataset");
+        bApplied = RuntimeDataset.IsValid() && Filter.Evaluate(*RuntimeDataset, FilterMask, Error);
+        if (!bApplied)
+        {
+            FilterMask.Reset();
+            UE_LOG(LogTemp, Warning, TEXT("ScatterActor - Filter \"%s\" not applied: %s"), *Filter.GetExpression(), *Error);
+        }
+    }
+
+    // Only points whose visibility changes are touched, so narrowing or widening a filter costs one pass over the mask
+    for (int32 PointIndex = 0; PointIndex < PointActors.Num(); ++PointIndex)
+    {
+        AScatterPointActor* Point = PointActors[PointIndex];
+        const bool bHidden = !FilterMask.IsEmpty() && !FilterMask[GetPointRow(PointIndex)];
+        if (IsValid(Point) && Point->IsHidden() != bHidden)
+        {
+            Point->SetActorHiddenInGame(bHidden);
+            Point->SetActorEnableCollision(!bHidden);
+        }
+    }
+    return bApplied;
+}
+
+void AScatterActor::SetSelection(TSharedPtr<FChartSelection> InSelection)
+{
+    if (Selection.IsValid())
+    {
+        Selection->OnChanged.Remove(SelectionChangedHandle);
+    }
+    Selection = MoveTemp(InSelection);
+    SelectionChangedHandle = Selection.IsValid() ? Selection->OnChanged.AddUObject(this, &AScatterActor::OnSelectionChanged) : FDelegateHandle();
+
+    // Points whose selection state differs from how they were drawn pick up the new selection
+    for (int32 PointIndex = 0; PointIndex < PointActors.Num(); ++PointIndex)
+    {
+        if (IsValid(PointActors[PointIndex]) && PointActorColors[PointIndex] != GetPointColor(PointIndex))
+        {
+            PlacePoint(PointIndex, PointActors[PointIndex]);
+        }
+    }
+}
+
+void AScatterActor::SelectPoints(const TArray<int32>& PointIndices, bool bAddToSelection)
+{
+    if (!Selection.IsValid())
+    {
+        SetSelection(MakeShared<FChartSelection>(RuntimeDataset.IsValid() ? RuntimeDataset->NumRows : DataPoints.Num()));
+    }
+
+    TArray<int32> Rows;
+    Rows.Reserve(PointIndices.Num());
+    for (const int32 PointIndex : PointIndices)
+    {
+        if (FMath::IsWithin(PointIndex, 0, DataPoints.Num()))
+        {
+            Rows.Add(GetPointRow(PointIndex));
+        }
+    }
+    Selection->SelectRows(Rows, bAddToSelection ? EChartSelectionOp::Add : EChartSelectionOp::Replace);
+}
+
+void AScatterActor::ClearSelection()
+{
+    if (Selection.IsValid())
+    {
+        Selection->Clear();
+    }
+}
+
+bool AScatterActor::IsPointSelected(int32 PointIndex) const
+{
+    return Selection.IsValid() && FMath::IsWithin(PointIndex, 0, DataPoints.Num()) && Selection->IsSelected(GetPointRow(PointIndex));
+}
+
+int32 AScatterActor::GetRowPoint(int32 Row)
+{
+    if (PointRows.Num() == 0)
+    {
+        return FMath::IsWithin(Row, 0, DataPoints.Num()) ? Row : INDEX_NONE;
+    }
+    if (PointOfRow.Num() == 0)
+    {
+        int32 NumSourceRows = 0;
+        for (const int32 SourceRow : PointRows)
+        {
+            NumSourceRows = FMath::Max(NumSourceRows, SourceRow + 1);
+        }
+        PointOfRow.Init(INDEX_NONE, NumSourceRows);
+        for (int32 PointIndex = 0; PointIndex < PointRows.Num(); ++PointIndex)
+        {
+            PointOfRow[PointRows[PointIndex]] = PointIndex;
+        }
+    }
+    return PointOfRow.IsValidIndex(Row) ? PointOfRow[Row] : INDEX_NONE;
+}
+
+void AScatterActor::OnSelectionChanged(const FChartSelectionChange& Change)
+{
+    Change.ForEachRow([this](int32 Row)
+    {
+        const int32 PointIndex = GetRowPoint(Row);
+        if (PointActors.IsValidIndex(PointIndex) && IsValid(PointActors[PointIndex]))
+        {
+            PlacePoint(PointIndex, PointActors[PointIndex]);
+        }
+    });
+}
+
+void AScatterActor::ClearOverlayActors()
+{
+    for (AGridLineActor* Line : OverlayActors)
+    {
+        if (IsValid(Line))
+        {
+            Line->Destroy();
+        }
+    }
+    OverlayActors.Empty();
+}
+
+void AScatterActor::UpdateOverlay()
+{
+    ClearOverlayActors();
+    if (!(bShowMeanOverlay || bShowSigmaBand || bShowRegressionOverlay) || DataPoints.Num() == 0)
+    {
+        return;
+    }
+    if (!bMomentsValid)
+    {
+        Moments = DataPoints.ComputeMoments();
+        bMomentsValid = true;
+    }
+
+    FActorSpawnParameters Params;
+    Params.Owner = this;
+    const auto SpawnLine = [this, &Params](const FVector& Start, const FVector& End)
+    {
+        const FVector WorldStart = GraphToWorld(Start);
+        if (AGridLineActor* Line = GetWorld()->SpawnActor<AGridLineActor>(AGridLineActor::StaticClass(), FTransform(WorldStart), Params))
+        {
+            Line->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+            Line->InitializeLine(WorldStart, GraphToWorld(End), OverlayColor, 3.0f);
+            OverlayActors.Add(Line);
+        }
+    };
+    // Outline of the surface Z = A + B * X + C * Y over the X/Y extent of the axes
+    const auto SpawnSurface = [this, &SpawnLine](double A, double B, double C)
+    {
+        const auto Corner = [A, B, C](double X, double Y) { return FVector(X, Y, A + B * X + C * Y); };
+        const FVector Corners[4] = { Corner(AxisMinX, AxisMinY), Corner(AxisMaxX, AxisMinY), Corner(AxisMaxX, AxisMaxY), Corner(AxisMinX, AxisMaxY) };
+        for (int32 Edge = 0; Edge < 4; ++Edge)
+        {
+            SpawnLine(Corners[Edge], Corners[(Edge + 1) % 4]);
+        }
+    };
+
+    const double MeanZ = Moments.Mean.Z;
+    const double BandZ = SigmaBandWidth * Moments.GetStdDev().Z;
+    if (bShowMeanOverlay)
+    {
+        SpawnSurface(MeanZ, 0.0, 0.0);
+    }
+    if (bShowSigmaBand)
+    {
+        SpawnSurface(MeanZ - BandZ, 0.0, 0.0);
+        SpawnSurface(MeanZ + BandZ, 0.0, 0.0);
+    }
+    double A, B, C;
+    if (bShowRegressionOverlay && Moments.FitPlane(A, B, C))
+    {
+        SpawnSurface(A, B, C);
+    }
+    else if (bShowRegressionOverlay && Moments.FitLine(A, B))
+    {
+        SpawnLine(FVector(AxisMinX, Moments.Mean.Y, A + B * AxisMinX), FVector(AxisMaxX, Moments.Mean.Y, A + B * AxisMaxX));
+    }
+}
+
 void AScatterActor::Rebuild()
 {
     ClearChildrenActors();
@@ -0,0 +1,845 @@
+#include "Data/ArrowFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+
+// Layout reference: Arrow columnar format, "IPC File Format" and Schema.fbs / Message.fbs / File.fbs
+namespace
+{
+    constexpr uint8 ArrowMagic[6] = { 'A', 'R', 'R', 'O', 'W', '1' };
+
+    // Union tags of Message.fbs MessageHeader and Schema.fbs Type
+    enum EMessageHeader : uint8
+    {
+        Header_DictionaryBatch = 2,
+        Header_RecordBatch = 3
+    };
+
+    enum ETypeTag : uint8
+    {
+        Type_Null = 1,
+        Type_Int = 2,
+        Type_FloatingPoint = 3,
+        Type_Binary = 4,
+        Type_Utf8 = 5,
+        Type_Bool = 6,
+        Type_Decimal = 7,
+        Type_Date = 8,
+        Type_Time = 9,
+        Type_Timestamp = 10,
+        Type_Interval = 11,
+        Type_List = 12,
+        Type_Struct = 13,
+        Type_FixedSizeBinary = 15,
+        Type_FixedSizeList = 16,
+        Type_Map = 17,
+        Type_Duration = 18,
+        Type_LargeBinary = 19,
+        Type_LargeUtf8 = 20,
+        Type_LargeList = 21
+    };
+
+    template<typename T>
+    T ReadUnaligned(const uint8* Ptr)
+    {
+        T Value;
+        FMemory::Memcpy(&Value, Ptr, sizeof(T));
+        return Value;
+    }
+
+    // Read-only flatbuffer table. Every access is bounds-checked against the enclosing buffer;
+    // absent or out-of-range fields read as their default, so a corrupt file cannot read outside the mapping.
+    class FFlatTable
+    {
+    public:
+        FFlatTable() = default;
+
+        FFlatTable(const uint8* InBegin, const uint8* InEnd, const uint8* InTable)
+        {
+            const int64 BufferSize = InEnd - InBegin;
+            const int64 TablePos = InTable - InBegin;
+            if (TablePos < 0 || TablePos + 4 > BufferSize)
+            {
+                return;
+            }
+
+            const int64 VTablePos = TablePos - ReadUnaligned<int32>(InTable);
+            if (VTablePos < 0 || VTablePos + 4 > BufferSize)
+            {
+                return;
+            }
+
+            const uint16 VTableBytes = ReadUnaligned<uint16>(InBegin + VTablePos);
+            if (VTablePos + VTableBytes > BufferSize)
+            {
+                return;
+            }
+
+            Begin = InBegin;
+            End = InEnd;
+            Table = InTable;
+            VTable = InBegin + VTablePos;
+            VTableSize = VTableBytes;
+        }
+
+        static FFlatTable Root(const uint8* Begin, const uint8* End)
+        {
+            return End - Begin >= 4 ? FFlatTable(Begin, End, Begin + ReadUnaligned<uint32>(Begin)) : FFlatTable();
+        }
+
+        bool IsValid() const { return Table != nullptr; }
+
+        template<typename T>
+        T GetScalar(int32 Field, T Default) const
+        {
+            const uint8* Ptr = GetFieldPtr(Field, sizeof(T));
+            return Ptr ? ReadUnaligned<T>(Ptr) : Default;
+        }
+
+        FFlatTable GetTable(int32 Field) const
+        {
+            const uint8* Target = Deref(Field);
+            return Target ? FFlatTable(Begin, End, Target) : FFlatTable();
+        }
+
+        // Elements of a vector field; nullptr when absent or when the elements would run past the buffer
+        const uint8* GetVector(int32 Field, int32 ElementSize, uint32& OutLength) const
+        {
+            OutLength = 0;
+            const uint8* Target = Deref(Field);
+            if (!Target || End - Target < 4)
+            {
+                return nullptr;
+            }
+
+            const uint32 Length = ReadUnaligned<uint32>(Target);
+            if (static_cast<uint64>(Length) * ElementSize > static_cast<uint64>(End - Target - 4))
+            {
+                return nullptr;
+            }
+            OutLength = Length;
+            return Target + 4;
+        }
+
+        FFlatTable GetVectorTable(const uint8* Elements, uint32 Index) const
+        {
+            const uint8* Slot = Elements + static_cast<int64>(Index) * 4;
+            const uint32 Offset = ReadUnaligned<uint32>(Slot);
+            return Offset <= static_cast<uint64>(End - Slot) ? FFlatTable(Begin, End, Slot + Offset) : FFlatTable();
+        }
+
+        FString GetString(int32 Field) const
+        {
+            uint32 Length = 0;
+            const uint8* Chars = GetVector(Field, 1, Length);
+            if (!Chars || Length == 0)
+            {
+                return FString();
+            }
+            const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Chars), static_cast<int32>(Length));
+            return FString(Converted.Length(), Converted.Get());
+        }
+
+    private:
+        const uint8* GetFieldPtr(int32 Field, int32 FieldSize) const
+        {
+            const int32 Entry = 4 + Field * 2;
+            if (!Table || Entry + 2 > VTableSize)
+            {
+                return nullptr;
+            }
+
+            const uint16 Offset = ReadUnaligned<uint16>(VTable + Entry);
+            return Offset != 0 && Offset + FieldSize <= End - Table ? Table + Offset : nullptr;
+        }
+
+        const uint8* Deref(int32 Field) const
+        {
+            const uint8* Ptr = GetFieldPtr(Field, 4);
+            if (!Ptr)
+            {
+                return nullptr;
+            }
+            const uint32 Offset = ReadUnaligned<uint32>(Ptr);
+            return Offset <= static_cast<uint64>(End - Ptr) ? Ptr + Offset : nullptr;
+        }
+
+        const uint8* Begin = nullptr;
+        const uint8* End = nullptr;
+        const uint8* Table = nullptr;
+        const uint8* VTable = nullptr;
+        uint16 VTableSize = 0;
+    };
+
+    // File.fbs Block, a struct stored inline in the footer vectors
+    struct FBlock
+    {
+        int64 Offset;
+        int32 MetaDataLength;
+        int32 Padding;
+        int64 BodyLength;
+    };
+    static_assert(sizeof(FBlock) == 24, "Arrow Block struct is 24 bytes");
+
+    // Message.fbs FieldNode and Buffer, stored inline in record batches
+    struct FFieldNode
+    {
+        int64 Length;
+        int64 NullCount;
+    };
+
+    struct FBufferRange
+    {
+        int64 Offset;
+        int64 Length;
+    };
+
+    // Where a schema field lives in every record batch, and how it is exposed
+    struct FFieldLayout
+    {
+        int32 NumNodes = 0;
+        int32 NumBuffers = 0;
+        int32 ColumnIndex = INDEX_NONE; // Index into FArrowFile columns, INDEX_NONE when skipped
+    };
+
+    EArrowValueType GetIntType(const FFlatTable& Int)
+    {
+        const bool bSigned = Int.GetScalar<uint8>(1, 0) != 0;
+        switch (Int.GetScalar<int32>(0, 0))
+        {
+        case 8:  return bSigned ? EArrowValueType::Int8 : EArrowValueType::UInt8;
+        case 16: return bSigned ? EArrowValueType::Int16 : EArrowValueType::UInt16;
+        case 32: return bSigned ? EArrowValueType::Int32 : EArrowValueType::UInt32;
+        case 64: return bSigned ? EArrowValueType::Int64 : EArrowValueType::UInt64;
+        default: return EArrowValueType::Unsupported;
+        }
+    }
+
+    int32 GetValueSize(EArrowValueType Type)
+    {
+        switch (Type)
+        {
+        case EArrowValueType::Int8:
+        case EArrowValueType::UInt8:
+            return 1;
+        case EArrowValueType::Int16:
+        case EArrowValueType::UInt16:
+            return 2;
+        case EArrowValueType::Int32:
+        case EArrowValueType::UInt32:
+        case EArrowValueType::Float32:
+        case EArrowValueType::Utf8: // int32 offsets
+            return 4;
+        case EArrowValueType::Int64:
+        case EArrowValueType::UInt64:
+        case EArrowValueType::Float64:
+            return 8;
+        default:
+            return 0;
+        }
+    }
+
+    // Value type of a schema field, or Unsupported when the reader does not expose it
+    EArrowValueType GetValueType(const FFlatTable& Field, int64& OutDictionaryId)
+    {
+        const uint8 TypeTag = Field.GetScalar<uint8>(2, 0);
+        const FFlatTable TypeTable = Field.GetTable(3);
+
+        const FFlatTable Dictionary = Field.GetTable(4);
+        if (Dictionary.IsValid())
+        {
+            if (TypeTag != Type_Utf8)
+            {
+                return EArrowValueType::Unsupported;
+            }
+            OutDictionaryId = Dictionary.GetScalar<int64>(0, 0);
+            const FFlatTable IndexType = Dictionary.GetTable(1);
+            return IndexType.IsValid() ? GetIntType(IndexType) : EArrowValueType::Int32;
+        }
+
+        switch (TypeTag)
+        {
+        case Type_Int:
+            return GetIntType(TypeTable);
+        case Type_FloatingPoint:
+        {
+            const int16 Precision = TypeTable.GetScalar<int16>(0, 0);
+            return Precision == 1 ? EArrowValueType::Float32 : Precision == 2 ? EArrowValueType::Float64 : EArrowValueType::Unsupported;
+        }
+        case Type_Utf8:
+            return EArrowValueType::Utf8;
+        default:
+            return EArrowValueType::Unsupported;
+        }
+    }
+
+    // Field nodes and buffers a field (including its children) occupies in each record batch.
+    // Returns false for layouts this reader cannot skip over (unions, view types).
+    bool CountLayout(const FFlatTable& Field, int32 Depth, FFieldLayout& Layout)
+    {
+        if (!Field.IsValid() || Depth > 64)
+        {
+            return false;
+        }
+
+        ++Layout.NumNodes;
+        if (Field.GetTable(4).IsValid())
+        {
+            // Dictionary-encoded: validity and indices; the values live in dictionary batches
+            Layout.NumBuffers += 2;
+            return true;
+        }
+
+        switch (Field.GetScalar<uint8>(2, 0))
+        {
+        case Type_Null:
+            break;
+        case Type_Struct:
+        case Type_FixedSizeList:
+            Layout.NumBuffers += 1;
+            break;
+        case Type_Int:
+        case Type_FloatingPoint:
+        case Type_Bool:
+        case Type_Decimal:
+        case Type_Date:
+        case Type_Time:
+        case Type_Timestamp:
+        case Type_Interval:
+        case Type_FixedSizeBinary:
+        case Type_Duration:
+        case Type_List:
+        case Type_LargeList:
+        case Type_Map:
+            Layout.NumBuffers += 2;
+            break;
+        case Type_Binary:
+        case Type_Utf8:
+        case Type_LargeBinary:
+        case Type_LargeUtf8:
+            Layout.NumBuffers += 3;
+            break;
+        default:
+            return false;
+        }
+
+        uint32 NumChildren = 0;
+        const uint8* Children = Field.GetVector(5, 4, NumChildren);
+        for (uint32 Child = 0; Child < NumChildren; ++Child)
+        {
+            if (!CountLayout(Field.GetVectorTable(Children, Child), Depth + 1, Layout))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Encapsulated IPC message at a footer block: its flatbuffer header and the body the buffers point into
+    struct FMessage
+    {
+        FFlatTable Header;
+        uint8 HeaderType = 0;
+        const uint8* Body = nullptr;
+        int64 BodyLength = 0;
+    };
+
+    bool ReadMessage(const uint8* Data, int64 Size, const FBlock& Block, FMessage& OutMessage)
+    {
+        if (Block.Offset < 8 || Block.MetaDataLength < 8 || Block.BodyLength < 0
+            || Block.Offset > Size - Block.MetaDataLength - Block.BodyLength)
+        {
+            return false;
+        }
+
+        // Current files prefix the header with a 0xFFFFFFFF continuation marker; pre-1.0 files omit it
+        const uint8* Message = Data + Block.Offset;
+        int32 HeaderOffset = 4;
+        int32 HeaderLength = ReadUnaligned<int32>(Message);
+        if (HeaderLength == -1)
+        {
+            HeaderOffset = 8;
+            HeaderLength = ReadUnaligned<int32>(Message + 4);
+        }
+        if (HeaderLength <= 0 || HeaderLength > Block.MetaDataLength - HeaderOffset)
+        {
+            return false;
+        }
+
+        const FFlatTable Root = FFlatTable::Root(Message + HeaderOffset, Message + HeaderOffset + HeaderLength);
+        OutMessage.HeaderType = Root.GetScalar<uint8>(1, 0);
+        OutMessage.Header = Root.GetTable(2);
+        OutMessage.Body = Message + Block.MetaDataLength;
+        OutMessage.BodyLength = Block.BodyLength;
+        return OutMessage.Header.IsValid();
+    }
+
+    // Field nodes and buffers of a RecordBatch table, validated against the message body
+    struct FRecordBatchView
+    {
+        const FMessage* Message = nullptr;
+        const uint8* Nodes = nullptr;
+        const uint8* Buffers = nullptr;
+        uint32 NumNodes = 0;
+        uint32 NumBuffers = 0;
+        int64 Length = 0;
+
+        bool Init(const FMessage& InMessage, const FFlatTable& Batch)
+        {
+            Message = &InMessage;
+            Length = Batch.GetScalar<int64>(0, 0);
+            Nodes = Batch.GetVector(1, sizeof(FFieldNode), NumNodes);
+            Buffers = Batch.GetVector(2, sizeof(FBufferRange), NumBuffers);
+            if (Batch.GetTable(3).IsValid())
+            {
+                UE_LOG(LogTemp, Error, TEXT("ArrowFile - Compressed record batches are not supported; write the file with compression='uncompressed'"));
+                return false;
+            }
+            return Length >= 0;
+        }
+
+        FFieldNode GetNode(int32 Index) const
+        {
+            return ReadUnaligned<FFieldNode>(Nodes + static_cast<int64>(Index) * sizeof(FFieldNode));
+        }
+
+        // Start of a buffer holding at least MinBytes, nullptr when the buffer is empty or out of bounds
+        const uint8* GetBuffer(int32 Index, int64 MinBytes, int32 Alignment, int64* OutLength = nullptr) const
+        {
+            const FBufferRange Range = ReadUnaligned<FBufferRange>(Buffers + static_cast<int64>(Index) * sizeof(FBufferRange));
+            if (Range.Offset < 0 || Range.Length < MinBytes || Range.Length == 0 || Range.Offset > Message->BodyLength - Range.Length)
+            {
+                return nullptr;
+            }
+
+            const uint8* Ptr = Message->Body + Range.Offset;
+            if (!IsAligned(Ptr, Alignment))
+            {
+                return nullptr;
+            }
+            if (OutLength)
+            {
+                *OutLength = Range.Length;
+            }
+            return Ptr;
+        }
+
+        // Chunk for the field whose first node and buffer are at the given cursors; false when a buffer is missing or truncated
+        bool GetChunk(int32 NodeIndex, int32 BufferIndex, EArrowValueType Type, FArrowColumnChunk& OutChunk) const
+        {
+            const FFieldNode Node = GetNode(NodeIndex);
+            // Every exposed type stores at least one byte per value, which also bounds the size arithmetic below
+            if (Node.Length < 0 || Node.Length > Message->BodyLength || Node.NullCount < 0 || Node.NullCount > Node.Length)
+            {
+                return false;
+            }
+
+            OutChunk.Length = Node.Length;
+            OutChunk.NullCount = Node.NullCount;
+            if (Node.Length == 0)
+            {
+                return true;
+            }
+
+            if (Node.NullCount > 0)
+            {
+                OutChunk.Validity = GetBuffer(BufferIndex, (Node.Length + 7) / 8, 1);
+                if (!OutChunk.Validity)
+                {
+                    return false;
+                }
+            }
+
+            const int32 ValueSize = GetValueSize(Type);
+            if (Type != EArrowValueType::Utf8)
+            {
+                OutChunk.Values = GetBuffer(BufferIndex + 1, Node.Length * ValueSize, ValueSize);
+                return OutChunk.Values != nullptr;
+            }
+
+            OutChunk.Values = GetBuffer(BufferIndex + 1, (Node.Length + 1) * ValueSize, ValueSize);
+            if (!OutChunk.Values)
+            {
+                return false;
+            }
+
+            // Offsets must stay inside the data buffer; individual rows are still checked when decoded
+            const int32* Offsets = OutChunk.GetValues<int32>();
+            const int64 TotalBytes = Offsets[Node.Length] - static_cast<int64>(Offsets[0]);
+            int64 DataLength = 0;
+            OutChunk.StringData = GetBuffer(BufferIndex + 2, 0, 1, &DataLength);
+            return Offsets[0] >= 0 && TotalBytes >= 0 && Offsets[Node.Length] <= DataLength && (OutChunk.StringData || TotalBytes == 0);
+        }
+    };
+
+    FString DecodeUtf8(const FArrowColumnChunk& Chunk, int64 Index)
+    {
+        const int32* Offsets = Chunk.GetValues<int32>();
+        const int32 Begin = Offsets[Index];
+        const int32 End = Offsets[Index + 1];
+        if (End <= Begin || Begin < Offsets[0] || End > Offsets[Chunk.Length])
+        {
+            return FString();
+        }
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Chunk.StringData + Begin), End - Begin);
+        return FString(Converted.Length(), Converted.Get());
+    }
+
+    // Appends a string value to a text column; a label already in its dictionary is not copied again
+    void AddUtf8(const FArrowColumnChunk& Chunk, int64 Index, FChartColumn& Dest)
+    {
+        const int32* Offsets = Chunk.GetValues<int32>();
+        const int32 Begin = Offsets[Index];
+        const int32 End = Offsets[Index + 1];
+        if (!Chunk.IsValid(Index) || End <= Begin || Begin < Offsets[0] || End > Offsets[Chunk.Length])
+        {
+            Dest.AddString(FStringView());
+            return;
+        }
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Chunk.StringData + Begin), End - Begin);
+        Dest.AddString(FStringView(Converted.Get(), Converted.Length()));
+    }
+
+    template<typename T>
+    void ConvertChunk(const FArrowColumnChunk& Chunk, float* Out)
+    {
+        const T* Values = Chunk.GetValues<T>();
+        if (!Chunk.Validity)
+        {
+            for (int64 Index = 0; Index < Chunk.Length; ++Index)
+            {
+                Out[Index] = static_cast<float>(Values[Index]);
+            }
+            return;
+        }
+
+        for (int64 Index = 0; Index < Chunk.Length; ++Index)
+        {
+            Out[Index] = Chunk.IsValid(Index) ? static_cast<float>(Values[Index]) : NAN;
+        }
+    }
+
+    // Dictionary index as int64, INDEX_NONE for a null entry
+    int64 GetIndex(const FArrowColumnChunk& Chunk, EArrowValueType Type, int64 Row)
+    {
+        if (!Chunk.IsValid(Row))
+        {
+            return INDEX_NONE;
+        }
+
+        switch (Type)
+        {
+        case EArrowValueType::Int8:   return Chunk.GetValues<int8>()[Row];
+        case EArrowValueType::Int16:  return Chunk.GetValues<int16>()[Row];
+        case EArrowValueType::Int32:  return Chunk.GetValues<int32>()[Row];
+        case EArrowValueType::Int64:  return Chunk.GetValues<int64>()[Row];
+        case EArrowValueType::UInt8:  return Chunk.GetValues<uint8>()[Row];
+        case EArrowValueType::UInt16: return Chunk.GetValues<uint16>()[Row];
+        case EArrowValueType::UInt32: return Chunk.GetValues<uint32>()[Row];
+        case EArrowValueType::UInt64: return static_cast<int64>(Chunk.GetValues<uint64>()[Row]);
+        default:                      return INDEX_NONE;
+        }
+    }
+}
+
+FArrowFile::~FArrowFile()
+{
+    // The region must be unmapped before its file handle closes
+    MappedRegion.Reset();
+    MappedHandle.Reset();
+}
+
+bool FArrowFile::IsArrowFile(const FString& FilePath)
+{
+    TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+    uint8 Leading[sizeof(ArrowMagic)] = {};
+    return Handle && Handle->Read(Leading, sizeof(Leading)) && FMemory::Memcmp(Leading, ArrowMagic, sizeof(ArrowMagic)) == 0;
+}
+
+TSharedPtr<FArrowFile> FArrowFile::Open(const FString& FilePath)
+{
+    TSharedPtr<FArrowFile> File = MakeShareable(new FArrowFile());
+    if (!File->Map(FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ArrowFile - Failed to open file: %s"), *FilePath);
+        return nullptr;
+    }
+
+    if (!File->Parse())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ArrowFile - Not a supported Arrow IPC file: %s"), *FilePath);
+        return nullptr;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ArrowFile - Mapped %lld rows x %d columns from %s"), File->NumRows, File->Columns.Num(), *FilePath);
+    return File;
+}
+
+bool FArrowFile::Map(const FString& FilePath)
+{
+    MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+    if (MappedHandle && MappedHandle->GetFileSize() > 0)
+    {
+        MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+    }
+
+    if (MappedRegion)
+    {
+        Data = MappedRegion->GetMappedPtr();
+        Size = MappedRegion->GetMappedSize();
+        return true;
+    }
+
+    // Platforms without file mapping (and empty files) fall back to one read
+    MappedHandle.Reset();
+    if (!FFileHelper::LoadFileToArray(LoadedBytes, *FilePath))
+    {
+        return false;
+    }
+    Data = LoadedBytes.GetData();
+    Size = LoadedBytes.Num();
+    return true;
+}
+
+bool FArrowFile::Parse()
+{
+    // Magic, padding, stream messages, footer flatbuffer, int32 footer length, magic
+    constexpr int64 MagicSize = sizeof(ArrowMagic);
+    if (Size < 2 * MagicSize + 6
+        || FMemory::Memcmp(Data, ArrowMagic, MagicSize) != 0
+        || FMemory::Memcmp(Data + Size - MagicSize, ArrowMagic, MagicSize) != 0)
+    {
+        return false;
+    }
+
+    const int32 FooterLength = ReadUnaligned<int32>(Data + Size - MagicSize - 4);
+    if (FooterLength <= 0 || FooterLength > Size - 2 * MagicSize - 4)
+    {
+        return false;
+    }
+
+    const uint8* FooterEnd = Data + Size - MagicSize - 4;
+    const FFlatTable Footer = FFlatTable::Root(FooterEnd - FooterLength, FooterEnd);
+    const FFlatTable Schema = Footer.GetTable(1);
+    if (!Schema.IsValid() || Schema.GetScalar<int16>(0, 0) != 0)
+    {
+        // Big-endian files would need every value swapped
+        return false;
+    }
+
+    // Schema: which top-level fields become columns, and the node/buffer span of each
+    uint32 NumFields = 0;
+    const uint8* Fields = Schema.GetVector(1, 4, NumFields);
+    TArray<FFieldLayout> Layouts;
+    TSet<int64> StringDictionaryIds;
+    for (uint32 FieldIndex = 0; FieldIndex < NumFields; ++FieldIndex)
+    {
+        const FFlatTable Field = Schema.GetVectorTable(Fields, FieldIndex);
+        FFieldLayout Layout;
+        if (!CountLayout(Field, 0, Layout))
+        {
+            // Later fields cannot be located without this one's buffer count
+            UE_LOG(LogTemp, Warning, TEXT("ArrowFile - Skipping field '%s' and the fields after it: unsupported layout"), *Field.GetString(0));
+            break;
+        }
+
+        int64 DictionaryId = INDEX_NONE;
+        const EArrowValueType Type = GetValueType(Field, DictionaryId);
+        if (Type != EArrowValueType::Unsupported)
+        {
+            Layout.ColumnIndex = Columns.Num();
+            FArrowColumn& Column = Columns.AddDefaulted_GetRef();
+            Column.Name = FName(*Field.GetString(0));
+            Column.Type = Type;
+            Column.DictionaryId = DictionaryId;
+            if (DictionaryId != INDEX_NONE)
+            {
+                StringDictionaryIds.Add(DictionaryId);
+            }
+        }
+        Layouts.Add(Layout);
+    }
+
+    // Dictionary batches: each holds one Utf8 column of values, possibly extending an earlier batch (delta)
+    uint32 NumDictionaryBlocks = 0;
+    const uint8* DictionaryBlocks = Footer.GetVector(2, sizeof(FBlock), NumDictionaryBlocks);
+    for (uint32 BlockIndex = 0; BlockIndex < NumDictionaryBlocks; ++BlockIndex)
+    {
+        FMessage Message;
+        const FBlock Block = ReadUnaligned<FBlock>(DictionaryBlocks + static_cast<int64>(BlockIndex) * sizeof(FBlock));
+        if (!ReadMessage(Data, Size, Block, Message) || Message.HeaderType != Header_DictionaryBatch)
+        {
+            return false;
+        }
+
+        const int64 DictionaryId = Message.Header.GetScalar<int64>(0, 0);
+        if (!StringDictionaryIds.Contains(DictionaryId))
+        {
+            continue;
+        }
+
+        FRecordBatchView Batch;
+        FArrowColumnChunk Values;
+        if (!Batch.Init(Message, Message.Header.GetTable(1)) || Batch.NumNodes < 1 || Batch.NumBuffers < 3
+            || !Batch.GetChunk(0, 0, EArrowValueType::Utf8, Values))
+        {
+            return false;
+        }
+
+        TArray<FString>& Dictionary = Dictionaries.FindOrAdd(DictionaryId);
+        if (Message.Header.GetScalar<uint8>(2, 0) == 0)
+        {
+            Dictionary.Reset();
+        }
+        for (int64 Index = 0; Index < Values.Length; ++Index)
+        {
+            Dictionary.Add(Values.IsValid(Index) ? DecodeUtf8(Values, Index) : FString());
+        }
+    }
+
+    // Record batches: one chunk per exposed column per batch
+    uint32 NumBatchBlocks = 0;
+    const uint8* BatchBlocks = Footer.GetVector(3, sizeof(FBlock), NumBatchBlocks);
+    for (uint32 BlockIndex = 0; BlockIndex < NumBatchBlocks; ++BlockIndex)
+    {
+        FMessage Message;
+        FRecordBatchView Batch;
+        const FBlock Block = ReadUnaligned<FBlock>(BatchBlocks + static_cast<int64>(BlockIndex) * sizeof(FBlock));
+        if (!ReadMessage(Data, Size, Block, Message) || Message.HeaderType != Header_RecordBatch || !Batch.Init(Message, Message.Header))
+        {
+            return false;
+        }
+
+        int32 NodeCursor = 0;
+        int32 BufferCursor = 0;
+        for (const FFieldLayout& Layout : Layouts)
+        {
+            if (NodeCursor + Layout.NumNodes > static_cast<int32>(Batch.NumNodes) || BufferCursor + Layout.NumBuffers > static_cast<int32>(Batch.NumBuffers))
+            {
+                return false;
+            }
+
+            if (Layout.ColumnIndex != INDEX_NONE)
+            {
+                FArrowColumn& Column = Columns[Layout.ColumnIndex];
+                FArrowColumnChunk& Chunk = Column.Chunks.AddDefaulted_GetRef();
+                if (!Batch.GetChunk(NodeCursor, BufferCursor, Column.Type, Chunk) || Chunk.Length != Batch.Length)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("ArrowFile - Column '%s' has a missing or truncated buffer"), *Column.Name.ToString());
+                    return false;
+                }
+            }
+            NodeCursor += Layout.NumNodes;
+            BufferCursor += Layout.NumBuffers;
+        }
+        NumRows += Batch.Length;
+    }
+    return true;
+}
+
+TSharedPtr<FChartDataset> FArrowFile::CreateDataset() const
+{
+    if (NumRows > MAX_int32)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ArrowFile - %lld rows exceed the chart dataset limit"), NumRows);
+        return nullptr;
+    }
+
+    TSharedPtr<FChartDataset> Dataset = MakeShared<FChartDataset>();
+    Dataset->NumRows = static_cast<int32>(NumRows);
+    Dataset->ExternalStorage = AsShared();
+    for (const FArrowColumn& Column : Columns)
+    {
+        const bool bString = Column.Type == EArrowValueType::Utf8 || Column.DictionaryId != INDEX_NONE;
+        Dataset->AddColumn(Column.Name, bString ? EChartColumnType::String : EChartColumnType::Float);
+    }
+
+    ParallelFor(Columns.Num(), [this, &Dataset](int32 ColumnIndex)
+    {
+        DecodeColumn(Columns[ColumnIndex], Dataset->Columns[ColumnIndex]);
+    });
+
+    // Only single-batch float32 columns without nulls are views, so say how much of the file was copied after all
+    int32 NumNumeric = 0, NumViewed = 0;
+    for (const FChartColumn& Column : Dataset->Columns)
+    {
+        NumNumeric += Column.Type == EChartColumnType::Float ? 1 : 0;
+        NumViewed += Column.ExternalFloats.Num() > 0 ? 1 : 0;
+    }
+    if (NumViewed < NumNumeric)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ArrowFile - %d of %d numeric columns viewed in place; the others were converted to float (%d record batches; nulls or types other than float32 also need a copy)"),
+            NumViewed, NumNumeric, Columns.Num() > 0 ? Columns[0].Chunks.Num() : 0);
+    }
+    return Dataset;
+}
+
+void FArrowFile::DecodeColumn(const FArrowColumn& Source, FChartColumn& Dest) const
+{
+    if (Dest.Type == EChartColumnType::String)
+    {
+        Dest.Codes.Reserve(static_cast<int32>(NumRows));
+        if (Source.DictionaryId == INDEX_NONE)
+        {
+            for (const FArrowColumnChunk& Chunk : Source.Chunks)
+            {
+                for (int64 Row = 0; Row < Chunk.Length; ++Row)
+                {
+                    AddUtf8(Chunk, Row, Dest);
+                }
+            }
+            return;
+        }
+
+        // A dictionary-encoded field keeps its encoding: file indices are translated into column codes
+        TArray<int32> CodeOfEntry;
+        if (const TArray<FString>* Dictionary = GetDictionary(Source.DictionaryId))
+        {
+            CodeOfEntry.Reserve(Dictionary->Num());
+            for (const FString& Entry : *Dictionary)
+            {
+                CodeOfEntry.Add(Dest.Labels.Add(Entry));
+            }
+        }
+        const int32 MissingCode = Dest.Labels.Add(FStringView());
+        for (const FArrowColumnChunk& Chunk : Source.Chunks)
+        {
+            for (int64 Row = 0; Row < Chunk.Length; ++Row)
+            {
+                const int64 Index = GetIndex(Chunk, Source.Type, Row);
+                Dest.Codes.Add(Index >= 0 && Index < CodeOfEntry.Num() ? CodeOfEntry[static_cast<int32>(Index)] : MissingCode);
+            }
+        }
+        return;
+    }
+
+    // The common case for exported sensor data: no copy at all
+    if (Source.Type == EArrowValueType::Float32 && Source.Chunks.Num() == 1 && !Source.Chunks[0].Validity)
+    {
+        Dest.ExternalFloats = TConstArrayView<float>(Source.Chunks[0].GetValues<float>(), static_cast<int32>(Source.Chunks[0].Length));
+        return;
+    }
+
+    Dest.Floats.SetNumUninitialized(static_cast<int32>(NumRows));
+    float* Out = Dest.Floats.GetData();
+    for (const FArrowColumnChunk& Chunk : Source.Chunks)
+    {
+        switch (Source.Type)
+        {
+        case EArrowValueType::Int8:    ConvertChunk<int8>(Chunk, Out); break;
+        case EArrowValueType::Int16:   ConvertChunk<int16>(Chunk, Out); break;
+        case EArrowValueType::Int32:   ConvertChunk<int32>(Chunk, Out); break;
+        case EArrowValueType::Int64:   ConvertChunk<int64>(Chunk, Out); break;
+        case EArrowValueType::UInt8:   ConvertChunk<uint8>(Chunk, Out); break;
+        case EArrowValueType::UInt16:  ConvertChunk<uint16>(Chunk, Out); break;
+        case EArrowValueType::UInt32:  ConvertChunk<uint32>(Chunk, Out); break;
+        case EArrowValueType::UInt64:  ConvertChunk<uint64>(Chunk, Out); break;
+        case EArrowValueType::Float32: ConvertChunk<float>(Chunk, Out); break;
+        case EArrowValueType::Float64: ConvertChunk<double>(Chunk, Out); break;
+        default: break;
+        }
+        Out += Chunk.Length;
+    }
+}
@@ -0,0 +1,107 @@
+#include "Data/BlockCompressedFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Compression.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+bool DataVizBlockFile::CompressFile(const FString& SourcePath, const FString& DestPath, FName FormatName, int32 BlockSize)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IFileHandle> Source(PlatformFile.OpenRead(*SourcePath));
+    TUniquePtr<IFileHandle> Dest(PlatformFile.OpenWrite(*DestPath));
+    if (!Source || !Dest)
+    {
+        UE_LOG(LogTemp, Error, TEXT("CompressFile - Failed to open %s or %s"), *SourcePath, *DestPath);
+        return false;
+    }
+
+    FHeader Header;
+    FTCHARToUTF8 FormatText(*FormatName.ToString());
+    FMemory::Memcpy(Header.FormatName, FormatText.Get(), FMath::Min<int32>(FormatText.Length(), UE_ARRAY_COUNT(Header.FormatName) - 1));
+    Header.BlockSize = static_cast<uint32>(FMath::Max(BlockSize, 64 * 1024));
+    if (!Dest->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header)))
+    {
+        return false;
+    }
+
+    // One block per worker per batch: read sequentially, compress in parallel, write in order
+    const int32 BatchBlocks = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, 16);
+    const int64 CompressedBound = FCompression::CompressMemoryBound(FormatName, Header.BlockSize);
+    TArray<TArray<uint8>> Raw;
+    TArray<TArray<uint8>> Packed;
+    TArray<FBlockHeader> BlockHeaders;
+    Raw.SetNum(BatchBlocks);
+    Packed.SetNum(BatchBlocks);
+    BlockHeaders.SetNum(BatchBlocks);
+
+    int64 Remaining = Source->Size();
+    int64 TotalCompressed = sizeof(Header);
+    while (Remaining > 0)
+    {
+        int32 NumBlocks = 0;
+        for (; NumBlocks < BatchBlocks && Remaining > 0; ++NumBlocks)
+        {
+            const int64 BytesToRead = FMath::Min<int64>(Header.BlockSize, Remaining);
+            Raw[NumBlocks].SetNumUninitialized(BytesToRead);
+            if (!Source->Read(Raw[NumBlocks].GetData(), BytesToRead))
+            {
+                return false;
+            }
+            Remaining -= BytesToRead;
+        }
+
+        ParallelFor(NumBlocks, [&](int32 Block)
+        {
+            FBlockHeader& BlockHeader = BlockHeaders[Block];
+            BlockHeader.UncompressedSize = Raw[Block].Num();
+            Packed[Block].SetNumUninitialized(CompressedBound);
+            int32 CompressedSize = Packed[Block].Num();
+            if (FCompression::CompressMemory(FormatName, Packed[Block].GetData(), CompressedSize, Raw[Block].GetData(), Raw[Block].Num())
+                && CompressedSize < Raw[Block].Num())
+            {
+                BlockHeader.CompressedSize = CompressedSize;
+            }
+            else
+            {
+                // Incompressible (or codec unavailable): store raw, flagged by equal sizes
+                BlockHeader.CompressedSize = BlockHeader.UncompressedSize;
+                Packed[Block] = Raw[Block];
+            }
+        });
+
+        for (int32 Block = 0; Block < NumBlocks; ++Block)
+        {
+            if (!Dest->Write(reinterpret_cast<const uint8*>(&BlockHeaders[Block]), sizeof(FBlockHeader))
+                || !Dest->Write(Packed[Block].GetData(), BlockHeaders[Block].CompressedSize))
+            {
+                return false;
+            }
+            TotalCompressed += sizeof(FBlockHeader) + BlockHeaders[Block].CompressedSize;
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("CompressFile - %s: %lld -> %lld bytes (%s)"), *DestPath, Source->Size(), TotalCompressed, *FormatName.ToString());
+    return true;
+}
+
+namespace
+{
+    void RunCompressCommand(const TArray<FString>& Args)
+    {
+        if (Args.Num() < 1)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Usage: VRDataViz.CompressCSV <SourcePath> [Oodle|LZ4|Zlib]"));
+            return;
+        }
+
+        const FName FormatName = Args.Num() > 1 ? FName(*Args[1]) : NAME_Oodle;
+        DataVizBlockFile::CompressFile(Args[0], Args[0] + TEXT(".ucz"), FormatName);
+    }
+
+    FAutoConsoleCommand CompressCommand(
+        TEXT("VRDataViz.CompressCSV"),
+        TEXT("Writes <SourcePath>.ucz, a block-compressed copy that loads with parallel decompression. Args: <SourcePath> [Oodle|LZ4|Zlib]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunCompressCommand));
+}
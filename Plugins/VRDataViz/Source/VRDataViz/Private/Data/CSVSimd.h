@@ -0,0 +1,186 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if defined(__AVX2__)
+#define DATAVIZ_CSV_AVX2 1
+#include <immintrin.h>
+#elif PLATFORM_CPU_X86_FAMILY
+#define DATAVIZ_CSV_SSE2 1
+#include <emmintrin.h>
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+#define DATAVIZ_CSV_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifndef DATAVIZ_CSV_AVX2
+#define DATAVIZ_CSV_AVX2 0
+#endif
+#ifndef DATAVIZ_CSV_SSE2
+#define DATAVIZ_CSV_SSE2 0
+#endif
+#ifndef DATAVIZ_CSV_NEON
+#define DATAVIZ_CSV_NEON 0
+#endif
+
+// Internal helpers shared by the CSV readers: classify 64-byte blocks into quote / delimiter / newline
+// bitmasks and walk the structural characters that are outside quoted fields.
+namespace DataVizCSVSimd
+{
+    constexpr int64 BlockSize = 64;
+
+    struct FBlockMasks
+    {
+        uint64 Quotes = 0;
+        uint64 Delimiters = 0;
+        uint64 Newlines = 0;
+    };
+
+#if DATAVIZ_CSV_NEON
+    FORCEINLINE uint64 NeonMoveMask16(uint8x16_t Matches)
+    {
+        static const uint8 BitWeights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        const uint8x16_t Weighted = vandq_u8(Matches, vld1q_u8(BitWeights));
+        return static_cast<uint64>(vaddv_u8(vget_low_u8(Weighted))) | (static_cast<uint64>(vaddv_u8(vget_high_u8(Weighted))) << 8);
+    }
+#endif
+
+    // Block must point at 64 readable bytes
+    FORCEINLINE void ClassifyBlock(const uint8* Block, uint8 Delimiter, FBlockMasks& Out)
+    {
+#if DATAVIZ_CSV_AVX2
+        const __m256i Lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block));
+        const __m256i Hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block + 32));
+        const auto Match = [&Lo, &Hi](__m256i Needle) -> uint64
+        {
+            const uint64 LoBits = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Lo, Needle)));
+            const uint64 HiBits = static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Hi, Needle)));
+            return LoBits | (HiBits << 32);
+        };
+        Out.Quotes = Match(_mm256_set1_epi8('"'));
+        Out.Delimiters = Match(_mm256_set1_epi8(static_cast<char>(Delimiter)));
+        Out.Newlines = Match(_mm256_set1_epi8('\n'));
+#elif DATAVIZ_CSV_SSE2
+        __m128i Lanes[4];
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            Lanes[Lane] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + Lane * 16));
+        }
+        const auto Match = [&Lanes](__m128i Needle) -> uint64
+        {
+            uint64 Bits = 0;
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                Bits |= static_cast<uint64>(static_cast<uint16>(_mm_movemask_epi8(_mm_cmpeq_epi8(Lanes[Lane], Needle)))) << (Lane * 16);
+            }
+            return Bits;
+        };
+        Out.Quotes = Match(_mm_set1_epi8('"'));
+        Out.Delimiters = Match(_mm_set1_epi8(static_cast<char>(Delimiter)));
+        Out.Newlines = Match(_mm_set1_epi8('\n'));
+#elif DATAVIZ_CSV_NEON
+        uint8x16_t Lanes[4];
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            Lanes[Lane] = vld1q_u8(Block + Lane * 16);
+        }
+        const auto Match = [&Lanes](uint8x16_t Needle) -> uint64
+        {
+            uint64 Bits = 0;
+            for (int32 Lane = 0; Lane < 4; ++Lane)
+            {
+                Bits |= NeonMoveMask16(vceqq_u8(Lanes[Lane], Needle)) << (Lane * 16);
+            }
+            return Bits;
+        };
+        Out.Quotes = Match(vdupq_n_u8('"'));
+        Out.Delimiters = Match(vdupq_n_u8(Delimiter));
+        Out.Newlines = Match(vdupq_n_u8('\n'));
+#else
+        Out = FBlockMasks();
+        for (int32 Index = 0; Index < BlockSize; ++Index)
+        {
+            const uint64 Bit = 1ull << Index;
+            const uint8 Char = Block[Index];
+            Out.Quotes |= (Char == '"') ? Bit : 0;
+            Out.Delimiters |= (Char == Delimiter) ? Bit : 0;
+            Out.Newlines |= (Char == '\n') ? Bit : 0;
+        }
+#endif
+    }
+
+    // Bit i of the result is the XOR of bits 0..i: marks every byte after an odd number of quotes
+    FORCEINLINE uint64 PrefixXor(uint64 Bits)
+    {
+        Bits ^= Bits << 1;
+        Bits ^= Bits << 2;
+        Bits ^= Bits << 4;
+        Bits ^= Bits << 8;
+        Bits ^= Bits << 16;
+        Bits ^= Bits << 32;
+        return Bits;
+    }
+
+    // Number of quote characters in [Data, Data + Size); its parity gives the quote state after the range
+    inline int64 CountQuotes(const uint8* Data, int64 Size)
+    {
+        alignas(64) uint8 Tail[BlockSize];
+        int64 Count = 0;
+        for (int64 BlockStart = 0; BlockStart < Size; BlockStart += BlockSize)
+        {
+            const uint8* Block = Data + BlockStart;
+            const int64 Remaining = Size - BlockStart;
+            if (Remaining < BlockSize)
+            {
+                FMemory::Memzero(Tail, BlockSize);
+                FMemory::Memcpy(Tail, Block, Remaining);
+                Block = Tail;
+            }
+
+            FBlockMasks Masks;
+            ClassifyBlock(Block, '"', Masks);
+            Count += FMath::CountBits(Masks.Quotes);
+        }
+        return Count;
+    }
+
+    // Calls Visitor(Offset, bIsNewline) for every delimiter / newline outside quotes in [Data, Data + Size).
+    // bStartInQuotes seeds the quote state. The visitor returns false to stop early.
+    // Returns the offset where scanning stopped (Size when the whole range was visited).
+    template <typename VisitorType>
+    int64 ScanStructural(const uint8* Data, int64 Size, uint8 Delimiter, bool bStartInQuotes, VisitorType&& Visitor)
+    {
+        uint64 QuoteCarry = bStartInQuotes ? ~0ull : 0ull;
+        alignas(64) uint8 Tail[BlockSize];
+
+        for (int64 BlockStart = 0; BlockStart < Size; BlockStart += BlockSize)
+        {
+            const uint8* Block = Data + BlockStart;
+            const int64 Remaining = Size - BlockStart;
+            if (Remaining < BlockSize)
+            {
+                FMemory::Memzero(Tail, BlockSize);
+                FMemory::Memcpy(Tail, Block, Remaining);
+                Block = Tail;
+            }
+
+            FBlockMasks Masks;
+            ClassifyBlock(Block, Delimiter, Masks);
+
+            const uint64 InQuotes = PrefixXor(Masks.Quotes) ^ QuoteCarry;
+            QuoteCarry = 0ull - (InQuotes >> 63);
+
+            uint64 Structural = (Masks.Delimiters | Masks.Newlines) & ~InQuotes;
+            while (Structural)
+            {
+                const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Structural));
+                Structural &= Structural - 1;
+                if (!Visitor(BlockStart + Bit, ((Masks.Newlines >> Bit) & 1ull) != 0))
+                {
+                    return BlockStart + Bit;
+                }
+            }
+        }
+        return Size;
+    }
+}
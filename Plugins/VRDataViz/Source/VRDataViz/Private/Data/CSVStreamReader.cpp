@@ -0,0 +1,125 @@
+#include "Data/CSVStreamReader.h"
+#include "Data/ChartDataset.h"
+#include "Data/DataByteSource.h"
+
+namespace
+{
+    // Type inference reads the first data record, so the schema waits until one newline follows the header
+    bool HasNewline(const uint8* Begin, const uint8* End)
+    {
+        for (const uint8* Char = Begin; Char < End; ++Char)
+        {
+            if (*Char == '\n')
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+FCSVStreamReader::FCSVStreamReader(const FCSVParseOptions& InOptions, int64 InBlockSize)
+    : Options(InOptions)
+    , BlockSize(FMath::Max<int64>(InBlockSize, 64 * 1024))
+{
+}
+
+bool FCSVStreamReader::ReadFile(const FString& FilePath, TArrayView<IChartDatasetSink* const> Sinks) const
+{
+    TUniquePtr<IDataByteSource> Source = DataVizByteSource::OpenFile(FilePath);
+    return Source && ReadSource(*Source, Sinks, FilePath);
+}
+
+bool FCSVStreamReader::ReadSource(IDataByteSource& Source, TArrayView<IChartDatasetSink* const> Sinks, const FString& DebugName) const
+{
+    const FCSVTokenizer Tokenizer(Options);
+    int64 SourceOffset = 0;
+
+    TArray64<uint8> Buffer;
+    Buffer.SetNumUninitialized(BlockSize);
+    int64 Filled = 0;
+
+    FChartDataset Block;
+    FCSVFieldLayout Layout;
+    bool bSchemaRead = false;
+    int64 RowsRead = 0;
+
+    while (true)
+    {
+        if (Options.IsCanceled())
+        {
+            return false;
+        }
+
+        // Top up the buffer behind the partial record carried over from the previous block
+        const int64 BytesToRead = Buffer.Num() - Filled;
+        const int64 BytesRead = Source.Read(Buffer.GetData() + Filled, BytesToRead);
+        if (BytesRead == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Error, TEXT("CSVStreamReader - Read failed at offset %lld: %s"), SourceOffset, *DebugName);
+            return false;
+        }
+        Filled += BytesRead;
+        SourceOffset += BytesRead;
+        const bool bFinal = BytesRead < BytesToRead;
+
+        const TConstArrayView64<uint8> Pending(Buffer.GetData(), Filled);
+        int64 Consumed = 0;
+
+        if (!bSchemaRead)
+        {
+            const int64 DataStart = Tokenizer.ParseSchema(Pending, Block, Layout);
+            if (!bFinal && (DataStart >= Filled || !HasNewline(Buffer.GetData() + DataStart, Buffer.GetData() + Filled)))
+            {
+                Buffer.SetNumUninitialized(Buffer.Num() * 2);
+                continue;
+            }
+            if (Block.Columns.Num() == 0)
+            {
+                UE_LOG(LogTemp, Error, TEXT("CSVStreamReader - No header record found: %s"), *DebugName);
+                return false;
+            }
+
+            for (IChartDatasetSink* Sink : Sinks)
+            {
+                Sink->BeginStream(Block);
+            }
+            Consumed = DataStart;
+            bSchemaRead = true;
+        }
+
+        Block.ResetRows();
+        Consumed += Tokenizer.ParseRecords(Pending.Slice(Consumed, Filled - Consumed), Layout, Block, bFinal);
+        if (Block.NumRows > 0)
+        {
+            for (IChartDatasetSink* Sink : Sinks)
+            {
+                Sink->ConsumeBlock(Block, RowsRead);
+            }
+            RowsRead += Block.NumRows;
+        }
+
+        if (bFinal)
+        {
+            break;
+        }
+
+        // Carry the incomplete trailing record to the front; a record longer than the whole buffer grows it
+        const int64 Remaining = Filled - Consumed;
+        if (Remaining > 0 && Consumed > 0)
+        {
+            FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + Consumed, Remaining);
+        }
+        Filled = Remaining;
+        if (Filled == Buffer.Num())
+        {
+            Buffer.SetNumUninitialized(Buffer.Num() * 2);
+        }
+    }
+
+    for (IChartDatasetSink* Sink : Sinks)
+    {
+        Sink->EndStream(RowsRead);
+    }
+    return true;
+}
@@ -0,0 +1,611 @@
+#include "Data/CSVTokenizer.h"
+#include "Data/ChartDataset.h"
+#include "Data/CSVSimd.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+namespace
+{
+    constexpr int32 MaxMantissaDigits = 19;
+
+    // Records ParseSchema reads to infer column types: a column is text when any of them holds a non-numeric field
+    constexpr int32 MaxSchemaSampleRecords = 1024;
+    constexpr int64 MaxSchemaSampleBytes = 1024 * 1024;
+
+    // Records ParseRecords averages to size its columns; a single short first record would over-reserve every column
+    constexpr int32 ReserveSampleRecords = 16;
+
+    constexpr double ExactPowersOf10[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    constexpr double NegativePowersOf10[] =
+    {
+        1e-0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8, 1e-9, 1e-10, 1e-11,
+        1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18, 1e-19, 1e-20, 1e-21, 1e-22
+    };
+
+    FORCEINLINE bool IsDigit(ANSICHAR Char)
+    {
+        return static_cast<uint8>(Char - '0') <= 9;
+    }
+
+    constexpr uint64 IntegerPowersOf10[] =
+    {
+        1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull
+    };
+
+    // SWAR digit handling: eight characters are loaded as one little-endian uint64 and
+    // converted together, so a typical "123.456789" field takes two steps instead of nine
+    FORCEINLINE uint64 LoadDigitValues(const ANSICHAR* Chars)
+    {
+        uint64 Bytes;
+        FMemory::Memcpy(&Bytes, Chars, sizeof(Bytes));
+        return Bytes ^ 0x3030303030303030ull;
+    }
+
+    // Number of leading bytes of Values that held '0'..'9' (0 to 8)
+    FORCEINLINE int32 CountLeadingDigits(uint64 Values)
+    {
+        const uint64 NonDigits = (((Values & 0x7F7F7F7F7F7F7F7Full) + 0x7676767676767676ull) | Values) & 0x8080808080808080ull;
+        return NonDigits ? static_cast<int32>(FMath::CountTrailingZeros64(NonDigits) >> 3) : 8;
+    }
+
+    // Integer value of the first Count (1 to 8) digits in Values
+    FORCEINLINE uint64 CombineDigits(uint64 Values, int32 Count)
+    {
+        const uint64 Mask = 0x000000FF000000FFull;
+        const uint64 Mul1 = 0x000F424000000064ull; // 100 + (1000000 << 32)
+        const uint64 Mul2 = 0x0000271000000001ull; // 1 + (10000 << 32)
+        Values <<= (8 - Count) * 8;
+        Values = (Values * 10) + (Values >> 8);
+        return (((Values & Mask) * Mul1) + (((Values >> 16) & Mask) * Mul2)) >> 32;
+    }
+
+    // Accumulates the digit run at Char into Mantissa, keeping at most MaxMantissaDigits significant digits.
+    // Bytes up to ReadableEnd may be loaded ahead of End. Returns the number of digits dropped past the limit.
+    FORCEINLINE int32 ReadDigits(const ANSICHAR*& Char, const ANSICHAR* End, const ANSICHAR* ReadableEnd, uint64& Mantissa, int32& SignificantDigits)
+    {
+        while (ReadableEnd - Char >= 8)
+        {
+            const uint64 Values = LoadDigitValues(Char);
+            const int32 Count = static_cast<int32>(FMath::Min<int64>(CountLeadingDigits(Values), End - Char));
+            if (Count == 0 || SignificantDigits + Count > MaxMantissaDigits)
+            {
+                break;
+            }
+            Mantissa = Mantissa * IntegerPowersOf10[Count] + CombineDigits(Values, Count);
+            SignificantDigits += Count;
+            Char += Count;
+            if (Count < 8)
+            {
+                return 0;
+            }
+        }
+
+        int32 DroppedDigits = 0;
+        for (; Char < End && IsDigit(*Char); ++Char)
+        {
+            if (SignificantDigits < MaxMantissaDigits)
+            {
+                Mantissa = Mantissa * 10 + static_cast<uint64>(*Char - '0');
+                ++SignificantDigits;
+            }
+            else
+            {
+                ++DroppedDigits;
+            }
+        }
+        return DroppedDigits;
+    }
+
+    FORCEINLINE bool IsBlank(const uint8* Begin, const uint8* End)
+    {
+        for (const uint8* Char = Begin; Char < End; ++Char)
+        {
+            if (*Char != ' ' && *Char != '\t' && *Char != '\r')
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Passes the field text without the trailing CR, surrounding quotes and with "" collapsed to " to Visit,
+    // converted from UTF-8 into a stack buffer rather than an FString
+    template<typename VisitorType>
+    auto VisitField(const uint8* Begin, const uint8* End, VisitorType&& Visit)
+    {
+        if (End > Begin && End[-1] == '\r')
+        {
+            --End;
+        }
+
+        if (End > Begin && *Begin == '"')
+        {
+            ++Begin;
+            if (End > Begin && End[-1] == '"')
+            {
+                --End;
+            }
+
+            TArray<ANSICHAR, TInlineAllocator<256>> Unescaped;
+            Unescaped.Reserve(static_cast<int32>(End - Begin));
+            for (const uint8* Char = Begin; Char < End; ++Char)
+            {
+                Unescaped.Add(static_cast<ANSICHAR>(*Char));
+                if (*Char == '"' && Char + 1 < End && Char[1] == '"')
+                {
+                    ++Char;
+                }
+            }
+            const FUTF8ToTCHAR Converted(Unescaped.GetData(), Unescaped.Num());
+            return Visit(FStringView(Converted.Get(), Converted.Length()));
+        }
+
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Begin), static_cast<int32>(End - Begin));
+        return Visit(FStringView(Converted.Get(), Converted.Length()));
+    }
+
+    // Field text as a string
+    FString DecodeField(const uint8* Begin, const uint8* End)
+    {
+        return VisitField(Begin, End, [](FStringView Text) { return FString(Text); });
+    }
+
+    // Body of FCSVTokenizer::ParseFloat; ReadableEnd bounds the look-ahead loads of the SWAR digit reader
+    bool ParseDecimal(const ANSICHAR* Begin, const ANSICHAR* End, const ANSICHAR* ReadableEnd, float& OutValue)
+    {
+        while (Begin < End && (*Begin == ' ' || *Begin == '\t' || *Begin == '"'))
+        {
+            ++Begin;
+        }
+        while (End > Begin && (End[-1] == ' ' || End[-1] == '\t' || End[-1] == '\r' || End[-1] == '"'))
+        {
+            --End;
+        }
+        if (Begin == End)
+        {
+            return false;
+        }
+
+        const ANSICHAR* Char = Begin;
+        bool bNegative = false;
+        if (*Char == '-' || *Char == '+')
+        {
+            bNegative = (*Char == '-');
+            ++Char;
+        }
+
+        uint64 Mantissa = 0;
+        int32 Exponent = 0;
+        int32 SignificantDigits = 0;
+
+        // Leading zeros never count towards the 19 significant digits a uint64 can hold
+        const ANSICHAR* IntegerStart = Char;
+        while (Char < End && *Char == '0')
+        {
+            ++Char;
+        }
+        Exponent += ReadDigits(Char, End, ReadableEnd, Mantissa, SignificantDigits);
+        bool bAnyDigit = Char != IntegerStart;
+
+        if (Char < End && *Char == '.')
+        {
+            const ANSICHAR* FractionStart = ++Char;
+            if (SignificantDigits == 0)
+            {
+                while (Char < End && *Char == '0')
+                {
+                    ++Char;
+                    --Exponent;
+                }
+            }
+            const int32 DigitsBefore = SignificantDigits;
+            ReadDigits(Char, End, ReadableEnd, Mantissa, SignificantDigits);
+            Exponent -= SignificantDigits - DigitsBefore;
+            bAnyDigit = bAnyDigit || Char != FractionStart;
+        }
+
+        if (!bAnyDigit)
+        {
+            const int64 Remaining = End - Char;
+            if (Remaining == 3 && FCStringAnsi::Strnicmp(Char, "nan", 3) == 0)
+            {
+                OutValue = NAN;
+                return true;
+            }
+            if ((Remaining == 3 && FCStringAnsi::Strnicmp(Char, "inf", 3) == 0) || (Remaining == 8 && FCStringAnsi::Strnicmp(Char, "infinity", 8) == 0))
+            {
+                OutValue = bNegative ? -INFINITY : INFINITY;
+                return true;
+            }
+            return false;
+        }
+
+        if (Char < End && (*Char == 'e' || *Char == 'E'))
+        {
+            ++Char;
+            bool bNegativeExponent = false;
+            if (Char < End && (*Char == '-' || *Char == '+'))
+            {
+                bNegativeExponent = (*Char == '-');
+                ++Char;
+            }
+            if (Char == End || !IsDigit(*Char))
+            {
+                return false;
+            }
+
+            int32 ExplicitExponent = 0;
+            for (; Char < End && IsDigit(*Char); ++Char)
+            {
+                if (ExplicitExponent < 100000)
+                {
+                    ExplicitExponent = ExplicitExponent * 10 + (*Char - '0');
+                }
+            }
+            Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+        }
+
+        if (Char != End)
+        {
+            return false;
+        }
+
+        double Value = static_cast<double>(Mantissa);
+        if (Mantissa == 0)
+        {
+            Value = 0.0;
+        }
+        else if (Exponent >= -22 && Exponent <= 22 && Mantissa <= (1ull << 53))
+        {
+            // Error stays far below float precision; multiplying by the reciprocal avoids a divide per field
+            Value = Exponent < 0 ? Value * NegativePowersOf10[-Exponent] : Value * ExactPowersOf10[Exponent];
+        }
+        else if (Exponent < -400)
+        {
+            Value = 0.0;
+        }
+        else if (Exponent > 400)
+        {
+            Value = INFINITY;
+        }
+        else
+        {
+            Value *= FMath::Pow(10.0, static_cast<double>(Exponent));
+        }
+
+        OutValue = static_cast<float>(bNegative ? -Value : Value);
+        return true;
+    }
+
+    FORCEINLINE void WriteField(FChartColumn& Column, const uint8* Begin, const uint8* End, const uint8* ReadableEnd)
+    {
+        if (Column.Type == EChartColumnType::Float)
+        {
+            float Value;
+            if (!ParseDecimal(reinterpret_cast<const ANSICHAR*>(Begin), reinterpret_cast<const ANSICHAR*>(End), reinterpret_cast<const ANSICHAR*>(ReadableEnd), Value))
+            {
+                Value = NAN;
+            }
+            Column.Floats.Add(Value);
+        }
+        else
+        {
+            // Repeated labels only cost a lookup; the text is copied into the dictionary the first time it is seen
+            VisitField(Begin, End, [&Column](FStringView Text) { Column.AddString(Text); });
+        }
+    }
+
+    FORCEINLINE void WriteMissing(FChartColumn& Column)
+    {
+        if (Column.Type == EChartColumnType::Float)
+        {
+            Column.Floats.Add(NAN);
+        }
+        else
+        {
+            Column.AddString(FStringView());
+        }
+    }
+
+    // Field boundaries of the first record starting at Offset; returns the offset just past its newline
+    int64 SplitRecord(const uint8* Data, int64 Size, int64 Offset, ANSICHAR Delimiter, TArray<TPair<int64, int64>>& OutFields)
+    {
+        OutFields.Reset();
+        int64 FieldStart = Offset;
+        int64 RecordEnd = Size;
+        DataVizCSVSimd::ScanStructural(Data + Offset, Size - Offset, static_cast<uint8>(Delimiter), false,
+            [&](int64 Position, bool bNewline)
+            {
+                const int64 Absolute = Offset + Position;
+                OutFields.Emplace(FieldStart, Absolute);
+                FieldStart = Absolute + 1;
+                if (bNewline)
+                {
+                    RecordEnd = Absolute + 1;
+                    return false;
+                }
+                return true;
+            });
+
+        if (RecordEnd == Size && FieldStart < Size)
+        {
+            OutFields.Emplace(FieldStart, Size);
+        }
+        return RecordEnd;
+    }
+}
+
+FCSVTokenizer::FCSVTokenizer(const FCSVParseOptions& InOptions)
+    : Options(InOptions)
+{
+}
+
+int64 FCSVTokenizer::ParseSchema(TConstArrayView64<uint8> Bytes, FChartDataset& OutDataset, FCSVFieldLayout& OutLayout) const
+{
+    OutDataset = FChartDataset();
+    OutLayout.FieldColumns.Reset();
+
+    const uint8* Data = Bytes.GetData();
+    const int64 Size = Bytes.Num();
+
+    int64 Offset = 0;
+    if (Size >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF)
+    {
+        Offset = 3;
+    }
+
+    // Skip blank lines before the header
+    while (Offset < Size && (Data[Offset] == '\n' || Data[Offset] == '\r'))
+    {
+        ++Offset;
+    }
+
+    TArray<TPair<int64, int64>> HeaderFields;
+    const int64 DataStart = SplitRecord(Data, Size, Offset, Options.Delimiter, HeaderFields);
+
+    // A blank or numeric first value says little about a column (IDs, "N/A" placeholders), so types come from a sample
+    // of records. A record cut off by the end of Bytes only counts when it is the first one, since a streamed block
+    // may end in the middle of a number.
+    TBitArray<> bTextField(false, HeaderFields.Num());
+    TArray<TPair<int64, int64>> RecordFields;
+    int64 RecordOffset = DataStart;
+    for (int32 NumSampled = 0; NumSampled < MaxSchemaSampleRecords && RecordOffset < Size && RecordOffset - DataStart < MaxSchemaSampleBytes;)
+    {
+        const int64 RecordEnd = SplitRecord(Data, Size, RecordOffset, Options.Delimiter, RecordFields);
+        const bool bComplete = RecordEnd < Size || Data[Size - 1] == '\n';
+        const bool bBlankLine = RecordFields.Num() == 1 && IsBlank(Data + RecordFields[0].Key, Data + RecordFields[0].Value);
+        RecordOffset = RecordEnd;
+        if (bBlankLine || (!bComplete && NumSampled > 0))
+        {
+            continue;
+        }
+        for (int32 FieldIndex = 0; FieldIndex < FMath::Min(RecordFields.Num(), HeaderFields.Num()); ++FieldIndex)
+        {
+            const uint8* Begin = Data + RecordFields[FieldIndex].Key;
+            const uint8* End = Data + RecordFields[FieldIndex].Value;
+            float Unused;
+            if (!bTextField[FieldIndex] && !IsBlank(Begin, End) && !ParseFloat(reinterpret_cast<const ANSICHAR*>(Begin), reinterpret_cast<const ANSICHAR*>(End), Unused))
+            {
+                bTextField[FieldIndex] = true;
+            }
+        }
+        ++NumSampled;
+    }
+
+    for (int32 FieldIndex = 0; FieldIndex < HeaderFields.Num(); ++FieldIndex)
+    {
+        FString Name = DecodeField(Data + HeaderFields[FieldIndex].Key, Data + HeaderFields[FieldIndex].Value).TrimStartAndEnd();
+        if (Name.IsEmpty())
+        {
+            Name = FString::Printf(TEXT("Column%d"), FieldIndex);
+        }
+
+        const FName ColumnName(*Name);
+        if (Options.Columns.Num() > 0)
+        {
+            if (!Options.Columns.Contains(ColumnName))
+            {
+                OutLayout.FieldColumns.Add(INDEX_NONE);
+                continue;
+            }
+            OutLayout.FieldColumns.Add(OutDataset.Columns.Num());
+        }
+
+        EChartColumnType Type = bTextField[FieldIndex] ? EChartColumnType::String : EChartColumnType::Float;
+        if (const EChartColumnType* ForcedType = Options.ColumnTypes.Find(ColumnName))
+        {
+            Type = *ForcedType;
+        }
+        else if (Options.DefaultColumnType.IsSet())
+        {
+            Type = Options.DefaultColumnType.GetValue();
+        }
+        OutDataset.AddColumn(ColumnName, Type);
+    }
+
+    return DataStart;
+}
+
+int64 FCSVTokenizer::ParseRecords(TConstArrayView64<uint8> Bytes, const FCSVFieldLayout& Layout, FChartDataset& OutDataset, bool bFinal) const
+{
+    const int32 NumColumns = OutDataset.Columns.Num();
+    if (NumColumns == 0)
+    {
+        return 0;
+    }
+
+    const uint8* Data = Bytes.GetData();
+    const int64 Size = Bytes.Num();
+    FChartColumn* Columns = OutDataset.Columns.GetData();
+
+    // Projected columns keep file order, so the columns written so far are always a prefix
+    const TArray<int32>& FieldColumns = Layout.FieldColumns;
+    const bool bProjected = FieldColumns.Num() > 0;
+    const int32 NumFields = bProjected ? FieldColumns.Num() : NumColumns;
+
+    int64 FieldStart = 0;
+    int64 RecordStart = 0;
+    int32 FieldIndex = 0;
+    int32 NumWritten = 0;
+    const int32 FirstRow = OutDataset.NumRows;
+    bool bReserved = false;
+
+    // Labels of each text column before the current record, so rolling the record back drops the ones it added
+    TArray<int32> TextColumns;
+    TArray<int32> RecordNumLabels;
+    RecordNumLabels.SetNumZeroed(NumColumns);
+    for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
+    {
+        if (Columns[ColumnIndex].Type == EChartColumnType::String)
+        {
+            TextColumns.Add(ColumnIndex);
+            RecordNumLabels[ColumnIndex] = Columns[ColumnIndex].Labels.Num();
+        }
+    }
+
+    const auto AddField = [&](int64 End)
+    {
+        if (FieldIndex < NumFields)
+        {
+            const int32 ColumnIndex = bProjected ? FieldColumns[FieldIndex] : FieldIndex;
+            if (ColumnIndex != INDEX_NONE)
+            {
+                WriteField(Columns[ColumnIndex], Data + FieldStart, Data + End, Data + Size);
+                ++NumWritten;
+            }
+        }
+        ++FieldIndex;
+    };
+
+    const auto EndRecord = [&]()
+    {
+        for (; NumWritten < NumColumns; ++NumWritten)
+        {
+            WriteMissing(Columns[NumWritten]);
+        }
+        FieldIndex = 0;
+        NumWritten = 0;
+        ++OutDataset.NumRows;
+        for (const int32 ColumnIndex : TextColumns)
+        {
+            RecordNumLabels[ColumnIndex] = Columns[ColumnIndex].Labels.Num();
+        }
+    };
+
+    DataVizCSVSimd::ScanStructural(Data, Size, static_cast<uint8>(Options.Delimiter), false,
+        [&](int64 Position, bool bNewline)
+        {
+            if (bNewline && FieldIndex == 0 && IsBlank(Data + FieldStart, Data + Position))
+            {
+                // Blank line between records
+                RecordStart = FieldStart = Position + 1;
+                return true;
+            }
+
+            AddField(Position);
+            FieldStart = Position + 1;
+
+            if (bNewline)
+            {
+                EndRecord();
+                RecordStart = FieldStart;
+                if (!bReserved && OutDataset.NumRows - FirstRow == ReserveSampleRecords)
+                {
+                    // Size the columns once from the average length of the first records instead of growing them
+                    // repeatedly. No record is shorter than two bytes, which bounds the estimate.
+                    const int64 EstimatedRows = FMath::Min(Size * ReserveSampleRecords / (Position + 1), Size / 2) + 1;
+                    OutDataset.ReserveRows(FirstRow + static_cast<int32>(FMath::Min<int64>(EstimatedRows, MAX_int32 - FirstRow)));
+                    bReserved = true;
+                }
+            }
+            return true;
+        });
+
+    if (RecordStart < Size)
+    {
+        if (bFinal)
+        {
+            if (!(FieldIndex == 0 && IsBlank(Data + FieldStart, Data + Size)))
+            {
+                AddField(Size);
+                EndRecord();
+            }
+            RecordStart = Size;
+        }
+        else
+        {
+            // Roll back the fields of the incomplete trailing record
+            OutDataset.TrimToNumRows(RecordNumLabels);
+        }
+    }
+
+    return RecordStart;
+}
+
+int64 FCSVTokenizer::ParseRecordsParallel(TConstArrayView64<uint8> Bytes, const FCSVFieldLayout& Layout, FChartDataset& OutDataset) const
+{
+    const uint8* Data = Bytes.GetData();
+    const int64 Size = Bytes.Num();
+
+    const int32 MaxChunks = Options.MaxParallelChunks > 0 ? Options.MaxParallelChunks : FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+    const int32 NumChunks = static_cast<int32>(FMath::Clamp<int64>(Size / FMath::Max<int64>(Options.MinParallelChunkBytes, 1), 1, MaxChunks));
+    if (NumChunks <= 1 || OutDataset.Columns.Num() == 0)
+    {
+        return ParseRecords(Bytes, Layout, OutDataset, true);
+    }
+
+    const int64 NominalChunkSize = Size / NumChunks;
+    const auto NominalStart = [NominalChunkSize](int32 Chunk) { return Chunk * NominalChunkSize; };
+
+    // Quote parity of each nominal range, so the quote state at every cut is known without a serial pass
+    TArray<uint8> QuoteParity;
+    QuoteParity.SetNumZeroed(NumChunks);
+    ParallelFor(NumChunks, [&](int32 Chunk)
+    {
+        const int64 Start = NominalStart(Chunk);
+        const int64 End = Chunk == NumChunks - 1 ? Size : NominalStart(Chunk + 1);
+        QuoteParity[Chunk] = static_cast<uint8>(DataVizCSVSimd::CountQuotes(Data + Start, End - Start) & 1);
+    });
+
+    // Move each cut just past the first newline outside quotes at or after its nominal offset
+    TArray<int64> Cuts;
+    Cuts.SetNumZeroed(NumChunks + 1);
+    Cuts[NumChunks] = Size;
+    bool bInQuotes = false;
+    for (int32 Chunk = 1; Chunk < NumChunks; ++Chunk)
+    {
+        bInQuotes = bInQuotes != (QuoteParity[Chunk - 1] != 0);
+        const int64 Start = NominalStart(Chunk);
+        const int64 NewlineOffset = DataVizCSVSimd::ScanStructural(Data + Start, Size - Start, static_cast<uint8>(Options.Delimiter), bInQuotes,
+            [](int64, bool bNewline) { return !bNewline; });
+        Cuts[Chunk] = FMath::Max(Cuts[Chunk - 1], FMath::Min(Start + NewlineOffset + 1, Size));
+    }
+
+    TArray<FChartDataset> Parts;
+    Parts.SetNum(NumChunks);
+    for (FChartDataset& Part : Parts)
+    {
+        Part.CopySchemaFrom(OutDataset);
+    }
+
+    ParallelFor(NumChunks, [&](int32 Chunk)
+    {
+        if (Cuts[Chunk + 1] > Cuts[Chunk] && !Options.IsCanceled())
+        {
+            ParseRecords(Bytes.Slice(Cuts[Chunk], Cuts[Chunk + 1] - Cuts[Chunk]), Layout, Parts[Chunk], true);
+        }
+    });
+
+    OutDataset.AppendRows(Parts);
+    return Size;
+}
+
+bool FCSVTokenizer::ParseFloat(const ANSICHAR* Begin, const ANSICHAR* End, float& OutValue)
+{
+    return ParseDecimal(Begin, End, End, OutValue);
+}
@@ -0,0 +1,341 @@
+#include "Data/ChartAggregation.h"
+#include "Data/ChartDataset.h"
+#include "Data/CSVTokenizer.h"
+#include "Charts/BarChartActor.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    // Rows one worker folds into its own table of groups
+    constexpr int32 BlockRows = 64 * 1024;
+
+    struct FGroup
+    {
+        double Sum = 0.0;
+        int64 Count = 0;
+        float Min = TNumericLimits<float>::Max();
+        float Max = TNumericLimits<float>::Lowest();
+        // Earliest row of the group, which the key labels are read from
+        int32 FirstRow = INDEX_NONE;
+
+        void Merge(const FGroup& Other)
+        {
+            Sum += Other.Sum;
+            Count += Other.Count;
+            Min = FMath::Min(Min, Other.Min);
+            Max = FMath::Max(Max, Other.Max);
+        }
+    };
+
+    // Groups of one block, keyed by the X key in the high and the Y key in the low 32 bits. Groups live in an array
+    // so that runs of rows with the same key skip the hash lookup.
+    struct FGroupTable
+    {
+        TMap<uint64, int32> IndexOfKey;
+        TArray<uint64> Keys;
+        TArray<FGroup> Groups;
+
+        int32 FindOrAdd(uint64 Key)
+        {
+            int32& Index = IndexOfKey.FindOrAdd(Key, INDEX_NONE);
+            if (Index == INDEX_NONE)
+            {
+                Index = Groups.AddDefaulted();
+                Keys.Add(Key);
+            }
+            return Index;
+        }
+    };
+
+    uint32 KeyOfFloat(float Value)
+    {
+        // -0 and 0 are one group
+        const float Normalized = Value == 0.0f ? 0.0f : Value;
+        uint32 Bits;
+        FMemory::Memcpy(&Bits, &Normalized, sizeof(Bits));
+        return Bits;
+    }
+
+    float FloatOfKey(uint32 Key)
+    {
+        float Value;
+        FMemory::Memcpy(&Value, &Key, sizeof(Value));
+        return Value;
+    }
+
+    // A group key column: text columns group by dictionary code, numeric ones by value
+    struct FKeyReader
+    {
+        const FChartColumn* Column = nullptr;
+        TConstArrayView<float> Floats;
+
+        explicit FKeyReader(const FChartColumn* InColumn)
+            : Column(InColumn)
+        {
+            if (Column && Column->Type == EChartColumnType::Float)
+            {
+                Floats = Column->GetFloats();
+            }
+        }
+
+        // False for a missing value. Without a column every row has key 0.
+        bool Read(int32 Row, uint32& OutKey) const
+        {
+            if (!Column)
+            {
+                OutKey = 0;
+                return true;
+            }
+            if (Column->Type == EChartColumnType::String)
+            {
+                // An empty label is a missing value, as in filters
+                OutKey = static_cast<uint32>(Column->Codes[Row]);
+                return !Column->GetLabel(Row).IsEmpty();
+            }
+            const float Value = Floats[Row];
+            OutKey = KeyOfFloat(Value);
+            return !FMath::IsNaN(Value);
+        }
+
+        bool IsKeyLess(uint32 A, uint32 B) const
+        {
+            if (Column->Type == EChartColumnType::Float)
+            {
+                return FloatOfKey(A) < FloatOfKey(B);
+            }
+            const FString& LabelA = Column->Labels[A];
+            const FString& LabelB = Column->Labels[B];
+            const int32 Order = LabelA.Compare(LabelB, ESearchCase::IgnoreCase);
+            return Order != 0 ? Order < 0 : LabelA.Compare(LabelB, ESearchCase::CaseSensitive) < 0;
+        }
+    };
+
+    // Numbers of a value column; text columns are parsed once per distinct label
+    struct FValueReader
+    {
+        TConstArrayView<float> Floats;
+        const int32* Codes = nullptr;
+        TArray<float> LabelValues;
+
+        explicit FValueReader(const FChartColumn& Column)
+        {
+            if (Column.Type == EChartColumnType::Float)
+            {
+                Floats = Column.GetFloats();
+                return;
+            }
+            Codes = Column.Codes.GetData();
+            LabelValues.Init(NAN, Column.Labels.Num());
+            for (int32 Code = 0; Code < LabelValues.Num(); ++Code)
+            {
+                const FTCHARToUTF8 Utf8(*Column.Labels[Code]);
+                FCSVTokenizer::ParseFloat(Utf8.Get(), Utf8.Get() + Utf8.Length(), LabelValues[Code]);
+            }
+        }
+
+        float Read(int32 Row) const { return Codes ? LabelValues[Codes[Row]] : Floats[Row]; }
+    };
+
+    // Sorted distinct keys of one axis and the index each key gets
+    struct FAxisKeys
+    {
+        TArray<uint32> Keys;
+        TMap<uint32, int32> IndexOfKey;
+        // Label of each index, read from the first row holding the key
+        TArray<FString> Labels;
+
+        void Build(const FKeyReader& Reader, const FGroupTable& Table, int32 KeyShift)
+        {
+            TMap<uint32, int32> FirstRowOfKey;
+            for (int32 GroupIndex = 0; GroupIndex < Table.Groups.Num(); ++GroupIndex)
+            {
+                const uint32 Key = static_cast<uint32>(Table.Keys[GroupIndex] >> KeyShift);
+                int32& FirstRow = FirstRowOfKey.FindOrAdd(Key, MAX_int32);
+                FirstRow = FMath::Min(FirstRow, Table.Groups[GroupIndex].FirstRow);
+            }
+
+            for (const TPair<uint32, int32>& Pair : FirstRowOfKey)
+            {
+                Keys.Add(Pair.Key);
+            }
+            if (Reader.Column)
+            {
+                Keys.Sort([&Reader](uint32 A, uint32 B) { return Reader.IsKeyLess(A, B); });
+            }
+
+            Labels.Reserve(Keys.Num());
+            for (int32 Index = 0; Index < Keys.Num(); ++Index)
+            {
+                IndexOfKey.Add(Keys[Index], Index);
+                const int32 Row = FirstRowOfKey.FindChecked(Keys[Index]);
+                Labels.Add(!Reader.Column ? FString()
+                    : Reader.Column->Type == EChartColumnType::String ? Reader.Column->GetLabel(Row) : Reader.Column->GetString(Row));
+            }
+        }
+    };
+}
+
+bool FChartAggregation::GroupBy(const FChartDataset& Dataset, const FChartGroupBy& GroupBy, TArray<FVRBarData>& OutBars, FString& OutError, TArray<int32>* OutBarOfRow)
+{
+    OutBars.Reset();
+    if (OutBarOfRow)
+    {
+        OutBarOfRow->Reset();
+    }
+
+    const FChartColumn* XColumn = Dataset.GetColumn(GroupBy.XColumn);
+    const FChartColumn* YColumn = GroupBy.YColumn.IsNone() ? nullptr : Dataset.GetColumn(GroupBy.YColumn);
+    const FChartColumn* ValueColumn = GroupBy.ValueColumn.IsNone() ? nullptr : Dataset.GetColumn(GroupBy.ValueColumn);
+    if (!XColumn)
+    {
+        OutError = FString::Printf(TEXT("No column '%s' to group by"), *GroupBy.XColumn.ToString());
+        return false;
+    }
+    if (!GroupBy.YColumn.IsNone() && !YColumn)
+    {
+        OutError = FString::Printf(TEXT("No column '%s' to group by"), *GroupBy.YColumn.ToString());
+        return false;
+    }
+    if (!ValueColumn && (!GroupBy.ValueColumn.IsNone() || GroupBy.Aggregate != EChartAggregate::Count))
+    {
+        OutError = GroupBy.ValueColumn.IsNone() ? FString(TEXT("Only Count can aggregate without a value column"))
+            : FString::Printf(TEXT("No column '%s' to aggregate"), *GroupBy.ValueColumn.ToString());
+        return false;
+    }
+
+    const FKeyReader XReader(XColumn);
+    const FKeyReader YReader(YColumn);
+    const TOptional<FValueReader> ValueReader = ValueColumn ? TOptional<FValueReader>(FValueReader(*ValueColumn)) : TOptional<FValueReader>();
+
+    // Rows first note their group within their block; that becomes their bar once the groups are merged and sorted
+    if (OutBarOfRow)
+    {
+        OutBarOfRow->Init(INDEX_NONE, Dataset.NumRows);
+    }
+    int32* GroupOfRow = OutBarOfRow ? OutBarOfRow->GetData() : nullptr;
+
+    const int32 NumBlocks = FMath::DivideAndRoundUp(Dataset.NumRows, BlockRows);
+    TArray<FGroupTable> BlockTables;
+    BlockTables.SetNum(FMath::Max(NumBlocks, 1));
+    ParallelFor(NumBlocks, [&](int32 Block)
+    {
+        FGroupTable& Table = BlockTables[Block];
+        const int32 EndRow = FMath::Min(Dataset.NumRows, (Block + 1) * BlockRows);
+        uint64 LastKey = 0;
+        int32 LastGroup = INDEX_NONE;
+        for (int32 Row = Block * BlockRows; Row < EndRow; ++Row)
+        {
+            uint32 XKey, YKey;
+            if (!XReader.Read(Row, XKey) || !YReader.Read(Row, YKey))
+            {
+                continue;
+            }
+            const float Value = ValueReader.IsSet() ? ValueReader->Read(Row) : 0.0f;
+            if (FMath::IsNaN(Value))
+            {
+                continue;
+            }
+
+            const uint64 Key = (static_cast<uint64>(XKey) << 32) | YKey;
+            if (LastGroup == INDEX_NONE || Key != LastKey)
+            {
+                LastKey = Key;
+                LastGroup = Table.FindOrAdd(Key);
+            }
+            if (GroupOfRow)
+            {
+                GroupOfRow[Row] = LastGroup;
+            }
+            FGroup& Group = Table.Groups[LastGroup];
+            Group.FirstRow = Group.FirstRow == INDEX_NONE ? Row : Group.FirstRow;
+            Group.Sum += Value;
+            Group.Count++;
+            Group.Min = FMath::Min(Group.Min, Value);
+            Group.Max = FMath::Max(Group.Max, Value);
+        }
+    });
+
+    // Later blocks only add rows after the ones already merged, so each group keeps its earliest row
+    FGroupTable Table = MoveTemp(BlockTables[0]);
+    TArray<TArray<int32>> MergedGroupOfBlockGroup;
+    MergedGroupOfBlockGroup.SetNum(BlockTables.Num());
+    for (int32 Block = 1; Block < BlockTables.Num(); ++Block)
+    {
+        const FGroupTable& BlockTable = BlockTables[Block];
+        MergedGroupOfBlockGroup[Block].SetNumUninitialized(BlockTable.Groups.Num());
+        for (int32 GroupIndex = 0; GroupIndex < BlockTable.Groups.Num(); ++GroupIndex)
+        {
+            const int32 MergedIndex = Table.FindOrAdd(BlockTable.Keys[GroupIndex]);
+            MergedGroupOfBlockGroup[Block][GroupIndex] = MergedIndex;
+            FGroup& Group = Table.Groups[MergedIndex];
+            if (Group.FirstRow == INDEX_NONE)
+            {
+                Group = BlockTable.Groups[GroupIndex];
+            }
+            else
+            {
+                Group.Merge(BlockTable.Groups[GroupIndex]);
+            }
+        }
+    }
+
+    FAxisKeys XKeys, YKeys;
+    XKeys.Build(XReader, Table, 32);
+    YKeys.Build(YReader, Table, 0);
+
+    // Groups are numbered in bar order, (XIndex, YIndex), and the bars written in that order
+    TArray<FIntPoint> CellOfGroup;
+    TArray<int32> GroupOfBar;
+    CellOfGroup.SetNumUninitialized(Table.Groups.Num());
+    GroupOfBar.SetNumUninitialized(Table.Groups.Num());
+    for (int32 GroupIndex = 0; GroupIndex < Table.Groups.Num(); ++GroupIndex)
+    {
+        CellOfGroup[GroupIndex] = FIntPoint(XKeys.IndexOfKey.FindChecked(static_cast<uint32>(Table.Keys[GroupIndex] >> 32)),
+            YKeys.IndexOfKey.FindChecked(static_cast<uint32>(Table.Keys[GroupIndex])));
+        GroupOfBar[GroupIndex] = GroupIndex;
+    }
+    GroupOfBar.Sort([&CellOfGroup](int32 A, int32 B)
+    {
+        return CellOfGroup[A].X != CellOfGroup[B].X ? CellOfGroup[A].X < CellOfGroup[B].X : CellOfGroup[A].Y < CellOfGroup[B].Y;
+    });
+
+    OutBars.SetNum(Table.Groups.Num());
+    TArray<int32> BarOfGroup;
+    BarOfGroup.SetNumUninitialized(Table.Groups.Num());
+    for (int32 BarIndex = 0; BarIndex < GroupOfBar.Num(); ++BarIndex)
+    {
+        const int32 GroupIndex = GroupOfBar[BarIndex];
+        BarOfGroup[GroupIndex] = BarIndex;
+        const FGroup& Group = Table.Groups[GroupIndex];
+        FVRBarData& Bar = OutBars[BarIndex];
+        Bar.XIndex = CellOfGroup[GroupIndex].X;
+        Bar.YIndex = CellOfGroup[GroupIndex].Y;
+        Bar.XLabel = XKeys.Labels[Bar.XIndex];
+        Bar.YLabel = YKeys.Labels[Bar.YIndex];
+        switch (GroupBy.Aggregate)
+        {
+        case EChartAggregate::Sum: Bar.Value = static_cast<float>(Group.Sum); break;
+        case EChartAggregate::Mean: Bar.Value = static_cast<float>(Group.Sum / Group.Count); break;
+        case EChartAggregate::Count: Bar.Value = static_cast<float>(Group.Count); break;
+        case EChartAggregate::Min: Bar.Value = Group.Min; break;
+        case EChartAggregate::Max: Bar.Value = Group.Max; break;
+        }
+    }
+
+    if (GroupOfRow)
+    {
+        ParallelFor(NumBlocks, [&](int32 Block)
+        {
+            const TArray<int32>& MergedGroup = MergedGroupOfBlockGroup[Block];
+            const int32 EndRow = FMath::Min(Dataset.NumRows, (Block + 1) * BlockRows);
+            for (int32 Row = Block * BlockRows; Row < EndRow; ++Row)
+            {
+                if (GroupOfRow[Row] != INDEX_NONE)
+                {
+                    GroupOfRow[Row] = BarOfGroup[Block == 0 ? GroupOfRow[Row] : MergedGroup[GroupOfRow[Row]]];
+                }
+            }
+        });
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+#include "Data/ChartColumnMapping.h"
+#include "Data/ChartDataset.h"
+
+namespace
+{
+    struct FRoleColumn
+    {
+        FName Target;
+        FName Source;
+    };
+
+    // Chart column of each role and the file column that feeds it; roles left unset read the chart's own column name
+    TArray<FRoleColumn> GetRoles(const FChartColumnMapping& Mapping, EChartType ChartType)
+    {
+        TArray<FRoleColumn> Roles;
+        const auto Add = [&Roles](const TCHAR* Target, FName Source = NAME_None)
+        {
+            Roles.Add({ FName(Target), Source.IsNone() ? FName(Target) : Source });
+        };
+
+        switch (ChartType)
+        {
+        case EChartType::Bar:
+            Add(TEXT("XIndex"), Mapping.X);
+            Add(TEXT("YIndex"), Mapping.Y);
+            Add(TEXT("Value"), Mapping.Value);
+            Add(TEXT("XLabel"));
+            Add(TEXT("YLabel"));
+            break;
+        case EChartType::Line:
+            Add(TEXT("X"), Mapping.X);
+            Add(TEXT("Y"), Mapping.Y);
+            Add(TEXT("Z"), Mapping.Z);
+            break;
+        case EChartType::Scatter:
+            Add(TEXT("X"), Mapping.X);
+            Add(TEXT("Y"), Mapping.Y);
+            Add(TEXT("Z"), Mapping.Z);
+            Add(TEXT("Color"), Mapping.Color);
+            Add(TEXT("Size"), Mapping.Size);
+            Add(TEXT("R"));
+            Add(TEXT("G"));
+            Add(TEXT("B"));
+            Add(TEXT("Intensity"));
+            break;
+        }
+        return Roles;
+    }
+
+    // A text column on a bar axis: categories numbered in order of first appearance, labelled with their text.
+    // Grouping works on the column's dictionary codes; no label is compared or copied.
+    void AddCategories(const FChartColumn& Source, FName IndexName, FName LabelName, FChartDataset& OutDataset)
+    {
+        TArray<int32> CategoryOfCode;
+        CategoryOfCode.Init(INDEX_NONE, Source.Labels.Num());
+        int32 NumCategories = 0;
+        FChartColumn& Index = OutDataset.AddColumn(IndexName, EChartColumnType::Float);
+        Index.Floats.Reserve(Source.Codes.Num());
+        for (const int32 Code : Source.Codes)
+        {
+            int32& Category = CategoryOfCode[Code];
+            Category = Category != INDEX_NONE ? Category : NumCategories++;
+            Index.Floats.Add(static_cast<float>(Category));
+        }
+
+        FChartColumn& Labels = OutDataset.Columns.Add_GetRef(Source);
+        Labels.Name = LabelName;
+    }
+}
+
+bool FChartColumnMapping::IsSet() const
+{
+    return !X.IsNone() || !Y.IsNone() || !Z.IsNone() || !Value.IsNone() || !Color.IsNone() || !Size.IsNone();
+}
+
+TArray<FName> FChartColumnMapping::GetSourceColumns(EChartType ChartType) const
+{
+    TArray<FName> Columns;
+    if (IsSet())
+    {
+        for (const FRoleColumn& Role : GetRoles(*this, ChartType))
+        {
+            Columns.AddUnique(Role.Source);
+        }
+    }
+    return Columns;
+}
+
+TSharedPtr<const FChartDataset> FChartColumnMapping::Apply(const TSharedPtr<const FChartDataset>& Source, EChartType ChartType) const
+{
+    if (!Source.IsValid() || !IsSet())
+    {
+        return Source;
+    }
+
+    const FName XIndexName(TEXT("XIndex"));
+    const FName YIndexName(TEXT("YIndex"));
+    const TSharedRef<FChartDataset> Mapped = MakeShared<FChartDataset>();
+    Mapped->NumRows = Source->NumRows;
+    Mapped->ExternalStorage = Source->ExternalStorage;
+
+    for (const FRoleColumn& Role : GetRoles(*this, ChartType))
+    {
+        // A category axis already wrote its label column
+        if (Mapped->FindColumn(Role.Target) != INDEX_NONE)
+        {
+            continue;
+        }
+
+        const FChartColumn* Column = Source->GetColumn(Role.Source);
+        if (!Column)
+        {
+            if (Role.Source != Role.Target)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ChartColumnMapping - Column %s mapped to %s is not in the dataset"), *Role.Source.ToString(), *Role.Target.ToString());
+            }
+            continue;
+        }
+
+        if (ChartType == EChartType::Bar && Column->Type == EChartColumnType::String && (Role.Target == XIndexName || Role.Target == YIndexName))
+        {
+            AddCategories(*Column, Role.Target, Role.Target == XIndexName ? FName(TEXT("XLabel")) : FName(TEXT("YLabel")), *Mapped);
+            continue;
+        }
+
+        FChartColumn& Copy = Mapped->Columns.Add_GetRef(*Column);
+        Copy.Name = Role.Target;
+    }
+    return Mapped;
+}
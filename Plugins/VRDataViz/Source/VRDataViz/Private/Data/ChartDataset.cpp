@@ -0,0 +1,389 @@
+#include "Data/ChartDataset.h"
+#include "Data/CSVTokenizer.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+    // Copies viewed values into the column's own array before rows are appended to it
+    void MaterializeFloats(FChartColumn& Column)
+    {
+        if (Column.ExternalFloats.Num() > 0)
+        {
+            Column.Floats.Reset(Column.ExternalFloats.Num());
+            Column.Floats.Append(Column.ExternalFloats.GetData(), Column.ExternalFloats.Num());
+            Column.ExternalFloats = TConstArrayView<float>();
+        }
+    }
+
+    uint32 HashLabel(FStringView Value)
+    {
+        return FCrc::MemCrc32(Value.GetData(), Value.Len() * sizeof(TCHAR));
+    }
+}
+
+int32 FChartLabelDictionary::Add(FStringView Value)
+{
+    if ((Values.Num() + 1) * 2 > Buckets.Num())
+    {
+        Grow();
+    }
+
+    const uint32 Hash = HashLabel(Value);
+    const int32 Slot = FindSlot(Value, Hash);
+    if (Buckets[Slot] == INDEX_NONE)
+    {
+        Buckets[Slot] = Values.Num();
+        Values.Emplace(Value);
+        Hashes.Add(Hash);
+    }
+    return Buckets[Slot];
+}
+
+int32 FChartLabelDictionary::Find(FStringView Value) const
+{
+    return Buckets.Num() > 0 ? Buckets[FindSlot(Value, HashLabel(Value))] : INDEX_NONE;
+}
+
+void FChartLabelDictionary::Reset()
+{
+    Values.Reset();
+    Hashes.Reset();
+    Buckets.Reset();
+}
+
+void FChartLabelDictionary::TrimTo(int32 NumValues)
+{
+    if (NumValues >= Values.Num())
+    {
+        return;
+    }
+    Values.SetNum(NumValues);
+    Hashes.SetNum(NumValues);
+    Rehash(Buckets.Num());
+}
+
+SIZE_T FChartLabelDictionary::GetAllocatedSize() const
+{
+    SIZE_T Bytes = Values.GetAllocatedSize() + Hashes.GetAllocatedSize() + Buckets.GetAllocatedSize();
+    for (const FString& Value : Values)
+    {
+        Bytes += Value.GetAllocatedSize();
+    }
+    return Bytes;
+}
+
+int32 FChartLabelDictionary::FindSlot(FStringView Value, uint32 Hash) const
+{
+    const int32 Mask = Buckets.Num() - 1;
+    for (int32 Slot = static_cast<int32>(Hash) & Mask;; Slot = (Slot + 1) & Mask)
+    {
+        const int32 Code = Buckets[Slot];
+        if (Code == INDEX_NONE || (Hashes[Code] == Hash && Value.Equals(Values[Code], ESearchCase::CaseSensitive)))
+        {
+            return Slot;
+        }
+    }
+}
+
+void FChartLabelDictionary::Grow()
+{
+    Rehash(FMath::Max(16, Buckets.Num() * 2));
+}
+
+void FChartLabelDictionary::Rehash(int32 NumBuckets)
+{
+    Buckets.Init(INDEX_NONE, NumBuckets);
+    const int32 Mask = Buckets.Num() - 1;
+    for (int32 Code = 0; Code < Values.Num(); ++Code)
+    {
+        int32 Slot = static_cast<int32>(Hashes[Code]) & Mask;
+        while (Buckets[Slot] != INDEX_NONE)
+        {
+            Slot = (Slot + 1) & Mask;
+        }
+        Buckets[Slot] = Code;
+    }
+}
+
+void FChartColumn::AppendValues(const FChartColumn& Source)
+{
+    if (Type == EChartColumnType::Float)
+    {
+        MaterializeFloats(*this);
+        Floats.Append(Source.GetFloats().GetData(), Source.GetFloats().Num());
+        return;
+    }
+
+    // Only labels that rows of Source use are added, each once
+    TArray<int32> CodeMap;
+    CodeMap.Init(INDEX_NONE, Source.Labels.Num());
+    Codes.Reserve(Codes.Num() + Source.Codes.Num());
+    for (const int32 SourceCode : Source.Codes)
+    {
+        int32& Code = CodeMap[SourceCode];
+        if (Code == INDEX_NONE)
+        {
+            Code = Labels.Add(Source.Labels[SourceCode]);
+        }
+        Codes.Add(Code);
+    }
+}
+
+float FChartColumn::GetFloat(int32 Row) const
+{
+    if (Type == EChartColumnType::Float)
+    {
+        const TConstArrayView<float> Values = GetFloats();
+        return Values.IsValidIndex(Row) ? Values[Row] : NAN;
+    }
+
+    if (!Codes.IsValidIndex(Row))
+    {
+        return NAN;
+    }
+
+    const FTCHARToUTF8 Utf8(*GetLabel(Row));
+    float Value = NAN;
+    FCSVTokenizer::ParseFloat(Utf8.Get(), Utf8.Get() + Utf8.Length(), Value);
+    return Value;
+}
+
+FString FChartColumn::GetString(int32 Row) const
+{
+    if (Type == EChartColumnType::String)
+    {
+        return Codes.IsValidIndex(Row) ? GetLabel(Row) : FString();
+    }
+    const TConstArrayView<float> Values = GetFloats();
+    return Values.IsValidIndex(Row) ? FString::SanitizeFloat(Values[Row], 0) : FString();
+}
+
+int32 FChartDataset::FindColumn(FName ColumnName) const
+{
+    return Columns.IndexOfByPredicate([ColumnName](const FChartColumn& Column) { return Column.Name == ColumnName; });
+}
+
+const FChartColumn* FChartDataset::GetColumn(FName ColumnName) const
+{
+    const int32 Index = FindColumn(ColumnName);
+    return Index != INDEX_NONE ? &Columns[Index] : nullptr;
+}
+
+FChartColumn& FChartDataset::AddColumn(FName ColumnName, EChartColumnType Type)
+{
+    FChartColumn& Column = Columns.AddDefaulted_GetRef();
+    Column.Name = ColumnName;
+    Column.Type = Type;
+    return Column;
+}
+
+void FChartDataset::ResetRows()
+{
+    for (FChartColumn& Column : Columns)
+    {
+        Column.Floats.Reset();
+        Column.Codes.Reset();
+        Column.Labels.Reset();
+        Column.ExternalFloats = TConstArrayView<float>();
+    }
+    NumRows = 0;
+}
+
+void FChartDataset::ReserveRows(int32 NumRowsToReserve)
+{
+    for (FChartColumn& Column : Columns)
+    {
+        if (Column.Type == EChartColumnType::Float)
+        {
+            Column.Floats.Reserve(NumRowsToReserve);
+        }
+        else
+        {
+            Column.Codes.Reserve(NumRowsToReserve);
+        }
+    }
+}
+
+void FChartDataset::TrimToNumRows(TConstArrayView<int32> NumLabels)
+{
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        FChartColumn& Column = Columns[ColumnIndex];
+        if (ColumnIndex < NumLabels.Num())
+        {
+            Column.Labels.TrimTo(NumLabels[ColumnIndex]);
+        }
+        if (Column.Floats.Num() > NumRows)
+        {
+            Column.Floats.SetNum(NumRows, false);
+        }
+        if (Column.Codes.Num() > NumRows)
+        {
+            Column.Codes.SetNum(NumRows, false);
+        }
+    }
+}
+
+void FChartDataset::AppendRows(FChartDataset&& Other)
+{
+    if (Other.NumRows == 0)
+    {
+        return;
+    }
+
+    if (NumRows == 0)
+    {
+        Columns = MoveTemp(Other.Columns);
+        NumRows = Other.NumRows;
+        ExternalStorage = Other.ExternalStorage;
+        Other.CopySchemaFrom(*this);
+        return;
+    }
+
+    check(Other.Columns.Num() == Columns.Num());
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        Columns[ColumnIndex].AppendValues(Other.Columns[ColumnIndex]);
+    }
+    NumRows += Other.NumRows;
+    Other.ResetRows();
+}
+
+void FChartDataset::AppendRows(TArrayView<FChartDataset> Parts)
+{
+    int64 TotalRows = NumRows;
+    for (const FChartDataset& Part : Parts)
+    {
+        check(Part.Columns.Num() == Columns.Num());
+        TotalRows += Part.NumRows;
+    }
+    check(TotalRows <= MAX_int32);
+
+    ParallelFor(Columns.Num(), [this, Parts, TotalRows](int32 ColumnIndex)
+    {
+        FChartColumn& Dest = Columns[ColumnIndex];
+        MaterializeFloats(Dest);
+        if (Dest.Type == EChartColumnType::Float)
+        {
+            Dest.Floats.Reserve(static_cast<int32>(TotalRows));
+        }
+        else
+        {
+            Dest.Codes.Reserve(static_cast<int32>(TotalRows));
+        }
+
+        for (const FChartDataset& Part : Parts)
+        {
+            Dest.AppendValues(Part.Columns[ColumnIndex]);
+        }
+    });
+
+    NumRows = static_cast<int32>(TotalRows);
+    for (FChartDataset& Part : Parts)
+    {
+        Part.ResetRows();
+    }
+}
+
+void FChartDataset::CopySchemaFrom(const FChartDataset& Other)
+{
+    Columns.Reset(Other.Columns.Num());
+    for (const FChartColumn& Column : Other.Columns)
+    {
+        AddColumn(Column.Name, Column.Type);
+    }
+    NumRows = 0;
+}
+
+void FChartDataset::AddRowFrom(const FChartDataset& Source, int32 SourceRow)
+{
+    check(Source.Columns.Num() == Columns.Num());
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        FChartColumn& Dest = Columns[ColumnIndex];
+        const FChartColumn& From = Source.Columns[ColumnIndex];
+        if (Dest.Type == EChartColumnType::Float)
+        {
+            Dest.Floats.Add(From.GetFloats()[SourceRow]);
+        }
+        else
+        {
+            Dest.AddString(From.GetLabel(SourceRow));
+        }
+    }
+    ++NumRows;
+}
+
+void FChartDataset::SetRowFrom(const FChartDataset& Source, int32 SourceRow, int32 DestRow)
+{
+    check(Source.Columns.Num() == Columns.Num());
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        FChartColumn& Dest = Columns[ColumnIndex];
+        const FChartColumn& From = Source.Columns[ColumnIndex];
+        if (Dest.Type == EChartColumnType::Float)
+        {
+            Dest.Floats[DestRow] = From.GetFloats()[SourceRow];
+        }
+        else
+        {
+            Dest.Codes[DestRow] = Dest.Labels.Add(From.GetLabel(SourceRow));
+        }
+    }
+}
+
+bool FChartDataset::GetColumnRange(FName ColumnName, float& OutMin, float& OutMax) const
+{
+    const FChartColumn* Column = GetColumn(ColumnName);
+    if (!Column || !Column->Stats.IsSet() || Column->Stats->Count == 0)
+    {
+        return false;
+    }
+
+    OutMin = Column->Stats->Min;
+    OutMax = Column->Stats->Max;
+    return true;
+}
+
+bool FChartDataset::GetColumnQuantileRange(FName ColumnName, double LowQ, double HighQ, float& OutMin, float& OutMax) const
+{
+    const FChartColumn* Column = GetColumn(ColumnName);
+    if (!Column || !Column->Stats.IsSet() || Column->Stats->Quantiles.IsEmpty())
+    {
+        return false;
+    }
+
+    OutMin = Column->Stats->Quantiles.GetQuantile(LowQ);
+    OutMax = Column->Stats->Quantiles.GetQuantile(HighQ);
+    return true;
+}
+
+bool FChartDataset::GatherPoints(FName XColumn, FName YColumn, FName ZColumn, TArray<FVector>& OutPoints, TArray<int32>* OutRows, int32 FirstRow) const
+{
+    const FChartColumn* Axes[3] = { GetColumn(XColumn), GetColumn(YColumn), GetColumn(ZColumn) };
+    if (!Axes[0] || !Axes[1] || !Axes[2])
+    {
+        return false;
+    }
+
+    FirstRow = FMath::Clamp(FirstRow, 0, NumRows);
+    OutPoints.Reserve(OutPoints.Num() + NumRows - FirstRow);
+    const TConstArrayView<float> Values[3] = { Axes[0]->GetFloats(), Axes[1]->GetFloats(), Axes[2]->GetFloats() };
+    const bool bAllFloat = Axes[0]->Type == EChartColumnType::Float && Axes[1]->Type == EChartColumnType::Float && Axes[2]->Type == EChartColumnType::Float;
+    for (int32 Row = FirstRow; Row < NumRows; ++Row)
+    {
+        const FVector Point = bAllFloat
+            ? FVector(Values[0][Row], Values[1][Row], Values[2][Row])
+            : FVector(Axes[0]->GetFloat(Row), Axes[1]->GetFloat(Row), Axes[2]->GetFloat(Row));
+        if (!Point.ContainsNaN())
+        {
+            OutPoints.Add(Point);
+            if (OutRows)
+            {
+                OutRows->Add(Row);
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,463 @@
+#include "Data/ChartDatasetAsset.h"
+#include "Data/RowIngestionPlan.h"
+#include "Async/Async.h"
+#include "Engine/DataTable.h"
+#include "Serialization/CustomVersion.h"
+
+#if WITH_EDITOR
+#include "Charts/BarChartActor.h"
+#include "Charts/LineGraphActor.h"
+#include "Charts/ScatterActor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#endif
+
+namespace
+{
+    // Columns start on 16-byte boundaries so float views into the payload stay aligned
+    constexpr int64 ColumnAlignment = 16;
+
+    // The bulk data read buffer, freed once no dataset views it
+    struct FChartDatasetPayload : public FChartDatasetStorage
+    {
+        explicit FChartDatasetPayload(uint8* InData) : Data(InData) {}
+        virtual ~FChartDatasetPayload() override { FMemory::Free(Data); }
+
+        uint8* Data;
+    };
+
+    // Layout changes of the serialized asset after its first version
+    struct FChartDatasetAssetVersion
+    {
+        enum Type
+        {
+            Initial = 0,
+            // A quantile sketch per column follows the bulk data
+            QuantileSketches,
+            LatestVersion = QuantileSketches
+        };
+
+        static const FGuid Guid;
+    };
+    const FGuid FChartDatasetAssetVersion::Guid(0x6B1F4E2A, 0x93D04C57, 0xA81E2C64, 0x5F0B7D39);
+    FCustomVersionRegistration RegisterChartDatasetAssetVersion(FChartDatasetAssetVersion::Guid, FChartDatasetAssetVersion::LatestVersion, TEXT("VRDataVizChartDatasetAsset"));
+
+#if WITH_EDITOR
+    // Chart row structs whose tables VRDataViz.ConvertChartTables converts
+    bool IsChartRowStruct(const UScriptStruct* RowStruct)
+    {
+        return RowStruct == FVRBarData::StaticStruct() || RowStruct == FVRLineData::StaticStruct() || RowStruct == FVRScatterData::StaticStruct();
+    }
+
+    // VRDataViz.ConvertChartTables [PackagePath=/Game]
+    // Creates or refreshes a <Table>_Dataset asset next to every bar, line and scatter DataTable under the path
+    void ConvertChartTables(const TArray<FString>& Args)
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+        FARFilter Filter;
+        Filter.ClassPaths.Add(UDataTable::StaticClass()->GetClassPathName());
+        Filter.PackagePaths.Add(FName(Args.Num() > 0 ? *Args[0] : TEXT("/Game")));
+        Filter.bRecursivePaths = true;
+        TArray<FAssetData> Tables;
+        AssetRegistry.GetAssets(Filter, Tables);
+
+        for (const FAssetData& TableData : Tables)
+        {
+            const UDataTable* Table = Cast<UDataTable>(TableData.GetAsset());
+            if (!Table || !IsChartRowStruct(Table->GetRowStruct()))
+            {
+                continue;
+            }
+
+            const FString AssetName = TableData.AssetName.ToString() + TEXT("_Dataset");
+            const FString PackageName = TableData.PackagePath.ToString() / AssetName;
+            UPackage* Package = CreatePackage(*PackageName);
+            Package->FullyLoad();
+
+            UChartDatasetAsset* Asset = FindObject<UChartDatasetAsset>(Package, *AssetName);
+            const bool bCreated = Asset == nullptr;
+            if (bCreated)
+            {
+                Asset = NewObject<UChartDatasetAsset>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+            }
+            else
+            {
+                Asset->Modify();
+            }
+            if (!Asset->BuildFromDataTable(Table))
+            {
+                continue;
+            }
+            if (bCreated)
+            {
+                FAssetRegistryModule::AssetCreated(Asset);
+            }
+            Package->MarkPackageDirty();
+
+            FSavePackageArgs SaveArgs;
+            SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+            const FString FileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+            const bool bSaved = UPackage::SavePackage(Package, Asset, *FileName, SaveArgs);
+            UE_LOG(LogTemp, Log, TEXT("ConvertChartTables - %s %s (%d rows x %d columns)%s"), bCreated ? TEXT("Created") : TEXT("Updated"),
+                *PackageName, Asset->NumRows, Asset->Columns.Num(), bSaved ? TEXT("") : TEXT(", but it could not be saved"));
+        }
+    }
+
+    FAutoConsoleCommand ConvertChartTablesCommand(
+        TEXT("VRDataViz.ConvertChartTables"),
+        TEXT("Packs every chart DataTable into a UChartDatasetAsset next to it. Args: [PackagePath=/Game]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&ConvertChartTables));
+
+    // Asset packed for each chart being cooked; dropped once the chart's package is saved
+    TMap<TWeakObjectPtr<UObject>, TWeakObjectPtr<UChartDatasetAsset>> ChartsPackedForCook;
+
+    void DropChartsPackedForCook(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+    {
+        for (auto It = ChartsPackedForCook.CreateIterator(); It; ++It)
+        {
+            const UObject* Chart = It.Key().Get();
+            if (!Chart || Chart->GetPackage() == Package)
+            {
+                if (UChartDatasetAsset* Asset = It.Value().Get())
+                {
+                    Asset->MarkAsGarbage();
+                }
+                It.RemoveCurrent();
+            }
+        }
+    }
+#endif
+}
+
+void UChartDatasetAsset::LoadDataset(TFunction<void(TSharedPtr<const FChartDataset>)> OnLoaded)
+{
+    check(IsInGameThread());
+
+    if (const TSharedPtr<const FChartDataset> Dataset = LoadedDataset.Pin())
+    {
+        OnLoaded(Dataset);
+        return;
+    }
+
+    // A read is already running for an earlier request
+    PendingLoads.Add(MoveTemp(OnLoaded));
+    if (PendingLoads.Num() > 1)
+    {
+        return;
+    }
+
+    // In the editor, and for freshly built assets, the payload is already in memory
+    if (ColumnData.GetBulkDataSize() == 0 || ColumnData.IsBulkDataLoaded())
+    {
+        void* Payload = nullptr;
+        if (ColumnData.GetBulkDataSize() > 0)
+        {
+            ColumnData.GetCopy(&Payload, false);
+        }
+        FinishLoad(static_cast<uint8*>(Payload));
+        return;
+    }
+
+    TWeakObjectPtr<UChartDatasetAsset> WeakThis(this);
+    FBulkDataIORequestCallBack OnRead = [WeakThis](bool bWasCancelled, IBulkDataIORequest* Request)
+    {
+        uint8* Payload = bWasCancelled ? nullptr : Request->GetReadResults();
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Payload]()
+        {
+            if (UChartDatasetAsset* This = WeakThis.Get())
+            {
+                This->FinishLoad(Payload);
+            }
+            else
+            {
+                FMemory::Free(Payload);
+            }
+        });
+    };
+    ReadRequest.Reset(ColumnData.CreateStreamingRequest(AIOP_Normal, &OnRead, nullptr));
+    if (!ReadRequest)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ChartDatasetAsset - Could not start reading the columns of %s"), *GetPathName());
+        FinishLoad(nullptr);
+    }
+}
+
+void UChartDatasetAsset::FinishLoad(uint8* Payload)
+{
+    if (ReadRequest)
+    {
+        ReadRequest->WaitCompletion();
+        ReadRequest.Reset();
+    }
+
+    TSharedPtr<const FChartDataset> Dataset;
+    if (Payload || ColumnData.GetBulkDataSize() == 0)
+    {
+        Dataset = CreateDataset(Payload);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("ChartDatasetAsset - Failed to read the columns of %s"), *GetPathName());
+    }
+    LoadedDataset = Dataset;
+
+    TArray<TFunction<void(TSharedPtr<const FChartDataset>)>> Callbacks = MoveTemp(PendingLoads);
+    for (TFunction<void(TSharedPtr<const FChartDataset>)>& Callback : Callbacks)
+    {
+        Callback(Dataset);
+    }
+}
+
+TSharedPtr<const FChartDataset> UChartDatasetAsset::CreateDataset(uint8* Payload) const
+{
+    const TSharedRef<FChartDatasetPayload> Storage = MakeShared<FChartDatasetPayload>(Payload);
+    const int64 PayloadSize = ColumnData.GetBulkDataSize();
+
+    TSharedPtr<FChartDataset> Dataset = MakeShared<FChartDataset>();
+    Dataset->NumRows = NumRows;
+    Dataset->ExternalStorage = Storage;
+    for (const FChartDatasetAssetColumn& Source : Columns)
+    {
+        if (NumRows > 0 && (Source.Offset < 0 || Source.Offset + static_cast<int64>(NumRows) * 4 > PayloadSize))
+        {
+            UE_LOG(LogTemp, Error, TEXT("ChartDatasetAsset - Column %s lies outside the payload of %s"), *Source.Name.ToString(), *GetPathName());
+            return nullptr;
+        }
+
+        FChartColumn& Column = Dataset->AddColumn(Source.Name, Source.bIsString ? EChartColumnType::String : EChartColumnType::Float);
+        if (!Source.bIsString)
+        {
+            Column.ExternalFloats = TConstArrayView<float>(reinterpret_cast<const float*>(Payload + Source.Offset), NumRows);
+        }
+        else if (NumRows > 0)
+        {
+            // Text columns are stored dictionary encoded already; only the codes are copied (and checked)
+            TArray<int32> CodeOfEntry;
+            CodeOfEntry.Reserve(Source.Dictionary.Num());
+            for (const FString& Entry : Source.Dictionary)
+            {
+                CodeOfEntry.Add(Column.Labels.Add(Entry));
+            }
+            const int32 MissingCode = Column.Labels.Add(FStringView());
+
+            const int32* Indices = reinterpret_cast<const int32*>(Payload + Source.Offset);
+            Column.Codes.Reserve(NumRows);
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                Column.Codes.Add(CodeOfEntry.IsValidIndex(Indices[Row]) ? CodeOfEntry[Indices[Row]] : MissingCode);
+            }
+        }
+
+        FChartColumnStats& Stats = Column.Stats.Emplace();
+        Stats.Min = Source.Min;
+        Stats.Max = Source.Max;
+        Stats.Count = Source.Count;
+        Stats.MissingCount = Source.MissingCount;
+        // Assets saved before sketches were stored clip to min/max until they are rebuilt
+        if (ColumnQuantiles.Num() == Columns.Num())
+        {
+            Stats.Quantiles = ColumnQuantiles[Dataset->Columns.Num() - 1];
+        }
+    }
+    return Dataset;
+}
+
+void UChartDatasetAsset::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+    Ar.UsingCustomVersion(FChartDatasetAssetVersion::Guid);
+    ColumnData.Serialize(Ar, this);
+
+    if (Ar.CustomVer(FChartDatasetAssetVersion::Guid) >= FChartDatasetAssetVersion::QuantileSketches)
+    {
+        Ar << ColumnQuantiles;
+    }
+    else if (Ar.IsLoading())
+    {
+        ColumnQuantiles.Reset();
+    }
+}
+
+void UChartDatasetAsset::BeginDestroy()
+{
+    // The read callback holds only a weak pointer; cancel it so it never writes into freed state
+    if (ReadRequest)
+    {
+        ReadRequest->Cancel();
+        ReadRequest->WaitCompletion();
+        ReadRequest.Reset();
+    }
+    Super::BeginDestroy();
+}
+
+#if WITH_EDITOR
+bool UChartDatasetAsset::BuildFromDataTable(const UDataTable* Table)
+{
+    const UScriptStruct* RowStruct = Table ? Table->GetRowStruct() : nullptr;
+    if (!RowStruct)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ChartDatasetAsset - %s has no row struct"), Table ? *Table->GetPathName() : TEXT("(null table)"));
+        return false;
+    }
+
+    TArray<uint8*> Rows;
+    Table->GetRowMap().GenerateValueArray(Rows);
+
+    // Read through the row struct's ingestion plan: numbers and bools as floats, other fields as their text
+    FChartDataset Dataset;
+    FRowIngestionPlan::Get(RowStruct)->ReadRows(TArray<const uint8*>(Rows), Dataset);
+
+    Columns.Reset();
+    ColumnQuantiles.Reset();
+    int64 PayloadSize = 0;
+    for (const FChartColumn& Source : Dataset.Columns)
+    {
+        FChartDatasetAssetColumn& Column = Columns.AddDefaulted_GetRef();
+        Column.Name = Source.Name;
+        Column.bIsString = Source.Type == EChartColumnType::String;
+        Column.Offset = PayloadSize;
+        PayloadSize = Align(PayloadSize + static_cast<int64>(Rows.Num()) * 4, ColumnAlignment);
+    }
+
+    TArray64<uint8> Payload;
+    Payload.SetNumZeroed(PayloadSize);
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        FChartDatasetAssetColumn& Column = Columns[ColumnIndex];
+        const FChartColumn& Source = Dataset.Columns[ColumnIndex];
+        FChartColumnStats Stats;
+
+        if (Column.bIsString)
+        {
+            // The column's own dictionary and codes are stored as they are
+            int32* Indices = reinterpret_cast<int32*>(Payload.GetData() + Column.Offset);
+            Column.Dictionary = TArray<FString>(Source.Labels.GetValues());
+            for (int32 Row = 0; Row < Rows.Num(); ++Row)
+            {
+                // Text columns only count values, like text columns read from CSV
+                if (Source.GetLabel(Row).IsEmpty())
+                {
+                    ++Stats.MissingCount;
+                }
+                else
+                {
+                    ++Stats.Count;
+                }
+                Indices[Row] = Source.Codes[Row];
+            }
+        }
+        else
+        {
+            float* Values = reinterpret_cast<float*>(Payload.GetData() + Column.Offset);
+            for (int32 Row = 0; Row < Rows.Num(); ++Row)
+            {
+                const float Number = Source.Floats[Row];
+                Values[Row] = Number;
+                if (FMath::IsNaN(Number))
+                {
+                    ++Stats.MissingCount;
+                    continue;
+                }
+                Stats.Min = FMath::Min(Stats.Min, Number);
+                Stats.Max = FMath::Max(Stats.Max, Number);
+                ++Stats.Count;
+            }
+            Stats.Quantiles.Add(Source.Floats);
+        }
+        ColumnQuantiles.Add(MoveTemp(Stats.Quantiles));
+
+        Column.Min = Stats.Min;
+        Column.Max = Stats.Max;
+        Column.Count = Stats.Count;
+        Column.MissingCount = Stats.MissingCount;
+    }
+
+    NumRows = Rows.Num();
+    ColumnData.Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(ColumnData.Realloc(PayloadSize), Payload.GetData(), PayloadSize);
+    ColumnData.Unlock();
+    // Keep the payload out of the export so the asset loads without it and the columns stream on demand
+    ColumnData.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+
+    LoadedDataset.Reset();
+    SourceTable = const_cast<UDataTable*>(Table);
+    return true;
+}
+
+void UChartDatasetAsset::PreSave(FObjectPreSaveContext SaveContext)
+{
+    Super::PreSave(SaveContext);
+
+    // Cooking repacks from the current table, so shipped columns never lag behind edits to it
+    if (SaveContext.IsCooking() && !SourceTable.IsNull())
+    {
+        if (const UDataTable* Table = SourceTable.LoadSynchronous())
+        {
+            BuildFromDataTable(Table);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ChartDatasetAsset - Source table of %s is missing; cooking the columns packed last"), *GetPathName());
+        }
+    }
+}
+
+void UChartDatasetAsset::PackForCook(const FObjectPreSaveContext& SaveContext, UObject* Chart, const UDataTable* Table, const UChartDatasetAsset* DatasetAsset)
+{
+    if (!SaveContext.IsCooking() || !Table || DatasetAsset)
+    {
+        return;
+    }
+
+    UChartDatasetAsset* Asset = NewObject<UChartDatasetAsset>(Chart, MakeUniqueObjectName(Chart, StaticClass(), TEXT("CookedDataset")));
+    if (!Asset->BuildFromDataTable(Table))
+    {
+        Asset->MarkAsGarbage();
+        UE_LOG(LogTemp, Warning, TEXT("ChartDatasetAsset - Cooking %s with its DataTable; the table could not be packed"), *Chart->GetPathName());
+        return;
+    }
+
+    static const FDelegateHandle DropHandle = UPackage::PackageSavedWithContextEvent.AddStatic(&DropChartsPackedForCook);
+
+    // A copy packed for an earlier save of the chart (for another platform) is not referenced again
+    TWeakObjectPtr<UChartDatasetAsset>& Packed = ChartsPackedForCook.FindOrAdd(Chart);
+    if (UChartDatasetAsset* OldAsset = Packed.Get())
+    {
+        OldAsset->MarkAsGarbage();
+    }
+    Packed = Asset;
+}
+
+FChartCookedTableScope::FChartCookedTableScope(FArchive& Ar, UObject* Chart, UDataTable*& InTable, UChartDatasetAsset*& InDatasetAsset)
+{
+    if (!Ar.IsCooking() || !InTable || InDatasetAsset)
+    {
+        return;
+    }
+    const TWeakObjectPtr<UChartDatasetAsset>* Packed = ChartsPackedForCook.Find(Chart);
+    if (!Packed || !Packed->IsValid())
+    {
+        return;
+    }
+
+    TableSlot = &InTable;
+    AssetSlot = &InDatasetAsset;
+    Table = InTable;
+    DatasetAsset = InDatasetAsset;
+    InTable = nullptr;
+    InDatasetAsset = Packed->Get();
+}
+
+FChartCookedTableScope::~FChartCookedTableScope()
+{
+    if (TableSlot)
+    {
+        *TableSlot = Table;
+        *AssetSlot = DatasetAsset;
+    }
+}
+#endif
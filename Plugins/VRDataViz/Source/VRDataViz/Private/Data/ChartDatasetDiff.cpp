@@ -0,0 +1,237 @@
+#include "Data/ChartDatasetDiff.h"
+#include "Data/ChartDataset.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    constexpr int32 HashBlockRows = 16384;
+
+    // NaNs hash alike and +0 / -0 hash alike, matching ValuesEqual
+    uint32 HashFloat(float Value)
+    {
+        if (FMath::IsNaN(Value))
+        {
+            return 0x7fc00000u;
+        }
+        return Value == 0.0f ? 0u : GetTypeHash(Value);
+    }
+
+    bool ValuesEqual(const FChartColumn& OldColumn, int32 OldRow, const FChartColumn& NewColumn, int32 NewRow)
+    {
+        if (OldColumn.Type == EChartColumnType::String)
+        {
+            return OldColumn.GetLabel(OldRow).Equals(NewColumn.GetLabel(NewRow), ESearchCase::CaseSensitive);
+        }
+        const float OldValue = OldColumn.GetFloats()[OldRow];
+        const float NewValue = NewColumn.GetFloats()[NewRow];
+        return OldValue == NewValue || (FMath::IsNaN(OldValue) && FMath::IsNaN(NewValue));
+    }
+
+    // One hash per row over the given columns, in that order
+    void HashRows(const FChartDataset& Dataset, const TArray<const FChartColumn*>& Columns, TArray<uint32>& OutHashes)
+    {
+        // Text is hashed once per distinct label; rows look their label's hash up by code
+        TArray<TArray<uint32>> LabelHashes;
+        LabelHashes.SetNum(Columns.Num());
+        for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+        {
+            if (Columns[ColumnIndex]->Type == EChartColumnType::String)
+            {
+                for (const FString& Label : Columns[ColumnIndex]->Labels.GetValues())
+                {
+                    LabelHashes[ColumnIndex].Add(GetTypeHash(Label));
+                }
+            }
+        }
+
+        OutHashes.SetNumZeroed(Dataset.NumRows);
+        const int32 NumBlocks = FMath::DivideAndRoundUp(Dataset.NumRows, HashBlockRows);
+        ParallelFor(NumBlocks, [&Columns, &LabelHashes, &OutHashes, NumRows = Dataset.NumRows](int32 Block)
+        {
+            const int32 First = Block * HashBlockRows;
+            const int32 Last = FMath::Min(NumRows, First + HashBlockRows);
+            for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+            {
+                const FChartColumn* Column = Columns[ColumnIndex];
+                if (Column->Type == EChartColumnType::String)
+                {
+                    const TArray<uint32>& Hashes = LabelHashes[ColumnIndex];
+                    for (int32 Row = First; Row < Last; ++Row)
+                    {
+                        OutHashes[Row] = HashCombine(OutHashes[Row], Hashes[Column->Codes[Row]]);
+                    }
+                }
+                else
+                {
+                    const TConstArrayView<float> Values = Column->GetFloats();
+                    for (int32 Row = First; Row < Last; ++Row)
+                    {
+                        OutHashes[Row] = HashCombine(OutHashes[Row], HashFloat(Values[Row]));
+                    }
+                }
+            }
+        });
+    }
+}
+
+FChartDatasetDiff FChartDatasetDiff::Compute(const FChartDataset& Old, const FChartDataset& New)
+{
+    FChartDatasetDiff Diff;
+
+    // Pair columns by name; the diff is only meaningful when both versions have the same columns and types
+    TArray<const FChartColumn*> OldColumns;
+    TArray<const FChartColumn*> NewColumns;
+    Diff.bSchemaChanged = Old.Columns.Num() != New.Columns.Num();
+    for (int32 ColumnIndex = 0; ColumnIndex < Old.Columns.Num() && !Diff.bSchemaChanged; ++ColumnIndex)
+    {
+        const FChartColumn& OldColumn = Old.Columns[ColumnIndex];
+        const FChartColumn* NewColumn = New.GetColumn(OldColumn.Name);
+        Diff.bSchemaChanged = !NewColumn || NewColumn->Type != OldColumn.Type;
+        OldColumns.Add(&OldColumn);
+        NewColumns.Add(NewColumn);
+    }
+    if (Diff.bSchemaChanged)
+    {
+        return Diff;
+    }
+
+    TArray<uint32> OldHashes;
+    TArray<uint32> NewHashes;
+    HashRows(Old, OldColumns, OldHashes);
+    HashRows(New, NewColumns, NewHashes);
+
+    const auto RowsEqual = [&](int32 OldRow, int32 NewRow)
+    {
+        if (OldHashes[OldRow] != NewHashes[NewRow])
+        {
+            return false;
+        }
+        for (int32 ColumnIndex = 0; ColumnIndex < OldColumns.Num(); ++ColumnIndex)
+        {
+            if (!ValuesEqual(*OldColumns[ColumnIndex], OldRow, *NewColumns[ColumnIndex], NewRow))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    Diff.NewToOld.Init(INDEX_NONE, New.NumRows);
+
+    // Edits usually leave a long common prefix and suffix (appends, in-place fixes)
+    int32 Prefix = 0;
+    while (Prefix < Old.NumRows && Prefix < New.NumRows && RowsEqual(Prefix, Prefix))
+    {
+        Diff.NewToOld[Prefix] = Prefix;
+        ++Prefix;
+    }
+    int32 OldEnd = Old.NumRows;
+    int32 NewEnd = New.NumRows;
+    while (OldEnd > Prefix && NewEnd > Prefix && RowsEqual(OldEnd - 1, NewEnd - 1))
+    {
+        --OldEnd;
+        --NewEnd;
+        Diff.NewToOld[NewEnd] = OldEnd;
+    }
+
+    // Old rows of the middle chained by hash in ascending order; each new row takes the first equal one
+    const int32 NumOldMiddle = OldEnd - Prefix;
+    TMap<uint32, int32> FirstWithHash;
+    TArray<int32> NextWithHash;
+    NextWithHash.Init(INDEX_NONE, NumOldMiddle);
+    for (int32 OldRow = OldEnd - 1; OldRow >= Prefix; --OldRow)
+    {
+        if (const int32* First = FirstWithHash.Find(OldHashes[OldRow]))
+        {
+            NextWithHash[OldRow - Prefix] = *First;
+        }
+        FirstWithHash.Add(OldHashes[OldRow], OldRow);
+    }
+
+    TBitArray<> OldMatched(false, NumOldMiddle);
+    for (int32 NewRow = Prefix; NewRow < NewEnd; ++NewRow)
+    {
+        int32* Head = FirstWithHash.Find(NewHashes[NewRow]);
+        if (!Head)
+        {
+            continue;
+        }
+
+        int32 Previous = INDEX_NONE;
+        int32 Candidate = *Head;
+        while (Candidate != INDEX_NONE && !RowsEqual(Candidate, NewRow))
+        {
+            Previous = Candidate;
+            Candidate = NextWithHash[Candidate - Prefix];
+        }
+        if (Candidate == INDEX_NONE)
+        {
+            continue;
+        }
+
+        const int32 Next = NextWithHash[Candidate - Prefix];
+        if (Previous == INDEX_NONE)
+        {
+            *Head = Next;
+        }
+        else
+        {
+            NextWithHash[Previous - Prefix] = Next;
+        }
+        Diff.NewToOld[NewRow] = Candidate;
+        OldMatched[Candidate - Prefix] = true;
+    }
+
+    // Old row of the next matched new row, bounding which old rows an unmatched new row may replace
+    TArray<int32> NextAnchor;
+    NextAnchor.SetNumUninitialized(NewEnd - Prefix);
+    int32 Anchor = OldEnd;
+    for (int32 NewRow = NewEnd - 1; NewRow >= Prefix; --NewRow)
+    {
+        if (Diff.NewToOld[NewRow] != INDEX_NONE)
+        {
+            Anchor = Diff.NewToOld[NewRow];
+        }
+        NextAnchor[NewRow - Prefix] = Anchor;
+    }
+
+    int32 OldCursor = Prefix;
+    int32 LastMatched = Prefix - 1;
+    for (int32 NewRow = Prefix; NewRow < NewEnd; ++NewRow)
+    {
+        const int32 Matched = Diff.NewToOld[NewRow];
+        if (Matched != INDEX_NONE)
+        {
+            Diff.bReordered |= Matched < LastMatched;
+            LastMatched = Matched;
+            OldCursor = FMath::Max(OldCursor, Matched + 1);
+            continue;
+        }
+
+        const int32 Limit = NextAnchor[NewRow - Prefix];
+        while (OldCursor < Limit && OldMatched[OldCursor - Prefix])
+        {
+            ++OldCursor;
+        }
+        if (OldCursor < Limit)
+        {
+            Diff.NewToOld[NewRow] = OldCursor;
+            OldMatched[OldCursor - Prefix] = true;
+            Diff.ModifiedRows.Add(NewRow);
+            ++OldCursor;
+        }
+        else
+        {
+            Diff.AppendedRows.Add(NewRow);
+        }
+    }
+
+    for (int32 OldRow = Prefix; OldRow < OldEnd; ++OldRow)
+    {
+        if (!OldMatched[OldRow - Prefix])
+        {
+            Diff.RemovedRows.Add(OldRow);
+        }
+    }
+    return Diff;
+}
@@ -0,0 +1,147 @@
+#include "Data/ChartDatasetLoader.h"
+#include "Data/ChartDataset.h"
+#include "Data/CSVStreamReader.h"
+#include "Data/DatasetSinks.h"
+#include "Data/DataByteSource.h"
+#include "Data/ArrowFile.h"
+#include "Data/PointCloudReader.h"
+#include "Data/PartitionedDatasetLoad.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+    // Runs a streaming reader into a stats sink and a reservoir sample, returning the sample with the stats applied
+    template<typename ReaderType>
+    TSharedPtr<FChartDataset> StreamSample(const ReaderType& Reader, const FString& FilePath, int32 MaxRows)
+    {
+        FColumnStatsSink StatsSink;
+        FReservoirSampleSink SampleSink(MaxRows);
+        IChartDatasetSink* const Sinks[] = { &StatsSink, &SampleSink };
+        if (!Reader.ReadFile(FilePath, Sinks))
+        {
+            return nullptr;
+        }
+
+        TSharedPtr<FChartDataset> Dataset = MakeShared<FChartDataset>(MoveTemp(SampleSink.GetSample()));
+        StatsSink.ApplyTo(*Dataset);
+        UE_LOG(LogTemp, Log, TEXT("ChartDatasetLoader - Kept %d sampled rows x %d columns from %s"), Dataset->NumRows, Dataset->Columns.Num(), *FilePath);
+        return Dataset;
+    }
+
+    // Arrow files and point clouds are read whole; a projection drops the other columns afterwards
+    TSharedPtr<FChartDataset> KeepColumns(TSharedPtr<FChartDataset> Dataset, const TArray<FName>& Columns)
+    {
+        if (Dataset.IsValid() && Columns.Num() > 0)
+        {
+            Dataset->Columns.RemoveAll([&Columns](const FChartColumn& Column) { return !Columns.Contains(Column.Name); });
+        }
+        return Dataset;
+    }
+}
+
+TSharedPtr<FChartDataset> FChartDatasetLoader::LoadCSVFile(const FString& FilePath, const FCSVParseOptions& Options)
+{
+    if (DataVizByteSource::IsCompressedFile(FilePath))
+    {
+        // Decompress as a stream into the parser instead of materializing the text
+        return StreamCSVFile(FilePath, 0, Options);
+    }
+
+    TArray64<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LoadCSVFile - Failed to read file: %s"), *FilePath);
+        return nullptr;
+    }
+
+    return ParseCSV(Bytes, Options);
+}
+
+TSharedPtr<FChartDataset> FChartDatasetLoader::ParseCSV(TConstArrayView64<uint8> Bytes, const FCSVParseOptions& Options)
+{
+    if (Options.IsCanceled())
+    {
+        return nullptr;
+    }
+
+    FCSVTokenizer Tokenizer(Options);
+    TSharedPtr<FChartDataset> Dataset = MakeShared<FChartDataset>();
+
+    FCSVFieldLayout Layout;
+    const int64 DataStart = Tokenizer.ParseSchema(Bytes, *Dataset, Layout);
+    if (Dataset->Columns.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ParseCSV - %s"), Options.Columns.Num() > 0 ? TEXT("None of the selected columns is in the header") : TEXT("No header record found"));
+        return nullptr;
+    }
+
+    Tokenizer.ParseRecordsParallel(Bytes.Slice(DataStart, Bytes.Num() - DataStart), Layout, *Dataset);
+    if (Options.IsCanceled())
+    {
+        return nullptr;
+    }
+    UE_LOG(LogTemp, Log, TEXT("ParseCSV - Parsed %d rows x %d columns"), Dataset->NumRows, Dataset->Columns.Num());
+    return Dataset;
+}
+
+TSharedPtr<FChartDataset> FChartDatasetLoader::StreamCSVFile(const FString& FilePath, int32 MaxRows, const FCSVParseOptions& Options)
+{
+    return StreamSample(FCSVStreamReader(Options), FilePath, MaxRows);
+}
+
+TSharedPtr<FChartDataset> FChartDatasetLoader::LoadCSVFileBounded(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options)
+{
+    // Compressed inputs always stream: their decompressed size is unknown up front
+    const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+    if (FileSize > MaxInMemoryBytes || DataVizByteSource::IsCompressedFile(FilePath))
+    {
+        return StreamCSVFile(FilePath, MaxStreamedRows, Options);
+    }
+    return LoadCSVFile(FilePath, Options);
+}
+
+bool FChartDatasetLoader::IsInMemoryCSVFile(const FString& FilePath, int64 MaxInMemoryBytes)
+{
+    if (FPartitionedDatasetLoad::IsPartitionedPath(FilePath) || FArrowFile::IsArrowFile(FilePath) || FPointCloudReader::IsPointCloudFile(FilePath)
+        || DataVizByteSource::IsCompressedFile(FilePath))
+    {
+        return false;
+    }
+    const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+    return FileSize >= 0 && FileSize <= MaxInMemoryBytes;
+}
+
+TSharedPtr<FChartDataset> FChartDatasetLoader::LoadArrowFile(const FString& FilePath)
+{
+    const TSharedPtr<FArrowFile> File = FArrowFile::Open(FilePath);
+    return File.IsValid() ? File->CreateDataset() : nullptr;
+}
+
+TSharedPtr<FChartDataset> FChartDatasetLoader::LoadPointCloudFile(const FString& FilePath, int32 MaxRows)
+{
+    return StreamSample(FPointCloudReader(), FilePath, MaxRows);
+}
+
+TSharedPtr<FChartDataset> FChartDatasetLoader::LoadPartitionedDataset(const FString& DirectoryOrGlob, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options)
+{
+    const TSharedPtr<FPartitionedDatasetLoad> Load = FPartitionedDatasetLoad::Start(DirectoryOrGlob, MaxInMemoryBytes, MaxStreamedRows, Options);
+    return Load.IsValid() ? Load->Wait() : nullptr;
+}
+
+TSharedPtr<FChartDataset> FChartDatasetLoader::LoadDataFile(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options)
+{
+    if (FPartitionedDatasetLoad::IsPartitionedPath(FilePath))
+    {
+        return LoadPartitionedDataset(FilePath, MaxInMemoryBytes, MaxStreamedRows, Options);
+    }
+    if (FArrowFile::IsArrowFile(FilePath))
+    {
+        return KeepColumns(LoadArrowFile(FilePath), Options.Columns);
+    }
+    if (FPointCloudReader::IsPointCloudFile(FilePath))
+    {
+        return KeepColumns(LoadPointCloudFile(FilePath, IFileManager::Get().FileSize(*FilePath) > MaxInMemoryBytes ? MaxStreamedRows : 0), Options.Columns);
+    }
+    return LoadCSVFileBounded(FilePath, MaxInMemoryBytes, MaxStreamedRows, Options);
+}
@@ -0,0 +1,627 @@
+#include "Data/ChartFilter.h"
+#include "Data/ChartDataset.h"
+#include "Data/CSVTokenizer.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    // Words of 64 rows evaluated together by one worker; a block's stack of masks stays in cache
+    constexpr int32 BlockWords = 64;
+
+    enum class ETokenKind : uint8
+    {
+        End,
+        Word,
+        Number,
+        Text,
+        LeftParen,
+        RightParen,
+        LeftBracket,
+        RightBracket,
+        Comma,
+        And,
+        Or,
+        Not,
+        In,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual
+    };
+
+    struct FToken
+    {
+        ETokenKind Kind = ETokenKind::End;
+        FString Text;
+        float Number = 0.0f;
+        int32 Offset = 0;
+    };
+
+    bool ParseNumber(const FString& Text, float& OutValue)
+    {
+        const FTCHARToUTF8 Utf8(*Text);
+        return FCSVTokenizer::ParseFloat(Utf8.Get(), Utf8.Get() + Utf8.Length(), OutValue);
+    }
+
+    bool IsNumberChar(const FString& Expression, int32 Pos)
+    {
+        const TCHAR C = Expression[Pos];
+        if (FChar::IsDigit(C) || C == TEXT('.') || C == TEXT('e') || C == TEXT('E'))
+        {
+            return true;
+        }
+        // The sign of an exponent
+        return (C == TEXT('-') || C == TEXT('+')) && (Expression[Pos - 1] == TEXT('e') || Expression[Pos - 1] == TEXT('E'));
+    }
+
+    bool Tokenize(const FString& Expression, TArray<FToken>& OutTokens, FString& OutError)
+    {
+        static const TPair<const TCHAR*, ETokenKind> Operators[] =
+        {
+            { TEXT("&&"), ETokenKind::And }, { TEXT("||"), ETokenKind::Or }, { TEXT("<="), ETokenKind::LessEqual },
+            { TEXT(">="), ETokenKind::GreaterEqual }, { TEXT("=="), ETokenKind::Equal }, { TEXT("!="), ETokenKind::NotEqual },
+            { TEXT("<"), ETokenKind::Less }, { TEXT(">"), ETokenKind::Greater }, { TEXT("="), ETokenKind::Equal },
+            { TEXT("!"), ETokenKind::Not }, { TEXT("("), ETokenKind::LeftParen }, { TEXT(")"), ETokenKind::RightParen },
+            { TEXT("["), ETokenKind::LeftBracket }, { TEXT("]"), ETokenKind::RightBracket }, { TEXT(","), ETokenKind::Comma }
+        };
+        static const TPair<const TCHAR*, ETokenKind> Keywords[] =
+        {
+            { TEXT("and"), ETokenKind::And }, { TEXT("or"), ETokenKind::Or }, { TEXT("not"), ETokenKind::Not }, { TEXT("in"), ETokenKind::In }
+        };
+
+        const int32 Len = Expression.Len();
+        int32 Pos = 0;
+        while (true)
+        {
+            while (Pos < Len && FChar::IsWhitespace(Expression[Pos]))
+            {
+                ++Pos;
+            }
+
+            FToken& Token = OutTokens.AddDefaulted_GetRef();
+            Token.Offset = Pos;
+            if (Pos >= Len)
+            {
+                return true;
+            }
+
+            const TCHAR C = Expression[Pos];
+            const TCHAR Next = Pos + 1 < Len ? Expression[Pos + 1] : TEXT('\0');
+            if (FChar::IsDigit(C) || C == TEXT('.') || ((C == TEXT('-') || C == TEXT('+')) && (FChar::IsDigit(Next) || Next == TEXT('.'))))
+            {
+                int32 End = Pos + 1;
+                while (End < Len && IsNumberChar(Expression, End))
+                {
+                    ++End;
+                }
+                Token.Kind = ETokenKind::Number;
+                Token.Text = Expression.Mid(Pos, End - Pos);
+                if (!ParseNumber(Token.Text, Token.Number))
+                {
+                    OutError = FString::Printf(TEXT("'%s' at %d is not a number"), *Token.Text, Pos);
+                    return false;
+                }
+                Pos = End;
+                continue;
+            }
+
+            if (FChar::IsAlpha(C) || C == TEXT('_'))
+            {
+                int32 End = Pos + 1;
+                while (End < Len && (FChar::IsAlnum(Expression[End]) || Expression[End] == TEXT('_') || Expression[End] == TEXT('.')))
+                {
+                    ++End;
+                }
+                Token.Kind = ETokenKind::Word;
+                Token.Text = Expression.Mid(Pos, End - Pos);
+                for (const TPair<const TCHAR*, ETokenKind>& Keyword : Keywords)
+                {
+                    if (Token.Text.Equals(Keyword.Key, ESearchCase::IgnoreCase))
+                    {
+                        Token.Kind = Keyword.Value;
+                    }
+                }
+                Pos = End;
+                continue;
+            }
+
+            // Quoted text, or a back-quoted column name
+            if (C == TEXT('"') || C == TEXT('\'') || C == TEXT('`'))
+            {
+                int32 Close = Pos + 1;
+                while (Close < Len && Expression[Close] != C)
+                {
+                    ++Close;
+                }
+                if (Close >= Len)
+                {
+                    OutError = FString::Printf(TEXT("Unterminated quote at %d"), Pos);
+                    return false;
+                }
+                Token.Kind = C == TEXT('`') ? ETokenKind::Word : ETokenKind::Text;
+                Token.Text = Expression.Mid(Pos + 1, Close - Pos - 1);
+                Pos = Close + 1;
+                continue;
+            }
+
+            bool bMatched = false;
+            for (const TPair<const TCHAR*, ETokenKind>& Operator : Operators)
+            {
+                const int32 OperatorLen = FCString::Strlen(Operator.Key);
+                if (FCString::Strncmp(*Expression + Pos, Operator.Key, OperatorLen) == 0)
+                {
+                    Token.Kind = Operator.Value;
+                    Token.Text = Operator.Key;
+                    Pos += OperatorLen;
+                    bMatched = true;
+                    break;
+                }
+            }
+            if (!bMatched)
+            {
+                OutError = FString::Printf(TEXT("Unexpected '%c' at %d"), C, Pos);
+                return false;
+            }
+        }
+    }
+
+    // Bit i of each word is Test of value i of its 64; rows past NumValues stay clear. Full words test into 64 bytes
+    // first, a loop the compiler turns into vector compares, and then pack eight bytes at a time with one multiply.
+    template<typename ValueType, typename TestType>
+    void TestRows(const ValueType* Values, int32 NumValues, int32 NumWords, uint64* OutWords, TestType Test)
+    {
+        alignas(16) uint8 Flags[64];
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            const int32 First = Word * 64;
+            const int32 Count = FMath::Clamp(NumValues - First, 0, 64);
+            if (Count < 64)
+            {
+                uint64 Bits = 0;
+                for (int32 Bit = 0; Bit < Count; ++Bit)
+                {
+                    Bits |= static_cast<uint64>(Test(Values[First + Bit])) << Bit;
+                }
+                OutWords[Word] = Bits;
+                continue;
+            }
+
+            for (int32 Bit = 0; Bit < 64; ++Bit)
+            {
+                Flags[Bit] = Test(Values[First + Bit]) ? 1 : 0;
+            }
+            uint64 Bits = 0;
+            for (int32 Byte = 0; Byte < 8; ++Byte)
+            {
+                uint64 Group;
+                FMemory::Memcpy(&Group, Flags + Byte * 8, sizeof(Group));
+                // Gathers the low bit of each byte into the top byte, first byte lowest
+                Bits |= ((Group * 0x0102040810204080ull) >> 56) << (Byte * 8);
+            }
+            OutWords[Word] = Bits;
+        }
+    }
+}
+
+void FChartRowMask::Init(int32 InNumRows, bool bValue)
+{
+    NumRows = InNumRows;
+    Words.Init(bValue ? ~uint64(0) : uint64(0), FMath::DivideAndRoundUp(NumRows, 64));
+    ClearSlack();
+}
+
+void FChartRowMask::SetBit(int32 Row, bool bValue)
+{
+    const uint64 Bit = uint64(1) << (Row & 63);
+    Words[Row >> 6] = bValue ? Words[Row >> 6] | Bit : Words[Row >> 6] & ~Bit;
+}
+
+int32 FChartRowMask::CountSetBits() const
+{
+    int32 Count = 0;
+    for (const uint64 Word : Words)
+    {
+        Count += FMath::CountBits(Word);
+    }
+    return Count;
+}
+
+void FChartRowMask::ClearSlack()
+{
+    if (NumRows & 63)
+    {
+        Words.Last() &= (uint64(1) << (NumRows & 63)) - 1;
+    }
+}
+
+// Recursive descent over the tokens, emitting the postfix program:
+//     Or         := And { (|| | or) And }
+//     And        := Unary { (&& | and) Unary }
+//     Unary      := (! | not) Unary | ( Or ) | Comparison
+//     Comparison := Column (< | <= | > | >= | == | !=) (Number | Text) | Column in [ Number , Number ]
+class FChartFilter::FParser
+{
+public:
+    FParser(const TArray<FToken>& InTokens, TArray<FInstruction>& InProgram, FString& InError)
+        : Tokens(InTokens), Program(InProgram), Error(InError)
+    {
+    }
+
+    bool Parse()
+    {
+        if (!ParseOr())
+        {
+            return false;
+        }
+        return Peek().Kind == ETokenKind::End || Fail(TEXT("Expected && or || before"));
+    }
+
+private:
+    const TArray<FToken>& Tokens;
+    TArray<FInstruction>& Program;
+    FString& Error;
+    int32 Index = 0;
+
+    const FToken& Peek() const { return Tokens[Index]; }
+    const FToken& Take() { return Tokens[Index++]; }
+
+    bool Fail(const TCHAR* What)
+    {
+        const FToken& Token = Peek();
+        Error = Token.Kind == ETokenKind::End
+            ? FString::Printf(TEXT("%s end of expression"), What)
+            : FString::Printf(TEXT("%s '%s' at %d"), What, *Token.Text, Token.Offset);
+        return false;
+    }
+
+    bool Expect(ETokenKind Kind, const TCHAR* What)
+    {
+        if (Peek().Kind != Kind)
+        {
+            return Fail(What);
+        }
+        ++Index;
+        return true;
+    }
+
+    bool ExpectNumber(float& OutValue)
+    {
+        if (Peek().Kind != ETokenKind::Number)
+        {
+            return Fail(TEXT("Expected a number before"));
+        }
+        OutValue = Take().Number;
+        return true;
+    }
+
+    void Emit(EOp Op)
+    {
+        FInstruction& Instruction = Program.AddDefaulted_GetRef();
+        Instruction.Op = Op;
+    }
+
+    bool ParseOr()
+    {
+        if (!ParseAnd())
+        {
+            return false;
+        }
+        while (Peek().Kind == ETokenKind::Or)
+        {
+            ++Index;
+            if (!ParseAnd())
+            {
+                return false;
+            }
+            Emit(EOp::Or);
+        }
+        return true;
+    }
+
+    bool ParseAnd()
+    {
+        if (!ParseUnary())
+        {
+            return false;
+        }
+        while (Peek().Kind == ETokenKind::And)
+        {
+            ++Index;
+            if (!ParseUnary())
+            {
+                return false;
+            }
+            Emit(EOp::And);
+        }
+        return true;
+    }
+
+    bool ParseUnary()
+    {
+        if (Peek().Kind == ETokenKind::Not)
+        {
+            ++Index;
+            if (!ParseUnary())
+            {
+                return false;
+            }
+            Emit(EOp::Not);
+            return true;
+        }
+        if (Peek().Kind == ETokenKind::LeftParen)
+        {
+            ++Index;
+            return ParseOr() && Expect(ETokenKind::RightParen, TEXT("Expected ) before"));
+        }
+        return ParseComparison();
+    }
+
+    bool ParseComparison()
+    {
+        if (Peek().Kind != ETokenKind::Word)
+        {
+            return Fail(TEXT("Expected a column name before"));
+        }
+
+        FInstruction Instruction;
+        Instruction.Column = FName(*Take().Text);
+
+        const ETokenKind OperatorKind = Take().Kind;
+        if (OperatorKind == ETokenKind::In)
+        {
+            Instruction.Compare = ECompare::InRange;
+            if (!Expect(ETokenKind::LeftBracket, TEXT("Expected [ before")) || !ExpectNumber(Instruction.Low)
+                || !Expect(ETokenKind::Comma, TEXT("Expected , before")) || !ExpectNumber(Instruction.High)
+                || !Expect(ETokenKind::RightBracket, TEXT("Expected ] before")))
+            {
+                return false;
+            }
+            Program.Add(MoveTemp(Instruction));
+            return true;
+        }
+
+        switch (OperatorKind)
+        {
+        case ETokenKind::Less: Instruction.Compare = ECompare::Less; break;
+        case ETokenKind::LessEqual: Instruction.Compare = ECompare::LessEqual; break;
+        case ETokenKind::Greater: Instruction.Compare = ECompare::Greater; break;
+        case ETokenKind::GreaterEqual: Instruction.Compare = ECompare::GreaterEqual; break;
+        case ETokenKind::Equal: Instruction.Compare = ECompare::Equal; break;
+        case ETokenKind::NotEqual: Instruction.Compare = ECompare::NotEqual; break;
+        default:
+            --Index;
+            return Fail(TEXT("Expected a comparison before"));
+        }
+
+        const FToken& Operand = Take();
+        if (Operand.Kind == ETokenKind::Number)
+        {
+            Instruction.Low = Operand.Number;
+        }
+        else if (Operand.Kind == ETokenKind::Text)
+        {
+            Instruction.bText = true;
+            Instruction.Text = Operand.Text;
+            Instruction.bTextIsNumber = ParseNumber(Operand.Text, Instruction.Low);
+        }
+        else
+        {
+            --Index;
+            return Fail(TEXT("Expected a number or quoted text before"));
+        }
+        Program.Add(MoveTemp(Instruction));
+        return true;
+    }
+};
+
+// A comparison resolved against a dataset's column
+struct FChartFilter::FBoundCompare
+{
+    const FInstruction* Instruction = nullptr;
+    const float* Floats = nullptr;
+    const int32* Codes = nullptr;
+    int32 NumValues = 0;
+    // Whether each label of a text column matches, decided once per distinct label
+    TArray<uint8> LabelMatches;
+
+    static bool TestNumber(ECompare Compare, float Value, float Low, float High)
+    {
+        switch (Compare)
+        {
+        case ECompare::Less: return Value < Low;
+        case ECompare::LessEqual: return Value <= Low;
+        case ECompare::Greater: return Value > Low;
+        case ECompare::GreaterEqual: return Value >= Low;
+        case ECompare::Equal: return Value == Low;
+        // Written as two comparisons so a missing (NaN) value fails it too
+        case ECompare::NotEqual: return Value < Low || Value > Low;
+        case ECompare::InRange: return Value >= Low && Value <= High;
+        }
+        return false;
+    }
+
+    static bool TestText(ECompare Compare, const FString& Value, const FString& Operand)
+    {
+        const int32 Order = Value.Compare(Operand, ESearchCase::CaseSensitive);
+        switch (Compare)
+        {
+        case ECompare::Less: return Order < 0;
+        case ECompare::LessEqual: return Order <= 0;
+        case ECompare::Greater: return Order > 0;
+        case ECompare::GreaterEqual: return Order >= 0;
+        case ECompare::Equal: return Order == 0;
+        case ECompare::NotEqual: return Order != 0;
+        case ECompare::InRange: return false;
+        }
+        return false;
+    }
+
+    bool Bind(const FChartDataset& Dataset, const FInstruction& InInstruction, FString& OutError)
+    {
+        Instruction = &InInstruction;
+        const FChartColumn* Column = Dataset.GetColumn(Instruction->Column);
+        if (!Column)
+        {
+            OutError = FString::Printf(TEXT("No column %s"), *Instruction->Column.ToString());
+            return false;
+        }
+
+        if (Column->Type == EChartColumnType::Float)
+        {
+            if (Instruction->bText && !Instruction->bTextIsNumber)
+            {
+                OutError = FString::Printf(TEXT("Column %s holds numbers and \"%s\" is not one"), *Instruction->Column.ToString(), *Instruction->Text);
+                return false;
+            }
+            const TConstArrayView<float> Values = Column->GetFloats();
+            Floats = Values.GetData();
+            NumValues = FMath::Min(Values.Num(), Dataset.NumRows);
+            return true;
+        }
+
+        Codes = Column->Codes.GetData();
+        NumValues = FMath::Min(Column->Codes.Num(), Dataset.NumRows);
+        const TConstArrayView<FString> Labels = Column->Labels.GetValues();
+        LabelMatches.SetNumZeroed(Labels.Num());
+        for (int32 Code = 0; Code < Labels.Num(); ++Code)
+        {
+            // The empty label is a missing value, which no comparison matches (not even != or == "")
+            float Value = NAN;
+            LabelMatches[Code] = !Labels[Code].IsEmpty() && (Instruction->bText
+                ? TestText(Instruction->Compare, Labels[Code], Instruction->Text)
+                : ParseNumber(Labels[Code], Value) && TestNumber(Instruction->Compare, Value, Instruction->Low, Instruction->High));
+        }
+        return true;
+    }
+
+    // Writes NumWords words of matches for the rows from FirstRow
+    void Evaluate(int32 FirstRow, int32 NumWords, uint64* OutWords) const
+    {
+        const int32 NumBlockValues = NumValues - FirstRow;
+        if (NumBlockValues <= 0)
+        {
+            FMemory::Memzero(OutWords, NumWords * sizeof(uint64));
+            return;
+        }
+
+        if (Codes)
+        {
+            const uint8* Matches = LabelMatches.GetData();
+            TestRows(Codes + FirstRow, NumBlockValues, NumWords, OutWords, [Matches](int32 Code) { return Matches[Code] != 0; });
+            return;
+        }
+
+        // One loop per operator so each compiles to a branch-free, vectorizable compare
+        const float* Values = Floats + FirstRow;
+        const float Low = Instruction->Low;
+        const float High = Instruction->High;
+        switch (Instruction->Compare)
+        {
+        case ECompare::Less: TestRows(Values, NumBlockValues, NumWords, OutWords, [Low](float Value) { return Value < Low; }); break;
+        case ECompare::LessEqual: TestRows(Values, NumBlockValues, NumWords, OutWords, [Low](float Value) { return Value <= Low; }); break;
+        case ECompare::Greater: TestRows(Values, NumBlockValues, NumWords, OutWords, [Low](float Value) { return Value > Low; }); break;
+        case ECompare::GreaterEqual: TestRows(Values, NumBlockValues, NumWords, OutWords, [Low](float Value) { return Value >= Low; }); break;
+        case ECompare::Equal: TestRows(Values, NumBlockValues, NumWords, OutWords, [Low](float Value) { return Value == Low; }); break;
+        case ECompare::NotEqual: TestRows(Values, NumBlockValues, NumWords, OutWords, [Low](float Value) { return (Value < Low) | (Value > Low); }); break;
+        case ECompare::InRange: TestRows(Values, NumBlockValues, NumWords, OutWords, [Low, High](float Value) { return (Value >= Low) & (Value <= High); }); break;
+        }
+    }
+};
+
+bool FChartFilter::Compile(const FString& Expression, FChartFilter& OutFilter, FString& OutError)
+{
+    OutFilter = FChartFilter();
+    OutFilter.Expression = Expression.TrimStartAndEnd();
+    if (OutFilter.Expression.IsEmpty())
+    {
+        return true;
+    }
+
+    TArray<FToken> Tokens;
+    if (!Tokenize(OutFilter.Expression, Tokens, OutError) || !FParser(Tokens, OutFilter.Program, OutError).Parse())
+    {
+        OutFilter = FChartFilter();
+        return false;
+    }
+
+    int32 Depth = 0;
+    for (const FInstruction& Instruction : OutFilter.Program)
+    {
+        Depth += Instruction.Op == EOp::Compare ? 1 : (Instruction.Op == EOp::Not ? 0 : -1);
+        OutFilter.MaxDepth = FMath::Max(OutFilter.MaxDepth, Depth);
+    }
+    return true;
+}
+
+bool FChartFilter::Evaluate(const FChartDataset& Dataset, FChartRowMask& OutMask, FString& OutError) const
+{
+    if (IsEmpty())
+    {
+        OutMask.Init(Dataset.NumRows, true);
+        return true;
+    }
+
+    TArray<FBoundCompare> Compares;
+    for (const FInstruction& Instruction : Program)
+    {
+        if (Instruction.Op == EOp::Compare && !Compares.AddDefaulted_GetRef().Bind(Dataset, Instruction, OutError))
+        {
+            OutMask.Reset();
+            return false;
+        }
+    }
+
+    OutMask.Init(Dataset.NumRows, false);
+    const int32 NumWords = OutMask.Words.Num();
+    const int32 NumBlocks = FMath::DivideAndRoundUp(NumWords, BlockWords);
+    ParallelFor(NumBlocks, [this, &Compares, &OutMask, NumWords](int32 Block)
+    {
+        const int32 FirstWord = Block * BlockWords;
+        const int32 NumBlockWords = FMath::Min(BlockWords, NumWords - FirstWord);
+        TArray<uint64> Stack;
+        Stack.SetNumUninitialized(MaxDepth * BlockWords);
+
+        int32 Depth = 0;
+        int32 NextCompare = 0;
+        for (const FInstruction& Instruction : Program)
+        {
+            if (Instruction.Op == EOp::Compare)
+            {
+                Compares[NextCompare++].Evaluate(FirstWord * 64, NumBlockWords, &Stack[Depth++ * BlockWords]);
+                continue;
+            }
+
+            uint64* Top = &Stack[(Depth - 1) * BlockWords];
+            if (Instruction.Op == EOp::Not)
+            {
+                for (int32 Word = 0; Word < NumBlockWords; ++Word)
+                {
+                    Top[Word] = ~Top[Word];
+                }
+                continue;
+            }
+
+            uint64* Under = &Stack[(Depth - 2) * BlockWords];
+            if (Instruction.Op == EOp::And)
+            {
+                for (int32 Word = 0; Word < NumBlockWords; ++Word)
+                {
+                    Under[Word] &= Top[Word];
+                }
+            }
+            else
+            {
+                for (int32 Word = 0; Word < NumBlockWords; ++Word)
+                {
+                    Under[Word] |= Top[Word];
+                }
+            }
+            --Depth;
+        }
+        FMemory::Memcpy(&OutMask.Words[FirstWord], Stack.GetData(), NumBlockWords * sizeof(uint64));
+    });
+    OutMask.ClearSlack();
+    return true;
+}
@@ -0,0 +1,130 @@
+#include "Data/ChartMoments.h"
+
+void FChartMoments::Add(const FVector& Point)
+{
+    ++Count;
+    const FVector Before = Point - Mean;
+    Mean += Before / static_cast<double>(Count);
+    const FVector After = Point - Mean;
+    M2 += Before * After;
+    CXY += Before.X * After.Y;
+    CXZ += Before.X * After.Z;
+    CYZ += Before.Y * After.Z;
+}
+
+void FChartMoments::Remove(const FVector& Point)
+{
+    if (Count <= 1)
+    {
+        *this = FChartMoments();
+        return;
+    }
+
+    // Add run backwards: After is the deviation from the current mean, Before from the mean without the point
+    const FVector After = Point - Mean;
+    Mean = (Mean * static_cast<double>(Count) - Point) / static_cast<double>(Count - 1);
+    --Count;
+    const FVector Before = Point - Mean;
+    M2 = (M2 - Before * After).ComponentMax(FVector::ZeroVector);
+    CXY -= Before.X * After.Y;
+    CXZ -= Before.X * After.Z;
+    CYZ -= Before.Y * After.Z;
+}
+
+void FChartMoments::Merge(const FChartMoments& Other)
+{
+    if (Other.Count == 0)
+    {
+        return;
+    }
+    if (Count == 0)
+    {
+        *this = Other;
+        return;
+    }
+
+    const double Total = static_cast<double>(Count + Other.Count);
+    const double Weight = static_cast<double>(Count) * static_cast<double>(Other.Count) / Total;
+    const FVector Delta = Other.Mean - Mean;
+    Mean += Delta * (static_cast<double>(Other.Count) / Total);
+    M2 += Other.M2 + Delta * Delta * Weight;
+    CXY += Other.CXY + Delta.X * Delta.Y * Weight;
+    CXZ += Other.CXZ + Delta.X * Delta.Z * Weight;
+    CYZ += Other.CYZ + Delta.Y * Delta.Z * Weight;
+    Count += Other.Count;
+}
+
+FChartMoments FChartMoments::FromPoints(TConstArrayView<FVector> Points)
+{
+    FChartMoments Result;
+    if (Points.Num() == 0)
+    {
+        return Result;
+    }
+
+    double SumX = 0.0, SumY = 0.0, SumZ = 0.0;
+    for (const FVector& Point : Points)
+    {
+        SumX += Point.X;
+        SumY += Point.Y;
+        SumZ += Point.Z;
+    }
+    Result.Count = Points.Num();
+    Result.Mean = FVector(SumX, SumY, SumZ) / static_cast<double>(Points.Num());
+
+    double XX = 0.0, YY = 0.0, ZZ = 0.0, XY = 0.0, XZ = 0.0, YZ = 0.0;
+    for (const FVector& Point : Points)
+    {
+        const double DX = Point.X - Result.Mean.X;
+        const double DY = Point.Y - Result.Mean.Y;
+        const double DZ = Point.Z - Result.Mean.Z;
+        XX += DX * DX;
+        YY += DY * DY;
+        ZZ += DZ * DZ;
+        XY += DX * DY;
+        XZ += DX * DZ;
+        YZ += DY * DZ;
+    }
+    Result.M2 = FVector(XX, YY, ZZ);
+    Result.CXY = XY;
+    Result.CXZ = XZ;
+    Result.CYZ = YZ;
+    return Result;
+}
+
+FVector FChartMoments::GetVariance() const
+{
+    return Count > 0 ? M2 / static_cast<double>(Count) : FVector::ZeroVector;
+}
+
+FVector FChartMoments::GetStdDev() const
+{
+    const FVector Variance = GetVariance();
+    return FVector(FMath::Sqrt(Variance.X), FMath::Sqrt(Variance.Y), FMath::Sqrt(Variance.Z));
+}
+
+bool FChartMoments::FitLine(double& OutIntercept, double& OutSlope) const
+{
+    // Relative to the size of the values, so that rounding left by Remove does not read as spread
+    if (Count < 2 || GetVariance().X <= UE_DOUBLE_SMALL_NUMBER * (1.0 + Mean.X * Mean.X))
+    {
+        return false;
+    }
+    OutSlope = CXZ / M2.X;
+    OutIntercept = Mean.Z - OutSlope * Mean.X;
+    return true;
+}
+
+bool FChartMoments::FitPlane(double& OutA, double& OutB, double& OutC) const
+{
+    // Normal equations over the centered X and Y: [XX XY; XY YY] [B; C] = [XZ; YZ]
+    const double Determinant = M2.X * M2.Y - CXY * CXY;
+    if (Count < 3 || Determinant <= UE_DOUBLE_SMALL_NUMBER * M2.X * M2.Y)
+    {
+        return false;
+    }
+    OutB = (CXZ * M2.Y - CYZ * CXY) / Determinant;
+    OutC = (CYZ * M2.X - CXZ * CXY) / Determinant;
+    OutA = Mean.Z - OutB * Mean.X - OutC * Mean.Y;
+    return true;
+}
@@ -0,0 +1,108 @@
+#include "Data/ChartSelection.h"
+
+FChartSelection::FChartSelection(int32 InNumRows)
+{
+    Rows.Init(FMath::Max(0, InNumRows), false);
+}
+
+TSharedRef<FChartSelection> FChartSelection::ForSource(const FString& SourceKey, int32 NumRows)
+{
+    check(IsInGameThread());
+    static TMap<FString, TWeakPtr<FChartSelection>> Selections;
+
+    const FString Key = FString::Printf(TEXT("%s#%d"), *SourceKey, NumRows);
+    if (const TSharedPtr<FChartSelection> Existing = Selections.FindRef(Key).Pin())
+    {
+        return Existing.ToSharedRef();
+    }
+
+    // Forget selections no chart holds any more
+    for (auto It = Selections.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    const TSharedRef<FChartSelection> Selection = MakeShared<FChartSelection>(NumRows);
+    Selections.Add(Key, Selection);
+    return Selection;
+}
+
+void FChartSelection::SelectRows(TConstArrayView<int32> RowIndices, EChartSelectionOp Op)
+{
+    FChartRowMask Edit;
+    Edit.Init(Rows.NumRows, false);
+    for (const int32 Row : RowIndices)
+    {
+        if (Row >= 0 && Row < Rows.NumRows)
+        {
+            Edit.SetBit(Row, true);
+        }
+    }
+    SelectMask(Edit, Op);
+}
+
+void FChartSelection::SelectMask(const FChartRowMask& Mask, EChartSelectionOp Op)
+{
+    TArray<uint64> NewWords;
+    NewWords.SetNumUninitialized(Rows.Words.Num());
+    for (int32 Word = 0; Word < NewWords.Num(); ++Word)
+    {
+        const uint64 Old = Rows.Words[Word];
+        const uint64 Edit = Mask.Words.IsValidIndex(Word) ? Mask.Words[Word] : 0;
+        switch (Op)
+        {
+        case EChartSelectionOp::Replace: NewWords[Word] = Edit; break;
+        case EChartSelectionOp::Add: NewWords[Word] = Old | Edit; break;
+        case EChartSelectionOp::Remove: NewWords[Word] = Old & ~Edit; break;
+        case EChartSelectionOp::Toggle: NewWords[Word] = Old ^ Edit; break;
+        }
+    }
+
+    // A longer mask must not set bits past the end of the selection
+    if (NewWords.Num() > 0 && (Rows.NumRows & 63))
+    {
+        NewWords.Last() &= (uint64(1) << (Rows.NumRows & 63)) - 1;
+    }
+    Commit(MoveTemp(NewWords));
+}
+
+void FChartSelection::Clear()
+{
+    if (NumSelected > 0)
+    {
+        SelectMask(FChartRowMask(), EChartSelectionOp::Replace);
+    }
+}
+
+void FChartSelection::Commit(TArray<uint64>&& NewWords)
+{
+    int32 First = 0;
+    while (First < NewWords.Num() && NewWords[First] == Rows.Words[First])
+    {
+        ++First;
+    }
+    if (First == NewWords.Num())
+    {
+        return;
+    }
+    int32 Last = NewWords.Num() - 1;
+    while (NewWords[Last] == Rows.Words[Last])
+    {
+        --Last;
+    }
+
+    FChartSelectionChange Change;
+    Change.FirstWord = First;
+    Change.Flipped.SetNumUninitialized(Last - First + 1);
+    for (int32 Word = First; Word <= Last; ++Word)
+    {
+        uint64& Current = Rows.Words[Word];
+        Change.Flipped[Word - First] = Current ^ NewWords[Word];
+        NumSelected += FMath::CountBits(NewWords[Word]) - FMath::CountBits(Current);
+        Current = NewWords[Word];
+    }
+    OnChanged.Broadcast(Change);
+}
@@ -0,0 +1,202 @@
+#include "Data/ChartSortOrder.h"
+#include "Data/ChartDataset.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    // Rows one worker histograms and scatters in each pass
+    constexpr int32 BlockRows = 64 * 1024;
+    constexpr int32 RadixBits = 8;
+    constexpr int32 NumBuckets = 1 << RadixBits;
+
+    // Unsigned key in the same order as the float
+    uint32 KeyOfFloat(float Value)
+    {
+        if (FMath::IsNaN(Value))
+        {
+            return MAX_uint32;
+        }
+        const float Normalized = Value == 0.0f ? 0.0f : Value;
+        uint32 Bits;
+        FMemory::Memcpy(&Bits, &Normalized, sizeof(Bits));
+        // Negative values flip every bit, so that larger magnitudes come first; positive ones only the sign bit
+        return (Bits & 0x80000000u) ? ~Bits : (Bits | 0x80000000u);
+    }
+
+    // Sorts Keys, carrying Order along, one byte per pass from the lowest
+    template<typename KeyType>
+    void RadixSort(TArray<KeyType>& Keys, TArray<int32>& Order)
+    {
+        const int32 Num = Keys.Num();
+        const int32 NumBlocks = FMath::DivideAndRoundUp(Num, BlockRows);
+
+        // Bytes that are the same in every key (the exponent of values of one magnitude, say) need no pass
+        TArray<KeyType> BlockAnd, BlockOr;
+        BlockAnd.Init(~KeyType(0), NumBlocks);
+        BlockOr.Init(0, NumBlocks);
+        ParallelFor(NumBlocks, [&](int32 Block)
+        {
+            const int32 EndRow = FMath::Min(Num, (Block + 1) * BlockRows);
+            for (int32 Row = Block * BlockRows; Row < EndRow; ++Row)
+            {
+                BlockAnd[Block] &= Keys[Row];
+                BlockOr[Block] |= Keys[Row];
+            }
+        });
+        KeyType AllAnd = ~KeyType(0), AllOr = 0;
+        for (int32 Block = 0; Block < NumBlocks; ++Block)
+        {
+            AllAnd &= BlockAnd[Block];
+            AllOr |= BlockOr[Block];
+        }
+        const KeyType VaryingBits = AllAnd ^ AllOr;
+
+        TArray<KeyType> KeysOut;
+        TArray<int32> OrderOut;
+        TArray<int32> Offsets;
+        for (int32 Shift = 0; Shift < static_cast<int32>(sizeof(KeyType)) * 8; Shift += RadixBits)
+        {
+            if (((VaryingBits >> Shift) & (NumBuckets - 1)) == 0)
+            {
+                continue;
+            }
+            if (KeysOut.Num() != Num)
+            {
+                KeysOut.SetNumUninitialized(Num);
+                OrderOut.SetNumUninitialized(Num);
+            }
+
+            Offsets.Reset();
+            Offsets.SetNumZeroed(NumBlocks * NumBuckets);
+            ParallelFor(NumBlocks, [&](int32 Block)
+            {
+                int32* Counts = &Offsets[Block * NumBuckets];
+                const int32 EndRow = FMath::Min(Num, (Block + 1) * BlockRows);
+                for (int32 Row = Block * BlockRows; Row < EndRow; ++Row)
+                {
+                    ++Counts[(Keys[Row] >> Shift) & (NumBuckets - 1)];
+                }
+            });
+
+            // Each bucket takes its rows block by block, which keeps equal bytes in their current order
+            int32 Next = 0;
+            for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+            {
+                for (int32 Block = 0; Block < NumBlocks; ++Block)
+                {
+                    int32& Offset = Offsets[Block * NumBuckets + Bucket];
+                    const int32 Count = Offset;
+                    Offset = Next;
+                    Next += Count;
+                }
+            }
+
+            ParallelFor(NumBlocks, [&](int32 Block)
+            {
+                int32* BlockOffsets = &Offsets[Block * NumBuckets];
+                const int32 EndRow = FMath::Min(Num, (Block + 1) * BlockRows);
+                for (int32 Row = Block * BlockRows; Row < EndRow; ++Row)
+                {
+                    const int32 Dest = BlockOffsets[(Keys[Row] >> Shift) & (NumBuckets - 1)]++;
+                    KeysOut[Dest] = Keys[Row];
+                    OrderOut[Dest] = Order[Row];
+                }
+            });
+            Swap(Keys, KeysOut);
+            Swap(Order, OrderOut);
+        }
+    }
+
+    // Keys of a text column: the alphabetical rank of each row's label
+    void GetLabelRanks(const FChartColumn& Column, TArray<uint32>& OutKeys)
+    {
+        TArray<int32> Codes;
+        Codes.Reserve(Column.Labels.Num());
+        for (int32 Code = 0; Code < Column.Labels.Num(); ++Code)
+        {
+            Codes.Add(Code);
+        }
+        Codes.Sort([&Column](int32 A, int32 B)
+        {
+            const int32 Order = Column.Labels[A].Compare(Column.Labels[B], ESearchCase::IgnoreCase);
+            return Order != 0 ? Order < 0 : Column.Labels[A].Compare(Column.Labels[B], ESearchCase::CaseSensitive) < 0;
+        });
+        TArray<uint32> RankOfCode;
+        RankOfCode.SetNumUninitialized(Codes.Num());
+        for (int32 Rank = 0; Rank < Codes.Num(); ++Rank)
+        {
+            RankOfCode[Codes[Rank]] = static_cast<uint32>(Rank);
+        }
+
+        OutKeys.SetNumUninitialized(Column.Codes.Num());
+        ParallelFor(FMath::DivideAndRoundUp(OutKeys.Num(), BlockRows), [&](int32 Block)
+        {
+            const int32 EndRow = FMath::Min(OutKeys.Num(), (Block + 1) * BlockRows);
+            for (int32 Row = Block * BlockRows; Row < EndRow; ++Row)
+            {
+                OutKeys[Row] = RankOfCode[Column.Codes[Row]];
+            }
+        });
+    }
+
+    template<typename KeyType>
+    void SortKeys(TArray<KeyType>&& Keys, TArray<int32>& OutOrder)
+    {
+        OutOrder.SetNumUninitialized(Keys.Num());
+        for (int32 Index = 0; Index < OutOrder.Num(); ++Index)
+        {
+            OutOrder[Index] = Index;
+        }
+        RadixSort(Keys, OutOrder);
+    }
+}
+
+void FChartSortOrder::SortIndices(TConstArrayView<float> Keys, TArray<int32>& OutOrder)
+{
+    TArray<uint32> SortKeysOfRows;
+    SortKeysOfRows.SetNumUninitialized(Keys.Num());
+    ParallelFor(FMath::DivideAndRoundUp(Keys.Num(), BlockRows), [&](int32 Block)
+    {
+        const int32 EndRow = FMath::Min(Keys.Num(), (Block + 1) * BlockRows);
+        for (int32 Row = Block * BlockRows; Row < EndRow; ++Row)
+        {
+            SortKeysOfRows[Row] = KeyOfFloat(Keys[Row]);
+        }
+    });
+    SortKeys(MoveTemp(SortKeysOfRows), OutOrder);
+}
+
+void FChartSortOrder::SortIndices(TConstArrayView<uint64> Keys, TArray<int32>& OutOrder)
+{
+    SortKeys(TArray<uint64>(Keys), OutOrder);
+}
+
+TSharedPtr<const TArray<int32>> FChartSortOrder::ForColumn(const TSharedPtr<const FChartDataset>& Dataset, FName ColumnName)
+{
+    check(IsInGameThread());
+    const FChartColumn* Column = Dataset.IsValid() ? Dataset->GetColumn(ColumnName) : nullptr;
+    if (!Column)
+    {
+        return nullptr;
+    }
+
+    TMap<FName, TSharedPtr<const TArray<int32>>>& Orders = Dataset->SortOrders.Orders;
+    if (const TSharedPtr<const TArray<int32>>* Existing = Orders.Find(ColumnName))
+    {
+        return *Existing;
+    }
+
+    const TSharedRef<TArray<int32>> Order = MakeShared<TArray<int32>>();
+    if (Column->Type == EChartColumnType::String)
+    {
+        TArray<uint32> Keys;
+        GetLabelRanks(*Column, Keys);
+        SortKeys(MoveTemp(Keys), *Order);
+    }
+    else
+    {
+        SortIndices(Column->GetFloats(), *Order);
+    }
+    Orders.Add(ColumnName, Order);
+    return Order;
+}
@@ -0,0 +1,348 @@
+#include "Data/CompressedDataset.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    // Unpacking reads a whole little-endian uint64 at the byte of each residual
+    constexpr int32 PaddingBytes = 8;
+    // Delta-of-delta is only tried on whole numbers whose deltas of deltas cannot overflow
+    constexpr double MaxWholeNumber = 1152921504606846976.0; // 2^60
+
+    uint64 ZigZag(int64 Value)
+    {
+        return (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63);
+    }
+
+    int64 UnZigZag(uint64 Value)
+    {
+        return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+    }
+
+    int32 BitWidth(uint64 Value)
+    {
+        return Value == 0 ? 0 : 64 - static_cast<int32>(FMath::CountLeadingZeros64(Value));
+    }
+
+    uint32 BitsOfFloat(float Value)
+    {
+        uint32 Bits;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        return Bits;
+    }
+
+    float FloatOfBits(uint32 Bits)
+    {
+        float Value;
+        FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+        return Value;
+    }
+
+    // Appends values of up to 32 bits, low bits first
+    struct FBitWriter
+    {
+        TArray<uint8>& Out;
+        uint64 Pending = 0;
+        int32 NumPending = 0;
+
+        explicit FBitWriter(TArray<uint8>& InOut) : Out(InOut) {}
+
+        void Add(uint64 Value, int32 Width)
+        {
+            Pending |= Value << NumPending;
+            NumPending += Width;
+            while (NumPending >= 8)
+            {
+                Out.Add(static_cast<uint8>(Pending));
+                Pending >>= 8;
+                NumPending -= 8;
+            }
+        }
+
+        void Flush()
+        {
+            if (NumPending > 0)
+            {
+                Out.Add(static_cast<uint8>(Pending));
+            }
+            Pending = 0;
+            NumPending = 0;
+        }
+    };
+
+    // Residual Index of Width (up to 32) bits; at most 7 + 32 bits of the word read are needed
+    uint64 UnpackBits(const uint8* Data, int64 Index, int32 Width)
+    {
+        const int64 BitPos = Index * Width;
+        uint64 Word;
+        FMemory::Memcpy(&Word, Data + (BitPos >> 3), sizeof(Word));
+        return (Word >> (BitPos & 7)) & ((uint64(1) << Width) - 1);
+    }
+
+    // Float bits as an unsigned integer in the order of the values, so that evenly spaced values of one sign and
+    // exponent are evenly spaced integers
+    int64 OrderedBitsOfFloat(float Value)
+    {
+        const uint32 Bits = BitsOfFloat(Value);
+        return (Bits & 0x80000000u) ? ~Bits : (Bits | 0x80000000u);
+    }
+
+    float FloatOfOrderedBits(int64 OrderedBits)
+    {
+        const uint32 Bits = static_cast<uint32>(OrderedBits);
+        return FloatOfBits((Bits & 0x80000000u) ? (Bits & 0x7FFFFFFFu) : ~Bits);
+    }
+
+    // Width of the zigzagged deltas of deltas of a sequence
+    int32 GetDeltaOfDeltaWidth(TConstArrayView<int64> Values)
+    {
+        uint64 AnyBits = 0;
+        for (int32 Index = 2; Index < Values.Num(); ++Index)
+        {
+            AnyBits |= ZigZag((Values[Index] - Values[Index - 1]) - (Values[Index - 1] - Values[Index - 2]));
+        }
+        return BitWidth(AnyBits);
+    }
+
+    // Rebuilds Count values from the first value, the first delta and the packed deltas of deltas
+    template<typename ToFloatType>
+    void RunDeltas(int64 Value, int64 Delta, const uint32* Residuals, int32 Count, float* Out, ToFloatType ToFloat)
+    {
+        Out[0] = ToFloat(Value);
+        if (Count > 1)
+        {
+            Value += Delta;
+            Out[1] = ToFloat(Value);
+        }
+        for (int32 Index = 2; Index < Count; ++Index)
+        {
+            Delta += UnZigZag(Residuals[Index - 2]);
+            Value += Delta;
+            Out[Index] = ToFloat(Value);
+        }
+    }
+
+    // Values of a whole-number block as integers; false when one is fractional, -0, NaN or too large
+    bool GetWholeNumbers(TConstArrayView<float> Values, TArray<int64>& OutIntegers)
+    {
+        OutIntegers.SetNumUninitialized(Values.Num());
+        for (int32 Index = 0; Index < Values.Num(); ++Index)
+        {
+            const float Value = Values[Index];
+            if (!(FMath::Abs(Value) < MaxWholeNumber) || FMath::TruncToFloat(Value) != Value)
+            {
+                return false;
+            }
+            OutIntegers[Index] = static_cast<int64>(Value);
+            if (BitsOfFloat(static_cast<float>(OutIntegers[Index])) != BitsOfFloat(Value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void FCompressedFloats::Reset()
+{
+    NumValues = 0;
+    Blocks.Reset();
+    Bytes.Reset();
+}
+
+void FCompressedFloats::Encode(TConstArrayView<float> Values)
+{
+    Reset();
+    NumValues = Values.Num();
+    const int32 NumBlocks = FMath::DivideAndRoundUp(NumValues, BlockValues);
+    Blocks.SetNum(NumBlocks);
+    TArray<TArray<uint8>> BlockBytes;
+    BlockBytes.SetNum(NumBlocks);
+
+    ParallelFor(NumBlocks, [this, &Values, &BlockBytes](int32 BlockIndex)
+    {
+        const TConstArrayView<float> BlockValuesView = Values.Slice(BlockIndex * BlockValues, FMath::Min(BlockValues, NumValues - BlockIndex * BlockValues));
+        const int32 Count = BlockValuesView.Num();
+        FBlock& Block = Blocks[BlockIndex];
+        TArray<uint8>& Out = BlockBytes[BlockIndex];
+
+        // XOR residuals lose the trailing zero bits they all share
+        uint32 AnyXorBits = 0;
+        for (int32 Index = 1; Index < Count; ++Index)
+        {
+            AnyXorBits |= BitsOfFloat(BlockValuesView[Index]) ^ BitsOfFloat(BlockValuesView[Index - 1]);
+        }
+        const int32 XorShift = AnyXorBits != 0 ? static_cast<int32>(FMath::CountTrailingZeros(AnyXorBits)) : 0;
+        const int32 XorWidth = BitWidth(AnyXorBits >> XorShift);
+
+        // Deltas of deltas run over whole numbers as such, and over the ordered bits of other floats, where a smooth
+        // curve within one exponent leaves small second differences
+        TArray<int64> Integers;
+        ECodec DeltaCodec = ECodec::DeltaOfDelta;
+        if (Count >= 2 && !GetWholeNumbers(BlockValuesView, Integers))
+        {
+            DeltaCodec = ECodec::FloatDeltaOfDelta;
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                Integers[Index] = OrderedBitsOfFloat(BlockValuesView[Index]);
+            }
+        }
+        const int32 DeltaWidth = Count >= 2 ? GetDeltaOfDeltaWidth(Integers) : 64;
+        if (DeltaWidth <= 32 && static_cast<int64>(Count - 2) * DeltaWidth < static_cast<int64>(Count - 1) * XorWidth)
+        {
+            Block.Codec = DeltaCodec;
+            Block.Width = static_cast<uint8>(DeltaWidth);
+            Block.Base = Integers[0];
+            Block.BaseDelta = Integers[1] - Integers[0];
+            FBitWriter Writer(Out);
+            for (int32 Index = 2; Index < Count; ++Index)
+            {
+                Writer.Add(ZigZag((Integers[Index] - Integers[Index - 1]) - (Integers[Index - 1] - Integers[Index - 2])), DeltaWidth);
+            }
+            Writer.Flush();
+            return;
+        }
+
+        Block.Codec = ECodec::Xor;
+        Block.Width = static_cast<uint8>(XorWidth);
+        Block.Shift = static_cast<uint8>(XorShift);
+        Block.Base = BitsOfFloat(BlockValuesView[0]);
+        FBitWriter Writer(Out);
+        for (int32 Index = 1; Index < Count; ++Index)
+        {
+            Writer.Add((BitsOfFloat(BlockValuesView[Index]) ^ BitsOfFloat(BlockValuesView[Index - 1])) >> XorShift, XorWidth);
+        }
+        Writer.Flush();
+    });
+
+    int64 TotalBytes = 0;
+    for (int32 BlockIndex = 0; BlockIndex < NumBlocks; ++BlockIndex)
+    {
+        Blocks[BlockIndex].Offset = TotalBytes;
+        TotalBytes += BlockBytes[BlockIndex].Num();
+    }
+    Bytes.Reserve(TotalBytes + PaddingBytes);
+    for (const TArray<uint8>& Packed : BlockBytes)
+    {
+        Bytes.Append(Packed);
+    }
+    Bytes.AddZeroed(PaddingBytes);
+}
+
+void FCompressedFloats::DecodeBlock(int32 BlockIndex, float* Out) const
+{
+    const FBlock& Block = Blocks[BlockIndex];
+    const int32 Count = FMath::Min(BlockValues, NumValues - BlockIndex * BlockValues);
+    const uint8* Data = Bytes.GetData() + Block.Offset;
+
+    // Unpacking first keeps the dependent running sum or XOR out of the loop that reads the bits
+    uint32 Residuals[BlockValues];
+    const int32 NumResiduals = FMath::Max(0, Count - (Block.Codec == ECodec::Xor ? 1 : 2));
+    for (int32 Index = 0; Index < NumResiduals; ++Index)
+    {
+        Residuals[Index] = static_cast<uint32>(UnpackBits(Data, Index, Block.Width));
+    }
+
+    if (Block.Codec == ECodec::DeltaOfDelta)
+    {
+        RunDeltas(Block.Base, Block.BaseDelta, Residuals, Count, Out, [](int64 Value) { return static_cast<float>(Value); });
+        return;
+    }
+    if (Block.Codec == ECodec::FloatDeltaOfDelta)
+    {
+        RunDeltas(Block.Base, Block.BaseDelta, Residuals, Count, Out, &FloatOfOrderedBits);
+        return;
+    }
+
+    uint32 Bits = static_cast<uint32>(Block.Base);
+    Out[0] = FloatOfBits(Bits);
+    for (int32 Index = 0; Index < NumResiduals; ++Index)
+    {
+        Bits ^= Residuals[Index] << Block.Shift;
+        Out[Index + 1] = FloatOfBits(Bits);
+    }
+}
+
+void FCompressedFloats::Decode(TArray<float>& Out) const
+{
+    Out.SetNumUninitialized(NumValues);
+    ParallelFor(Blocks.Num(), [this, &Out](int32 BlockIndex)
+    {
+        DecodeBlock(BlockIndex, Out.GetData() + BlockIndex * BlockValues);
+    });
+}
+
+float FCompressedFloats::GetValue(int32 Index) const
+{
+    check(Index >= 0 && Index < NumValues);
+    float Values[BlockValues];
+    DecodeBlock(Index / BlockValues, Values);
+    return Values[Index % BlockValues];
+}
+
+TSharedRef<FCompressedDataset> FCompressedDataset::Compress(const FChartDataset& Dataset)
+{
+    const TSharedRef<FCompressedDataset> Result = MakeShared<FCompressedDataset>();
+    Result->NumRows = Dataset.NumRows;
+    for (const FChartColumn& Source : Dataset.Columns)
+    {
+        FColumn& Column = Result->Columns.AddDefaulted_GetRef();
+        Column.Name = Source.Name;
+        Column.Type = Source.Type;
+        Column.Stats = Source.Stats;
+        if (Source.Type == EChartColumnType::Float)
+        {
+            Column.Floats.Encode(Source.GetFloats());
+            continue;
+        }
+
+        Column.Labels = Source.Labels;
+        Column.CodeWidth = static_cast<uint8>(BitWidth(static_cast<uint64>(FMath::Max(0, Source.Labels.Num() - 1))));
+        FBitWriter Writer(Column.Codes);
+        Column.Codes.Reserve(static_cast<int64>(Source.Codes.Num()) * Column.CodeWidth / 8 + 1 + PaddingBytes);
+        for (const int32 Code : Source.Codes)
+        {
+            Writer.Add(static_cast<uint64>(Code), Column.CodeWidth);
+        }
+        Writer.Flush();
+        Column.Codes.AddZeroed(PaddingBytes);
+    }
+    return Result;
+}
+
+TSharedRef<FChartDataset> FCompressedDataset::Decompress() const
+{
+    const TSharedRef<FChartDataset> Dataset = MakeShared<FChartDataset>();
+    Dataset->NumRows = NumRows;
+    for (const FColumn& Column : Columns)
+    {
+        FChartColumn& Dest = Dataset->AddColumn(Column.Name, Column.Type);
+        Dest.Stats = Column.Stats;
+        if (Column.Type == EChartColumnType::Float)
+        {
+            Column.Floats.Decode(Dest.Floats);
+            continue;
+        }
+
+        Dest.Labels = Column.Labels;
+        Dest.Codes.SetNumUninitialized(NumRows);
+        ParallelFor(FMath::DivideAndRoundUp(NumRows, FCompressedFloats::BlockValues), [&Column, &Dest, this](int32 Block)
+        {
+            const int32 EndRow = FMath::Min(NumRows, (Block + 1) * FCompressedFloats::BlockValues);
+            for (int32 Row = Block * FCompressedFloats::BlockValues; Row < EndRow; ++Row)
+            {
+                Dest.Codes[Row] = static_cast<int32>(UnpackBits(Column.Codes.GetData(), Row, Column.CodeWidth));
+            }
+        });
+    }
+    return Dataset;
+}
+
+SIZE_T FCompressedDataset::GetAllocatedSize() const
+{
+    SIZE_T Size = Columns.GetAllocatedSize();
+    for (const FColumn& Column : Columns)
+    {
+        Size += Column.Floats.GetAllocatedSize() + Column.Codes.GetAllocatedSize() + Column.Labels.GetAllocatedSize();
+    }
+    return Size;
+}
@@ -0,0 +1,301 @@
+#include "Data/DataByteSource.h"
+#include "Data/BlockCompressedFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Compression.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <atomic>
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace
+{
+    constexpr int64 CompressedReadSize = 256 * 1024;
+
+    TUniquePtr<IFileHandle> OpenHandle(const FString& FilePath)
+    {
+        TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+        if (!Handle)
+        {
+            UE_LOG(LogTemp, Error, TEXT("DataByteSource - Failed to open file: %s"), *FilePath);
+        }
+        return Handle;
+    }
+
+    class FPlainByteSource : public IDataByteSource
+    {
+    public:
+        explicit FPlainByteSource(TUniquePtr<IFileHandle>&& InHandle)
+            : Handle(MoveTemp(InHandle))
+            , Remaining(Handle->Size())
+        {
+        }
+
+        virtual int64 Read(uint8* Dest, int64 MaxBytes) override
+        {
+            const int64 BytesToRead = FMath::Min(MaxBytes, Remaining);
+            if (BytesToRead > 0 && !Handle->Read(Dest, BytesToRead))
+            {
+                return INDEX_NONE;
+            }
+            Remaining -= BytesToRead;
+            return BytesToRead;
+        }
+
+    private:
+        TUniquePtr<IFileHandle> Handle;
+        int64 Remaining;
+    };
+
+    // Streaming inflate; gzip members are inherently sequential, so this decodes on the calling thread.
+    // Concatenated members (as written by parallel gzip tools) are decoded back to back.
+    class FGzipByteSource : public IDataByteSource
+    {
+    public:
+        explicit FGzipByteSource(TUniquePtr<IFileHandle>&& InHandle)
+            : Handle(MoveTemp(InHandle))
+            , Remaining(Handle->Size())
+        {
+            FMemory::Memzero(&Stream, sizeof(Stream));
+            Input.SetNumUninitialized(CompressedReadSize);
+            bValid = inflateInit2(&Stream, 16 + MAX_WBITS) == Z_OK;
+        }
+
+        virtual ~FGzipByteSource() override
+        {
+            if (bValid)
+            {
+                inflateEnd(&Stream);
+            }
+        }
+
+        virtual int64 Read(uint8* Dest, int64 MaxBytes) override
+        {
+            if (!bValid)
+            {
+                return INDEX_NONE;
+            }
+
+            int64 Written = 0;
+            while (Written < MaxBytes && !bFinished)
+            {
+                if (Stream.avail_in == 0 && Remaining > 0)
+                {
+                    const int64 BytesToRead = FMath::Min<int64>(Input.Num(), Remaining);
+                    if (!Handle->Read(Input.GetData(), BytesToRead))
+                    {
+                        return INDEX_NONE;
+                    }
+                    Remaining -= BytesToRead;
+                    Stream.next_in = Input.GetData();
+                    Stream.avail_in = static_cast<uInt>(BytesToRead);
+                }
+
+                const uInt OutputSize = static_cast<uInt>(FMath::Min<int64>(MaxBytes - Written, MAX_uint32));
+                Stream.next_out = Dest + Written;
+                Stream.avail_out = OutputSize;
+                const int Result = inflate(&Stream, Z_NO_FLUSH);
+                Written += OutputSize - Stream.avail_out;
+
+                if (Result == Z_STREAM_END)
+                {
+                    if (Stream.avail_in == 0 && Remaining == 0)
+                    {
+                        bFinished = true;
+                    }
+                    else if (inflateReset(&Stream) != Z_OK)
+                    {
+                        return INDEX_NONE;
+                    }
+                }
+                else if (Result == Z_BUF_ERROR && Stream.avail_in == 0 && Remaining == 0)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("DataByteSource - Truncated gzip stream"));
+                    return INDEX_NONE;
+                }
+                else if (Result != Z_OK && Result != Z_BUF_ERROR)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("DataByteSource - inflate failed (%d)"), Result);
+                    return INDEX_NONE;
+                }
+            }
+            return Written;
+        }
+
+    private:
+        TUniquePtr<IFileHandle> Handle;
+        int64 Remaining;
+        TArray<uint8> Input;
+        z_stream Stream;
+        bool bValid = false;
+        bool bFinished = false;
+    };
+
+    // Reads a batch of blocks (one per worker) and decompresses them with ParallelFor
+    class FBlockContainerByteSource : public IDataByteSource
+    {
+    public:
+        FBlockContainerByteSource(TUniquePtr<IFileHandle>&& InHandle, const DataVizBlockFile::FHeader& Header)
+            : Handle(MoveTemp(InHandle))
+            , FormatName(ANSI_TO_TCHAR(Header.FormatName))
+            , BlockSize(Header.BlockSize)
+            , MaxCompressedSize(FMath::Max<int64>(FCompression::CompressMemoryBound(FormatName, Header.BlockSize), Header.BlockSize))
+            , BatchBlocks(FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, 16))
+        {
+            Compressed.SetNum(BatchBlocks);
+            BlockHeaders.SetNum(BatchBlocks);
+            Decoded.SetNumUninitialized(static_cast<int64>(BatchBlocks) * BlockSize);
+        }
+
+        virtual int64 Read(uint8* Dest, int64 MaxBytes) override
+        {
+            int64 Written = 0;
+            while (Written < MaxBytes)
+            {
+                if (DecodedOffset == DecodedSize)
+                {
+                    if (!DecodeBatch())
+                    {
+                        return INDEX_NONE;
+                    }
+                    if (DecodedSize == 0)
+                    {
+                        break;
+                    }
+                }
+
+                const int64 BytesToCopy = FMath::Min(MaxBytes - Written, DecodedSize - DecodedOffset);
+                FMemory::Memcpy(Dest + Written, Decoded.GetData() + DecodedOffset, BytesToCopy);
+                DecodedOffset += BytesToCopy;
+                Written += BytesToCopy;
+            }
+            return Written;
+        }
+
+    private:
+        bool DecodeBatch()
+        {
+            DecodedOffset = DecodedSize = 0;
+
+            // Compressed payloads are read sequentially, then decoded one block per worker
+            int32 NumBlocks = 0;
+            while (NumBlocks < BatchBlocks && Handle->Tell() < Handle->Size())
+            {
+                // Sizes are checked before anything is allocated, so a corrupt header cannot ask for gigabytes
+                DataVizBlockFile::FBlockHeader& BlockHeader = BlockHeaders[NumBlocks];
+                if (!Handle->Read(reinterpret_cast<uint8*>(&BlockHeader), sizeof(BlockHeader))
+                    || BlockHeader.UncompressedSize > BlockSize || BlockHeader.CompressedSize == 0
+                    || BlockHeader.CompressedSize > MaxCompressedSize || BlockHeader.CompressedSize > Handle->Size() - Handle->Tell())
+                {
+                    UE_LOG(LogTemp, Error, TEXT("DataByteSource - Corrupt block header"));
+                    return false;
+                }
+
+                Compressed[NumBlocks].SetNumUninitialized(BlockHeader.CompressedSize);
+                if (!Handle->Read(Compressed[NumBlocks].GetData(), BlockHeader.CompressedSize))
+                {
+                    return false;
+                }
+                ++NumBlocks;
+            }
+
+            TArray<int64, TInlineAllocator<16>> Offsets;
+            for (int32 Block = 0; Block < NumBlocks; ++Block)
+            {
+                Offsets.Add(DecodedSize);
+                DecodedSize += BlockHeaders[Block].UncompressedSize;
+            }
+
+            std::atomic<bool> bFailed(false);
+            ParallelFor(NumBlocks, [&](int32 Block)
+            {
+                const DataVizBlockFile::FBlockHeader& BlockHeader = BlockHeaders[Block];
+                uint8* Target = Decoded.GetData() + Offsets[Block];
+                if (BlockHeader.CompressedSize == BlockHeader.UncompressedSize)
+                {
+                    FMemory::Memcpy(Target, Compressed[Block].GetData(), BlockHeader.UncompressedSize);
+                }
+                else if (!FCompression::UncompressMemory(FormatName, Target, BlockHeader.UncompressedSize, Compressed[Block].GetData(), BlockHeader.CompressedSize))
+                {
+                    bFailed = true;
+                }
+            });
+
+            if (bFailed)
+            {
+                UE_LOG(LogTemp, Error, TEXT("DataByteSource - %s block decompression failed"), *FormatName.ToString());
+                return false;
+            }
+            return true;
+        }
+
+        TUniquePtr<IFileHandle> Handle;
+        FName FormatName;
+        uint32 BlockSize;
+        // Largest payload the writer produces for a block: the codec's bound, or the block stored raw
+        int64 MaxCompressedSize;
+        int32 BatchBlocks;
+        TArray<TArray<uint8>> Compressed;
+        TArray<DataVizBlockFile::FBlockHeader> BlockHeaders;
+        TArray64<uint8> Decoded;
+        int64 DecodedSize = 0;
+        int64 DecodedOffset = 0;
+    };
+}
+
+DataVizByteSource::EFormat DataVizByteSource::DetectFormat(const FString& FilePath)
+{
+    TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+    uint8 Leading[4] = {};
+    if (!Handle || Handle->Size() < 4 || !Handle->Read(Leading, 4))
+    {
+        return EFormat::Plain;
+    }
+
+    if (Leading[0] == 0x1F && Leading[1] == 0x8B)
+    {
+        return EFormat::Gzip;
+    }
+
+    uint32 Magic;
+    FMemory::Memcpy(&Magic, Leading, sizeof(Magic));
+    return Magic == DataVizBlockFile::Magic ? EFormat::BlockContainer : EFormat::Plain;
+}
+
+TUniquePtr<IDataByteSource> DataVizByteSource::OpenFile(const FString& FilePath)
+{
+    const EFormat Format = DetectFormat(FilePath);
+    TUniquePtr<IFileHandle> Handle = OpenHandle(FilePath);
+    if (!Handle)
+    {
+        return nullptr;
+    }
+
+    switch (Format)
+    {
+    case EFormat::Gzip:
+        return MakeUnique<FGzipByteSource>(MoveTemp(Handle));
+    case EFormat::BlockContainer:
+    {
+        DataVizBlockFile::FHeader Header;
+        if (!Handle->Read(reinterpret_cast<uint8*>(&Header), sizeof(Header)) || Header.Version != DataVizBlockFile::Version || Header.BlockSize == 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("DataByteSource - Unsupported block container: %s"), *FilePath);
+            return nullptr;
+        }
+        Header.FormatName[UE_ARRAY_COUNT(Header.FormatName) - 1] = '\0';
+        return MakeUnique<FBlockContainerByteSource>(MoveTemp(Handle), Header);
+    }
+    default:
+        return MakeUnique<FPlainByteSource>(MoveTemp(Handle));
+    }
+}
+
+const TArray<FString>& DataVizByteSource::GetFilePatterns()
+{
+    static const TArray<FString> Patterns = { TEXT("*.csv"), TEXT("*.csv.gz"), TEXT("*.csv.ucz"), TEXT("*.arrow"), TEXT("*.feather"), TEXT("*.ply"), TEXT("*.las") };
+    return Patterns;
+}
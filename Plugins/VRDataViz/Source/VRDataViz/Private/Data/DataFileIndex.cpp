@@ -0,0 +1,527 @@
+#include "Data/DataFileIndex.h"
+#include "Data/ChartDataset.h"
+#include "Data/CSVTokenizer.h"
+#include "Data/DataByteSource.h"
+#include "Data/ArrowFile.h"
+#include "Data/PointCloudReader.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Paths.h"
+
+#if WITH_DATAVIZ_DIRECTORY_WATCHER
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "Modules/ModuleManager.h"
+#endif
+
+namespace
+{
+    // Text read from the start of a delimited file for its header and row estimate
+    constexpr int64 SampleSize = 64 * 1024;
+
+    // Rows of the sample checked for an ordered X column
+    constexpr int32 MaxOrderedCheckRows = 4096;
+
+    bool IsDataFileName(const FString& FileName)
+    {
+        for (const FString& Pattern : DataVizByteSource::GetFilePatterns())
+        {
+            if (FileName.MatchesWildcard(Pattern))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename T>
+    bool IsNonDecreasing(const T* Values, int64 Count)
+    {
+        for (int64 Index = 1; Index < Count; ++Index)
+        {
+            if (Values[Index] < Values[Index - 1])
+            {
+                return false;
+            }
+        }
+        return Count > 1;
+    }
+
+    // Bar charts read XIndex / Value columns; of the X, Y, Z charts, a line suits rows whose X only grows
+    EChartType SuggestChartType(const TArray<FName>& Columns, bool bOrderedX)
+    {
+        if (Columns.Contains(FName(TEXT("XIndex"))) && Columns.Contains(FName(TEXT("Value"))))
+        {
+            return EChartType::Bar;
+        }
+        return bOrderedX ? EChartType::Line : EChartType::Scatter;
+    }
+
+    // Decoded size of a delimited file: its size when plain, the gzip trailer's ISIZE (size mod 4 GiB) when that
+    // is plausible, INDEX_NONE otherwise
+    int64 GetTextSize(const FString& FilePath, int64 FileSize)
+    {
+        switch (DataVizByteSource::DetectFormat(FilePath))
+        {
+        case DataVizByteSource::EFormat::Plain:
+            return FileSize;
+        case DataVizByteSource::EFormat::Gzip:
+        {
+            TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+            uint8 Trailer[4] = {};
+            if (!Handle || FileSize < 18 || !Handle->Seek(FileSize - 4) || !Handle->Read(Trailer, 4))
+            {
+                return INDEX_NONE;
+            }
+            const int64 DecodedSize = Trailer[0] | (Trailer[1] << 8) | (Trailer[2] << 16) | (static_cast<int64>(Trailer[3]) << 24);
+            return DecodedSize >= FileSize ? DecodedSize : INDEX_NONE;
+        }
+        default:
+            return INDEX_NONE;
+        }
+    }
+
+    bool ReadDelimitedInfo(const FString& FilePath, FDataFileInfo& OutInfo)
+    {
+        TUniquePtr<IDataByteSource> Source = DataVizByteSource::OpenFile(FilePath);
+        if (!Source)
+        {
+            return false;
+        }
+
+        TArray64<uint8> Sample;
+        Sample.SetNumUninitialized(SampleSize);
+        const int64 Filled = Source->Read(Sample.GetData(), Sample.Num());
+        if (Filled <= 0)
+        {
+            return false;
+        }
+
+        const TConstArrayView64<uint8> Bytes(Sample.GetData(), Filled);
+        FCSVTokenizer Tokenizer;
+        FChartDataset Dataset;
+        FCSVFieldLayout Layout;
+        const int64 DataStart = Tokenizer.ParseSchema(Bytes, Dataset, Layout);
+        if (Dataset.Columns.Num() == 0)
+        {
+            return false;
+        }
+
+        // A short read means the sample is the whole file
+        const bool bWholeFile = Filled < SampleSize;
+        const int64 Consumed = Tokenizer.ParseRecords(Bytes.Slice(DataStart, Filled - DataStart), Layout, Dataset, bWholeFile);
+
+        for (const FChartColumn& Column : Dataset.Columns)
+        {
+            OutInfo.Columns.Add(Column.Name);
+        }
+
+        if (bWholeFile)
+        {
+            OutInfo.EstimatedRows = Dataset.NumRows;
+        }
+        else if (Dataset.NumRows > 0 && Consumed > 0)
+        {
+            const int64 TextSize = GetTextSize(FilePath, OutInfo.FileSize);
+            if (TextSize > DataStart)
+            {
+                OutInfo.EstimatedRows = FMath::RoundToInt64(static_cast<double>(TextSize - DataStart) * Dataset.NumRows / Consumed);
+            }
+        }
+
+        const FChartColumn* XColumn = Dataset.GetColumn(TEXT("X"));
+        const bool bOrderedX = XColumn && XColumn->Type == EChartColumnType::Float
+            && IsNonDecreasing(XColumn->GetFloats().GetData(), FMath::Min(XColumn->Num(), MaxOrderedCheckRows));
+        OutInfo.SuggestedChartType = SuggestChartType(OutInfo.Columns, bOrderedX);
+        return true;
+    }
+
+    bool ReadArrowInfo(const FString& FilePath, FDataFileInfo& OutInfo)
+    {
+        const TSharedPtr<FArrowFile> File = FArrowFile::Open(FilePath);
+        if (!File.IsValid())
+        {
+            return false;
+        }
+
+        bool bOrderedX = false;
+        for (const FArrowColumn& Column : File->GetColumns())
+        {
+            OutInfo.Columns.Add(Column.Name);
+            if (Column.Name != FName(TEXT("X")) || Column.Chunks.Num() == 0 || Column.Chunks[0].NullCount > 0)
+            {
+                continue;
+            }
+
+            // Only the first batch is checked, which keeps the index from paging in whole columns
+            const FArrowColumnChunk& Chunk = Column.Chunks[0];
+            const int64 Count = FMath::Min<int64>(Chunk.Length, MaxOrderedCheckRows);
+            switch (Column.Type)
+            {
+            case EArrowValueType::Float32: bOrderedX = IsNonDecreasing(Chunk.GetValues<float>(), Count); break;
+            case EArrowValueType::Float64: bOrderedX = IsNonDecreasing(Chunk.GetValues<double>(), Count); break;
+            case EArrowValueType::Int32:   bOrderedX = IsNonDecreasing(Chunk.GetValues<int32>(), Count); break;
+            case EArrowValueType::Int64:   bOrderedX = IsNonDecreasing(Chunk.GetValues<int64>(), Count); break;
+            default: break;
+            }
+        }
+
+        OutInfo.EstimatedRows = File->GetNumRows();
+        OutInfo.SuggestedChartType = SuggestChartType(OutInfo.Columns, bOrderedX);
+        return true;
+    }
+
+    // Stats the files under Directory, reusing what Known has for files whose size and timestamp did not change
+    TMap<FString, FDataFileInfo> ScanDirectory(const FString& Directory, const TMap<FString, FDataFileInfo>& Known)
+    {
+        TArray<FDataFileInfo> Found;
+        FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStatRecursively(*Directory,
+            [&Found](const TCHAR* Path, const FFileStatData& StatData)
+            {
+                if (!StatData.bIsDirectory && IsDataFileName(FPaths::GetCleanFilename(Path)))
+                {
+                    FDataFileInfo& Info = Found.AddDefaulted_GetRef();
+                    Info.FilePath = Path;
+                    FPaths::NormalizeFilename(Info.FilePath);
+                    Info.FileSize = StatData.FileSize;
+                    Info.ModificationTime = StatData.ModificationTime;
+                }
+                return true;
+            });
+
+        TArray<int32> ChangedIndices;
+        for (int32 Index = 0; Index < Found.Num(); ++Index)
+        {
+            const FDataFileInfo* Previous = Known.Find(Found[Index].FilePath);
+            if (Previous && Previous->FileSize == Found[Index].FileSize && Previous->ModificationTime == Found[Index].ModificationTime)
+            {
+                Found[Index] = *Previous;
+            }
+            else
+            {
+                ChangedIndices.Add(Index);
+            }
+        }
+
+        // Files that fail to parse stay listed with their size and time; loading them reports the error
+        ParallelFor(ChangedIndices.Num(), [&Found, &ChangedIndices](int32 Index)
+        {
+            FDataFileInfo& Info = Found[ChangedIndices[Index]];
+            FDataFileIndex::ReadFileInfo(Info.FilePath, Info);
+        }, EParallelForFlags::Unbalanced);
+
+        TMap<FString, FDataFileInfo> Scanned;
+        Scanned.Reserve(Found.Num());
+        for (FDataFileInfo& Info : Found)
+        {
+            FString Key = Info.FilePath;
+            Scanned.Add(MoveTemp(Key), MoveTemp(Info));
+        }
+        return Scanned;
+    }
+}
+
+TSharedRef<FDataFileIndex> FDataFileIndex::Create(const FString& Directory)
+{
+    TSharedRef<FDataFileIndex> Index = MakeShareable(new FDataFileIndex());
+
+    // Watcher notifications carry absolute paths, so the index keys files the same way
+    Index->Directory = FPaths::ConvertRelativePathToFull(Directory);
+    FPaths::NormalizeDirectoryName(Index->Directory);
+
+    Index->StartWatching();
+    Index->Rescan();
+    return Index;
+}
+
+FDataFileIndex::~FDataFileIndex()
+{
+#if WITH_DATAVIZ_DIRECTORY_WATCHER
+    if (WatcherHandle.IsValid())
+    {
+        if (FDirectoryWatcherModule* Module = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+        {
+            if (IDirectoryWatcher* Watcher = Module->Get())
+            {
+                Watcher->UnregisterDirectoryChangedCallback_Handle(Directory, WatcherHandle);
+            }
+        }
+    }
+#endif
+}
+
+bool FDataFileIndex::ReadFileInfo(const FString& FilePath, FDataFileInfo& OutInfo)
+{
+    OutInfo.FilePath = FilePath;
+    OutInfo.bIsFolder = false;
+    OutInfo.Columns.Reset();
+    OutInfo.EstimatedRows = INDEX_NONE;
+    OutInfo.SuggestedChartType = EChartType::Scatter;
+
+    const FFileStatData StatData = IFileManager::Get().GetStatData(*FilePath);
+    if (!StatData.bIsValid || StatData.bIsDirectory)
+    {
+        return false;
+    }
+    OutInfo.FileSize = StatData.FileSize;
+    OutInfo.ModificationTime = StatData.ModificationTime;
+
+    if (FArrowFile::IsArrowFile(FilePath))
+    {
+        return ReadArrowInfo(FilePath, OutInfo);
+    }
+    if (FPointCloudReader::IsPointCloudFile(FilePath))
+    {
+        return FPointCloudReader::ReadHeader(FilePath, OutInfo.Columns, OutInfo.EstimatedRows);
+    }
+    return ReadDelimitedInfo(FilePath, OutInfo);
+}
+
+void FDataFileIndex::Rescan()
+{
+    const uint32 ScanSerial = LatestScanSerial = ++LatestSerial;
+    ++PendingScans;
+
+    // Workers only hold a weak reference and hand results back to the game thread, which owns the entries
+    TWeakPtr<FDataFileIndex> WeakIndex = AsShared();
+    Async(EAsyncExecution::ThreadPool, [WeakIndex, ScanSerial, ScanRoot = Directory, Known = Files]()
+    {
+        TMap<FString, FDataFileInfo> Scanned = ScanDirectory(ScanRoot, Known);
+        AsyncTask(ENamedThreads::GameThread, [WeakIndex, ScanSerial, Scanned = MoveTemp(Scanned)]() mutable
+        {
+            if (const TSharedPtr<FDataFileIndex> Index = WeakIndex.Pin())
+            {
+                Index->ApplyScan(ScanSerial, MoveTemp(Scanned));
+            }
+        });
+    });
+}
+
+void FDataFileIndex::ApplyScan(uint32 ScanSerial, TMap<FString, FDataFileInfo>&& ScannedFiles)
+{
+    --PendingScans;
+    if (ScanSerial != LatestScanSerial)
+    {
+        // A newer scan is on its way
+        return;
+    }
+
+    // Paths refreshed since the scan started keep the refreshed state, which was read later than the scan's
+    for (auto It = RefreshSerials.CreateIterator(); It; ++It)
+    {
+        if (It->Value < ScanSerial)
+        {
+            It.RemoveCurrent();
+        }
+        else if (const FDataFileInfo* Refreshed = Files.Find(It->Key))
+        {
+            ScannedFiles.Add(It->Key, *Refreshed);
+        }
+        else
+        {
+            ScannedFiles.Remove(It->Key);
+        }
+    }
+    Files = MoveTemp(ScannedFiles);
+    AppliedScanSerial = ScanSerial;
+    RebuildEntries();
+}
+
+void FDataFileIndex::RefreshFiles(TArray<FString> Paths)
+{
+    const uint32 RefreshSerial = ++LatestSerial;
+    ++PendingScans;
+    TWeakPtr<FDataFileIndex> WeakIndex = AsShared();
+    Async(EAsyncExecution::ThreadPool, [WeakIndex, RefreshSerial, Paths = MoveTemp(Paths)]()
+    {
+        TArray<FDataFileInfo> Infos;
+        Infos.SetNum(Paths.Num());
+        ParallelFor(Paths.Num(), [&Paths, &Infos](int32 Index)
+        {
+            FDataFileIndex::ReadFileInfo(Paths[Index], Infos[Index]);
+        }, EParallelForFlags::Unbalanced);
+
+        TArray<FString> Removed;
+        for (int32 Index = Infos.Num() - 1; Index >= 0; --Index)
+        {
+            if (!IFileManager::Get().FileExists(*Paths[Index]))
+            {
+                Removed.Add(Paths[Index]);
+                Infos.RemoveAtSwap(Index);
+            }
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakIndex, RefreshSerial, Infos = MoveTemp(Infos), Removed = MoveTemp(Removed)]() mutable
+        {
+            if (const TSharedPtr<FDataFileIndex> Index = WeakIndex.Pin())
+            {
+                Index->ApplyRefresh(RefreshSerial, MoveTemp(Infos), Removed);
+            }
+        });
+    });
+}
+
+void FDataFileIndex::ApplyRefresh(uint32 RefreshSerial, TArray<FDataFileInfo>&& Infos, const TArray<FString>& Removed)
+{
+    --PendingScans;
+
+    // False when the applied scan or a refresh already landed for the path started later; a scan still running that
+    // started later replaces the path again when it lands
+    const auto Claim = [this, RefreshSerial](const FString& FilePath)
+    {
+        if (RefreshSerial < AppliedScanSerial)
+        {
+            return false;
+        }
+        uint32& Serial = RefreshSerials.FindOrAdd(FilePath, 0);
+        if (Serial > RefreshSerial)
+        {
+            return false;
+        }
+        Serial = RefreshSerial;
+        return true;
+    };
+
+    for (const FString& FilePath : Removed)
+    {
+        if (Claim(FilePath))
+        {
+            Files.Remove(FilePath);
+        }
+    }
+    for (FDataFileInfo& Info : Infos)
+    {
+        if (Claim(Info.FilePath))
+        {
+            FString Key = Info.FilePath;
+            Files.Add(MoveTemp(Key), MoveTemp(Info));
+        }
+    }
+    RebuildEntries();
+}
+
+void FDataFileIndex::RebuildEntries()
+{
+    Entries.Reset();
+
+    // Files in subfolders are grouped under their top-level subfolder, which loads as one partitioned dataset.
+    // Shards merge in path order, so the first shard decides a folder's columns.
+    TMap<FString, FDataFileInfo> Folders;
+    TMap<FString, const FDataFileInfo*> FirstShards;
+    const FString Prefix = Directory + TEXT("/");
+    for (const TPair<FString, FDataFileInfo>& Pair : Files)
+    {
+        const FString RelativePath = Pair.Key.RightChop(Prefix.Len());
+        int32 SlashIndex = INDEX_NONE;
+        if (!RelativePath.FindChar(TEXT('/'), SlashIndex))
+        {
+            Entries.Add(Pair.Value);
+            continue;
+        }
+
+        const FString FolderPath = Prefix + RelativePath.Left(SlashIndex);
+        FDataFileInfo* Folder = Folders.Find(FolderPath);
+        if (!Folder)
+        {
+            Folder = &Folders.Add(FolderPath);
+            Folder->FilePath = FolderPath;
+            Folder->bIsFolder = true;
+            Folder->EstimatedRows = 0;
+        }
+        Folder->FileSize += Pair.Value.FileSize;
+        Folder->ModificationTime = FMath::Max(Folder->ModificationTime, Pair.Value.ModificationTime);
+        if (Folder->EstimatedRows != INDEX_NONE)
+        {
+            Folder->EstimatedRows = Pair.Value.EstimatedRows != INDEX_NONE ? Folder->EstimatedRows + Pair.Value.EstimatedRows : INDEX_NONE;
+        }
+
+        const FDataFileInfo*& FirstShard = FirstShards.FindOrAdd(FolderPath);
+        if (!FirstShard || Pair.Key < FirstShard->FilePath)
+        {
+            FirstShard = &Pair.Value;
+        }
+    }
+
+    auto ByPath = [](const FDataFileInfo& A, const FDataFileInfo& B) { return A.FilePath < B.FilePath; };
+    Entries.Sort(ByPath);
+
+    TArray<FDataFileInfo> FolderEntries;
+    FolderEntries.Reserve(Folders.Num());
+    for (TPair<FString, FDataFileInfo>& Pair : Folders)
+    {
+        const FDataFileInfo* FirstShard = FirstShards.FindRef(Pair.Key);
+        Pair.Value.Columns = FirstShard->Columns;
+        Pair.Value.SuggestedChartType = FirstShard->SuggestedChartType;
+        FolderEntries.Add(MoveTemp(Pair.Value));
+    }
+    FolderEntries.Sort(ByPath);
+    Entries.Append(MoveTemp(FolderEntries));
+
+    ++Version;
+}
+
+TArray<FDataFileInfo> FDataFileIndex::GetEntries() const
+{
+    return Entries;
+}
+
+const FDataFileInfo* FDataFileIndex::FindEntry(const FString& Path) const
+{
+    return Entries.FindByPredicate([&Path](const FDataFileInfo& Entry) { return Entry.FilePath == Path; });
+}
+
+void FDataFileIndex::StartWatching()
+{
+#if WITH_DATAVIZ_DIRECTORY_WATCHER
+    FDirectoryWatcherModule& Module = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    if (IDirectoryWatcher* Watcher = Module.Get())
+    {
+        IFileManager::Get().MakeDirectory(*Directory, true);
+        Watcher->RegisterDirectoryChangedCallback_Handle(Directory,
+            IDirectoryWatcher::FDirectoryChanged::CreateSP(this, &FDataFileIndex::OnDirectoryChanged),
+            WatcherHandle, IDirectoryWatcher::WatchOptions::IncludeDirectoryChanges);
+    }
+#endif
+}
+
+void FDataFileIndex::Tick(float DeltaTime)
+{
+#if WITH_DATAVIZ_DIRECTORY_WATCHER && !WITH_EDITOR
+    if (WatcherHandle.IsValid())
+    {
+        if (IDirectoryWatcher* Watcher = FModuleManager::GetModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get())
+        {
+            Watcher->Tick(DeltaTime);
+        }
+    }
+#endif
+}
+
+#if WITH_DATAVIZ_DIRECTORY_WATCHER
+void FDataFileIndex::OnDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+    TArray<FString> ChangedFiles;
+    for (const FFileChangeData& Change : Changes)
+    {
+        // Folder changes (and watcher overflow) can touch any number of files; restatting everything is cheap
+        // because unchanged files keep their metadata
+        if (Change.Action == FFileChangeData::FCA_RescanRequired || !IsDataFileName(FPaths::GetCleanFilename(Change.Filename)))
+        {
+            Rescan();
+            return;
+        }
+
+        FString FilePath = Change.Filename;
+        FPaths::NormalizeFilename(FilePath);
+        ChangedFiles.AddUnique(FilePath);
+    }
+
+    if (ChangedFiles.Num() > 0)
+    {
+        RefreshFiles(MoveTemp(ChangedFiles));
+    }
+}
+#endif
@@ -0,0 +1,158 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Math/RandomStream.h"
+#include "Data/ChartDataset.h"
+#include "Data/CSVTokenizer.h"
+
+// Console benchmark for the CSV ingestion path:
+//   VRDataViz.Benchmark.CSV [SizeMB=256] [Columns=3]
+// Builds a numeric CSV in memory (fixed six-decimal values, like typical exported sensor data),
+// parses it on 1 (the serial tokenizer), 2, 4, ... cores, and logs throughput per core count plus
+// how many parsed values differ from the correctly rounded float.
+namespace
+{
+    constexpr int32 BenchmarkSeed = 20240611;
+    constexpr int32 BenchmarkRuns = 3;
+
+    int64 NextScaledValue(FRandomStream& Stream)
+    {
+        // Values in (-100, 100) scaled by 1e6; the random divisor varies the field lengths
+        const int64 Scaled = Stream.RandRange(0, 99999999);
+        const int64 Divisor = 1 + Stream.RandRange(0, 3) * 333;
+        return Stream.RandRange(0, 1) ? Scaled / Divisor : -(Scaled / Divisor);
+    }
+
+    void AppendFixed(TArray64<uint8>& Out, int64 ScaledValue)
+    {
+        if (ScaledValue < 0)
+        {
+            Out.Add('-');
+            ScaledValue = -ScaledValue;
+        }
+
+        ANSICHAR Digits[32];
+        int32 Count = 0;
+        int64 Fraction = ScaledValue % 1000000;
+        for (int32 Digit = 0; Digit < 6; ++Digit)
+        {
+            Digits[Count++] = static_cast<ANSICHAR>('0' + Fraction % 10);
+            Fraction /= 10;
+        }
+        Digits[Count++] = '.';
+        int64 Integer = ScaledValue / 1000000;
+        do
+        {
+            Digits[Count++] = static_cast<ANSICHAR>('0' + Integer % 10);
+            Integer /= 10;
+        } while (Integer > 0);
+
+        while (Count > 0)
+        {
+            Out.Add(static_cast<uint8>(Digits[--Count]));
+        }
+    }
+
+    void RunCSVBenchmark(const TArray<FString>& Args)
+    {
+        const int32 SizeMB = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 4096) : 256;
+        const int32 NumColumns = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 1, 64) : 3;
+        const int64 TargetBytes = static_cast<int64>(SizeMB) * 1024 * 1024;
+
+        TArray64<uint8> Bytes;
+        Bytes.Reserve(TargetBytes + 256);
+        for (int32 Column = 0; Column < NumColumns; ++Column)
+        {
+            const FString Header = FString::Printf(TEXT("%sC%d"), Column > 0 ? TEXT(",") : TEXT(""), Column);
+            for (const TCHAR Char : Header)
+            {
+                Bytes.Add(static_cast<uint8>(Char));
+            }
+        }
+        Bytes.Add('\n');
+
+        FRandomStream Stream(BenchmarkSeed);
+        int64 NumRows = 0;
+        while (Bytes.Num() < TargetBytes)
+        {
+            for (int32 Column = 0; Column < NumColumns; ++Column)
+            {
+                if (Column > 0)
+                {
+                    Bytes.Add(',');
+                }
+                AppendFixed(Bytes, NextScaledValue(Stream));
+            }
+            Bytes.Add('\n');
+            ++NumRows;
+        }
+
+        // Best-of-N parse time with at most MaxChunks ranges parsed at once (1 = the serial tokenizer)
+        const auto TimeParse = [&Bytes](int32 MaxChunks, FChartDataset& OutDataset)
+        {
+            FCSVParseOptions Options;
+            Options.MaxParallelChunks = MaxChunks;
+            Options.MinParallelChunkBytes = 1024 * 1024;
+            FCSVTokenizer Tokenizer(Options);
+
+            double BestSeconds = TNumericLimits<double>::Max();
+            for (int32 Run = 0; Run < BenchmarkRuns; ++Run)
+            {
+                const double StartTime = FPlatformTime::Seconds();
+                FCSVFieldLayout Layout;
+                const int64 DataStart = Tokenizer.ParseSchema(Bytes, OutDataset, Layout);
+                const TConstArrayView64<uint8> Records = TConstArrayView64<uint8>(Bytes).Slice(DataStart, Bytes.Num() - DataStart);
+                if (MaxChunks == 1)
+                {
+                    Tokenizer.ParseRecords(Records, Layout, OutDataset, true);
+                }
+                else
+                {
+                    Tokenizer.ParseRecordsParallel(Records, Layout, OutDataset);
+                }
+                BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+            }
+            return BestSeconds;
+        };
+
+        UE_LOG(LogTemp, Log, TEXT("VRDataViz.Benchmark.CSV - %.1f MB, %lld rows x %d columns, best of %d runs"),
+            Bytes.Num() / (1024.0 * 1024.0), NumRows, NumColumns, BenchmarkRuns);
+
+        // Scaling curve: 1, 2, 4, ... cores up to every task graph worker plus the calling thread
+        const int32 MaxCores = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+        FChartDataset Dataset;
+        double SerialSeconds = 0.0;
+        for (int32 Cores = 1; ; Cores = FMath::Min(Cores * 2, MaxCores))
+        {
+            const double Seconds = TimeParse(Cores, Dataset);
+            SerialSeconds = Cores == 1 ? Seconds : SerialSeconds;
+            UE_LOG(LogTemp, Log, TEXT("VRDataViz.Benchmark.CSV - %2d cores: %.3f s, %.2f GB/s total, %.2f GB/s per core, %.2fx"),
+                Cores, Seconds, Bytes.Num() / Seconds / 1.0e9, Bytes.Num() / Seconds / 1.0e9 / Cores, SerialSeconds / Seconds);
+            if (Cores >= MaxCores)
+            {
+                break;
+            }
+        }
+
+        // Replay the generator against the widest parallel parse: checks float rounding and that row order survived the merge
+        Stream.Initialize(BenchmarkSeed);
+        int64 Mismatches = 0;
+        for (int32 Row = 0; Row < Dataset.NumRows; ++Row)
+        {
+            for (int32 Column = 0; Column < NumColumns; ++Column)
+            {
+                const float Expected = static_cast<float>(static_cast<double>(NextScaledValue(Stream)) / 1000000.0);
+                Mismatches += Dataset.Columns[Column].Floats[Row] != Expected ? 1 : 0;
+            }
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("VRDataViz.Benchmark.CSV - Parsed %d of %lld rows, %lld values differ from the correctly rounded float"),
+            Dataset.NumRows, NumRows, Mismatches);
+    }
+
+    FAutoConsoleCommand CSVBenchmarkCommand(
+        TEXT("VRDataViz.Benchmark.CSV"),
+        TEXT("Parses a generated numeric CSV and logs tokenizer throughput. Args: [SizeMB=256] [Columns=3]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunCSVBenchmark));
+}
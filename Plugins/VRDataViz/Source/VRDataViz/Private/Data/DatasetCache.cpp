@@ -0,0 +1,490 @@
+#include "Data/DatasetCache.h"
+#include "Data/ChartDataset.h"
+#include "Data/ChartDatasetLoader.h"
+#include "Data/CompressedDataset.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+    // Heap memory of a dataset; columns viewed in a mapped file are paged by the OS and not counted
+    int64 GetAllocatedBytes(const FChartDataset& Dataset)
+    {
+        int64 Bytes = Dataset.Columns.GetAllocatedSize();
+        for (const FChartColumn& Column : Dataset.Columns)
+        {
+            Bytes += Column.Floats.GetAllocatedSize() + Column.Codes.GetAllocatedSize() + Column.Labels.GetAllocatedSize();
+        }
+        return Bytes;
+    }
+
+    // False for directories and globs, which are not cached
+    bool StatFile(const FString& FilePath, int64& OutFileSize, FDateTime& OutModificationTime)
+    {
+        IFileManager& FileManager = IFileManager::Get();
+        OutFileSize = FileManager.FileSize(*FilePath);
+        OutModificationTime = FileManager.GetTimeStamp(*FilePath);
+        return OutFileSize >= 0;
+    }
+
+    // LoadDataFile, except that a file read whole for tokenizing is parsed from RawBytes when given. A projected load
+    // reads the bytes into RawBytes itself, so the file can be parsed again for other columns without a read.
+    TSharedPtr<FChartDataset> LoadFile(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options, TSharedPtr<const TArray64<uint8>>& InOutRawBytes)
+    {
+        if (!FChartDatasetLoader::IsInMemoryCSVFile(FilePath, MaxInMemoryBytes) || (!InOutRawBytes.IsValid() && Options.Columns.Num() == 0))
+        {
+            InOutRawBytes.Reset();
+            return FChartDatasetLoader::LoadDataFile(FilePath, MaxInMemoryBytes, MaxStreamedRows, Options);
+        }
+
+        if (!InOutRawBytes.IsValid())
+        {
+            const TSharedRef<TArray64<uint8>> Bytes = MakeShared<TArray64<uint8>>();
+            if (!FFileHelper::LoadFileToArray(*Bytes, *FilePath))
+            {
+                UE_LOG(LogTemp, Error, TEXT("DatasetCache - Failed to read file: %s"), *FilePath);
+                return nullptr;
+            }
+            InOutRawBytes = Bytes;
+        }
+        return FChartDatasetLoader::ParseCSV(*InOutRawBytes, Options);
+    }
+
+    void RunStatsCommand(const TArray<FString>& Args)
+    {
+        FDatasetCache& Cache = FDatasetCache::Get();
+        Cache.LogStats();
+        if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+        {
+            Cache.ResetStats();
+        }
+    }
+
+    FAutoConsoleCommand DatasetCacheStatsCommand(
+        TEXT("VRDataViz.DatasetCache.Stats"),
+        TEXT("Logs dataset cache and prefetch hit rates. Args: [reset]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunStatsCommand));
+}
+
+FDatasetCache& FDatasetCache::Get()
+{
+    static FDatasetCache Cache;
+    return Cache;
+}
+
+void FDatasetCache::Prefetch(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const TArray<FName>& Columns)
+{
+    check(IsInGameThread());
+
+    int64 FileSize = 0;
+    FDateTime ModificationTime;
+    const bool bIsFile = StatFile(FilePath, FileSize, ModificationTime);
+
+    // The user moved on: whatever is still loading for another file is wasted work
+    for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; --EntryIndex)
+    {
+        const FEntry& Entry = Entries[EntryIndex];
+        const bool bSameLoad = Entry.FilePath == FilePath && Entry.MaxInMemoryBytes == MaxInMemoryBytes && Entry.MaxStreamedRows == MaxStreamedRows && Entry.Columns == Columns;
+        if (Entry.Pending.IsValid() && !Entry.Result.IsReady() && !bSameLoad)
+        {
+            CancelLoad(EntryIndex);
+        }
+    }
+    if (!bIsFile)
+    {
+        return;
+    }
+
+    RemoveOutdated(FilePath, FileSize, ModificationTime);
+    const int32 Existing = FindEntry(FilePath, MaxInMemoryBytes, MaxStreamedRows, Columns);
+    if (Existing != INDEX_NONE)
+    {
+        FEntry& Entry = Entries[Existing];
+        Entry.LastUse = ++UseCounter;
+        if (Entry.Compressed.IsValid() && !Entry.Pending.IsValid())
+        {
+            StartDecompress(Entry);
+        }
+        return;
+    }
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.FilePath = FilePath;
+    Entry.MaxInMemoryBytes = MaxInMemoryBytes;
+    Entry.MaxStreamedRows = MaxStreamedRows;
+    Entry.Columns = Columns;
+    Entry.FileSize = FileSize;
+    Entry.ModificationTime = ModificationTime;
+    Entry.LastUse = ++UseCounter;
+    Entry.bPrefetch = true;
+    StartLoad(Entry);
+    ++Stats.PrefetchesStarted;
+
+    Trim();
+}
+
+void FDatasetCache::CancelPrefetch()
+{
+    check(IsInGameThread());
+    for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; --EntryIndex)
+    {
+        if (Entries[EntryIndex].Pending.IsValid() && !Entries[EntryIndex].Result.IsReady())
+        {
+            CancelLoad(EntryIndex);
+        }
+    }
+}
+
+TSharedPtr<const FChartDataset> FDatasetCache::Load(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const TArray<FName>& Columns)
+{
+    check(IsInGameThread());
+
+    FCSVParseOptions Options;
+    Options.Columns = Columns;
+
+    int64 FileSize = 0;
+    FDateTime ModificationTime;
+    if (!StatFile(FilePath, FileSize, ModificationTime))
+    {
+        return FChartDatasetLoader::LoadDataFile(FilePath, MaxInMemoryBytes, MaxStreamedRows, Options);
+    }
+
+    ++Stats.Requests;
+    RemoveOutdated(FilePath, FileSize, ModificationTime);
+    const int32 EntryIndex = FindEntry(FilePath, MaxInMemoryBytes, MaxStreamedRows, Columns);
+
+    if (EntryIndex == INDEX_NONE)
+    {
+        ++Stats.Misses;
+        TSharedPtr<const TArray64<uint8>> RawBytes = FindRawBytes(FilePath);
+        Stats.RawReuses += RawBytes.IsValid() ? 1 : 0;
+        const double StartTime = FPlatformTime::Seconds();
+        TSharedPtr<const FChartDataset> Dataset = LoadFile(FilePath, MaxInMemoryBytes, MaxStreamedRows, Options, RawBytes);
+        Stats.MissSeconds += FPlatformTime::Seconds() - StartTime;
+        if (!Dataset.IsValid())
+        {
+            return nullptr;
+        }
+
+        FEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.FilePath = FilePath;
+        Entry.MaxInMemoryBytes = MaxInMemoryBytes;
+        Entry.MaxStreamedRows = MaxStreamedRows;
+        Entry.Columns = Columns;
+        Entry.FileSize = FileSize;
+        Entry.ModificationTime = ModificationTime;
+        Entry.Dataset = Dataset;
+        Entry.AllocatedBytes = GetAllocatedBytes(*Dataset);
+        Entry.RawBytes = RawBytes;
+        Entry.LastUse = ++UseCounter;
+        Entry.bUsed = true;
+        Trim();
+        return Dataset;
+    }
+
+    FEntry& Entry = Entries[EntryIndex];
+    if (Entry.Pending.IsValid())
+    {
+        if (Entry.Result.IsReady())
+        {
+            ++Stats.Hits;
+        }
+        else
+        {
+            ++Stats.InFlightHits;
+            const double StartTime = FPlatformTime::Seconds();
+            Entry.Result.Wait();
+            Stats.WaitSeconds += FPlatformTime::Seconds() - StartTime;
+        }
+        CollectLoad(Entry);
+    }
+    else
+    {
+        ++Stats.Hits;
+    }
+
+    if (Entry.Compressed.IsValid())
+    {
+        // Not prefetched: still decoded on the worker pool, the game thread only waits for it
+        StartDecompress(Entry);
+        Entry.Result.Wait();
+        CollectLoad(Entry);
+    }
+
+    Entry.LastUse = ++UseCounter;
+    Entry.bUsed = true;
+    const TSharedPtr<const FChartDataset> Dataset = Entry.Dataset;
+    if (!Dataset.IsValid())
+    {
+        // A failed prefetch is not kept, so the next request tries the file again
+        RemoveEntry(EntryIndex);
+    }
+    Trim();
+    return Dataset;
+}
+
+void FDatasetCache::SetMaxBytes(int64 InMaxBytes)
+{
+    MaxBytes = FMath::Max<int64>(InMaxBytes, 0);
+    Trim();
+}
+
+void FDatasetCache::Empty()
+{
+    for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; --EntryIndex)
+    {
+        RemoveEntry(EntryIndex);
+    }
+}
+
+void FDatasetCache::LogStats() const
+{
+    const int64 CachedBytes = GetCachedBytes();
+    UE_LOG(LogTemp, Log, TEXT("DatasetCache - %d requests, hit rate %.0f%%: %d hits, %d in-flight hits (%.3f s waiting), %d misses (%.3f s loading)"),
+        Stats.Requests, Stats.GetHitRate() * 100.0f, Stats.Hits, Stats.InFlightHits, Stats.WaitSeconds, Stats.Misses, Stats.MissSeconds);
+    UE_LOG(LogTemp, Log, TEXT("DatasetCache - %d prefetches started, %d canceled, %d unused; %d loads parsed from cached file bytes; %d entries, %.1f of %.1f MB"),
+        Stats.PrefetchesStarted, Stats.PrefetchesCanceled, Stats.PrefetchesUnused, Stats.RawReuses, Entries.Num(), CachedBytes / (1024.0 * 1024.0), MaxBytes / (1024.0 * 1024.0));
+    UE_LOG(LogTemp, Log, TEXT("DatasetCache - %d idle datasets compressed (%.3f s), %d decompressed on the worker pool (%.3f s)"),
+        Stats.Compressions, Stats.CompressSeconds, Stats.Decompressions, Stats.DecompressSeconds);
+}
+
+int32 FDatasetCache::FindEntry(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const TArray<FName>& Columns) const
+{
+    return Entries.IndexOfByPredicate([&](const FEntry& Entry)
+    {
+        return Entry.FilePath == FilePath && Entry.MaxInMemoryBytes == MaxInMemoryBytes && Entry.MaxStreamedRows == MaxStreamedRows && Entry.Columns == Columns;
+    });
+}
+
+TSharedPtr<const TArray64<uint8>> FDatasetCache::FindRawBytes(const FString& FilePath) const
+{
+    const FEntry* Entry = Entries.FindByPredicate([&FilePath](const FEntry& Candidate) { return Candidate.FilePath == FilePath && Candidate.RawBytes.IsValid(); });
+    return Entry ? Entry->RawBytes : nullptr;
+}
+
+void FDatasetCache::StartLoad(FEntry& Entry)
+{
+    const TSharedRef<FPendingLoad> Pending = MakeShared<FPendingLoad>();
+    Pending->RawBytes = FindRawBytes(Entry.FilePath);
+    Stats.RawReuses += Pending->RawBytes.IsValid() ? 1 : 0;
+    Entry.Pending = Pending;
+    Entry.Result = Async(EAsyncExecution::ThreadPool, [Pending, FilePath = Entry.FilePath, MaxInMemoryBytes = Entry.MaxInMemoryBytes, MaxStreamedRows = Entry.MaxStreamedRows, Columns = Entry.Columns]()
+    {
+        FCSVParseOptions Options;
+        Options.Columns = Columns;
+        Options.CancelFlag = &Pending->bCanceled;
+        TSharedPtr<const TArray64<uint8>> RawBytes = Pending->RawBytes;
+        const TSharedPtr<FChartDataset> Dataset = LoadFile(FilePath, MaxInMemoryBytes, MaxStreamedRows, Options, RawBytes);
+        if (Dataset.IsValid() && !Pending->bCanceled)
+        {
+            Pending->AllocatedBytes = GetAllocatedBytes(*Dataset);
+            Pending->Dataset = Dataset;
+            Pending->RawBytes = RawBytes;
+        }
+    });
+}
+
+void FDatasetCache::StartDecompress(FEntry& Entry)
+{
+    const TSharedRef<FPendingLoad> Pending = MakeShared<FPendingLoad>();
+    Pending->Compressed = Entry.Compressed;
+    Pending->RawBytes = Entry.RawBytes;
+    Entry.Pending = Pending;
+    ++Stats.Decompressions;
+    Entry.Result = Async(EAsyncExecution::ThreadPool, [Pending]()
+    {
+        if (Pending->bCanceled)
+        {
+            return;
+        }
+        const double StartTime = FPlatformTime::Seconds();
+        const TSharedRef<FChartDataset> Dataset = Pending->Compressed->Decompress();
+        Pending->AllocatedBytes = GetAllocatedBytes(*Dataset);
+        Pending->Dataset = Dataset;
+        Pending->DecompressSeconds = FPlatformTime::Seconds() - StartTime;
+    });
+}
+
+void FDatasetCache::CollectLoad(FEntry& Entry)
+{
+    Entry.Dataset = Entry.Pending->Dataset;
+    Entry.AllocatedBytes = Entry.Pending->AllocatedBytes;
+    Entry.RawBytes = Entry.Dataset.IsValid() ? Entry.Pending->RawBytes : nullptr;
+    Entry.Compressed.Reset();
+    Stats.DecompressSeconds += Entry.Pending->DecompressSeconds;
+    Entry.Pending.Reset();
+    Entry.Result = TFuture<void>();
+}
+
+void FDatasetCache::CancelLoad(int32 EntryIndex)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    if (!Entry.Compressed.IsValid())
+    {
+        RemoveEntry(EntryIndex);
+        return;
+    }
+    Entry.Pending->bCanceled = true;
+    Entry.Pending.Reset();
+    Entry.Result = TFuture<void>();
+}
+
+int64 FDatasetCache::GetCachedBytes() const
+{
+    int64 Bytes = 0;
+    TSet<const TArray64<uint8>*> CountedFiles;
+    for (const FEntry& Entry : Entries)
+    {
+        Bytes += Entry.AllocatedBytes;
+        bool bCounted = false;
+        if (Entry.RawBytes.IsValid())
+        {
+            CountedFiles.Add(Entry.RawBytes.Get(), &bCounted);
+            Bytes += bCounted ? 0 : Entry.RawBytes->Num();
+        }
+    }
+    return Bytes;
+}
+
+void FDatasetCache::RemoveEntry(int32 EntryIndex)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    if (Entry.Pending.IsValid() && !Entry.Result.IsReady())
+    {
+        Entry.Pending->bCanceled = true;
+        ++Stats.PrefetchesCanceled;
+    }
+    else if (Entry.bPrefetch && !Entry.bUsed)
+    {
+        ++Stats.PrefetchesUnused;
+    }
+    Entries.RemoveAt(EntryIndex);
+}
+
+void FDatasetCache::RemoveOutdated(const FString& FilePath, int64 FileSize, const FDateTime& ModificationTime)
+{
+    for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; --EntryIndex)
+    {
+        const FEntry& Entry = Entries[EntryIndex];
+        if (Entry.FilePath == FilePath && (Entry.FileSize != FileSize || Entry.ModificationTime != ModificationTime))
+        {
+            RemoveEntry(EntryIndex);
+        }
+    }
+}
+
+void FDatasetCache::Trim()
+{
+    for (FEntry& Entry : Entries)
+    {
+        if (Entry.Pending.IsValid() && Entry.Result.IsReady())
+        {
+            CollectLoad(Entry);
+        }
+        if (Entry.PendingCompression.IsValid() && Entry.PendingCompression->bDone)
+        {
+            CollectCompression(Entry);
+        }
+    }
+
+    // Only datasets the cache alone holds free memory when compressed; columns viewed in a mapped file are not counted.
+    // Datasets already compressing count as freed, so a trim starts no more compressions than the overflow needs.
+    int64 Bytes = GetCachedBytes();
+    bool bCompressing = false;
+    for (const FEntry& Entry : Entries)
+    {
+        if (Entry.PendingCompression.IsValid())
+        {
+            Bytes -= Entry.AllocatedBytes;
+            bCompressing = true;
+        }
+    }
+    while (Bytes > MaxBytes)
+    {
+        const int32 Oldest = FindLeastRecentlyUsed([](const FEntry& Entry)
+        {
+            return Entry.Dataset.IsValid() && Entry.Dataset.IsUnique() && !Entry.Dataset->ExternalStorage.IsValid() && !Entry.bIncompressible
+                && !Entry.PendingCompression.IsValid();
+        });
+        if (Oldest == INDEX_NONE)
+        {
+            break;
+        }
+        StartCompress(Entries[Oldest]);
+        Bytes -= Entries[Oldest].AllocatedBytes;
+        bCompressing = true;
+    }
+
+    // Evicting waits for running compressions, after which the entries may fit. Loads still running are never evicted;
+    // their size is not known yet.
+    if (bCompressing)
+    {
+        return;
+    }
+    while (GetCachedBytes() > MaxBytes)
+    {
+        const int32 Oldest = FindLeastRecentlyUsed([](const FEntry& Entry) { return !Entry.Pending.IsValid(); });
+        if (Oldest == INDEX_NONE)
+        {
+            break;
+        }
+        RemoveEntry(Oldest);
+    }
+}
+
+void FDatasetCache::StartCompress(FEntry& Entry)
+{
+    const TSharedRef<FPendingCompression> Pending = MakeShared<FPendingCompression>();
+    Pending->Source = Entry.Dataset;
+    Entry.PendingCompression = Pending;
+    Async(EAsyncExecution::ThreadPool, [Pending]()
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        Pending->Compressed = FCompressedDataset::Compress(*Pending->Source);
+        Pending->CompressSeconds = FPlatformTime::Seconds() - StartTime;
+        Pending->bDone = true;
+        AsyncTask(ENamedThreads::GameThread, []()
+        {
+            FDatasetCache::Get().Trim();
+        });
+    });
+}
+
+void FDatasetCache::CollectCompression(FEntry& Entry)
+{
+    const TSharedPtr<FPendingCompression> Pending = MoveTemp(Entry.PendingCompression);
+    Pending->Source.Reset();
+    Stats.CompressSeconds += Pending->CompressSeconds;
+    // A chart took the dataset while it was compressed, so dropping it would free nothing
+    if (!Entry.Dataset.IsUnique())
+    {
+        return;
+    }
+
+    const int64 CompressedBytes = static_cast<int64>(Pending->Compressed->GetAllocatedSize());
+    if (CompressedBytes >= Entry.AllocatedBytes)
+    {
+        Entry.bIncompressible = true;
+        return;
+    }
+    ++Stats.Compressions;
+    Entry.Compressed = Pending->Compressed;
+    Entry.Dataset.Reset();
+    Entry.AllocatedBytes = CompressedBytes;
+}
+
+int32 FDatasetCache::FindLeastRecentlyUsed(TFunctionRef<bool(const FEntry&)> Filter) const
+{
+    int32 Oldest = INDEX_NONE;
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+    {
+        if (Filter(Entries[EntryIndex]) && (Oldest == INDEX_NONE || Entries[EntryIndex].LastUse < Entries[Oldest].LastUse))
+        {
+            Oldest = EntryIndex;
+        }
+    }
+    return Oldest;
+}
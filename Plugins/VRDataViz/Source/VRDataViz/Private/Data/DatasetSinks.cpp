@@ -0,0 +1,151 @@
+#include "Data/DatasetSinks.h"
+
+void FColumnStatsSink::BeginStream(const FChartDataset& Schema)
+{
+    Stats.Reset();
+    Stats.SetNum(Schema.Columns.Num());
+}
+
+void FColumnStatsSink::ConsumeBlock(const FChartDataset& Block, int64 FirstRow)
+{
+    for (int32 ColumnIndex = 0; ColumnIndex < Block.Columns.Num(); ++ColumnIndex)
+    {
+        const FChartColumn& Column = Block.Columns[ColumnIndex];
+        FChartColumnStats& ColumnStats = Stats[ColumnIndex];
+
+        if (Column.Type == EChartColumnType::String)
+        {
+            for (const int32 Code : Column.Codes)
+            {
+                ++(Column.Labels[Code].IsEmpty() ? ColumnStats.MissingCount : ColumnStats.Count);
+            }
+            continue;
+        }
+
+        float Min = ColumnStats.Min;
+        float Max = ColumnStats.Max;
+        int64 Missing = 0;
+        for (const float Value : Column.GetFloats())
+        {
+            if (FMath::IsNaN(Value))
+            {
+                ++Missing;
+                continue;
+            }
+            Min = FMath::Min(Min, Value);
+            Max = FMath::Max(Max, Value);
+        }
+        ColumnStats.Quantiles.Add(Column.GetFloats());
+        ColumnStats.Min = Min;
+        ColumnStats.Max = Max;
+        ColumnStats.MissingCount += Missing;
+        ColumnStats.Count += Column.GetFloats().Num() - Missing;
+    }
+}
+
+void FColumnStatsSink::ApplyTo(FChartDataset& Dataset) const
+{
+    check(Dataset.Columns.Num() == Stats.Num());
+    for (int32 ColumnIndex = 0; ColumnIndex < Stats.Num(); ++ColumnIndex)
+    {
+        Dataset.Columns[ColumnIndex].Stats = Stats[ColumnIndex];
+    }
+}
+
+FReservoirSampleSink::FReservoirSampleSink(int32 InMaxRows, int32 Seed)
+    : Stream(Seed)
+    , MaxRows(InMaxRows)
+{
+}
+
+double FReservoirSampleSink::NextUniform()
+{
+    // (0, 1] so the logarithms below stay finite
+    return 1.0 - Stream.GetFraction();
+}
+
+void FReservoirSampleSink::AdvanceSkip()
+{
+    SkipWeight *= FMath::Exp(FMath::Loge(NextUniform()) / MaxRows);
+    NextReplaceRow += static_cast<int64>(FMath::FloorToDouble(FMath::Loge(NextUniform()) / FMath::Loge(1.0 - SkipWeight))) + 1;
+}
+
+void FReservoirSampleSink::BeginStream(const FChartDataset& Schema)
+{
+    Sample.CopySchemaFrom(Schema);
+    SampleFileRows.Reset();
+    if (MaxRows > 0)
+    {
+        const int32 RowsToReserve = ExpectedRows > 0 ? static_cast<int32>(FMath::Min<int64>(ExpectedRows, MaxRows)) : MaxRows;
+        Sample.ReserveRows(RowsToReserve);
+        SampleFileRows.Reserve(RowsToReserve);
+    }
+    else if (ExpectedRows > 0)
+    {
+        Sample.ReserveRows(static_cast<int32>(FMath::Min<int64>(ExpectedRows, MAX_int32)));
+    }
+}
+
+void FReservoirSampleSink::ConsumeBlock(const FChartDataset& Block, int64 FirstRow)
+{
+    if (MaxRows <= 0)
+    {
+        for (int32 ColumnIndex = 0; ColumnIndex < Sample.Columns.Num(); ++ColumnIndex)
+        {
+            Sample.Columns[ColumnIndex].AppendValues(Block.Columns[ColumnIndex]);
+        }
+        Sample.NumRows += Block.NumRows;
+        return;
+    }
+
+    // Fill the reservoir with the first MaxRows rows
+    int32 Row = 0;
+    for (; Row < Block.NumRows && Sample.NumRows < MaxRows; ++Row)
+    {
+        Sample.AddRowFrom(Block, Row);
+        SampleFileRows.Add(FirstRow + Row);
+        if (Sample.NumRows == MaxRows)
+        {
+            SkipWeight = 1.0;
+            NextReplaceRow = FirstRow + Row;
+            AdvanceSkip();
+        }
+    }
+
+    // Then jump straight to the next row that replaces a random slot
+    const int64 BlockEnd = FirstRow + Block.NumRows;
+    while (Sample.NumRows == MaxRows && NextReplaceRow < BlockEnd)
+    {
+        const int32 Slot = Stream.RandRange(0, MaxRows - 1);
+        Sample.SetRowFrom(Block, static_cast<int32>(NextReplaceRow - FirstRow), Slot);
+        SampleFileRows[Slot] = NextReplaceRow;
+        AdvanceSkip();
+    }
+}
+
+void FReservoirSampleSink::EndStream(int64 TotalRows)
+{
+    if (MaxRows <= 0 || TotalRows <= MaxRows)
+    {
+        return;
+    }
+
+    // Slots were replaced in random order; restore file order so line charts connect rows as written
+    TArray<int32> Order;
+    Order.SetNum(Sample.NumRows);
+    for (int32 Index = 0; Index < Order.Num(); ++Index)
+    {
+        Order[Index] = Index;
+    }
+    Order.Sort([this](int32 A, int32 B) { return SampleFileRows[A] < SampleFileRows[B]; });
+
+    FChartDataset Ordered;
+    Ordered.CopySchemaFrom(Sample);
+    Ordered.ReserveRows(Sample.NumRows);
+    for (const int32 Index : Order)
+    {
+        Ordered.AddRowFrom(Sample, Index);
+    }
+    Sample = MoveTemp(Ordered);
+    SampleFileRows.Sort();
+}
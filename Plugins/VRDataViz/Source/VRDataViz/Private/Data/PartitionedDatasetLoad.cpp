@@ -0,0 +1,302 @@
+#include "Data/PartitionedDatasetLoad.h"
+#include "Data/ChartDataset.h"
+#include "Data/ChartDatasetLoader.h"
+#include "Data/DatasetSinks.h"
+#include "Data/DataByteSource.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    // Reorders Part's columns to match Schema by name; false (leaving Part untouched) when the names differ
+    bool AlignColumns(FChartDataset& Part, const FChartDataset& Schema)
+    {
+        if (Part.Columns.Num() != Schema.Columns.Num())
+        {
+            return false;
+        }
+
+        TArray<int32> SourceIndices;
+        SourceIndices.Reserve(Schema.Columns.Num());
+        for (const FChartColumn& Column : Schema.Columns)
+        {
+            const int32 SourceIndex = Part.FindColumn(Column.Name);
+            if (SourceIndex == INDEX_NONE)
+            {
+                return false;
+            }
+            SourceIndices.Add(SourceIndex);
+        }
+
+        TArray<FChartColumn> Aligned;
+        Aligned.Reserve(SourceIndices.Num());
+        for (const int32 SourceIndex : SourceIndices)
+        {
+            Aligned.Add(MoveTemp(Part.Columns[SourceIndex]));
+        }
+        Part.Columns = MoveTemp(Aligned);
+        return true;
+    }
+
+    // Turns a numeric column into text so it can be merged with a shard where the same column did not parse as numbers
+    void ConvertToText(FChartColumn& Column)
+    {
+        FChartColumn Text;
+        Text.Codes.Reserve(Column.Num());
+        for (int32 Row = 0; Row < Column.Num(); ++Row)
+        {
+            Text.AddString(Column.GetString(Row));
+        }
+
+        Column.Type = EChartColumnType::String;
+        Column.Codes = MoveTemp(Text.Codes);
+        Column.Labels = MoveTemp(Text.Labels);
+        Column.Floats.Empty();
+        Column.ExternalFloats = TConstArrayView<float>();
+        if (Column.Stats.IsSet())
+        {
+            // Text columns only count values
+            Column.Stats->Min = TNumericLimits<float>::Max();
+            Column.Stats->Max = TNumericLimits<float>::Lowest();
+            Column.Stats->Quantiles.Reset();
+        }
+    }
+}
+
+bool FPartitionedDatasetLoad::IsPartitionedPath(const FString& Path)
+{
+    const FString FileName = FPaths::GetCleanFilename(Path);
+    return FileName.Contains(TEXT("*")) || FileName.Contains(TEXT("?")) || IFileManager::Get().DirectoryExists(*Path);
+}
+
+TArray<FString> FPartitionedDatasetLoad::FindShards(const FString& DirectoryOrGlob)
+{
+    IFileManager& FileManager = IFileManager::Get();
+    TArray<FString> Files;
+
+    if (FileManager.DirectoryExists(*DirectoryOrGlob))
+    {
+        for (const FString& Pattern : DataVizByteSource::GetFilePatterns())
+        {
+            TArray<FString> PatternFiles;
+            FileManager.FindFilesRecursive(PatternFiles, *DirectoryOrGlob, *Pattern, true, false);
+            Files.Append(PatternFiles);
+        }
+    }
+    else
+    {
+        // FindFiles matches the wildcard against file names and returns them without their directory
+        const FString Directory = FPaths::GetPath(DirectoryOrGlob);
+        TArray<FString> FileNames;
+        FileManager.FindFiles(FileNames, *DirectoryOrGlob, true, false);
+        for (const FString& FileName : FileNames)
+        {
+            Files.Add(FPaths::Combine(Directory, FileName));
+        }
+    }
+
+    Files.Sort();
+    return Files;
+}
+
+TSharedPtr<FPartitionedDatasetLoad> FPartitionedDatasetLoad::Start(const FString& DirectoryOrGlob, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options)
+{
+    const TArray<FString> Files = FindShards(DirectoryOrGlob);
+    if (Files.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("PartitionedDatasetLoad - No data files match %s"), *DirectoryOrGlob);
+        return nullptr;
+    }
+
+    TSharedRef<FPartitionedDatasetLoad> Load = MakeShared<FPartitionedDatasetLoad>();
+    Load->Path = DirectoryOrGlob;
+    Load->Shards.SetNum(Files.Num());
+    for (int32 ShardIndex = 0; ShardIndex < Files.Num(); ++ShardIndex)
+    {
+        Load->Shards[ShardIndex].FilePath = Files[ShardIndex];
+        Load->Shards[ShardIndex].FileSize = IFileManager::Get().FileSize(*Files[ShardIndex]);
+    }
+
+    // The task keeps the load alive until it finishes, even when the caller lets go of it
+    Load->Result = Async(EAsyncExecution::ThreadPool, [Load, MaxInMemoryBytes, MaxStreamedRows, Options]()
+    {
+        Load->Dataset = Load->Run(MaxInMemoryBytes, MaxStreamedRows, Options);
+    });
+    return Load;
+}
+
+TArray<FDatasetShardProgress> FPartitionedDatasetLoad::GetProgress() const
+{
+    FScopeLock Lock(&ProgressLock);
+    return Shards;
+}
+
+TSharedPtr<FChartDataset> FPartitionedDatasetLoad::Wait() const
+{
+    Result.Wait();
+    return Dataset;
+}
+
+void FPartitionedDatasetLoad::SetShardState(int32 ShardIndex, EDatasetShardState State, int32 NumRows)
+{
+    FScopeLock Lock(&ProgressLock);
+    Shards[ShardIndex].State = State;
+    Shards[ShardIndex].NumRows = NumRows;
+}
+
+TSharedPtr<FChartDataset> FPartitionedDatasetLoad::Run(int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options)
+{
+    // Paths and sizes are not written after Start, so workers read them without the lock
+    int64 TotalBytes = 0;
+    for (const FDatasetShardProgress& Shard : Shards)
+    {
+        TotalBytes += FMath::Max<int64>(Shard.FileSize, 0);
+    }
+    const bool bStream = TotalBytes > MaxInMemoryBytes;
+
+    // Shards stop on this load's own flag; a cancel through the caller's options is forwarded to it as each shard starts
+    FCSVParseOptions ShardOptions = Options;
+    ShardOptions.CancelFlag = &bCanceled;
+
+    TArray<TSharedPtr<FChartDataset>> Parts;
+    Parts.SetNum(Shards.Num());
+    ParallelFor(Shards.Num(), [this, &Parts, TotalBytes, bStream, MaxStreamedRows, &Options, &ShardOptions](int32 ShardIndex)
+    {
+        if (Options.IsCanceled())
+        {
+            bCanceled = true;
+        }
+        if (bCanceled)
+        {
+            return;
+        }
+
+        const FDatasetShardProgress& Shard = Shards[ShardIndex];
+        SetShardState(ShardIndex, EDatasetShardState::Loading);
+
+        // Each streamed shard keeps a share of the row budget proportional to its size, so the merged sample is
+        // close to uniform over all shards
+        int32 ShardMaxRows = 0;
+        if (bStream && MaxStreamedRows > 0)
+        {
+            const double Share = static_cast<double>(FMath::Max<int64>(Shard.FileSize, 0)) / FMath::Max<int64>(TotalBytes, 1);
+            ShardMaxRows = FMath::Max(1, FMath::CeilToInt(MaxStreamedRows * Share));
+        }
+
+        Parts[ShardIndex] = FChartDatasetLoader::LoadDataFile(Shard.FilePath, bStream ? 0 : MAX_int64, ShardMaxRows, ShardOptions);
+        const bool bLoaded = Parts[ShardIndex].IsValid();
+        SetShardState(ShardIndex, bLoaded ? EDatasetShardState::Loaded : EDatasetShardState::Failed, bLoaded ? Parts[ShardIndex]->NumRows : 0);
+    }, EParallelForFlags::Unbalanced);
+
+    if (bCanceled)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PartitionedDatasetLoad - Canceled loading %s"), *Path);
+        return nullptr;
+    }
+    return Merge(Parts);
+}
+
+TSharedPtr<FChartDataset> FPartitionedDatasetLoad::Merge(TArray<TSharedPtr<FChartDataset>>& Parts)
+{
+    // The first shard that loaded defines the column order
+    const TSharedPtr<FChartDataset>* First = Parts.FindByPredicate([](const TSharedPtr<FChartDataset>& Part) { return Part.IsValid(); });
+    if (!First)
+    {
+        UE_LOG(LogTemp, Error, TEXT("PartitionedDatasetLoad - None of the %d shards of %s could be loaded"), Parts.Num(), *Path);
+        return nullptr;
+    }
+
+    TSharedPtr<FChartDataset> Merged = MakeShared<FChartDataset>();
+    Merged->CopySchemaFrom(**First);
+
+    TArray<FChartDataset> Aligned;
+    Aligned.Reserve(Parts.Num());
+    int64 TotalRows = 0;
+    bool bHasStats = false;
+    for (int32 ShardIndex = 0; ShardIndex < Parts.Num(); ++ShardIndex)
+    {
+        TSharedPtr<FChartDataset>& Part = Parts[ShardIndex];
+        if (!Part.IsValid())
+        {
+            continue;
+        }
+        if (!AlignColumns(*Part, *Merged))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PartitionedDatasetLoad - Skipping %s: its columns differ from the other shards"), *Shards[ShardIndex].FilePath);
+            SetShardState(ShardIndex, EDatasetShardState::Failed);
+            continue;
+        }
+        if (TotalRows + Part->NumRows > MAX_int32)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PartitionedDatasetLoad - Skipping %s: the merged dataset would exceed %d rows"), *Shards[ShardIndex].FilePath, MAX_int32);
+            SetShardState(ShardIndex, EDatasetShardState::Failed);
+            continue;
+        }
+
+        TotalRows += Part->NumRows;
+        bHasStats |= Part->Columns.ContainsByPredicate([](const FChartColumn& Column) { return Column.Stats.IsSet(); });
+        Aligned.Add(MoveTemp(*Part));
+        Part.Reset();
+    }
+
+    // Sampled shards carry whole-file stats; give the fully loaded ones stats too so the merged ranges cover every row
+    if (bHasStats)
+    {
+        ParallelFor(Aligned.Num(), [&Aligned](int32 PartIndex)
+        {
+            FChartDataset& Part = Aligned[PartIndex];
+            if (!Part.Columns.ContainsByPredicate([](const FChartColumn& Column) { return Column.Stats.IsSet(); }))
+            {
+                FColumnStatsSink StatsSink;
+                StatsSink.BeginStream(Part);
+                StatsSink.ConsumeBlock(Part, 0);
+                StatsSink.ApplyTo(Part);
+            }
+        });
+    }
+
+    // Column types are inferred per file, so a column may be numeric in one shard and text in another
+    for (int32 ColumnIndex = 0; ColumnIndex < Merged->Columns.Num(); ++ColumnIndex)
+    {
+        const bool bAnyText = Aligned.ContainsByPredicate([ColumnIndex](const FChartDataset& Part) { return Part.Columns[ColumnIndex].Type == EChartColumnType::String; });
+        if (!bAnyText)
+        {
+            continue;
+        }
+        Merged->Columns[ColumnIndex].Type = EChartColumnType::String;
+        for (FChartDataset& Part : Aligned)
+        {
+            if (Part.Columns[ColumnIndex].Type == EChartColumnType::Float)
+            {
+                ConvertToText(Part.Columns[ColumnIndex]);
+            }
+        }
+    }
+
+    if (bHasStats)
+    {
+        for (int32 ColumnIndex = 0; ColumnIndex < Merged->Columns.Num(); ++ColumnIndex)
+        {
+            FChartColumnStats Stats;
+            for (const FChartDataset& Part : Aligned)
+            {
+                const FChartColumnStats& PartStats = Part.Columns[ColumnIndex].Stats.GetValue();
+                Stats.Min = FMath::Min(Stats.Min, PartStats.Min);
+                Stats.Max = FMath::Max(Stats.Max, PartStats.Max);
+                Stats.Count += PartStats.Count;
+                Stats.MissingCount += PartStats.MissingCount;
+                Stats.Quantiles.Merge(PartStats.Quantiles);
+            }
+            Merged->Columns[ColumnIndex].Stats = Stats;
+        }
+    }
+
+    const int32 NumShardsMerged = Aligned.Num();
+    Merged->AppendRows(Aligned);
+    UE_LOG(LogTemp, Log, TEXT("PartitionedDatasetLoad - Merged %d of %d shards into %d rows x %d columns from %s"),
+        NumShardsMerged, Parts.Num(), Merged->NumRows, Merged->Columns.Num(), *Path);
+    return Merged;
+}
@@ -0,0 +1,511 @@
+#include "Data/PointCloudReader.h"
+#include "Data/ChartDataset.h"
+#include "Data/CSVStreamReader.h"
+#include "Data/DataByteSource.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    // Enough for any PLY header in practice and the fixed part of a LAS header
+    constexpr int64 HeaderReadSize = 64 * 1024;
+
+    enum class EScalarType : uint8
+    {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64
+    };
+
+    int32 GetScalarSize(EScalarType Type)
+    {
+        switch (Type)
+        {
+        case EScalarType::Int8:
+        case EScalarType::UInt8:
+            return 1;
+        case EScalarType::Int16:
+        case EScalarType::UInt16:
+            return 2;
+        case EScalarType::Int32:
+        case EScalarType::UInt32:
+        case EScalarType::Float32:
+            return 4;
+        default:
+            return 8;
+        }
+    }
+
+    // One scalar of every record written to a dataset column as Raw * Scale + Bias
+    struct FFieldDecoder
+    {
+        FName Column;
+        EScalarType Type = EScalarType::Float32;
+        int32 Offset = 0;
+        double Scale = 1.0;
+        double Bias = 0.0;
+    };
+
+    struct FPointLayout
+    {
+        TArray<FFieldDecoder> Fields;
+        int64 DataOffset = 0; // Stream offset of the first vertex record
+        int32 Stride = 0;
+        int64 NumPoints = 0;
+        bool bByteSwap = false;
+    };
+
+    template<typename T>
+    T LoadScalar(const uint8* Ptr, bool bByteSwap)
+    {
+        uint8 Bytes[sizeof(T)];
+        FMemory::Memcpy(Bytes, Ptr, sizeof(T));
+        if (bByteSwap)
+        {
+            for (int32 Index = 0; Index < static_cast<int32>(sizeof(T) / 2); ++Index)
+            {
+                Swap(Bytes[Index], Bytes[sizeof(T) - 1 - Index]);
+            }
+        }
+
+        T Value;
+        FMemory::Memcpy(&Value, Bytes, sizeof(T));
+        return Value;
+    }
+
+    template<typename T>
+    void DecodeField(const uint8* Records, int32 NumRecords, const FPointLayout& Layout, const FFieldDecoder& Field, float* Out)
+    {
+        const uint8* Ptr = Records + Field.Offset;
+        for (int32 Row = 0; Row < NumRecords; ++Row, Ptr += Layout.Stride)
+        {
+            Out[Row] = static_cast<float>(static_cast<double>(LoadScalar<T>(Ptr, Layout.bByteSwap)) * Field.Scale + Field.Bias);
+        }
+    }
+
+    void DecodeField(const uint8* Records, int32 NumRecords, const FPointLayout& Layout, const FFieldDecoder& Field, float* Out)
+    {
+        switch (Field.Type)
+        {
+        case EScalarType::Int8:    DecodeField<int8>(Records, NumRecords, Layout, Field, Out); break;
+        case EScalarType::UInt8:   DecodeField<uint8>(Records, NumRecords, Layout, Field, Out); break;
+        case EScalarType::Int16:   DecodeField<int16>(Records, NumRecords, Layout, Field, Out); break;
+        case EScalarType::UInt16:  DecodeField<uint16>(Records, NumRecords, Layout, Field, Out); break;
+        case EScalarType::Int32:   DecodeField<int32>(Records, NumRecords, Layout, Field, Out); break;
+        case EScalarType::UInt32:  DecodeField<uint32>(Records, NumRecords, Layout, Field, Out); break;
+        case EScalarType::Float32: DecodeField<float>(Records, NumRecords, Layout, Field, Out); break;
+        case EScalarType::Float64: DecodeField<double>(Records, NumRecords, Layout, Field, Out); break;
+        }
+    }
+
+    FPointCloudReader::EFormat DetectLeadingBytes(const uint8* Bytes, int64 Size)
+    {
+        if (Size >= 4 && FMemory::Memcmp(Bytes, "ply", 3) == 0 && (Bytes[3] == '\n' || Bytes[3] == '\r'))
+        {
+            return FPointCloudReader::EFormat::Ply;
+        }
+        if (Size >= 4 && FMemory::Memcmp(Bytes, "LASF", 4) == 0)
+        {
+            return FPointCloudReader::EFormat::Las;
+        }
+        return FPointCloudReader::EFormat::Unknown;
+    }
+
+    struct FPlyTypeName
+    {
+        const TCHAR* Name;
+        EScalarType Type;
+    };
+
+    bool ParsePlyType(const FString& Name, EScalarType& OutType)
+    {
+        static const FPlyTypeName TypeNames[] = {
+            { TEXT("char"), EScalarType::Int8 },     { TEXT("int8"), EScalarType::Int8 },
+            { TEXT("uchar"), EScalarType::UInt8 },   { TEXT("uint8"), EScalarType::UInt8 },
+            { TEXT("short"), EScalarType::Int16 },   { TEXT("int16"), EScalarType::Int16 },
+            { TEXT("ushort"), EScalarType::UInt16 }, { TEXT("uint16"), EScalarType::UInt16 },
+            { TEXT("int"), EScalarType::Int32 },     { TEXT("int32"), EScalarType::Int32 },
+            { TEXT("uint"), EScalarType::UInt32 },   { TEXT("uint32"), EScalarType::UInt32 },
+            { TEXT("float"), EScalarType::Float32 }, { TEXT("float32"), EScalarType::Float32 },
+            { TEXT("double"), EScalarType::Float64 }, { TEXT("float64"), EScalarType::Float64 },
+        };
+        for (const FPlyTypeName& TypeName : TypeNames)
+        {
+            if (Name == TypeName.Name)
+            {
+                OutType = TypeName.Type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    struct FPlyColumnName
+    {
+        const TCHAR* Property;
+        const TCHAR* Column;
+    };
+
+    // Dataset column for a PLY vertex property, NAME_None for properties the charts do not use
+    FName GetPlyColumn(const FString& Property)
+    {
+        static const FPlyColumnName ColumnNames[] = {
+            { TEXT("x"), TEXT("X") }, { TEXT("y"), TEXT("Y") }, { TEXT("z"), TEXT("Z") },
+            { TEXT("red"), TEXT("R") }, { TEXT("r"), TEXT("R") }, { TEXT("diffuse_red"), TEXT("R") },
+            { TEXT("green"), TEXT("G") }, { TEXT("g"), TEXT("G") }, { TEXT("diffuse_green"), TEXT("G") },
+            { TEXT("blue"), TEXT("B") }, { TEXT("b"), TEXT("B") }, { TEXT("diffuse_blue"), TEXT("B") },
+            { TEXT("intensity"), TEXT("Intensity") }, { TEXT("scalar_intensity"), TEXT("Intensity") },
+        };
+        for (const FPlyColumnName& ColumnName : ColumnNames)
+        {
+            if (Property.Equals(ColumnName.Property, ESearchCase::IgnoreCase))
+            {
+                return FName(ColumnName.Column);
+            }
+        }
+        return NAME_None;
+    }
+
+    bool ParsePlyHeader(TConstArrayView64<uint8> Leading, FPointLayout& OutLayout)
+    {
+        // The header is ASCII lines ending at "end_header"; the binary records start right after its newline
+        int64 HeaderEnd = INDEX_NONE;
+        static const ANSICHAR EndMarker[] = "end_header";
+        const int64 MarkerLength = UE_ARRAY_COUNT(EndMarker) - 1;
+        for (int64 Index = 1; Index + MarkerLength < Leading.Num(); ++Index)
+        {
+            if (Leading[Index - 1] == '\n' && FMemory::Memcmp(&Leading[Index], EndMarker, MarkerLength) == 0)
+            {
+                int64 LineEnd = Index + MarkerLength;
+                while (LineEnd < Leading.Num() && Leading[LineEnd] != '\n')
+                {
+                    ++LineEnd;
+                }
+                HeaderEnd = LineEnd < Leading.Num() ? LineEnd + 1 : INDEX_NONE;
+                break;
+            }
+        }
+        if (HeaderEnd == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Error, TEXT("PointCloudReader - PLY header not terminated within %lld bytes"), HeaderReadSize);
+            return false;
+        }
+
+        const FUTF8ToTCHAR HeaderText(reinterpret_cast<const ANSICHAR*>(Leading.GetData()), static_cast<int32>(HeaderEnd));
+        TArray<FString> Lines;
+        FString(HeaderText.Length(), HeaderText.Get()).ParseIntoArrayLines(Lines);
+
+        // Elements before the vertex element are skipped, which needs their record size
+        int64 SkippedBytes = 0;
+        int64 ElementCount = 0;
+        int32 ElementStride = 0;
+        bool bElementHasList = false;
+        bool bInVertexElement = false;
+        for (const FString& Line : Lines)
+        {
+            TArray<FString> Tokens;
+            Line.ParseIntoArrayWS(Tokens);
+            if (Tokens.Num() == 0)
+            {
+                continue;
+            }
+
+            if (Tokens[0] == TEXT("format") && Tokens.Num() >= 2)
+            {
+                if (Tokens[1] != TEXT("binary_little_endian") && Tokens[1] != TEXT("binary_big_endian"))
+                {
+                    UE_LOG(LogTemp, Error, TEXT("PointCloudReader - Only binary PLY is supported (found '%s')"), *Tokens[1]);
+                    return false;
+                }
+                OutLayout.bByteSwap = (Tokens[1] == TEXT("binary_big_endian")) == PLATFORM_LITTLE_ENDIAN;
+            }
+            else if (Tokens[0] == TEXT("element") && Tokens.Num() >= 3)
+            {
+                if (bInVertexElement)
+                {
+                    break;
+                }
+                if (bElementHasList)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("PointCloudReader - PLY elements with list properties must follow the vertex element"));
+                    return false;
+                }
+
+                SkippedBytes += ElementStride * ElementCount;
+                bInVertexElement = Tokens[1] == TEXT("vertex");
+                ElementCount = FCString::Atoi64(*Tokens[2]);
+                ElementStride = 0;
+            }
+            else if (Tokens[0] == TEXT("property") && Tokens.Num() >= 3)
+            {
+                EScalarType Type;
+                if (Tokens[1] == TEXT("list") || !ParsePlyType(Tokens[1], Type))
+                {
+                    if (bInVertexElement)
+                    {
+                        UE_LOG(LogTemp, Error, TEXT("PointCloudReader - Unsupported PLY vertex property: %s"), *Line);
+                        return false;
+                    }
+                    bElementHasList = true;
+                    continue;
+                }
+
+                const FName Column = bInVertexElement ? GetPlyColumn(Tokens[2]) : NAME_None;
+                if (!Column.IsNone())
+                {
+                    FFieldDecoder& Field = OutLayout.Fields.AddDefaulted_GetRef();
+                    Field.Column = Column;
+                    Field.Type = Type;
+                    Field.Offset = ElementStride;
+                    if (Column == TEXT("R") || Column == TEXT("G") || Column == TEXT("B"))
+                    {
+                        Field.Scale = Type == EScalarType::UInt8 ? 1.0 / 255.0 : Type == EScalarType::UInt16 ? 1.0 / 65535.0 : 1.0;
+                    }
+                }
+                ElementStride += GetScalarSize(Type);
+            }
+        }
+
+        OutLayout.NumPoints = ElementCount;
+        OutLayout.Stride = ElementStride;
+        OutLayout.DataOffset = HeaderEnd + SkippedBytes;
+        return bInVertexElement && OutLayout.Stride > 0 && SkippedBytes >= 0;
+    }
+
+    bool ParseLasHeader(TConstArrayView64<uint8> Leading, FPointLayout& OutLayout)
+    {
+        // LAS 1.0 - 1.3 public header block is 227 bytes; 1.4 extends it to 375
+        if (Leading.Num() < 227)
+        {
+            return false;
+        }
+
+        const uint8* Header = Leading.GetData();
+        const uint8 VersionMinor = Header[25];
+        const uint16 HeaderSize = LoadScalar<uint16>(Header + 94, false);
+        const uint8 PointFormat = Header[104];
+        const uint16 RecordLength = LoadScalar<uint16>(Header + 105, false);
+        if (PointFormat & 0xC0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("PointCloudReader - LAZ-compressed points are not supported; decompress to LAS first"));
+            return false;
+        }
+
+        static const int32 MinRecordLength[] = { 20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67 };
+        static const int32 ColorOffset[] = { -1, -1, 20, 28, -1, 28, -1, 30, 30, -1, 30 };
+        if (PointFormat >= UE_ARRAY_COUNT(MinRecordLength) || RecordLength < MinRecordLength[PointFormat])
+        {
+            UE_LOG(LogTemp, Error, TEXT("PointCloudReader - Unsupported LAS point format %d (record length %d)"), PointFormat, RecordLength);
+            return false;
+        }
+
+        OutLayout.DataOffset = LoadScalar<uint32>(Header + 96, false);
+        OutLayout.Stride = RecordLength;
+        OutLayout.NumPoints = LoadScalar<uint32>(Header + 107, false);
+        if (VersionMinor >= 4 && HeaderSize >= 375 && Leading.Num() >= 255)
+        {
+            // Point formats 6+ leave the legacy count at zero
+            OutLayout.NumPoints = FMath::Max<int64>(OutLayout.NumPoints, static_cast<int64>(LoadScalar<uint64>(Header + 247, false)));
+        }
+
+        // Coordinates are scaled integers: Value = Raw * Scale + Offset
+        static const TCHAR* const Axes[] = { TEXT("X"), TEXT("Y"), TEXT("Z") };
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            FFieldDecoder& Field = OutLayout.Fields.AddDefaulted_GetRef();
+            Field.Column = Axes[Axis];
+            Field.Type = EScalarType::Int32;
+            Field.Offset = Axis * 4;
+            Field.Scale = LoadScalar<double>(Header + 131 + Axis * 8, false);
+            Field.Bias = LoadScalar<double>(Header + 155 + Axis * 8, false);
+        }
+
+        FFieldDecoder& Intensity = OutLayout.Fields.AddDefaulted_GetRef();
+        Intensity.Column = TEXT("Intensity");
+        Intensity.Type = EScalarType::UInt16;
+        Intensity.Offset = 12;
+
+        if (ColorOffset[PointFormat] >= 0)
+        {
+            static const TCHAR* const Channels[] = { TEXT("R"), TEXT("G"), TEXT("B") };
+            for (int32 Channel = 0; Channel < 3; ++Channel)
+            {
+                FFieldDecoder& Field = OutLayout.Fields.AddDefaulted_GetRef();
+                Field.Column = Channels[Channel];
+                Field.Type = EScalarType::UInt16;
+                Field.Offset = ColorOffset[PointFormat] + Channel * 2;
+                Field.Scale = 1.0 / 65535.0;
+            }
+        }
+        return true;
+    }
+
+    // Reads the first HeaderReadSize bytes of Source into Buffer and parses the header found there
+    bool ReadLayout(IDataByteSource& Source, const FString& FilePath, TArray64<uint8>& Buffer, int64& OutFilled, FPointLayout& OutLayout)
+    {
+        Buffer.SetNumUninitialized(HeaderReadSize);
+        OutFilled = Source.Read(Buffer.GetData(), Buffer.Num());
+        if (OutFilled == INDEX_NONE)
+        {
+            return false;
+        }
+
+        const TConstArrayView64<uint8> Leading(Buffer.GetData(), OutFilled);
+        const FPointCloudReader::EFormat Format = DetectLeadingBytes(Buffer.GetData(), OutFilled);
+        const bool bParsed = Format == FPointCloudReader::EFormat::Ply ? ParsePlyHeader(Leading, OutLayout) : Format == FPointCloudReader::EFormat::Las && ParseLasHeader(Leading, OutLayout);
+        if (!bParsed || OutLayout.NumPoints < 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("PointCloudReader - Unsupported or malformed point cloud header: %s"), *FilePath);
+            return false;
+        }
+        for (const FName Axis : { FName(TEXT("X")), FName(TEXT("Y")), FName(TEXT("Z")) })
+        {
+            if (!OutLayout.Fields.ContainsByPredicate([Axis](const FFieldDecoder& Field) { return Field.Column == Axis; }))
+            {
+                UE_LOG(LogTemp, Error, TEXT("PointCloudReader - No %s coordinate in %s"), *Axis.ToString(), *FilePath);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+FPointCloudReader::FPointCloudReader(int32 InBlockRows)
+    : BlockRows(FMath::Max(InBlockRows, 1024))
+{
+}
+
+FPointCloudReader::EFormat FPointCloudReader::DetectFormat(const FString& FilePath)
+{
+    TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+    uint8 Leading[4] = {};
+    if (!Handle || Handle->Size() < 4 || !Handle->Read(Leading, 4))
+    {
+        return EFormat::Unknown;
+    }
+    return DetectLeadingBytes(Leading, 4);
+}
+
+bool FPointCloudReader::ReadHeader(const FString& FilePath, TArray<FName>& OutColumns, int64& OutNumPoints)
+{
+    TUniquePtr<IDataByteSource> Source = DataVizByteSource::OpenFile(FilePath);
+    TArray64<uint8> Buffer;
+    int64 Filled = 0;
+    FPointLayout Layout;
+    if (!Source || !ReadLayout(*Source, FilePath, Buffer, Filled, Layout))
+    {
+        return false;
+    }
+
+    OutColumns.Reset(Layout.Fields.Num());
+    for (const FFieldDecoder& Field : Layout.Fields)
+    {
+        OutColumns.Add(Field.Column);
+    }
+    OutNumPoints = Layout.NumPoints;
+    return true;
+}
+
+bool FPointCloudReader::ReadFile(const FString& FilePath, TArrayView<IChartDatasetSink* const> Sinks) const
+{
+    TUniquePtr<IDataByteSource> Source = DataVizByteSource::OpenFile(FilePath);
+    if (!Source)
+    {
+        return false;
+    }
+
+    TArray64<uint8> Buffer;
+    int64 Filled = 0;
+    FPointLayout Layout;
+    if (!ReadLayout(*Source, FilePath, Buffer, Filled, Layout))
+    {
+        return false;
+    }
+
+    // Whole records per block; the buffer also holds whatever followed the header in the first read
+    const int32 RowsPerBlock = FMath::Max<int32>(BlockRows, static_cast<int32>(HeaderReadSize / Layout.Stride) + 1);
+    Buffer.SetNumUninitialized(FMath::Max<int64>(static_cast<int64>(RowsPerBlock) * Layout.Stride, Filled));
+
+    if (Layout.DataOffset <= Filled)
+    {
+        Filled -= Layout.DataOffset;
+        FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + Layout.DataOffset, Filled);
+    }
+    else
+    {
+        // LAS variable-length records (projection, metadata) can push the points past the first read
+        for (int64 ToSkip = Layout.DataOffset - Filled; ToSkip > 0;)
+        {
+            const int64 Skipped = Source->Read(Buffer.GetData(), FMath::Min<int64>(ToSkip, Buffer.Num()));
+            if (Skipped <= 0)
+            {
+                UE_LOG(LogTemp, Error, TEXT("PointCloudReader - File ends before its point records: %s"), *FilePath);
+                return false;
+            }
+            ToSkip -= Skipped;
+        }
+        Filled = 0;
+    }
+
+    FChartDataset Block;
+    for (const FFieldDecoder& Field : Layout.Fields)
+    {
+        Block.AddColumn(Field.Column, EChartColumnType::Float);
+    }
+    for (IChartDatasetSink* Sink : Sinks)
+    {
+        Sink->SetExpectedRows(Layout.NumPoints);
+        Sink->BeginStream(Block);
+    }
+
+    int64 RowsRead = 0;
+    while (RowsRead < Layout.NumPoints)
+    {
+        const int32 NumRecords = static_cast<int32>(FMath::Min<int64>(RowsPerBlock, Layout.NumPoints - RowsRead));
+        const int64 BlockBytes = static_cast<int64>(NumRecords) * Layout.Stride;
+        if (Filled < BlockBytes)
+        {
+            const int64 BytesRead = Source->Read(Buffer.GetData() + Filled, BlockBytes - Filled);
+            if (BytesRead != BlockBytes - Filled)
+            {
+                UE_LOG(LogTemp, Error, TEXT("PointCloudReader - File ends after %lld of %lld points: %s"), RowsRead, Layout.NumPoints, *FilePath);
+                return false;
+            }
+            Filled = BlockBytes;
+        }
+
+        // Each column is decoded on its own worker straight from the interleaved records
+        Block.ResetRows();
+        ParallelFor(Layout.Fields.Num(), [&Block, &Buffer, &Layout, NumRecords](int32 FieldIndex)
+        {
+            TArray<float>& Values = Block.Columns[FieldIndex].Floats;
+            Values.SetNumUninitialized(NumRecords);
+            DecodeField(Buffer.GetData(), NumRecords, Layout, Layout.Fields[FieldIndex], Values.GetData());
+        });
+        Block.NumRows = NumRecords;
+
+        for (IChartDatasetSink* Sink : Sinks)
+        {
+            Sink->ConsumeBlock(Block, RowsRead);
+        }
+        RowsRead += NumRecords;
+
+        Filled -= BlockBytes;
+        if (Filled > 0)
+        {
+            FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + BlockBytes, Filled);
+        }
+    }
+
+    for (IChartDatasetSink* Sink : Sinks)
+    {
+        Sink->EndStream(RowsRead);
+    }
+    return true;
+}
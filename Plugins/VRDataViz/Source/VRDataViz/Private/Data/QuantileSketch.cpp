@@ -0,0 +1,210 @@
+#include "Data/QuantileSketch.h"
+
+namespace
+{
+    // Each level below the top holds this fraction of the one above
+    constexpr double CapacityRatio = 2.0 / 3.0;
+}
+
+FQuantileSketch::FQuantileSketch(int32 InK)
+    : K(FMath::Max(InK, 8))
+{
+    AddLevel();
+}
+
+void FQuantileSketch::Reset()
+{
+    NumValues = 0;
+    Min = TNumericLimits<float>::Max();
+    Max = TNumericLimits<float>::Lowest();
+    Levels.Reset();
+    NumRetained = 0;
+    CoinState = 0x9E3779B9u;
+    AddLevel();
+}
+
+int32 FQuantileSketch::GetCapacity(int32 Level) const
+{
+    const int32 Depth = Levels.Num() - Level - 1;
+    return FMath::Max(2, FMath::CeilToInt(K * FMath::Pow(CapacityRatio, Depth)));
+}
+
+void FQuantileSketch::AddLevel()
+{
+    Levels.AddDefaulted();
+    MaxRetained = 0;
+    for (int32 Level = 0; Level < Levels.Num(); ++Level)
+    {
+        MaxRetained += GetCapacity(Level);
+    }
+}
+
+void FQuantileSketch::Add(float Value)
+{
+    if (FMath::IsNaN(Value))
+    {
+        return;
+    }
+
+    ++NumValues;
+    Min = FMath::Min(Min, Value);
+    Max = FMath::Max(Max, Value);
+    Levels[0].Add(Value);
+    if (++NumRetained >= MaxRetained)
+    {
+        Compress();
+    }
+}
+
+void FQuantileSketch::Add(TConstArrayView<float> Values)
+{
+    for (const float Value : Values)
+    {
+        Add(Value);
+    }
+}
+
+void FQuantileSketch::Compress()
+{
+    for (int32 Level = 0; Level < Levels.Num(); ++Level)
+    {
+        if (Levels[Level].Num() < GetCapacity(Level))
+        {
+            continue;
+        }
+        if (Level + 1 == Levels.Num())
+        {
+            AddLevel();
+        }
+
+        // An odd value out stays behind; of the rest, every other one moves up
+        TArray<float>& Compactor = Levels[Level];
+        Compactor.Sort();
+        const int32 NumPaired = Compactor.Num() & ~1;
+        CoinState ^= CoinState << 13;
+        CoinState ^= CoinState >> 17;
+        CoinState ^= CoinState << 5;
+        TArray<float>& Above = Levels[Level + 1];
+        for (int32 Index = CoinState & 1; Index < NumPaired; Index += 2)
+        {
+            Above.Add(Compactor[Index]);
+        }
+        const bool bHasOddValue = Compactor.Num() > NumPaired;
+        const float OddValue = bHasOddValue ? Compactor.Last() : 0.0f;
+        Compactor.Reset();
+        if (bHasOddValue)
+        {
+            Compactor.Add(OddValue);
+        }
+
+        NumRetained = 0;
+        for (const TArray<float>& Values : Levels)
+        {
+            NumRetained += Values.Num();
+        }
+        if (NumRetained < MaxRetained)
+        {
+            break;
+        }
+    }
+}
+
+void FQuantileSketch::Merge(const FQuantileSketch& Other)
+{
+    if (Other.IsEmpty())
+    {
+        return;
+    }
+    while (Levels.Num() < Other.Levels.Num())
+    {
+        AddLevel();
+    }
+
+    for (int32 Level = 0; Level < Other.Levels.Num(); ++Level)
+    {
+        Levels[Level].Append(Other.Levels[Level]);
+    }
+    NumValues += Other.NumValues;
+    NumRetained += Other.NumRetained;
+    Min = FMath::Min(Min, Other.Min);
+    Max = FMath::Max(Max, Other.Max);
+    while (NumRetained >= MaxRetained)
+    {
+        Compress();
+    }
+}
+
+float FQuantileSketch::GetQuantile(double Q) const
+{
+    if (IsEmpty())
+    {
+        return NAN;
+    }
+    if (Q <= 0.0)
+    {
+        return Min;
+    }
+    if (Q >= 1.0)
+    {
+        return Max;
+    }
+
+    TArray<TPair<float, int64>> Weighted;
+    Weighted.Reserve(NumRetained);
+    int64 TotalWeight = 0;
+    for (int32 Level = 0; Level < Levels.Num(); ++Level)
+    {
+        const int64 Weight = int64(1) << Level;
+        for (const float Value : Levels[Level])
+        {
+            Weighted.Emplace(Value, Weight);
+            TotalWeight += Weight;
+        }
+    }
+    Weighted.Sort([](const TPair<float, int64>& A, const TPair<float, int64>& B) { return A.Key < B.Key; });
+
+    const double TargetWeight = Q * TotalWeight;
+    int64 CumulativeWeight = 0;
+    for (const TPair<float, int64>& Entry : Weighted)
+    {
+        CumulativeWeight += Entry.Value;
+        if (CumulativeWeight >= TargetWeight)
+        {
+            return FMath::Clamp(Entry.Key, Min, Max);
+        }
+    }
+    return Max;
+}
+
+SIZE_T FQuantileSketch::GetAllocatedSize() const
+{
+    SIZE_T Size = Levels.GetAllocatedSize();
+    for (const TArray<float>& Values : Levels)
+    {
+        Size += Values.GetAllocatedSize();
+    }
+    return Size;
+}
+
+FArchive& operator<<(FArchive& Ar, FQuantileSketch& Sketch)
+{
+    Ar << Sketch.K << Sketch.NumValues << Sketch.Min << Sketch.Max << Sketch.CoinState << Sketch.Levels;
+    if (Ar.IsLoading())
+    {
+        // Retained counts follow from the levels; a damaged sketch comes back empty rather than misweighted
+        Sketch.K = FMath::Max(Sketch.K, 8);
+        if (Sketch.Levels.Num() == 0 || Ar.IsError())
+        {
+            Sketch.Reset();
+            return Ar;
+        }
+        Sketch.NumRetained = 0;
+        Sketch.MaxRetained = 0;
+        for (int32 Level = 0; Level < Sketch.Levels.Num(); ++Level)
+        {
+            Sketch.NumRetained += Sketch.Levels[Level].Num();
+            Sketch.MaxRetained += Sketch.GetCapacity(Level);
+        }
+    }
+    return Ar;
+}
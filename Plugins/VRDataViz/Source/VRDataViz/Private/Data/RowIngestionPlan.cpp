@@ -0,0 +1,463 @@
+#include "Data/RowIngestionPlan.h"
+#include "Async/ParallelFor.h"
+#include "Engine/DataTable.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include <type_traits>
+
+namespace
+{
+    // Rows per worker task, and per scratch block when filling a DataTable
+    constexpr int32 RowBlockSize = 4096;
+
+    // Calls Write(Index, Value) for every present number among rows [FirstRow, FirstRow + Count)
+    template<typename WriteType>
+    void ForEachNumber(const FChartColumn& Column, int32 FirstRow, int32 Count, WriteType&& Write)
+    {
+        if (Column.Type == EChartColumnType::Float)
+        {
+            const TConstArrayView<float> Values = Column.GetFloats();
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                const float Value = Values[FirstRow + Index];
+                if (!FMath::IsNaN(Value))
+                {
+                    Write(Index, Value);
+                }
+            }
+            return;
+        }
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const float Value = Column.GetFloat(FirstRow + Index);
+            if (!FMath::IsNaN(Value))
+            {
+                Write(Index, Value);
+            }
+        }
+    }
+
+    // Calls Write(Index, Text) for rows [FirstRow, FirstRow + Count)
+    template<typename WriteType>
+    void ForEachText(const FChartColumn& Column, int32 FirstRow, int32 Count, WriteType&& Write)
+    {
+        if (Column.Type == EChartColumnType::String)
+        {
+            for (int32 Index = 0; Index < Count; ++Index)
+            {
+                Write(Index, Column.GetLabel(FirstRow + Index));
+            }
+            return;
+        }
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Write(Index, Column.GetString(FirstRow + Index));
+        }
+    }
+
+    // As ForEachText, but passes Convert(Text); a text column converts each distinct label once per call
+    template<typename ValueType, typename ConvertType, typename WriteType>
+    void ForEachConvertedText(const FChartColumn& Column, int32 FirstRow, int32 Count, ConvertType&& Convert, WriteType&& Write)
+    {
+        if (Column.Type != EChartColumnType::String)
+        {
+            ForEachText(Column, FirstRow, Count, [&Convert, &Write](int32 Index, const FString& Text) { Write(Index, Convert(Text)); });
+            return;
+        }
+
+        TMap<int32, ValueType> Converted;
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const int32 Code = Column.Codes[FirstRow + Index];
+            const ValueType* Value = Converted.Find(Code);
+            Write(Index, Value ? *Value : Converted.Add(Code, Convert(Column.Labels[Code])));
+        }
+    }
+
+    template<typename T>
+    void WriteNumbers(const FChartColumn& Column, int32 FirstRow, TArrayView<uint8* const> Rows, int32 Offset)
+    {
+        ForEachNumber(Column, FirstRow, Rows.Num(), [Rows, Offset](int32 Index, float Value)
+        {
+            T& Target = *reinterpret_cast<T*>(Rows[Index] + Offset);
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                Target = static_cast<T>(Value);
+            }
+            else if constexpr (sizeof(T) < sizeof(int64))
+            {
+                Target = static_cast<T>(FMath::Clamp<double>(FMath::RoundToDouble(Value), TNumericLimits<T>::Lowest(), TNumericLimits<T>::Max()));
+            }
+            else
+            {
+                Target = static_cast<T>(FMath::RoundToDouble(Value));
+            }
+        });
+    }
+
+    template<typename T>
+    void ReadNumbers(TConstArrayView<const uint8*> Rows, int32 Offset, TArray<float>& OutValues)
+    {
+        OutValues.SetNumUninitialized(Rows.Num());
+        for (int32 Row = 0; Row < Rows.Num(); ++Row)
+        {
+            OutValues[Row] = static_cast<float>(*reinterpret_cast<const T*>(Rows[Row] + Offset));
+        }
+    }
+}
+
+TSharedRef<const FRowIngestionPlan> FRowIngestionPlan::Get(const UScriptStruct* RowStruct)
+{
+    check(RowStruct);
+    static FCriticalSection PlansLock;
+    static TMap<const UScriptStruct*, TSharedRef<const FRowIngestionPlan>> Plans;
+
+    FScopeLock Lock(&PlansLock);
+    if (const TSharedRef<const FRowIngestionPlan>* Plan = Plans.Find(RowStruct))
+    {
+        if ((*Plan)->FirstProperty == RowStruct->ChildProperties && (*Plan)->StructureSize == RowStruct->GetStructureSize())
+        {
+            return *Plan;
+        }
+    }
+    return Plans.Add(RowStruct, MakeShareable(new FRowIngestionPlan(RowStruct)));
+}
+
+FRowIngestionPlan::FRowIngestionPlan(const UScriptStruct* InRowStruct)
+    : RowStruct(InRowStruct)
+    , FirstProperty(InRowStruct->ChildProperties)
+    , StructureSize(InRowStruct->GetStructureSize())
+{
+    for (TFieldIterator<FProperty> It(RowStruct); It; ++It)
+    {
+        const FProperty* Property = *It;
+        FFieldPlan& Field = Fields.AddDefaulted_GetRef();
+        // Authored names are what users type into headers; user-defined struct fields carry a GUID suffix otherwise
+        Field.ColumnName = FName(*Property->GetAuthoredName());
+        Field.Offset = Property->GetOffset_ForInternal();
+        Field.Kind = GetFieldKind(Property);
+        Field.Property = Property;
+    }
+}
+
+FRowIngestionPlan::EFieldKind FRowIngestionPlan::GetFieldKind(const FProperty* Property)
+{
+    if (Property->ArrayDim != 1)
+    {
+        return EFieldKind::ImportText;
+    }
+    if (Property->IsA<FFloatProperty>()) return EFieldKind::Float;
+    if (Property->IsA<FDoubleProperty>()) return EFieldKind::Double;
+    if (Property->IsA<FInt8Property>()) return EFieldKind::Int8;
+    if (Property->IsA<FInt16Property>()) return EFieldKind::Int16;
+    if (Property->IsA<FIntProperty>()) return EFieldKind::Int32;
+    if (Property->IsA<FInt64Property>()) return EFieldKind::Int64;
+    if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+    {
+        return ByteProperty->Enum ? EFieldKind::Enum : EFieldKind::UInt8;
+    }
+    if (Property->IsA<FUInt16Property>()) return EFieldKind::UInt16;
+    if (Property->IsA<FUInt32Property>()) return EFieldKind::UInt32;
+    if (Property->IsA<FUInt64Property>()) return EFieldKind::UInt64;
+    if (Property->IsA<FBoolProperty>()) return EFieldKind::Bool;
+    if (Property->IsA<FEnumProperty>()) return EFieldKind::Enum;
+    if (Property->IsA<FStrProperty>()) return EFieldKind::String;
+    if (Property->IsA<FNameProperty>()) return EFieldKind::Name;
+    if (Property->IsA<FTextProperty>()) return EFieldKind::Text;
+    return EFieldKind::ImportText;
+}
+
+int32 FRowIngestionPlan::WriteRows(const FChartDataset& Dataset, int32 FirstRow, TArrayView<uint8* const> Rows) const
+{
+    check(FirstRow >= 0 && FirstRow + Rows.Num() <= Dataset.NumRows);
+
+    // Columns are resolved once per call; the row loops index them directly
+    struct FBoundField
+    {
+        const FFieldPlan* Field;
+        const FChartColumn* Column;
+    };
+    TArray<FBoundField, TInlineAllocator<16>> Bound;
+    bool bNeedsGameThread = false;
+    for (const FFieldPlan& Field : Fields)
+    {
+        if (const FChartColumn* Column = Dataset.GetColumn(Field.ColumnName))
+        {
+            Bound.Add({ &Field, Column });
+            // Text import may resolve object references, which is only safe on the game thread
+            bNeedsGameThread |= Field.Kind == EFieldKind::ImportText;
+        }
+    }
+    if (Bound.Num() == 0 || Rows.Num() == 0)
+    {
+        return Bound.Num();
+    }
+
+    // Blocks own whole rows, so bools packed into the same byte are never written from two workers
+    const int32 NumBlocks = FMath::DivideAndRoundUp(Rows.Num(), RowBlockSize);
+    ParallelFor(NumBlocks, [this, &Bound, FirstRow, Rows](int32 Block)
+    {
+        const int32 Start = Block * RowBlockSize;
+        const TArrayView<uint8* const> BlockRows = Rows.Slice(Start, FMath::Min(RowBlockSize, Rows.Num() - Start));
+        for (const FBoundField& Binding : Bound)
+        {
+            WriteField(*Binding.Field, *Binding.Column, FirstRow + Start, BlockRows);
+        }
+    }, bNeedsGameThread || NumBlocks == 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+    return Bound.Num();
+}
+
+void FRowIngestionPlan::WriteField(const FFieldPlan& Field, const FChartColumn& Column, int32 FirstRow, TArrayView<uint8* const> Rows) const
+{
+    const int32 Offset = Field.Offset;
+    switch (Field.Kind)
+    {
+    case EFieldKind::Float: WriteNumbers<float>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::Double: WriteNumbers<double>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::Int8: WriteNumbers<int8>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::Int16: WriteNumbers<int16>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::Int32: WriteNumbers<int32>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::Int64: WriteNumbers<int64>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::UInt8: WriteNumbers<uint8>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::UInt16: WriteNumbers<uint16>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::UInt32: WriteNumbers<uint32>(Column, FirstRow, Rows, Offset); break;
+    case EFieldKind::UInt64: WriteNumbers<uint64>(Column, FirstRow, Rows, Offset); break;
+
+    case EFieldKind::Bool:
+    {
+        const FBoolProperty* BoolProperty = CastFieldChecked<FBoolProperty>(Field.Property);
+        if (Column.Type == EChartColumnType::Float)
+        {
+            ForEachNumber(Column, FirstRow, Rows.Num(), [BoolProperty, Rows, Offset](int32 Index, float Value)
+            {
+                BoolProperty->SetPropertyValue(Rows[Index] + Offset, Value != 0.0f);
+            });
+        }
+        else
+        {
+            ForEachText(Column, FirstRow, Rows.Num(), [BoolProperty, Rows, Offset](int32 Index, const FString& Text)
+            {
+                if (!Text.IsEmpty())
+                {
+                    BoolProperty->SetPropertyValue(Rows[Index] + Offset, FCString::ToBool(*Text));
+                }
+            });
+        }
+        break;
+    }
+
+    case EFieldKind::Enum:
+    {
+        // Numbers are enum values; text is an enumerator name, with or without the enum prefix
+        const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Field.Property);
+        const FNumericProperty* Underlying = EnumProperty ? EnumProperty->GetUnderlyingProperty() : CastFieldChecked<FNumericProperty>(Field.Property);
+        const UEnum* Enum = EnumProperty ? EnumProperty->GetEnum() : CastFieldChecked<FByteProperty>(Field.Property)->Enum;
+        if (Column.Type == EChartColumnType::Float)
+        {
+            ForEachNumber(Column, FirstRow, Rows.Num(), [Underlying, Rows, Offset](int32 Index, float Value)
+            {
+                Underlying->SetIntPropertyValue(Rows[Index] + Offset, static_cast<int64>(Value));
+            });
+        }
+        else
+        {
+            const auto ToValue = [Enum](const FString& Text) { return Text.IsEmpty() ? INDEX_NONE : Enum->GetValueByNameString(Text); };
+            ForEachConvertedText<int64>(Column, FirstRow, Rows.Num(), ToValue, [Underlying, Rows, Offset](int32 Index, int64 Value)
+            {
+                if (Value != INDEX_NONE)
+                {
+                    Underlying->SetIntPropertyValue(Rows[Index] + Offset, Value);
+                }
+            });
+        }
+        break;
+    }
+
+    case EFieldKind::String:
+        ForEachText(Column, FirstRow, Rows.Num(), [Rows, Offset](int32 Index, const FString& Text)
+        {
+            *reinterpret_cast<FString*>(Rows[Index] + Offset) = Text;
+        });
+        break;
+
+    case EFieldKind::Name:
+        ForEachConvertedText<FName>(Column, FirstRow, Rows.Num(), [](const FString& Text) { return FName(*Text); }, [Rows, Offset](int32 Index, FName Name)
+        {
+            *reinterpret_cast<FName*>(Rows[Index] + Offset) = Name;
+        });
+        break;
+
+    case EFieldKind::Text:
+        ForEachText(Column, FirstRow, Rows.Num(), [Rows, Offset](int32 Index, const FString& Text)
+        {
+            *reinterpret_cast<FText*>(Rows[Index] + Offset) = FText::FromString(Text);
+        });
+        break;
+
+    case EFieldKind::ImportText:
+    {
+        // Structs, containers and object references take the same text a DataTable CSV cell would hold
+        const FProperty* Property = Field.Property;
+        ForEachText(Column, FirstRow, Rows.Num(), [Property, Rows, Offset](int32 Index, const FString& Text)
+        {
+            if (!Text.IsEmpty())
+            {
+                Property->ImportText_Direct(*Text, Rows[Index] + Offset, nullptr, PPF_None);
+            }
+        });
+        break;
+    }
+    }
+}
+
+void FRowIngestionPlan::ReadRows(TConstArrayView<const uint8*> Rows, FChartDataset& OutDataset) const
+{
+    OutDataset = FChartDataset();
+    OutDataset.Columns.Reserve(Fields.Num());
+    for (const FFieldPlan& Field : Fields)
+    {
+        const bool bNumber = Field.Kind <= EFieldKind::Bool;
+        FChartColumn& Column = OutDataset.AddColumn(Field.ColumnName, bNumber ? EChartColumnType::Float : EChartColumnType::String);
+        const int32 Offset = Field.Offset;
+
+        switch (Field.Kind)
+        {
+        case EFieldKind::Float: ReadNumbers<float>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::Double: ReadNumbers<double>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::Int8: ReadNumbers<int8>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::Int16: ReadNumbers<int16>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::Int32: ReadNumbers<int32>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::Int64: ReadNumbers<int64>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::UInt8: ReadNumbers<uint8>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::UInt16: ReadNumbers<uint16>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::UInt32: ReadNumbers<uint32>(Rows, Offset, Column.Floats); break;
+        case EFieldKind::UInt64: ReadNumbers<uint64>(Rows, Offset, Column.Floats); break;
+
+        case EFieldKind::Bool:
+        {
+            const FBoolProperty* BoolProperty = CastFieldChecked<FBoolProperty>(Field.Property);
+            Column.Floats.SetNumUninitialized(Rows.Num());
+            for (int32 Row = 0; Row < Rows.Num(); ++Row)
+            {
+                Column.Floats[Row] = BoolProperty->GetPropertyValue(Rows[Row] + Offset) ? 1.0f : 0.0f;
+            }
+            break;
+        }
+
+        case EFieldKind::String:
+            Column.Codes.Reserve(Rows.Num());
+            for (const uint8* Row : Rows)
+            {
+                Column.AddString(*reinterpret_cast<const FString*>(Row + Offset));
+            }
+            break;
+
+        case EFieldKind::Name:
+        {
+            // Names repeat far more often than they differ; each distinct one is converted once
+            TMap<FName, int32> NameCodes;
+            Column.Codes.Reserve(Rows.Num());
+            for (const uint8* Row : Rows)
+            {
+                const FName Name = *reinterpret_cast<const FName*>(Row + Offset);
+                const int32* Code = NameCodes.Find(Name);
+                Column.Codes.Add(Code ? *Code : NameCodes.Add(Name, Column.Labels.Add(Name.ToString())));
+            }
+            break;
+        }
+
+        case EFieldKind::Text:
+            Column.Codes.Reserve(Rows.Num());
+            for (const uint8* Row : Rows)
+            {
+                Column.AddString(reinterpret_cast<const FText*>(Row + Offset)->ToString());
+            }
+            break;
+
+        case EFieldKind::Enum:
+        case EFieldKind::ImportText:
+        {
+            Column.Codes.Reserve(Rows.Num());
+            FString Text;
+            for (const uint8* Row : Rows)
+            {
+                Text.Reset();
+                Field.Property->ExportText_Direct(Text, Row + Offset, Row + Offset, nullptr, PPF_None);
+                Column.AddString(Text);
+            }
+            break;
+        }
+        }
+    }
+    OutDataset.NumRows = Rows.Num();
+}
+
+TMap<FName, EChartColumnType> FRowIngestionPlan::GetColumnTypes() const
+{
+    TMap<FName, EChartColumnType> Types;
+    for (const FFieldPlan& Field : Fields)
+    {
+        const bool bNumber = Field.Kind <= EFieldKind::UInt64;
+        Types.Add(Field.ColumnName, bNumber ? EChartColumnType::Float : EChartColumnType::String);
+    }
+    return Types;
+}
+
+bool FRowIngestionPlan::FillDataTable(const FChartDataset& Dataset, UDataTable* Table) const
+{
+    if (!Table || Table->GetRowStruct() != RowStruct)
+    {
+        UE_LOG(LogTemp, Error, TEXT("RowIngestionPlan - Table does not hold %s rows"), *RowStruct->GetName());
+        return false;
+    }
+
+    // A partial match is left to the DataTable importer, which reports each missing column
+    const int32 NumBound = Fields.FilterByPredicate([&Dataset](const FFieldPlan& Field) { return Dataset.FindColumn(Field.ColumnName) != INDEX_NONE; }).Num();
+    if (NumBound < Fields.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RowIngestionPlan - %d of %d fields of %s have no column"), Fields.Num() - NumBound, Fields.Num(), *RowStruct->GetName());
+        return false;
+    }
+
+    const FChartColumn* NameColumn = nullptr;
+    if (Dataset.Columns.Num() > 0 && !Fields.ContainsByPredicate([&Dataset](const FFieldPlan& Field) { return Field.ColumnName == Dataset.Columns[0].Name; }))
+    {
+        NameColumn = &Dataset.Columns[0];
+    }
+
+    Table->EmptyTable();
+
+    // Rows are built in a reused scratch block and copied into the table, which owns its row memory
+    const int32 RowSize = RowStruct->GetStructureSize();
+    const int32 BlockRows = FMath::Clamp(Dataset.NumRows, 1, RowBlockSize);
+    uint8* Block = static_cast<uint8*>(FMemory::Malloc(static_cast<SIZE_T>(RowSize) * BlockRows, RowStruct->GetMinAlignment()));
+    TArray<uint8*> RowPointers;
+    RowPointers.Reserve(BlockRows);
+    for (int32 FirstRow = 0; FirstRow < Dataset.NumRows; FirstRow += RowBlockSize)
+    {
+        const int32 Count = FMath::Min(RowBlockSize, Dataset.NumRows - FirstRow);
+        RowStruct->InitializeStruct(Block, Count);
+        RowPointers.Reset();
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            RowPointers.Add(Block + static_cast<SIZE_T>(RowSize) * Index);
+        }
+
+        WriteRows(Dataset, FirstRow, RowPointers);
+
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const FString RowName = NameColumn ? NameColumn->GetString(FirstRow + Index) : FString();
+            Table->AddRow(RowName.IsEmpty() ? FName(TEXT("Row"), FirstRow + Index + 1) : FName(*RowName), RowPointers[Index], RowStruct);
+        }
+        RowStruct->DestroyStruct(Block, Count);
+    }
+    FMemory::Free(Block);
+
+    if (Table->GetRowMap().Num() < Dataset.NumRows)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RowIngestionPlan - %d rows share a name with an earlier row and replaced it"), Dataset.NumRows - Table->GetRowMap().Num());
+    }
+    return true;
+}
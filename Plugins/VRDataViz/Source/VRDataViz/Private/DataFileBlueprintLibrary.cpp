@@ -2,6 +2,8 @@
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "HAL/FileManager.h"
+#include "Data/DataByteSource.h"
+#include "Data/PartitionedDatasetLoad.h"
 
 void UDataFileBlueprintLibrary::GetCSVFiles(TArray<FString>& OutFilePaths, const FString& SubfolderName)
 {
@@ -11,10 +13,16 @@ void UDataFileBlueprintLibrary::GetCSVFiles(TArray<FString>& OutFilePaths, const
     const FString TargetDir = FPaths::Combine(BaseDir, SubfolderName);
 
     IFileManager& FileManager = IFileManager::Get();
-    FString SearchPattern = FPaths::Combine(TargetDir, TEXT("*.csv"));
 
+    // Plain and compressed CSVs (.csv.gz, .csv.ucz); the loaders decompress them as a stream
     TArray<FString> FoundFiles;
-    FileManager.FindFiles(FoundFiles, *SearchPattern, true, false);
+    for (const FString& Pattern : DataVizByteSource::GetFilePatterns())
+    {
+        TArray<FString> PatternFiles;
+        FileManager.FindFiles(PatternFiles, *FPaths::Combine(TargetDir, Pattern), true, false);
+        FoundFiles.Append(PatternFiles);
+    }
+    FoundFiles.Sort();
 
     OutFilePaths.Reset();
     for (const FString& FileName : FoundFiles)
@@ -23,6 +31,26 @@ void UDataFileBlueprintLibrary::GetCSVFiles(TArray<FString>& OutFilePaths, const
     }
 }
 
+void UDataFileBlueprintLibrary::GetPartitionedDatasets(TArray<FString>& OutDirectoryPaths, const FString& SubfolderName)
+{
+    OutDirectoryPaths.Reset();
+
+    const FString TargetDir = FPaths::Combine(FPaths::ProjectSavedDir(), SubfolderName);
+
+    TArray<FString> DirectoryNames;
+    IFileManager::Get().FindFiles(DirectoryNames, *FPaths::Combine(TargetDir, TEXT("*")), false, true);
+    DirectoryNames.Sort();
+
+    for (const FString& DirectoryName : DirectoryNames)
+    {
+        const FString DirectoryPath = FPaths::Combine(TargetDir, DirectoryName);
+        if (FPartitionedDatasetLoad::FindShards(DirectoryPath).Num() > 0)
+        {
+            OutDirectoryPaths.Add(DirectoryPath);
+        }
+    }
+}
+
 bool UDataFileBlueprintLibrary::LoadTextFile(const FString& FilePath, FString& OutText)
 {
     OutText.Reset();
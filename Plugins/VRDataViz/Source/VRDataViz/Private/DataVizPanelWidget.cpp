@@ -1,6 +1,13 @@
 #include "DataVizPanelWidget.h"
 #include "DataFileBlueprintLibrary.h"
 #include "PlacementManager.h"
+#include "ChartAdjustLibrary.h"
+#include "Data/ChartDatasetLoader.h"
+#include "Data/PartitionedDatasetLoad.h"
+#include "Data/DataFileIndex.h"
+#include "Data/ChartDatasetDiff.h"
+#include "Data/DatasetCache.h"
+#include "Data/ChartSelection.h"
 #include "Charts/PreviewPlacementActor.h"
 #include "Charts/ScatterActor.h"
 #include "Charts/LineGraphActor.h"
@@ -27,21 +34,58 @@
 #include "Input/Events.h"
 #include "InputCoreTypes.h"
 #include "EngineUtils.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
 
 void UDataVizPanelWidget::ListCSVFiles(TArray<FString>& OutFilePaths, const FString& SubfolderName)
 {
     UDataFileBlueprintLibrary::GetCSVFiles(OutFilePaths, SubfolderName);
 }
 
+namespace
+{
+    const TCHAR* const DefaultColumnOption = TEXT("(default)");
+}
+
 AActor* UDataVizPanelWidget::GenerateChart(EChartType ChartType, const FString& FilePath, const FTransform& SpawnTransform)
 {
-    FString Text;
-    if (!UDataFileBlueprintLibrary::LoadTextFile(FilePath, Text))
+    const TSharedPtr<const FChartDataset> Dataset = LoadDataset(FilePath, ChartType);
+    if (!Dataset.IsValid())
     {
         return nullptr;
     }
 
-    return UChartSpawnLibrary::SpawnChartFromCSV(this, ChartType, Text, SpawnTransform);
+    AActor* Chart = UChartSpawnLibrary::SpawnChartFromDataset(this, ChartType, Dataset, SpawnTransform);
+    TrackPlacedChart(Chart, FilePath, ChartType, ColumnMapping);
+    return Chart;
+}
+
+TSharedPtr<const FChartDataset> UDataVizPanelWidget::LoadDataset(const FString& FilePath, EChartType ChartType) const
+{
+    // Only the columns the mapping draws are parsed
+    const TArray<FName> Columns = ColumnMapping.GetSourceColumns(ChartType);
+    if (PartitionLoad.IsValid() && PartitionLoad->GetPath() == FilePath && PartitionLoadColumns == Columns)
+    {
+        return ColumnMapping.Apply(PartitionLoad->Wait(), ChartType);
+    }
+
+    // Waits for the prefetch started when the file was selected, if it is still running
+    FDatasetCache& Cache = FDatasetCache::Get();
+    Cache.SetMaxBytes(static_cast<int64>(DatasetCacheMB) * 1024 * 1024);
+    return ColumnMapping.Apply(Cache.Load(FilePath, static_cast<int64>(StreamingThresholdMB) * 1024 * 1024, StreamingMaxRows, Columns), ChartType);
+}
+
+EChartType UDataVizPanelWidget::GetSelectedChartType() const
+{
+    const FString Sel = ChartTypeCombo ? ChartTypeCombo->GetSelectedOption() : FString();
+    if (Sel == TEXT("Bar")) return EChartType::Bar;
+    if (Sel == TEXT("Line")) return EChartType::Line;
+    return EChartType::Scatter;
+}
+
+float UDataVizPanelWidget::GetPrefetchHitRate() const
+{
+    return FDatasetCache::Get().GetStats().GetHitRate();
 }
 
 void UDataVizPanelWidget::NativeConstruct()
@@ -61,6 +105,21 @@ void UDataVizPanelWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaT
     
     // Handle keyboard input
     HandleKeyboardInput();
+
+    if (PartitionLoad.IsValid() && !bShardProgressFinal)
+    {
+        UpdateShardProgress();
+    }
+
+    if (FileIndex.IsValid())
+    {
+        FileIndex->Tick(InDeltaTime);
+        if (FileIndex->GetVersion() != FileIndexVersion)
+        {
+            PopulateFileCombo();
+            ReloadChangedCharts();
+        }
+    }
     
     // Continuously update preview position while placement is active
     if (IsPlacementActive())
@@ -92,7 +151,16 @@ TSharedRef<SWidget> UDataVizPanelWidget::RebuildWidget()
     UVerticalBox* VBox = Cast<UVerticalBox>(WidgetTree->RootWidget);
 
     FileCombo = WidgetTree->ConstructWidget<UComboBoxString>(UComboBoxString::StaticClass());
+    PathBox = WidgetTree->ConstructWidget<UEditableTextBox>(UEditableTextBox::StaticClass());
+    ShardProgressText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
+    FileInfoText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
     ChartTypeCombo = WidgetTree->ConstructWidget<UComboBoxString>(UComboBoxString::StaticClass());
+    ColumnXCombo = WidgetTree->ConstructWidget<UComboBoxString>(UComboBoxString::StaticClass());
+    ColumnYCombo = WidgetTree->ConstructWidget<UComboBoxString>(UComboBoxString::StaticClass());
+    ColumnZCombo = WidgetTree->ConstructWidget<UComboBoxString>(UComboBoxString::StaticClass());
+    ColumnValueCombo = WidgetTree->ConstructWidget<UComboBoxString>(UComboBoxString::StaticClass());
+    ColumnColorCombo = WidgetTree->ConstructWidget<UComboBoxString>(UComboBoxString::StaticClass());
+    ColumnSizeCombo = WidgetTree->ConstructWidget<UComboBoxString>(UComboBoxString::StaticClass());
     XBox = WidgetTree->ConstructWidget<UEditableTextBox>(UEditableTextBox::StaticClass());
     YBox = WidgetTree->ConstructWidget<UEditableTextBox>(UEditableTextBox::StaticClass());
     ZBox = WidgetTree->ConstructWidget<UEditableTextBox>(UEditableTextBox::StaticClass());
@@ -158,12 +226,47 @@ TSharedRef<SWidget> UDataVizPanelWidget::RebuildWidget()
     VBox->AddChildToVerticalBox(FileLabel);
     VBox->AddChildToVerticalBox(FileCombo);
 
+    // Size, columns and row estimate of the selected entry, from the file index
+    VBox->AddChildToVerticalBox(FileInfoText);
+
+    // Folder or glob of partitioned files, added to the file list when committed
+    PathBox->SetHintText(FText::FromString(TEXT("Folder or glob, e.g. Saved/DataCharts/trips/part-*.csv")));
+    VBox->AddChildToVerticalBox(PathBox);
+
+    // Per-shard progress while a folder or glob loads
+    ShardProgressText->SetVisibility(ESlateVisibility::Collapsed);
+    VBox->AddChildToVerticalBox(ShardProgressText);
+
     // --- Chart type row ---
     UTextBlock* ChartLabel = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
     ChartLabel->SetText(FText::FromString(TEXT("Chart Type")));
     VBox->AddChildToVerticalBox(ChartLabel);
     VBox->AddChildToVerticalBox(ChartTypeCombo);
 
+    // --- Column mapping rows: which file column drives each axis, listed from the selected file ---
+    auto MakeLabeledComboRow = [this, VBox](const FString& Label, UComboBoxString* Combo) -> UHorizontalBox*
+    {
+        UHorizontalBox* Row = WidgetTree->ConstructWidget<UHorizontalBox>(UHorizontalBox::StaticClass());
+
+        UTextBlock* LabelWidget = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
+        LabelWidget->SetText(FText::FromString(Label));
+
+        Row->AddChildToHorizontalBox(LabelWidget);
+        Row->AddChildToHorizontalBox(Combo);
+        Combo->OnSelectionChanged.AddDynamic(this, &UDataVizPanelWidget::OnColumnMappingChanged);
+
+        VBox->AddChildToVerticalBox(Row);
+        return Row;
+    };
+
+    MakeLabeledComboRow(TEXT("X Column"), ColumnXCombo);
+    MakeLabeledComboRow(TEXT("Y Column"), ColumnYCombo);
+    ColumnZRow = MakeLabeledComboRow(TEXT("Z Column"), ColumnZCombo);
+    ColumnValueRow = MakeLabeledComboRow(TEXT("Value Column"), ColumnValueCombo);
+    ColumnColorRow = MakeLabeledComboRow(TEXT("Color Column"), ColumnColorCombo);
+    ColumnSizeRow = MakeLabeledComboRow(TEXT("Size Column"), ColumnSizeCombo);
+    PopulateColumnCombos(nullptr);
+
     // --- Position input rows (X/Y/Z) ---
     auto MakeLabeledTextRow = [this, VBox](const FString& Label, UEditableTextBox* TextBox)
     {
@@ -266,12 +369,18 @@ TSharedRef<SWidget> UDataVizPanelWidget::RebuildWidget()
     YBox->SetText(FText::FromString(TEXT("0")));
     ZBox->SetText(FText::FromString(TEXT("0")));
 
+    FileCombo->OnSelectionChanged.AddDynamic(this, &UDataVizPanelWidget::OnFileSelected);
+    PathBox->OnTextCommitted.AddDynamic(this, &UDataVizPanelWidget::OnPathCommitted);
     RefreshBtn->OnClicked.AddDynamic(this, &UDataVizPanelWidget::RefreshFiles);
     PlaceBtn->OnClicked.AddDynamic(this, &UDataVizPanelWidget::OnPlace);
     PlaceXYZBtn->OnClicked.AddDynamic(this, &UDataVizPanelWidget::OnPlaceXYZ);
     ConfirmBtn->OnClicked.AddDynamic(this, &UDataVizPanelWidget::OnConfirm);
     CancelBtn->OnClicked.AddDynamic(this, &UDataVizPanelWidget::OnCancel);
 
+    if (!FileIndex.IsValid())
+    {
+        FileIndex = FDataFileIndex::Create(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("DataCharts")));
+    }
     RefreshFiles();
 
     return WidgetTree->RootWidget->TakeWidget();
@@ -285,13 +394,380 @@ void UDataVizPanelWidget::NativeDestruct()
 
 void UDataVizPanelWidget::RefreshFiles()
 {
-    TArray<FString> Files; ListCSVFiles(Files, TEXT("DataCharts"));
-    if (FileCombo)
+    // The list fills at once from the index; the rescan only restats files and updates the list when it finishes
+    if (FileIndex.IsValid())
+    {
+        FileIndex->Rescan();
+    }
+    PopulateFileCombo();
+}
+
+void UDataVizPanelWidget::PopulateFileCombo()
+{
+    if (!FileCombo || !FileIndex.IsValid())
+    {
+        return;
+    }
+
+    FileIndexVersion = FileIndex->GetVersion();
+    const FString Selected = FileCombo->GetSelectedOption();
+
+    FileCombo->ClearOptions();
+    for (const FDataFileInfo& Entry : FileIndex->GetEntries())
+    {
+        FileCombo->AddOption(Entry.FilePath);
+    }
+    for (const FString& Path : CustomPaths)
+    {
+        FileCombo->AddOption(Path);
+    }
+
+    if (FileCombo->FindOptionIndex(Selected) != INDEX_NONE)
+    {
+        FileCombo->SetSelectedOption(Selected);
+    }
+    else if (FileCombo->GetOptionCount() > 0)
+    {
+        FileCombo->SetSelectedIndex(0);
+    }
+}
+
+void UDataVizPanelWidget::TrackPlacedChart(AActor* Chart, const FString& FilePath, EChartType ChartType, const FChartColumnMapping& Mapping)
+{
+    if (!Chart || !UChartAdjustLibrary::GetChartDataset(Chart).IsValid())
+    {
+        return;
+    }
+
+    FPlacedChartSource& Source = PlacedCharts.AddDefaulted_GetRef();
+    Source.Chart = Chart;
+    Source.FilePath = FilePath;
+    Source.ChartType = ChartType;
+    Source.Mapping = Mapping;
+    if (const FDataFileInfo* Info = FileIndex.IsValid() ? FileIndex->FindEntry(FilePath) : nullptr)
+    {
+        Source.FileSize = Info->FileSize;
+        Source.ModificationTime = Info->ModificationTime;
+    }
+
+    // Charts of the same file share a selection; samples are seeded, so equal row counts mean the same rows
+    UChartAdjustLibrary::SetSelection(Chart, FChartSelection::ForSource(FilePath, UChartAdjustLibrary::GetChartDataset(Chart)->NumRows));
+}
+
+void UDataVizPanelWidget::ReloadChangedCharts()
+{
+    PlacedCharts.RemoveAll([](const FPlacedChartSource& Source) { return !Source.Chart.IsValid(); });
+    if (!bHotReloadCharts || !FileIndex.IsValid())
+    {
+        return;
+    }
+
+    const int64 MaxInMemoryBytes = static_cast<int64>(StreamingThresholdMB) * 1024 * 1024;
+    for (FPlacedChartSource& Source : PlacedCharts)
+    {
+        // Files outside the index (such as custom globs) are not followed
+        const FDataFileInfo* Info = FileIndex->FindEntry(Source.FilePath);
+        if (!Info || Source.bReloading || (Info->FileSize == Source.FileSize && Info->ModificationTime == Source.ModificationTime))
+        {
+            continue;
+        }
+        TSharedPtr<const FChartDataset> OldDataset = UChartAdjustLibrary::GetChartDataset(Source.Chart.Get());
+        if (!OldDataset.IsValid())
+        {
+            continue;
+        }
+
+        Source.FileSize = Info->FileSize;
+        Source.ModificationTime = Info->ModificationTime;
+        Source.bReloading = true;
+
+        TWeakObjectPtr<UDataVizPanelWidget> WeakThis(this);
+        Async(EAsyncExecution::ThreadPool, [WeakThis, Chart = Source.Chart, FilePath = Source.FilePath, ChartType = Source.ChartType, Mapping = Source.Mapping, OldDataset, MaxInMemoryBytes, MaxRows = StreamingMaxRows]()
+        {
+            // Re-read with the columns and mapping the chart was placed with, so the diff compares like with like
+            FCSVParseOptions Options;
+            Options.Columns = Mapping.GetSourceColumns(ChartType);
+            TSharedPtr<const FChartDataset> NewDataset = Mapping.Apply(FChartDatasetLoader::LoadDataFile(FilePath, MaxInMemoryBytes, MaxRows, Options), ChartType);
+            FChartDatasetDiff Diff = NewDataset.IsValid() ? FChartDatasetDiff::Compute(*OldDataset, *NewDataset) : FChartDatasetDiff();
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, Chart, OldDataset, NewDataset, Diff = MoveTemp(Diff)]()
+            {
+                if (UDataVizPanelWidget* This = WeakThis.Get())
+                {
+                    This->FinishChartReload(Chart, OldDataset, NewDataset, Diff);
+                }
+            });
+        });
+    }
+}
+
+void UDataVizPanelWidget::FinishChartReload(TWeakObjectPtr<AActor> Chart, TSharedPtr<const FChartDataset> OldDataset, TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff)
+{
+    FPlacedChartSource* Source = PlacedCharts.FindByPredicate([&Chart](const FPlacedChartSource& Placed) { return Placed.Chart == Chart; });
+    if (!Source || !Chart.IsValid())
+    {
+        return;
+    }
+    Source->bReloading = false;
+
+    if (!NewDataset.IsValid())
+    {
+        // Often a file caught mid-write; the next change notification retries
+        UE_LOG(LogTemp, Warning, TEXT("FinishChartReload - Could not reload %s, keeping the chart as it was"), *Source->FilePath);
+    }
+    else if (UChartAdjustLibrary::GetChartDataset(Chart.Get()) != OldDataset)
+    {
+        // The chart was rebuilt from other data while the file was read; diff against what it shows now
+        const TSharedPtr<const FChartDataset> CurrentDataset = UChartAdjustLibrary::GetChartDataset(Chart.Get());
+        const FChartDatasetDiff CurrentDiff = CurrentDataset.IsValid() ? FChartDatasetDiff::Compute(*CurrentDataset, *NewDataset) : FChartDatasetDiff();
+        UChartAdjustLibrary::ApplyDatasetUpdate(Chart.Get(), NewDataset, CurrentDiff);
+    }
+    else
+    {
+        UChartAdjustLibrary::ApplyDatasetUpdate(Chart.Get(), NewDataset, Diff);
+    }
+    if (NewDataset.IsValid())
+    {
+        // Rows added or removed no longer line up with the other charts of the old file
+        UChartAdjustLibrary::SetSelection(Chart.Get(), FChartSelection::ForSource(Source->FilePath, NewDataset->NumRows));
+    }
+
+    // The file may have changed again while it was being read
+    ReloadChangedCharts();
+}
+
+void UDataVizPanelWidget::OnFileSelected(FString Selected, ESelectInfo::Type SelectionType)
+{
+    // Clearing the list while it is rebuilt selects nothing; keep whatever load is running
+    if (Selected.IsEmpty())
+    {
+        return;
+    }
+
+    const FDataFileInfo* Info = FileIndex.IsValid() ? FileIndex->FindEntry(Selected) : nullptr;
+    if (FileInfoText)
+    {
+        FString InfoLine;
+        if (Info)
+        {
+            const FString RowsText = Info->EstimatedRows != INDEX_NONE ? FText::AsNumber(Info->EstimatedRows).ToString() : FString(TEXT("?"));
+            FString ColumnsText;
+            for (const FName Column : Info->Columns)
+            {
+                ColumnsText += (ColumnsText.IsEmpty() ? TEXT("") : TEXT(", ")) + Column.ToString();
+            }
+            InfoLine = FString::Printf(TEXT("%s%.1f MB, ~%s rows, %d columns (%s)"), Info->bIsFolder ? TEXT("Folder: ") : TEXT(""),
+                Info->FileSize / (1024.0 * 1024.0), *RowsText, Info->Columns.Num(), *ColumnsText);
+        }
+        FileInfoText->SetText(FText::FromString(InfoLine));
+    }
+
+    PopulateColumnCombos(Info);
+
+    // Picking an entry by hand also picks the chart type its columns suggest
+    if (Info && ChartTypeCombo && SelectionType != ESelectInfo::Direct)
+    {
+        const TCHAR* const ChartTypeNames[] = { TEXT("Bar"), TEXT("Line"), TEXT("Scatter") };
+        const FString ChartTypeName = ChartTypeNames[static_cast<int32>(Info->SuggestedChartType)];
+        ChartTypeCombo->SetSelectedOption(ChartTypeName);
+    }
+
+    StartSelectedLoad(Selected);
+}
+
+void UDataVizPanelWidget::StartSelectedLoad(const FString& Selected)
+{
+    if (Selected.IsEmpty())
+    {
+        return;
+    }
+
+    // Start reading the file right away so it is parsed (or close to it) by the time placement starts.
+    // Folders and globs load through PartitionLoad below, which also shows their progress.
+    const TArray<FName> Columns = ColumnMapping.GetSourceColumns(GetSelectedChartType());
+    FDatasetCache& Cache = FDatasetCache::Get();
+    if (bPrefetchSelectedFile && !FPartitionedDatasetLoad::IsPartitionedPath(Selected))
+    {
+        Cache.SetMaxBytes(static_cast<int64>(DatasetCacheMB) * 1024 * 1024);
+        Cache.Prefetch(Selected, static_cast<int64>(StreamingThresholdMB) * 1024 * 1024, StreamingMaxRows, Columns);
+    }
+    else
+    {
+        Cache.CancelPrefetch();
+    }
+
+    if (PartitionLoad.IsValid() && PartitionLoad->GetPath() == Selected && PartitionLoadColumns == Columns)
+    {
+        return;
+    }
+
+    // Same for the shards of a folder; a folder the user moved away from stops loading
+    if (PartitionLoad.IsValid())
+    {
+        PartitionLoad->Cancel();
+    }
+    PartitionLoad.Reset();
+    PartitionLoadColumns = Columns;
+    bShardProgressFinal = false;
+    if (FPartitionedDatasetLoad::IsPartitionedPath(Selected))
+    {
+        FCSVParseOptions Options;
+        Options.Columns = Columns;
+        PartitionLoad = FPartitionedDatasetLoad::Start(Selected, static_cast<int64>(StreamingThresholdMB) * 1024 * 1024, StreamingMaxRows, Options);
+    }
+    UpdateShardProgress();
+}
+
+void UDataVizPanelWidget::PopulateColumnCombos(const FDataFileInfo* Info)
+{
+    // Roles naming a column the new file lacks fall back to the chart's default column
+    if (Info && Info->Columns.Num() > 0)
     {
-        FileCombo->ClearOptions();
-        for (const FString& P : Files) { FileCombo->AddOption(P); }
-        if (Files.Num() > 0) { FileCombo->SetSelectedOption(Files[0]); }
+        for (FName* Role : { &ColumnMapping.X, &ColumnMapping.Y, &ColumnMapping.Z, &ColumnMapping.Value, &ColumnMapping.Color, &ColumnMapping.Size })
+        {
+            if (!Info->Columns.Contains(*Role))
+            {
+                *Role = NAME_None;
+            }
+        }
     }
+
+    TGuardValue<bool> Populating(bPopulatingColumnCombos, true);
+    const auto Fill = [Info](UComboBoxString* Combo, FName Selected)
+    {
+        if (!Combo)
+        {
+            return;
+        }
+        Combo->ClearOptions();
+        Combo->AddOption(DefaultColumnOption);
+        for (const FName Column : Info ? Info->Columns : TArray<FName>())
+        {
+            Combo->AddOption(Column.ToString());
+        }
+        if (!Selected.IsNone() && Combo->FindOptionIndex(Selected.ToString()) == INDEX_NONE)
+        {
+            Combo->AddOption(Selected.ToString());
+        }
+        Combo->SetSelectedOption(Selected.IsNone() ? FString(DefaultColumnOption) : Selected.ToString());
+    };
+    Fill(ColumnXCombo, ColumnMapping.X);
+    Fill(ColumnYCombo, ColumnMapping.Y);
+    Fill(ColumnZCombo, ColumnMapping.Z);
+    Fill(ColumnValueCombo, ColumnMapping.Value);
+    Fill(ColumnColorCombo, ColumnMapping.Color);
+    Fill(ColumnSizeCombo, ColumnMapping.Size);
+}
+
+void UDataVizPanelWidget::OnColumnMappingChanged(FString Selected, ESelectInfo::Type SelectionType)
+{
+    if (bPopulatingColumnCombos)
+    {
+        return;
+    }
+
+    const auto Read = [](const UComboBoxString* Combo)
+    {
+        const FString Option = Combo ? Combo->GetSelectedOption() : FString();
+        return Option.IsEmpty() || Option == DefaultColumnOption ? FName() : FName(*Option);
+    };
+    FChartColumnMapping Mapping;
+    Mapping.X = Read(ColumnXCombo);
+    Mapping.Y = Read(ColumnYCombo);
+    Mapping.Z = Read(ColumnZCombo);
+    Mapping.Value = Read(ColumnValueCombo);
+    Mapping.Color = Read(ColumnColorCombo);
+    Mapping.Size = Read(ColumnSizeCombo);
+    if (Mapping == ColumnMapping)
+    {
+        return;
+    }
+
+    // Re-read with the new projection; an in-memory file parses again from its cached bytes
+    ColumnMapping = Mapping;
+    StartSelectedLoad(FileCombo ? FileCombo->GetSelectedOption() : FString());
+}
+
+void UDataVizPanelWidget::OnPathCommitted(const FText& Text, ETextCommit::Type CommitMethod)
+{
+    if (CommitMethod != ETextCommit::OnEnter || !FileCombo)
+    {
+        return;
+    }
+
+    FString Path = Text.ToString().TrimStartAndEnd();
+    if (FPaths::IsRelative(Path))
+    {
+        Path = FPaths::Combine(FPaths::ProjectDir(), Path);
+    }
+    if (FPartitionedDatasetLoad::FindShards(Path).Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("OnPathCommitted - No data files match %s"), *Path);
+        return;
+    }
+
+    if (FileCombo->FindOptionIndex(Path) == INDEX_NONE)
+    {
+        CustomPaths.AddUnique(Path);
+        FileCombo->AddOption(Path);
+    }
+    FileCombo->SetSelectedOption(Path);
+}
+
+void UDataVizPanelWidget::UpdateShardProgress()
+{
+    if (!ShardProgressText)
+    {
+        return;
+    }
+    if (!PartitionLoad.IsValid())
+    {
+        ShardProgressText->SetVisibility(ESlateVisibility::Collapsed);
+        return;
+    }
+
+    // Checked before taking the snapshot so the final update shows every shard finished
+    const bool bComplete = PartitionLoad->IsComplete();
+    const TArray<FDatasetShardProgress> Progress = PartitionLoad->GetProgress();
+
+    // Long shard lists only show the shards that still need attention
+    const int32 MaxListedShards = 16;
+    const bool bListAll = Progress.Num() <= MaxListedShards;
+    int32 NumFinished = 0;
+    int32 NumListed = 0;
+    int64 NumRows = 0;
+    FString ShardLines;
+    for (const FDatasetShardProgress& Shard : Progress)
+    {
+        FString StateText;
+        switch (Shard.State)
+        {
+        case EDatasetShardState::Queued:  StateText = TEXT("queued"); break;
+        case EDatasetShardState::Loading: StateText = TEXT("loading..."); break;
+        case EDatasetShardState::Loaded:  StateText = FString::Printf(TEXT("%d rows"), Shard.NumRows); break;
+        case EDatasetShardState::Failed:  StateText = TEXT("failed"); break;
+        }
+
+        if (Shard.State == EDatasetShardState::Loaded || Shard.State == EDatasetShardState::Failed)
+        {
+            ++NumFinished;
+            NumRows += Shard.NumRows;
+        }
+
+        const bool bList = bListAll || Shard.State == EDatasetShardState::Loading || Shard.State == EDatasetShardState::Failed;
+        if (bList && NumListed < MaxListedShards)
+        {
+            FString ShardName = Shard.FilePath;
+            FPaths::MakePathRelativeTo(ShardName, *PartitionLoad->GetPath());
+            ShardLines += FString::Printf(TEXT("\n  %s: %s"), *ShardName, *StateText);
+            ++NumListed;
+        }
+    }
+
+    const FString Summary = FString::Printf(TEXT("%s %d / %d shards, %lld rows"),
+        bComplete ? TEXT("Loaded") : TEXT("Loading"), NumFinished, Progress.Num(), NumRows);
+    ShardProgressText->SetText(FText::FromString(Summary + ShardLines));
+    ShardProgressText->SetVisibility(ESlateVisibility::Visible);
+    bShardProgressFinal = bComplete;
 }
 
 void UDataVizPanelWidget::OnChartTypeChanged(FString Selected, ESelectInfo::Type)
@@ -303,6 +779,25 @@ void UDataVizPanelWidget::OnChartTypeChanged(FString Selected, ESelectInfo::Type
     {
         PointScaleRow->SetVisibility((bIsLine || bIsScatter) ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
     }
+
+    // Column roles the chart type draws
+    const auto ShowIf = [](UWidget* Row, bool bShow)
+    {
+        if (Row)
+        {
+            Row->SetVisibility(bShow ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+        }
+    };
+    ShowIf(ColumnZRow, bIsLine || bIsScatter);
+    ShowIf(ColumnValueRow, bIsBar);
+    ShowIf(ColumnColorRow, bIsScatter);
+    ShowIf(ColumnSizeRow, bIsScatter);
+
+    // Each chart type parses its own set of mapped columns
+    if (ColumnMapping.IsSet() && FileCombo)
+    {
+        StartSelectedLoad(FileCombo->GetSelectedOption());
+    }
 }
 
 void UDataVizPanelWidget::OnPlace()
@@ -802,6 +1297,9 @@ bool UDataVizPanelWidget::ConfirmPlacement(EChartType ChartType, const FString&
     // Apply final transform with rotation and scale
     UpdatePreviewTransform();
     
+    // Swap the sampled preview for the full-resolution build
+    UChartAdjustLibrary::SetPreviewFidelity(PreviewChart, false, PreviewMaxPrimitives);
+    
     // Remove preview transparency
     TArray<UActorComponent*> Components;
     PreviewChart->GetComponents(Components);
@@ -832,6 +1330,7 @@ bool UDataVizPanelWidget::ConfirmPlacement(EChartType ChartType, const FString&
     
     // Clear preview state but keep the chart (it's now the actual placed chart)
     AActor* PlacedChart = PreviewChart;
+    TrackPlacedChart(PlacedChart, PendingFile.IsEmpty() ? FilePath : PendingFile, PendingType, PendingMapping);
     PreviewChart = nullptr;
     if (PlacementMgr) { PlacementMgr->Destroy(); PlacementMgr = nullptr; }
     if (VisualGuideActor && IsValid(VisualGuideActor))
@@ -970,14 +1469,15 @@ AActor* UDataVizPanelWidget::CreatePreviewChart()
         return nullptr;
     }
     
-    FString Text;
-    if (!UDataFileBlueprintLibrary::LoadTextFile(PendingFile, Text))
+    PendingMapping = ColumnMapping;
+    const TSharedPtr<const FChartDataset> Dataset = LoadDataset(PendingFile, PendingType);
+    if (!Dataset.IsValid())
     {
         UE_LOG(LogTemp, Error, TEXT("CreatePreviewChart - Failed to load file: %s"), *PendingFile);
         return nullptr;
     }
     
-    if (Text.IsEmpty())
+    if (Dataset->NumRows == 0)
     {
         UE_LOG(LogTemp, Error, TEXT("CreatePreviewChart - File is empty: %s"), *PendingFile);
         return nullptr;
@@ -1007,7 +1507,7 @@ AActor* UDataVizPanelWidget::CreatePreviewChart()
     FTransform InitialTransform(FRotator::ZeroRotator, InitialLocation, FVector::OneVector);
     
     // Spawn chart with safe parameters
-    AActor* Chart = UChartSpawnLibrary::SpawnChartFromCSV(this, PendingType, Text, InitialTransform);
+    AActor* Chart = UChartSpawnLibrary::SpawnChartFromDataset(this, PendingType, Dataset, InitialTransform, PreviewMaxPrimitives);
     
     if (Chart && IsValid(Chart))
     {
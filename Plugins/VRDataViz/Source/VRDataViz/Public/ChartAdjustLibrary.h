@@ -1,8 +1,14 @@
 #pragma once
 
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "Data/ChartAggregation.h"
 #include "ChartAdjustLibrary.generated.h"
 
+struct FChartDataset;
+struct FChartDatasetDiff;
+class FChartSelection;
+enum class ELineGraphOrder : uint8;
+
 UCLASS()
 class VRDATAVIZ_API UChartAdjustLibrary : public UBlueprintFunctionLibrary
 {
@@ -17,5 +23,50 @@ public:
 
     UFUNCTION(BlueprintCallable, Category = "Data|Charts")
     static void SetAxisRanges(AActor* ChartActor, bool bUseCustom, float XMin, float XMax, float YMin, float YMax, float ZMin, float ZMax);
+
+    // Fit scatter and line axes to a percentile span of the data (1st to 99th by default) rather than its min..max
+    UFUNCTION(BlueprintCallable, Category = "Data|Charts")
+    static void SetPercentileClip(AActor* ChartActor, bool bClip, float LowPercentile = 1.0f, float HighPercentile = 99.0f);
+
+    // Toggle the mean, sigma band and least-squares overlays of a scatter or line chart; only the overlays respawn
+    UFUNCTION(BlueprintCallable, Category = "Data|Charts")
+    static void SetStatsOverlay(AActor* ChartActor, bool bMean, bool bSigmaBand, bool bRegression, float SigmaBandWidth = 1.0f);
+
+    // Order in which a line graph connects its points: file order, by X, or by any column of its dataset
+    UFUNCTION(BlueprintCallable, Category = "Data|Charts")
+    static void SetLineOrder(AActor* ChartActor, ELineGraphOrder Order, FName Column = NAME_None);
+
+    // Zoom a line graph into data X from MinX to MaxX, refined from its decimation pyramid; MinX >= MaxX zooms out
+    UFUNCTION(BlueprintCallable, Category = "Data|Charts")
+    static void SetLineXRange(AActor* ChartActor, float MinX, float MaxX);
+
+    // Draw a bar chart's dataset rows as one bar per X (and Y) key, valued by an aggregate of a value column, such as
+    // the sum of Sales per Region and Year; an unset XColumn goes back to one bar per row
+    UFUNCTION(BlueprintCallable, Category = "Data|Charts")
+    static void SetBarGroupBy(AActor* ChartActor, const FChartGroupBy& GroupBy);
+
+    // Toggle the capped-sample preview build; turning it off swaps in the full-resolution chart
+    UFUNCTION(BlueprintCallable, Category = "Data|Charts")
+    static void SetPreviewFidelity(AActor* ChartActor, bool bPreview, int32 MaxPrimitives = 2000);
+
+    // Show only the rows of a dataset chart that match a filter expression such as `Z > 0.5 && X in [10, 20]`
+    // (an empty expression shows every row); points and bars are hidden in place, without a rebuild
+    UFUNCTION(BlueprintCallable, Category = "Data|Charts")
+    static bool SetFilter(AActor* ChartActor, const FString& Expression);
+
+    // Links the selections of charts drawn from the same rows: selecting rows in one highlights them in all. Charts
+    // whose row count differs from the first dataset chart's, and bar charts whose bars do not know their rows, are
+    // left unlinked. Returns how many charts were linked.
+    UFUNCTION(BlueprintCallable, Category = "Data|Charts")
+    static int32 LinkSelection(const TArray<AActor*>& ChartActors);
+
+    static void SetSelection(AActor* ChartActor, TSharedPtr<FChartSelection> Selection);
+
+    // The dataset a chart was built from; null for charts built from a DataTable
+    static TSharedPtr<const FChartDataset> GetChartDataset(AActor* ChartActor);
+
+    // Swaps a re-read version of the chart's dataset in, touching only the primitives of rows in Diff
+    // (computed against GetChartDataset) and rebuilding axes only when their grid changes
+    static void ApplyDatasetUpdate(AActor* ChartActor, TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff);
 };
 
@@ -2,6 +2,7 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Engine/DataTable.h"
+#include "Data/ChartDataset.h"
 #include "ChartSpawnLibrary.generated.h"
 
 UENUM(BlueprintType)
@@ -21,7 +22,11 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Data|Charts")
     static bool ParseCSVToDataTable(const FString& CSVText, UScriptStruct* RowStruct, UDataTable*& OutDataTable);
 
+    // PreviewPrimitiveBudget > 0 builds the chart in preview fidelity (capped stratified sample) from the start
     UFUNCTION(BlueprintCallable, Category = "Data|Charts")
-    static AActor* SpawnChartFromCSV(UObject* WorldContextObject, EChartType ChartType, const FString& CSVText, const FTransform& SpawnTransform);
+    static AActor* SpawnChartFromCSV(UObject* WorldContextObject, EChartType ChartType, const FString& CSVText, const FTransform& SpawnTransform, int32 PreviewPrimitiveBudget = 0);
+
+    // Same as SpawnChartFromCSV for a dataset already loaded by FChartDatasetLoader; the chart keeps a reference to it
+    static AActor* SpawnChartFromDataset(UObject* WorldContextObject, EChartType ChartType, TSharedPtr<const FChartDataset> Dataset, const FTransform& SpawnTransform, int32 PreviewPrimitiveBudget = 0);
 };
 
@@ -3,10 +3,17 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Engine/DataTable.h"
+#include "Data/ChartAggregation.h"
+#include "Data/ChartDataset.h"
+#include "Data/ChartFilter.h"
+#include "Data/ChartSelection.h"
 #include "BarChartActor.generated.h"
 
 class UMaterialInterface;
 class ABarActor;
+class AAxisTickActor;
+class UChartDatasetAsset;
+struct FChartDatasetDiff;
 
 USTRUCT(BlueprintType)
 struct FVRBarData : public FTableRowBase
@@ -30,6 +37,11 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+#if WITH_EDITOR
+    // Cooks the DataTable as a dataset asset packed into the chart when DatasetAsset is not set
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+    virtual void Serialize(FArchive& Ar) override;
+#endif
 
 private:
     UPROPERTY() USceneComponent* Root;
@@ -38,16 +50,80 @@ private:
     UPROPERTY() TArray<AActor*> SpawnedChildren;
     UPROPERTY() UMaterialInterface* BarColorMaterial;
 
+    // Source rows of RuntimeDataset behind each entry of BarPoints: bar I stands for BarRows[BarRowStarts[I]] up to
+    // BarRows[BarRowStarts[I + 1]], one row for bars read from the dataset's rows and a group's rows for aggregated
+    // bars. Empty when the bars have no rows (DataTable, or SetRuntimeData without them). Text labels of row bars are
+    // left empty in BarPoints and read from the dataset's label dictionary through their row.
+    TArray<int32> BarRowStarts;
+    TArray<int32> BarRows;
+    // Bar of each row of RuntimeDataset given with SetRuntimeData (INDEX_NONE for rows in no bar)
+    TArray<int32> RuntimeBarOfRow;
+    // Whether BarPoints are the rows of RuntimeDataset one for one, rather than groups of them or given bars
+    bool bBarsAreRows = false;
+    TConstArrayView<int32> GetBarRows(int32 BarIndex) const;
+    // Fills BarRowStarts and BarRows from the bar of each row
+    void SetBarRows(TConstArrayView<int32> InBarOfRow);
+    // Bar and value label of each entry of BarPoints (null where a preview sample skipped it); SpawnedChildren
+    // holds the axis labels and Z ticks
+    UPROPERTY() TArray<ABarActor*> BarActors;
+    UPROPERTY() TArray<AAxisTickActor*> ValueLabels;
+
+    // What the axis labels and Z ticks were last built from
+    TMap<int32, FString> XAxisLabels;
+    TMap<int32, FString> YAxisLabels;
+    int32 AxisMinXIndex = 0;
+    int32 AxisMinYIndex = 0;
+    int32 AxisMaxLabelLength = 1;
+    float AxisMaxValue = 0.0f;
+    float ZAxisMin = 0.0f, ZAxisMax = 0.0f, ZAxisStep = 0.0f;
+
+    TSharedPtr<const FChartDataset> RuntimeDataset;
+
+    FChartFilter Filter;
+    FChartRowMask FilterMask;
+    // Evaluates Filter over the runtime dataset and hides the bars none of whose rows it keeps; false when it cannot
+    // be evaluated
+    bool ApplyFilter();
+
+    // Linked selection shared with other charts of the same rows; bars with a selected row are drawn in SelectionColor
+    TSharedPtr<FChartSelection> Selection;
+    FDelegateHandle SelectionChangedHandle;
+    // Bar of each source row (INDEX_NONE for rows without one), built when a selection change first needs it
+    TArray<int32> BarOfRow;
+    // Recolors the bars of the rows that flipped, and nothing else
+    void OnSelectionChanged(const FChartSelectionChange& Change);
+
     void LoadBarData();
     void GenerateBars();
+    // Recomputes labels, index bounds and the Z grid from BarPoints; true when the axis labels or ticks would change
+    bool UpdateAxisLayout();
+    // Text label column of the runtime dataset that the bars were loaded from, read by dictionary code; null otherwise
+    const FChartColumn* GetLabelCodes(FName ColumnName) const;
+    void GenerateAxisLabels();
     void GenerateZAxisTicks(float MaxValue, const FVector& AxisOrigin, const FQuat& GraphRotation, float ScaledBarWidth, float ScaledBarDepth);
+    // Moves and recolors an existing bar and value label, or spawns them when null
+    void PlaceBar(int32 BarIndex, ABarActor* Bar, AAxisTickActor* ValueLabel);
+    void ClearAxisActors();
     void ClearChildrenActors();
+    void ConfigureText(AAxisTickActor* Tick) const;
+    FVector GetLayoutScale() const;
+    FQuat GetGraphRotation() const;
     FLinearColor GetBarColor(int32 BarIndex);
 
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data")
     UDataTable* BarDataTable;
 
+    // Packed columns converted from a chart DataTable (VRDataViz.ConvertChartTables); read asynchronously at BeginPlay and used instead of the DataTable when set
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data")
+    UChartDatasetAsset* DatasetAsset = nullptr;
+
+    // Draws one bar per distinct GroupBy.XColumn (and YColumn) key of the runtime dataset, valued by the aggregate of
+    // ValueColumn over its rows (FChartAggregation::GroupBy), instead of one bar per row read from the XIndex, YIndex
+    // and Value columns. Each bar keeps its rows, so filters and linked selections apply to them. Unset by default.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data")
+    FChartGroupBy GroupBy;
+
     // Overall scale multiplier (X scales width/spacing, Y scales depth/spacing, Z scales height)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scale")
     FVector GraphScale = FVector(1.0f, 1.0f, 1.0f);
@@ -111,8 +187,70 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Z Axis")
     int32 ZTickCount = 5;
 
+    // Preview fidelity: build a stratified sample of bars (bar + value label count against the cap);
+    // Z range and axis labels still come from every row
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preview")
+    bool bPreviewFidelity = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preview", meta=(EditCondition="bPreviewFidelity"))
+    int32 MaxPreviewPrimitives = 2000;
+
     UFUNCTION(BlueprintCallable, Category = "Chart")
     void Rebuild();
 
-    void SetRuntimeData(const TArray<FVRBarData>& InData) { RuntimeBarPoints = InData; }
+    // Shows only the bars whose rows match Expression (see FChartFilter; an empty expression shows everything). The
+    // filter runs over the runtime dataset and hides bars and their value labels rather than rebuilding the chart, and
+    // it is applied again after rebuilds and dataset updates. False when Expression does not parse (the old filter
+    // stays) or cannot be evaluated against the dataset (every bar is shown).
+    UFUNCTION(BlueprintCallable, Category = "Chart")
+    bool SetFilter(const FString& Expression);
+
+    UFUNCTION(BlueprintPure, Category = "Chart")
+    FString GetFilter() const { return Filter.GetExpression(); }
+
+    // Rows the current filter keeps; empty when the chart is unfiltered
+    const FChartRowMask& GetFilterMask() const { return FilterMask; }
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Selection")
+    FLinearColor SelectionColor = FLinearColor(1.0f, 0.85f, 0.1f, 1.0f);
+
+    // Binds the chart to a selection shared with other charts of the same rows (FChartSelection::ForSource). Selecting
+    // rows in any of them recolors the bars holding them here in place; null unbinds. Bars without source rows
+    // (DataTable, or SetRuntimeData without them) are selected by bar index and link to nothing else.
+    void SetSelection(TSharedPtr<FChartSelection> InSelection);
+    TSharedPtr<FChartSelection> GetSelection() const { return Selection; }
+
+    // Selects every row of the given bars in the bound selection, or in a selection of this chart alone when unbound
+    UFUNCTION(BlueprintCallable, Category = "Selection")
+    void SelectBars(const TArray<int32>& BarIndices, bool bAddToSelection = false);
+
+    UFUNCTION(BlueprintCallable, Category = "Selection")
+    void ClearSelection();
+
+    UFUNCTION(BlueprintPure, Category = "Selection")
+    bool IsBarSelected(int32 BarIndex) const;
+
+    // Whether every bar knows the rows of the runtime dataset it stands for, which filters and linked selections need
+    bool HasBarRows() const { return BarRowStarts.Num() == BarPoints.Num() + 1; }
+
+    // Bars given this way have no source rows, so filters do not apply to them and their selection links to no
+    // other chart
+    void SetRuntimeData(const TArray<FVRBarData>& InData) { RuntimeBarPoints = InData; RuntimeBarOfRow.Reset(); }
+    void SetRuntimeData(TArray<FVRBarData>&& InData) { RuntimeBarPoints = MoveTemp(InData); RuntimeBarOfRow.Reset(); }
+    // Bars computed from the rows of the runtime dataset, with the bar of each row, such as FChartAggregation::GroupBy
+    // returns. Filters and linked selections then work on the rows behind each bar. Setting GroupBy does the same
+    // from Blueprints and regroups on every rebuild.
+    void SetRuntimeData(TArray<FVRBarData>&& InData, TArray<int32>&& InBarOfRow)
+    {
+        RuntimeBarPoints = MoveTemp(InData);
+        RuntimeBarOfRow = MoveTemp(InBarOfRow);
+    }
+
+    // Columnar data from FChartDatasetLoader (XIndex, YIndex, Value, XLabel, YLabel columns); used instead of BarDataTable when set
+    void SetRuntimeDataset(TSharedPtr<const FChartDataset> InDataset) { RuntimeDataset = MoveTemp(InDataset); }
+    TSharedPtr<const FChartDataset> GetRuntimeDataset() const { return RuntimeDataset; }
+
+    // Swaps in a new version of the runtime dataset, given its diff against the current one. Only bars of changed
+    // rows are touched; axis labels and Z ticks are rebuilt only when they would change.
+    void ApplyDatasetUpdate(TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff);
 };
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Min/max decimation pyramid over one or more series of a line's values (its Y and Z, say), in line order. Level 0
+// splits the line into buckets of LeafPoints positions and each level above merges pairs, keeping for every bucket the
+// positions of the lowest and highest value of each series. A bucket is drawn as its first and last point and the
+// extremes of every series (M4, per series), which is all a pixel column of the bucket can show, so the peaks of each
+// series survive at any level. Selecting a range of positions picks the level whose buckets
+// yield about the requested number of points and covers the range's ragged ends with smaller buckets, so zooming in
+// costs O(points drawn + levels) and never reads the raw values again.
+class VRDATAVIZ_API FChartLinePyramid
+{
+public:
+    static constexpr int32 LeafPoints = 8;
+
+    // Builds the pyramid over Series, each holding one value per position in line order (all of the same length); leaf
+    // buckets are summarized in parallel. NaN values are never picked as a bucket's lowest or highest while the bucket
+    // has another value.
+    void Build(TConstArrayView<TConstArrayView<float>> Series);
+    void Reset();
+
+    int32 Num() const { return NumPoints; }
+    int32 GetNumLevels() const { return Levels.Num(); }
+    // Positions a bucket draws at most: its first and last, and the lowest and highest of each series
+    int32 GetPointsPerBucket() const { return 2 + 2 * NumSeries; }
+
+    // Ascending positions in Begin..End - 1 that draw the range with about MaxPoints points (every position when the
+    // range has no more than that; MaxPoints <= 0 means no cap)
+    void Select(int32 Begin, int32 End, int32 MaxPoints, TArray<int32>& OutPositions) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FExtremes
+    {
+        int32 Min = 0;
+        int32 Max = 0;
+    };
+
+    int32 NumPoints = 0;
+    int32 NumSeries = 0;
+    // Per level, the extremes of each series in each bucket of LeafPoints << Level positions (the last one may be
+    // short), NumSeries to a bucket
+    TArray<TArray<FExtremes>> Levels;
+};
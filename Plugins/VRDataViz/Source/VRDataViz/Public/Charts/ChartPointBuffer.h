@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ChartMoments.h"
+
+struct FChartDatasetDiff;
+
+// Data positions of a chart's points in compact, non-reflected storage. Quantized points keep one 16-bit step per
+// axis across the bounds of the points (6 bytes a point instead of an FVector's 24) and read back within half a
+// step, well under what a placed point shows; otherwise points are kept as FVector3f (12 bytes). Exact values stay
+// in the chart's dataset or DataTable.
+class VRDATAVIZ_API FChartPointBuffer
+{
+public:
+    void Reset();
+
+    // Replaces the points. Points with a non-finite coordinate cannot be quantized and are kept as FVector3f.
+    void Assign(TConstArrayView<FVector> Points, bool bQuantize);
+    // Adds points after the current ones, as rows streamed onto the end of a dataset. Quantized points that fall
+    // outside the quantization frame widen it by half the bounds beyond them and re-step the stored points, so bounds
+    // that keep growing re-step them a logarithmic number of times, and points read back within about a step.
+    void Append(TConstArrayView<FVector> Points);
+
+    int32 Num() const { return NumPoints; }
+    bool IsQuantized() const { return Quantized.Num() > 0; }
+    FVector operator[](int32 Index) const;
+
+    // Exact bounds of the points as they were assigned
+    const FBox& GetBounds() const { return Bounds; }
+    // Per-axis values at fractions LowQ and HighQ (0..1) of the points, from quantile sketches built in one pass
+    void GetQuantileRange(double LowQ, double HighQ, FVector& OutMin, FVector& OutMax) const;
+    // Mean and covariance of the points, from blocks read back and summarized in parallel, then merged in order
+    FChartMoments ComputeMoments() const;
+    // Turns the moments of OldPoints into those of NewPoints from the rows Diff lists, in O(1) per listed row: points
+    // of removed rows are taken out, those of appended rows added and those of modified rows swapped. OldPointOfRow
+    // and NewPointOfRow give the point of an old and of a new row (INDEX_NONE for rows without one).
+    static void PatchMoments(FChartMoments& Moments, const FChartPointBuffer& OldPoints, const FChartPointBuffer& NewPoints, const FChartDatasetDiff& Diff,
+        TFunctionRef<int32(int32)> OldPointOfRow, TFunctionRef<int32(int32)> NewPointOfRow);
+
+    // Indices of the points along a Z-order (Morton) curve over the quantized bounds, which interleaves the bits of
+    // the three 16-bit steps: points close in space end up close in the order. Non-finite points go last.
+    void GetMortonOrder(TArray<int32>& OutOrder) const;
+    // Reorders the points so that point I becomes the old point Order[I]
+    void Permute(TConstArrayView<int32> Order);
+
+    // True when two stored points are the same to within the coarser precision of the two buffers. Points of buffers
+    // quantized over the same bounds compare exactly.
+    static bool IsSamePoint(const FChartPointBuffer& A, int32 AIndex, const FChartPointBuffer& B, int32 BIndex);
+
+    SIZE_T GetAllocatedSize() const { return Quantized.GetAllocatedSize() + Floats.GetAllocatedSize(); }
+
+private:
+    int32 NumPoints = 0;
+    FBox Bounds = FBox(ForceInit);
+    // Quantization frame: Origin up to 65535 steps of Step on each axis (zero on a flat axis). Assign fits it to the
+    // bounds; Append may widen it past them.
+    FVector Origin = FVector::ZeroVector;
+    FVector Step = FVector::ZeroVector;
+    // Three steps-from-Origin per point
+    TArray<uint16> Quantized;
+    TArray<FVector3f> Floats;
+};
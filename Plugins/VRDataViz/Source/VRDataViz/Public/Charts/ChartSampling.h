@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+namespace DataVizSampling
+{
+    // Pick at most MaxCount row indices out of NumRows, one per equal-width stratum, in ascending order.
+    // The jitter inside each stratum is seeded so repeated preview rebuilds pick the same rows.
+    // MaxCount <= 0 means "no cap" and returns every row.
+    inline void StratifiedIndices(int32 NumRows, int32 MaxCount, TArray<int32>& OutIndices, int32 Seed = 0)
+    {
+        OutIndices.Reset();
+        if (NumRows <= 0)
+        {
+            return;
+        }
+
+        if (MaxCount <= 0 || NumRows <= MaxCount)
+        {
+            OutIndices.Reserve(NumRows);
+            for (int32 Index = 0; Index < NumRows; ++Index)
+            {
+                OutIndices.Add(Index);
+            }
+            return;
+        }
+
+        OutIndices.Reserve(MaxCount);
+        FRandomStream Stream(Seed);
+        const double Stride = static_cast<double>(NumRows) / MaxCount;
+        for (int32 Stratum = 0; Stratum < MaxCount; ++Stratum)
+        {
+            const int32 First = static_cast<int32>(Stratum * Stride);
+            const int32 Last = FMath::Min(NumRows, static_cast<int32>((Stratum + 1) * Stride)) - 1;
+            OutIndices.Add(First + Stream.RandRange(0, FMath::Max(0, Last - First)));
+        }
+    }
+
+    // Number of rows a chart may draw when each row costs PrimitivesPerRow spawned primitives.
+    inline int32 RowBudget(bool bPreviewFidelity, int32 MaxPrimitives, int32 PrimitivesPerRow)
+    {
+        if (!bPreviewFidelity || MaxPrimitives <= 0)
+        {
+            return 0;
+        }
+        return FMath::Max(1, MaxPrimitives / FMath::Max(1, PrimitivesPerRow));
+    }
+}
@@ -112,4 +112,10 @@ namespace DataVizGrid
         Result.NumTicks = NumTicks;
         return Result;
     }
+
+    // True when a recomputed grid draws the same ticks as an axis built from AxisMin, AxisMax and TickStep
+    inline bool IsSameAxis(const FAxisGridConfig& Config, float AxisMin, float AxisMax, float TickStep)
+    {
+        return Config.AxisMin == AxisMin && Config.AxisMax == AxisMax && Config.TickStep == TickStep;
+    }
 }
@@ -3,9 +3,28 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Engine/DataTable.h"
+#include "Data/ChartDataset.h"
+#include "Data/ChartFilter.h"
+#include "Data/ChartSelection.h"
+#include "Charts/ChartPointBuffer.h"
+#include "Charts/ChartLinePyramid.h"
 #include "LineGraphActor.generated.h"
 
 class UMaterialInterface;
+class AStaticMeshActor;
+class ALineSegmentActor;
+class AGridLineActor;
+class UChartDatasetAsset;
+struct FChartDatasetDiff;
+
+// Order in which the line visits the points
+UENUM(BlueprintType)
+enum class ELineGraphOrder : uint8
+{
+    FileOrder UMETA(DisplayName = "File Order"),
+    ByX       UMETA(DisplayName = "By X"),
+    ByColumn  UMETA(DisplayName = "By Column")
+};
 
 USTRUCT(BlueprintType)
 struct FVRLineData : public FTableRowBase
@@ -26,10 +45,16 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+#if WITH_EDITOR
+    // Cooks the DataTable as a dataset asset packed into the chart when DatasetAsset is not set
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+    virtual void Serialize(FArchive& Ar) override;
+#endif
 
 private:
     UPROPERTY() USceneComponent* Root;
-    UPROPERTY() TArray<FVector> DataPoints;
+    // Data position of each point, quantized unless bQuantizePoints is off (see GetPointValue for exact values)
+    FChartPointBuffer DataPoints;
     UPROPERTY() FVector GraphOrigin;
     UPROPERTY() UStaticMesh* CylinderMesh;
     UPROPERTY() UMaterialInterface* PointColorMaterial;
@@ -39,16 +64,104 @@ private:
     float AxisMinX = 0.0f, AxisMaxX = 0.0f, AxisMinY = 0.0f, AxisMaxY = 0.0f, AxisMinZ = 0.0f, AxisMaxZ = 0.0f;
     float AxisStepX = 1.0f, AxisStepY = 1.0f, AxisStepZ = 1.0f;
 
+    // Points actually drawn this build in line order (all points, a decimated or stratified sample, or those of the
+    // X range)
+    TArray<int32> DrawIndices;
+    // Fills DrawIndices with at most about MaxCount points (0 for all) of the X range: from the pyramid when
+    // decimating, else sampled evenly along the line order
+    void UpdateDrawIndices(int32 MaxCount);
+
+    int32 GetPointRow(int32 PointIndex) const { return PointRows.Num() > 0 ? PointRows[PointIndex] : PointIndex; }
+
+    // Points in line order (empty for file order), whether their X ascends along it, and the min/max pyramid over
+    // their Y and Z, built the first time a range has more points than the budget. All of it is kept until the next load,
+    // so rebuilding at another budget or X range only reads the pyramid.
+    TArray<int32> PointOrder;
+    bool bLineAlongX = false;
+    FChartLinePyramid LinePyramid;
+    void UpdateLineOrder();
+    int32 GetPointAt(int32 Position) const { return PointOrder.Num() > 0 ? PointOrder[Position] : Position; }
+    // Positions along the line order of the points inside the X range; the whole line without one
+    void GetXRangePositions(int32& OutBegin, int32& OutEnd) const;
+    // Points to draw: the preview budget, and when decimating six per pixel column the X axis spans on screen
+    int32 GetDrawBudget() const;
+    // Places spheres and segments for DrawIndices, moving the ones already spawned instead of respawning them
+    void RedrawLine();
+
+    // Zoomed X range, and data X to chart X: the range's axis stretched over the width of the whole data's X axis
+    bool bXRangeSet = false;
+    float XRangeMin = 0.0f, XRangeMax = 0.0f;
+    double XViewScale = 1.0, XViewShift = 0.0;
+
+    // Source row of each entry of DataPoints; empty while every point is its own row (no row was skipped)
+    TArray<int32> PointRows;
+    // Names of the DataTable's rows in row order, so exact values are looked up without listing the table again
+    TArray<FName> TableRowNames;
+    // Sphere of each entry of DataPoints (null where a preview sample skipped it) and the color it was given
+    UPROPERTY() TArray<AStaticMeshActor*> PointActors;
+    TArray<FLinearColor> PointActorColors;
+    // Segment from each drawn point to the next one (null for zero-length segments)
+    UPROPERTY() TArray<ALineSegmentActor*> SegmentActors;
+
+    TSharedPtr<const FChartDataset> RuntimeDataset;
+
+    FChartFilter Filter;
+    FChartRowMask FilterMask;
+    // Evaluates Filter over the runtime dataset and hides the points and segments of rows it drops; false when it cannot be evaluated
+    bool ApplyFilter();
+
+    // Linked selection shared with other charts of the same rows; points of selected rows are drawn in SelectionColor
+    TSharedPtr<FChartSelection> Selection;
+    FDelegateHandle SelectionChangedHandle;
+    // Point of each source row (INDEX_NONE for rows without one), built when a selection change first needs it
+    TArray<int32> PointOfRow;
+    int32 GetRowPoint(int32 Row);
+    // Recolors the points of the rows that flipped, and nothing else
+    void OnSelectionChanged(const FChartSelectionChange& Change);
+
+    // Mean and covariance of DataPoints behind the overlays; patched per changed row by ApplyDatasetUpdate and
+    // recomputed after a reload only when an overlay needs it
+    FChartMoments Moments;
+    bool bMomentsValid = false;
+    UPROPERTY() TArray<AGridLineActor*> OverlayActors;
+    void ClearOverlayActors();
+
     void LoadData();
+    // Adds the points of the dataset's rows from FirstRow on after the loaded ones, for rows streamed onto its end
+    void AppendData(int32 FirstRow);
+    // Recomputes data ranges and axis grids from DataPoints; true when an axis grid changed
+    bool UpdateAxes();
     void GeneratePoints();
     void GenerateLines();
     void GenerateAxes();
     void GenerateGridlines();
-    void CreateLineSegmentCylinder(const FVector& Start, const FVector& End, const FLinearColor& Color);
+    void ClearGridActors();
+    FLinearColor GetPointColor(int32 PointIndex) const;
+    // Move and recolor an existing sphere or segment, or spawn one when null
+    void PlacePoint(int32 PointIndex, AStaticMeshActor* SphereActor);
+    void PlaceSegment(int32 SegmentIndex, ALineSegmentActor* Segment);
+    ALineSegmentActor* CreateLineSegmentCylinder(const FVector& Start, const FVector& End, const FLinearColor& Color);
     FVector MapDataToWorld(const FVector& In) const;
 
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") UDataTable* LineDataTable;
+    // Packed columns converted from a chart DataTable (VRDataViz.ConvertChartTables); read asynchronously at BeginPlay and used instead of the DataTable when set
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") UChartDatasetAsset* DatasetAsset = nullptr;
+
+    // Connect points in file order, or sorted by X or by OrderColumn (a parallel radix sort of the dataset rows,
+    // cached with the dataset; the points themselves stay in file order)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") ELineGraphOrder LineOrder = ELineGraphOrder::FileOrder;
+    // Any numeric or text column of the runtime dataset (text sorts alphabetically); X, Y or Z for a DataTable
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data", meta=(EditCondition="LineOrder == ELineGraphOrder::ByColumn")) FName OrderColumn;
+
+    // Draw lines longer than the budget from a min/max pyramid (FChartLinePyramid): about six points per pixel column
+    // the X axis spans on screen, at most MaxLinePoints, keeping the first and last point and the lowest and highest Y
+    // and Z of each column so that peaks along either axis survive. Off draws every point (or a stratified sample while previewing).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") bool bDecimateLine = true;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data", meta=(EditCondition="bDecimateLine", ClampMin="4")) int32 MaxLinePoints = 4000;
+
+    // Keep point positions as 16-bit steps across the data bounds (6 bytes a point) rather than float vectors (12 bytes)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") bool bQuantizePoints = true;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes") bool bUseCustomRange = false;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bUseCustomRange")) float XMin = 0.0f;
@@ -57,15 +170,75 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bUseCustomRange")) float YMax = 1.0f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bUseCustomRange")) float ZMin = 0.0f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bUseCustomRange")) float ZMax = 1.0f;
+    // Fit the axes and color range to the LowPercentile..HighPercentile span of the data instead of its min..max, so a
+    // few outliers do not squash the rest of the chart; points past it are drawn outside the grid
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="!bUseCustomRange")) bool bClipToPercentiles = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bClipToPercentiles", ClampMin="0", ClampMax="100")) float LowPercentile = 1.0f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bClipToPercentiles", ClampMin="0", ClampMax="100")) float HighPercentile = 99.0f;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance") FVector GraphScale = FVector(100.0f, 100.0f, 100.0f);
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance") float PointScale = 0.2f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance") float TextScale = 1.0f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance") FRotator AdditionalRotation = FRotator::ZeroRotator;
 
+    // Preview fidelity: build from a stratified sample (one sphere + one segment per row); axes still span the full data
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preview") bool bPreviewFidelity = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preview", meta=(EditCondition="bPreviewFidelity")) int32 MaxPreviewPrimitives = 2000;
+
     UFUNCTION(BlueprintCallable, Category = "Chart") void Rebuild();
+
+    // Zooms into data X from MinX to MaxX: the X axis spans the range across the chart's full width, and the points in
+    // it are drawn at the full budget, refined from the decimation pyramid without reading the data again. Needs a
+    // line whose X ascends (ordered by X, or a time series in file order); MinX >= MaxX zooms back out.
+    UFUNCTION(BlueprintCallable, Category = "Chart") void SetXRange(float MinX, float MaxX);
+    UFUNCTION(BlueprintPure, Category = "Chart") bool GetXRange(float& OutMinX, float& OutMaxX) const { OutMinX = XRangeMin; OutMaxX = XRangeMax; return bXRangeSet; }
+
+    // Full-precision X, Y, Z of a point, read from the runtime dataset or DataTable row it came from (for labels and tooltips)
+    UFUNCTION(BlueprintCallable, Category = "Chart") FVector GetPointValue(int32 PointIndex) const;
+
+    // Shows only the points whose rows match Expression (see FChartFilter; an empty expression shows everything). The
+    // filter runs over the runtime dataset and hides points, and the segments that touch them, rather than rebuilding
+    // the chart; it is applied again after rebuilds and dataset updates. False when Expression does not parse (the old
+    // filter stays) or cannot be evaluated against the dataset (every point is shown).
+    UFUNCTION(BlueprintCallable, Category = "Chart") bool SetFilter(const FString& Expression);
+    UFUNCTION(BlueprintPure, Category = "Chart") FString GetFilter() const { return Filter.GetExpression(); }
+    // Rows the current filter keeps; empty when the chart is unfiltered
+    const FChartRowMask& GetFilterMask() const { return FilterMask; }
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Selection") FLinearColor SelectionColor = FLinearColor(1.0f, 0.85f, 0.1f, 1.0f);
+
+    // Binds the chart to a selection shared with other charts of the same rows (FChartSelection::ForSource). Selecting
+    // rows in any of them recolors the matching points here in place; null unbinds.
+    void SetSelection(TSharedPtr<FChartSelection> InSelection);
+    TSharedPtr<FChartSelection> GetSelection() const { return Selection; }
+
+    // Selects the rows of the given points in the bound selection, or in a selection of this chart alone when unbound
+    UFUNCTION(BlueprintCallable, Category = "Selection") void SelectPoints(const TArray<int32>& PointIndices, bool bAddToSelection = false);
+    UFUNCTION(BlueprintCallable, Category = "Selection") void ClearSelection();
+    UFUNCTION(BlueprintPure, Category = "Selection") bool IsPointSelected(int32 PointIndex) const;
+
+    // Statistics overlays, kept current as dataset updates arrive: the mean of Z, the band of SigmaBandWidth standard
+    // deviations around it and the least-squares line of Z over X, drawn along X at the mean Y
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay") bool bShowMeanOverlay = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay") bool bShowSigmaBand = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay", meta=(EditCondition="bShowSigmaBand", ClampMin="0")) float SigmaBandWidth = 1.0f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay") bool bShowRegressionOverlay = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay") FLinearColor OverlayColor = FLinearColor(0.9f, 0.2f, 0.6f, 1.0f);
+
+    // Respawns the overlays from the current flags, without touching the points
+    UFUNCTION(BlueprintCallable, Category = "Overlay") void UpdateOverlay();
+    // Summary statistics of the plotted points; current while an overlay is shown
+    const FChartMoments& GetMoments() const { return Moments; }
+
+    // Columnar data from FChartDatasetLoader (X, Y, Z columns); used instead of LineDataTable when set
+    void SetRuntimeDataset(TSharedPtr<const FChartDataset> InDataset) { RuntimeDataset = MoveTemp(InDataset); }
+    TSharedPtr<const FChartDataset> GetRuntimeDataset() const { return RuntimeDataset; }
+
+    // Swaps in a new version of the runtime dataset, given its diff against the current one. Only spheres and segments
+    // of changed rows are touched; axes and gridlines are rebuilt only when an axis grid changes.
+    void ApplyDatasetUpdate(TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff);
     
-    // Track spawned child actors for cleanup
+    // Axes, gridlines, ticks and labels (spheres and segments are tracked separately)
     UPROPERTY() TArray<AActor*> SpawnedChildren;
     void ClearChildrenActors();
 };
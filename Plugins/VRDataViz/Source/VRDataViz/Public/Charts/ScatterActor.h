@@ -3,8 +3,17 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Engine/DataTable.h"
+#include "Data/ChartDataset.h"
+#include "Data/ChartFilter.h"
+#include "Data/ChartSelection.h"
+#include "Charts/ChartPointBuffer.h"
 #include "ScatterActor.generated.h"
 
+class AScatterPointActor;
+class AGridLineActor;
+class UChartDatasetAsset;
+struct FChartDatasetDiff;
+
 USTRUCT(BlueprintType)
 struct FVRScatterData : public FTableRowBase
 {
@@ -24,10 +33,20 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+#if WITH_EDITOR
+    // Cooks the DataTable as a dataset asset packed into the chart when DatasetAsset is not set
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+    virtual void Serialize(FArchive& Ar) override;
+#endif
 
 private:
     UPROPERTY() USceneComponent* Root;
-    UPROPERTY() TArray<FVector> DataPoints;
+    // Data position of each point, quantized unless bQuantizePoints is off (see GetPointValue for exact values)
+    FChartPointBuffer DataPoints;
+    // Per-point colors from the dataset's Color (heat ramp), R, G, B or Intensity columns; empty means color by Z
+    UPROPERTY() TArray<FLinearColor> PointColors;
+    // Per-point multipliers of PointScale from the dataset's Size column; empty means every point is PointScale
+    TArray<float> PointSizes;
     UPROPERTY() float AxisMinX = 0.0f;
     UPROPERTY() float AxisMaxX = 0.0f;
     UPROPERTY() float AxisMinY = 0.0f;
@@ -37,13 +56,73 @@ private:
     UPROPERTY() float AxisStepX = 1.0f;
     UPROPERTY() float AxisStepY = 1.0f;
     UPROPERTY() float AxisStepZ = 1.0f;
+    float ColorMinZ = 0.0f;
+    float ColorMaxZ = 0.0f;
+
+    // Source row of each entry of DataPoints; empty while every point is its own row (nothing skipped or reordered)
+    TArray<int32> PointRows;
+    // Names of the DataTable's rows in row order, so exact values are looked up without listing the table again
+    TArray<FName> TableRowNames;
+    // Spawned point of each entry of DataPoints (null where a preview sample skipped it) and the color it was given
+    UPROPERTY() TArray<AScatterPointActor*> PointActors;
+    TArray<FLinearColor> PointActorColors;
+
+    TSharedPtr<const FChartDataset> RuntimeDataset;
+
+    FChartFilter Filter;
+    FChartRowMask FilterMask;
+    // Evaluates Filter over the runtime dataset and hides the points of rows it drops; false when it cannot be evaluated
+    bool ApplyFilter();
+
+    // Linked selection shared with other charts of the same rows; points of selected rows are drawn in SelectionColor
+    TSharedPtr<FChartSelection> Selection;
+    FDelegateHandle SelectionChangedHandle;
+    // Point of each source row (INDEX_NONE for rows without one), built when a selection change first needs it
+    TArray<int32> PointOfRow;
+    int32 GetRowPoint(int32 Row);
+    // Recolors the points of the rows that flipped, and nothing else
+    void OnSelectionChanged(const FChartSelectionChange& Change);
+
+    // Mean and covariance of DataPoints behind the overlays; patched per changed row by ApplyDatasetUpdate and
+    // recomputed after a reload only when an overlay needs it
+    FChartMoments Moments;
+    bool bMomentsValid = false;
+    UPROPERTY() TArray<AGridLineActor*> OverlayActors;
+    void ClearOverlayActors();
 
     void LoadSampleData();
+    // Adds the points of the dataset's rows from FirstRow on after the loaded ones, for rows streamed onto its end.
+    // Only for points in row order without colors or sizes, which are scaled over every row.
+    void AppendSampleData(int32 FirstRow);
+    int32 GetPointRow(int32 PointIndex) const { return PointRows.Num() > 0 ? PointRows[PointIndex] : PointIndex; }
+
+    // Reorders DataPoints and PointRows along the Morton curve (bSpatialOrder)
+    void SortPointsSpatially();
+    void LoadPointColors(const TArray<int32>& SourceRows);
+    void LoadPointSizes(const TArray<int32>& SourceRows);
     void GenerateScatterplot();
     void GenerateGridlinesAndLabels();
+    void ClearGridActors();
+
+    // Recomputes the axis grids and the color range from DataPoints; true when an axis grid changed
+    bool UpdateAxes();
+    FLinearColor GetPointColor(int32 PointIndex) const;
+    float GetPointSize(int32 PointIndex) const;
+    FVector GraphToWorld(const FVector& Local) const;
+    // Moves and recolors Point, or spawns a new one when Point is null
+    void PlacePoint(int32 PointIndex, AScatterPointActor* Point);
 
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") UDataTable* ScatterDataTable;
+    // Packed columns converted from a chart DataTable (VRDataViz.ConvertChartTables); read asynchronously at BeginPlay and used instead of the DataTable when set
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") UChartDatasetAsset* DatasetAsset = nullptr;
+
+    // Keep point positions as 16-bit steps across the data bounds (6 bytes a point) rather than float vectors (12 bytes)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") bool bQuantizePoints = true;
+    // Store points along a Z-order curve over the data bounds instead of in row order, so neighbors in space are
+    // neighbors in memory and in spawn order, and a preview sample is spread evenly over space. Rows are still found
+    // through the kept permutation, so filters, selections and dataset updates work as before.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data") bool bSpatialOrder = false;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes") bool bUseCustomRange = false;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bUseCustomRange")) float XMin = 0.0f;
@@ -52,13 +131,69 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bUseCustomRange")) float YMax = 1.0f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bUseCustomRange")) float ZMin = 0.0f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bUseCustomRange")) float ZMax = 1.0f;
+    // Fit the axes and color range to the LowPercentile..HighPercentile span of the data instead of its min..max, so a
+    // few outliers do not squash the rest of the chart; points past it are drawn outside the grid
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="!bUseCustomRange")) bool bClipToPercentiles = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bClipToPercentiles", ClampMin="0", ClampMax="100")) float LowPercentile = 1.0f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Axes", meta=(EditCondition="bClipToPercentiles", ClampMin="0", ClampMax="100")) float HighPercentile = 99.0f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance") FVector GraphScale = FVector(100.f, 100.f, 100.f);
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance") float PointScale = 0.5f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance") float TextScale = 1.0f;
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Appearance") FRotator AdditionalRotation = FRotator::ZeroRotator;
+
+    // Preview fidelity: build from a stratified sample of at most MaxPreviewPrimitives points; axes still span the full data
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preview") bool bPreviewFidelity = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preview", meta=(EditCondition="bPreviewFidelity")) int32 MaxPreviewPrimitives = 2000;
+
     UFUNCTION(BlueprintCallable, Category = "Chart") void Rebuild();
+
+    // Full-precision X, Y, Z of a point, read from the runtime dataset or DataTable row it came from (for labels and tooltips)
+    UFUNCTION(BlueprintCallable, Category = "Chart") FVector GetPointValue(int32 PointIndex) const;
+
+    // Shows only the points whose rows match Expression (see FChartFilter; an empty expression shows everything). The
+    // filter runs over the runtime dataset and hides points rather than rebuilding the chart, and it is applied again
+    // after rebuilds and dataset updates. False when Expression does not parse (the old filter stays) or cannot be
+    // evaluated against the dataset (every point is shown).
+    UFUNCTION(BlueprintCallable, Category = "Chart") bool SetFilter(const FString& Expression);
+    UFUNCTION(BlueprintPure, Category = "Chart") FString GetFilter() const { return Filter.GetExpression(); }
+    // Rows the current filter keeps; empty when the chart is unfiltered
+    const FChartRowMask& GetFilterMask() const { return FilterMask; }
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Selection") FLinearColor SelectionColor = FLinearColor(1.0f, 0.85f, 0.1f, 1.0f);
+
+    // Binds the chart to a selection shared with other charts of the same rows (FChartSelection::ForSource). Selecting
+    // rows in any of them recolors the matching points here in place; null unbinds.
+    void SetSelection(TSharedPtr<FChartSelection> InSelection);
+    TSharedPtr<FChartSelection> GetSelection() const { return Selection; }
+
+    // Selects the rows of the given points in the bound selection, or in a selection of this chart alone when unbound
+    UFUNCTION(BlueprintCallable, Category = "Selection") void SelectPoints(const TArray<int32>& PointIndices, bool bAddToSelection = false);
+    UFUNCTION(BlueprintCallable, Category = "Selection") void ClearSelection();
+    UFUNCTION(BlueprintPure, Category = "Selection") bool IsPointSelected(int32 PointIndex) const;
+
+    // Statistics overlays, kept current as dataset updates arrive: the mean of Z, the band of SigmaBandWidth standard
+    // deviations around it and the least-squares fit of Z on X and Y (a plane; a line over X when Y is flat)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay") bool bShowMeanOverlay = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay") bool bShowSigmaBand = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay", meta=(EditCondition="bShowSigmaBand", ClampMin="0")) float SigmaBandWidth = 1.0f;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay") bool bShowRegressionOverlay = false;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay") FLinearColor OverlayColor = FLinearColor(0.9f, 0.2f, 0.6f, 1.0f);
+
+    // Respawns the overlays from the current flags, without touching the points
+    UFUNCTION(BlueprintCallable, Category = "Overlay") void UpdateOverlay();
+    // Summary statistics of the plotted points; current while an overlay is shown
+    const FChartMoments& GetMoments() const { return Moments; }
+
+    // Columnar data from FChartDatasetLoader (X, Y, Z columns, optional Color or R, G, B in 0..1 or Intensity, optional Size);
+    // used instead of ScatterDataTable when set. FChartColumnMapping renames other file columns into these roles.
+    void SetRuntimeDataset(TSharedPtr<const FChartDataset> InDataset) { RuntimeDataset = MoveTemp(InDataset); }
+    TSharedPtr<const FChartDataset> GetRuntimeDataset() const { return RuntimeDataset; }
+
+    // Swaps in a new version of the runtime dataset, given its diff against the current one. Only points of changed
+    // rows are moved, recolored, spawned or destroyed; gridlines and labels are rebuilt only when an axis grid changes.
+    void ApplyDatasetUpdate(TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff);
     
-    // Track spawned child actors for cleanup
+    // Gridlines, ticks and labels (points are tracked in PointActors)
     UPROPERTY() TArray<AActor*> SpawnedChildren;
     void ClearChildrenActors();
 };
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ChartDataset.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// Physical value type of an Arrow column; for dictionary-encoded columns this is the index type
+enum class EArrowValueType : uint8
+{
+    Unsupported,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    Float32,
+    Float64,
+    Utf8
+};
+
+// One record batch's slice of a column, pointing straight into the mapped file
+struct FArrowColumnChunk
+{
+    const uint8* Values = nullptr;     // Fixed-width values or dictionary indices; int32 offsets for Utf8
+    const uint8* Validity = nullptr;   // LSB-first bitmap, nullptr when every value is present
+    const uint8* StringData = nullptr; // Utf8 bytes addressed by the offsets
+    int64 Length = 0;
+    int64 NullCount = 0;
+
+    bool IsValid(int64 Index) const { return !Validity || ((Validity[Index >> 3] >> (Index & 7)) & 1) != 0; }
+
+    template<typename T>
+    const T* GetValues() const { return reinterpret_cast<const T*>(Values); }
+};
+
+struct FArrowColumn
+{
+    FName Name;
+    EArrowValueType Type = EArrowValueType::Unsupported;
+
+    // Set for dictionary-encoded Utf8 columns: chunk values are indices into GetDictionary(DictionaryId)
+    int64 DictionaryId = INDEX_NONE;
+
+    // One chunk per record batch, in file order
+    TArray<FArrowColumnChunk> Chunks;
+};
+
+// Memory-mapped Arrow IPC file (Feather v2). Opening decodes only the footer, schema and message headers;
+// column data is paged in when something reads a view. Supports little-endian files without body compression,
+// exposing numeric, Utf8 and dictionary-encoded Utf8 columns (other columns are skipped).
+class VRDATAVIZ_API FArrowFile : public FChartDatasetStorage, public TSharedFromThis<FArrowFile>
+{
+public:
+    virtual ~FArrowFile() override;
+
+    // nullptr when the file cannot be opened or is not a supported Arrow IPC file
+    static TSharedPtr<FArrowFile> Open(const FString& FilePath);
+
+    // True when the file starts with the Arrow IPC magic, whatever its extension
+    static bool IsArrowFile(const FString& FilePath);
+
+    const TArray<FArrowColumn>& GetColumns() const { return Columns; }
+    int64 GetNumRows() const { return NumRows; }
+
+    // Decoded values of a string dictionary, nullptr for an unknown id
+    const TArray<FString>* GetDictionary(int64 DictionaryId) const { return Dictionaries.Find(DictionaryId); }
+
+    // Chart dataset that keeps this file mapped. Only float32 columns stored in one chunk without nulls are viewed in
+    // place: chart columns are contiguous, so a file of several record batches (pyarrow's default for large tables),
+    // integer or float64 columns and columns with a validity bitmap are converted to float once (nulls become NaN),
+    // and string columns are decoded. Write single-batch float32 files to load without a copy.
+    TSharedPtr<FChartDataset> CreateDataset() const;
+
+private:
+    FArrowFile() = default;
+
+    bool Map(const FString& FilePath);
+    bool Parse();
+    void DecodeColumn(const FArrowColumn& Source, FChartColumn& Dest) const;
+
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray64<uint8> LoadedBytes; // Whole file, when the platform cannot map it
+    const uint8* Data = nullptr;
+    int64 Size = 0;
+
+    TArray<FArrowColumn> Columns;
+    TMap<int64, TArray<FString>> Dictionaries;
+    int64 NumRows = 0;
+};
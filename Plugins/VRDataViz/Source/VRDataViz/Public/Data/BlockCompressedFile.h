@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ".csv.ucz" container: a text file cut into fixed-size blocks that are compressed independently with any
+// FCompression format (Oodle, LZ4, Zlib), so both writing and reading can run one block per worker.
+// Layout (little endian): FHeader, then per block uint32 CompressedSize, uint32 UncompressedSize and the payload.
+// A block whose CompressedSize equals its UncompressedSize is stored raw.
+namespace DataVizBlockFile
+{
+    constexpr uint32 Magic = 0x425A4456; // "VDZB"
+    constexpr uint32 Version = 1;
+    constexpr int32 DefaultBlockSize = 4 * 1024 * 1024;
+
+    struct FHeader
+    {
+        uint32 Magic = DataVizBlockFile::Magic;
+        uint32 Version = DataVizBlockFile::Version;
+        ANSICHAR FormatName[16] = {};
+        uint32 BlockSize = DefaultBlockSize;
+    };
+
+    struct FBlockHeader
+    {
+        uint32 CompressedSize = 0;
+        uint32 UncompressedSize = 0;
+    };
+
+    // Compresses SourcePath (read as a stream) into DestPath. Returns false on I/O or codec errors.
+    VRDATAVIZ_API bool CompressFile(const FString& SourcePath, const FString& DestPath, FName FormatName = NAME_Oodle, int32 BlockSize = DefaultBlockSize);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/CSVTokenizer.h"
+
+struct FChartDataset;
+class IDataByteSource;
+
+// Receives the rows of a streamed file one block at a time
+class VRDATAVIZ_API IChartDatasetSink
+{
+public:
+    virtual ~IChartDatasetSink() = default;
+
+    // Called before BeginStream by sources whose header states the row count (binary point clouds), so sinks can allocate once
+    virtual void SetExpectedRows(int64 ExpectedRows) {}
+
+    // Called once with the (empty) dataset holding the file's schema
+    virtual void BeginStream(const FChartDataset& Schema) {}
+
+    // Rows [FirstRow, FirstRow + Block.NumRows) of the file. Block is reused for the next block after this returns.
+    virtual void ConsumeBlock(const FChartDataset& Block, int64 FirstRow) = 0;
+
+    virtual void EndStream(int64 TotalRows) {}
+};
+
+// Reads a CSV file through IFileHandle in fixed-size blocks and hands each block of parsed rows to a set of sinks.
+// Peak memory is the block buffer plus one block of parsed rows, independent of file size; the buffer only grows
+// when a single record is longer than a whole block. Compressed files (.csv.gz, .csv.ucz) are decoded on the fly
+// by the matching IDataByteSource, so the decompressed text never exists in full.
+class VRDATAVIZ_API FCSVStreamReader
+{
+public:
+    explicit FCSVStreamReader(const FCSVParseOptions& InOptions = FCSVParseOptions(), int64 InBlockSize = 4 * 1024 * 1024);
+
+    // Returns false when the file cannot be opened or read, or has no header record
+    bool ReadFile(const FString& FilePath, TArrayView<IChartDatasetSink* const> Sinks) const;
+
+    // Same as ReadFile for an already opened source; DebugName only appears in log messages
+    bool ReadSource(IDataByteSource& Source, TArrayView<IChartDatasetSink* const> Sinks, const FString& DebugName) const;
+
+private:
+    FCSVParseOptions Options;
+    int64 BlockSize;
+};
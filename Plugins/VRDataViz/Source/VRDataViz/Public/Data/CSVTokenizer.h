@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ChartDataset.h"
+#include <atomic>
+
+struct FChartDataset;
+
+struct FCSVParseOptions
+{
+    // Field separator; quoting always uses '"' with "" as the escaped quote
+    ANSICHAR Delimiter = ',';
+
+    // ParseRecordsParallel only splits inputs into chunks of at least this many bytes
+    int64 MinParallelChunkBytes = 8 * 1024 * 1024;
+
+    // Upper bound on chunks parsed at once; 0 uses every task graph worker plus the calling thread, 1 parses serially
+    int32 MaxParallelChunks = 0;
+
+    // Projection: when set, only these columns are stored (in file order) and every other field is skipped without
+    // being decoded. Names missing from the header are ignored.
+    TArray<FName> Columns;
+
+    // Types decided up front instead of inferred from the first records: per column name (matched like Columns), and
+    // for every other column when DefaultColumnType is set. Fields a Float column cannot parse are stored as NaN.
+    TMap<FName, EChartColumnType> ColumnTypes;
+    TOptional<EChartColumnType> DefaultColumnType;
+
+    // Set from another thread to abandon the load: parsing stops at the next block or chunk and the loader returns nullptr
+    const std::atomic<bool>* CancelFlag = nullptr;
+
+    bool IsCanceled() const { return CancelFlag && CancelFlag->load(std::memory_order_relaxed); }
+};
+
+// Where the fields of each record are stored, resolved from the header by FCSVTokenizer::ParseSchema
+struct FCSVFieldLayout
+{
+    // Dataset column of each field of a record (INDEX_NONE for fields the projection skips); empty stores field i in
+    // column i
+    TArray<int32> FieldColumns;
+};
+
+// Byte-level UTF-8 CSV tokenizer that writes straight into typed FChartDataset columns.
+// Delimiters, quotes and newlines are located 64 bytes at a time (AVX2 or SSE2 on x86, NEON on ARM64,
+// scalar elsewhere); quoted regions are masked with a prefix-XOR over the quote bits so embedded
+// delimiters and newlines never split a field.
+class VRDATAVIZ_API FCSVTokenizer
+{
+public:
+    explicit FCSVTokenizer(const FCSVParseOptions& InOptions = FCSVParseOptions());
+
+    // Reads the header record into column names and infers each column's type from up to the first 1024 data
+    // records (or 1 MB) of Bytes: text when any of them holds a non-blank field that is not a number. Types set in
+    // Options.ColumnTypes or Options.DefaultColumnType are taken as they are.
+    // Skips a UTF-8 BOM. Returns the byte offset where data records start. OutLayout receives the column of each
+    // field (with a projection, Options.Columns, most fields have none); pass it to ParseRecords for this file.
+    int64 ParseSchema(TConstArrayView64<uint8> Bytes, FChartDataset& OutDataset, FCSVFieldLayout& OutLayout) const;
+
+    // Appends every complete record in Bytes to OutDataset, whose schema and Layout come from ParseSchema.
+    // Bytes must start on a record boundary. Unless bFinal, a trailing record without a newline is left
+    // unconsumed so the caller can retry it with more data. Returns the number of bytes consumed.
+    int64 ParseRecords(TConstArrayView64<uint8> Bytes, const FCSVFieldLayout& Layout, FChartDataset& OutDataset, bool bFinal) const;
+
+    // Same result as ParseRecords(Bytes, Layout, OutDataset, true), computed on worker threads. Bytes is cut into one
+    // range per worker; each cut is moved forward to the next record-ending newline outside quotes (the quote
+    // state at a cut comes from the quote-count parity of everything before it), the ranges are parsed in
+    // parallel and their columns are appended to OutDataset in file order.
+    int64 ParseRecordsParallel(TConstArrayView64<uint8> Bytes, const FCSVFieldLayout& Layout, FChartDataset& OutDataset) const;
+
+    // Locale-independent decimal parser ("1", "-2.5", "3e-4", "nan", "inf"); surrounding blanks and quotes are ignored.
+    // Returns false when [Begin, End) is not a complete number.
+    static bool ParseFloat(const ANSICHAR* Begin, const ANSICHAR* End, float& OutValue);
+
+    const FCSVParseOptions& GetOptions() const { return Options; }
+
+private:
+    FCSVParseOptions Options;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChartAggregation.generated.h"
+
+struct FChartDataset;
+struct FVRBarData;
+
+UENUM(BlueprintType)
+enum class EChartAggregate : uint8
+{
+    Sum,
+    Mean,
+    Count,
+    Min,
+    Max
+};
+
+// Group-by over raw rows: one bar per distinct (XColumn, YColumn) pair, valued by Aggregate over ValueColumn
+USTRUCT(BlueprintType)
+struct VRDATAVIZ_API FChartGroupBy
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Group By") FName XColumn;
+    // NAME_None groups by XColumn alone, on a single row of bars
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Group By") FName YColumn;
+    // NAME_None is only valid for Count, which then counts rows instead of values
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Group By") FName ValueColumn;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Group By") EChartAggregate Aggregate = EChartAggregate::Sum;
+
+    bool IsSet() const { return !XColumn.IsNone(); }
+};
+
+// Aggregates a columnar dataset into bar chart rows (ABarChartActor::GroupBy, or SetRuntimeData). Rows are split into blocks
+// that each fill their own hash table of groups in parallel; the tables are then merged in block order. XIndex and
+// YIndex number the sorted distinct keys of each column (text in alphabetical order, numbers ascending), and the
+// labels are the keys as text. Rows with a missing key or value are skipped.
+class VRDATAVIZ_API FChartAggregation
+{
+public:
+    // Bars come out ordered by XIndex, then YIndex. OutBarOfRow, when given, receives the bar of each row of Dataset
+    // (INDEX_NONE for skipped rows), so that the bars can be linked to the rows they stand for. False when a column is
+    // missing or the group-by is incomplete, described in OutError.
+    static bool GroupBy(const FChartDataset& Dataset, const FChartGroupBy& GroupBy, TArray<FVRBarData>& OutBars, FString& OutError, TArray<int32>* OutBarOfRow = nullptr);
+};
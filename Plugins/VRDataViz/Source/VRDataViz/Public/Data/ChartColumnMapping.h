@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChartSpawnLibrary.h"
+#include "ChartColumnMapping.generated.h"
+
+struct FChartDataset;
+
+// Which file columns drive each role of a chart. An unset role reads the column the chart uses by default
+// (X, Y, Z; XIndex, YIndex, Value for bars). Color and Size only apply to scatter plots; a text column mapped to
+// a bar axis becomes categories labelled with its values.
+USTRUCT(BlueprintType)
+struct VRDATAVIZ_API FChartColumnMapping
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Columns") FName X;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Columns") FName Y;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Columns") FName Z;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Columns") FName Value;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Columns") FName Color;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Columns") FName Size;
+
+    bool IsSet() const;
+
+    // Columns a chart of this type needs from the file, for FCSVParseOptions::Columns; empty (load everything)
+    // when no role is mapped
+    TArray<FName> GetSourceColumns(EChartType ChartType) const;
+
+    // The mapped columns under the names the chart reads, plus the optional columns it picks up by name (labels,
+    // point colors). Columns are copied; views into external storage stay views. Returns Source when nothing is mapped.
+    TSharedPtr<const FChartDataset> Apply(const TSharedPtr<const FChartDataset>& Source, EChartType ChartType) const;
+
+    bool operator==(const FChartColumnMapping& Other) const
+    {
+        return X == Other.X && Y == Other.Y && Z == Other.Z && Value == Other.Value && Color == Other.Color && Size == Other.Size;
+    }
+    bool operator!=(const FChartColumnMapping& Other) const { return !(*this == Other); }
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/QuantileSketch.h"
+
+enum class EChartColumnType : uint8
+{
+    Float,
+    String
+};
+
+// Summary of one column over every row that was read, even when the dataset only keeps a sample of rows
+struct FChartColumnStats
+{
+    float Min = TNumericLimits<float>::Max();
+    float Max = TNumericLimits<float>::Lowest();
+    int64 Count = 0;
+    int64 MissingCount = 0;
+    // Distribution of numeric values, for percentile axis ranges that an outlier cannot stretch
+    FQuantileSketch Quantiles;
+};
+
+// Owner of memory that dataset columns view without copying (such as a memory-mapped file)
+struct FChartDatasetStorage
+{
+    virtual ~FChartDatasetStorage() = default;
+};
+
+// Distinct values of a text column, numbered in order of first appearance. Matching is case-sensitive.
+struct VRDATAVIZ_API FChartLabelDictionary
+{
+    // Code of Value, adding it when it is new
+    int32 Add(FStringView Value);
+    // Code of Value, or INDEX_NONE
+    int32 Find(FStringView Value) const;
+
+    const FString& operator[](int32 Code) const { return Values[Code]; }
+    int32 Num() const { return Values.Num(); }
+    TConstArrayView<FString> GetValues() const { return Values; }
+
+    void Reset();
+    // Drops the values numbered NumValues and up
+    void TrimTo(int32 NumValues);
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    TArray<FString> Values;
+    TArray<uint32> Hashes;
+    // Open-addressed table of codes, a power of two in size and at most half full
+    TArray<int32> Buckets;
+
+    int32 FindSlot(FStringView Value, uint32 Hash) const;
+    void Grow();
+    void Rehash(int32 NumBuckets);
+};
+
+// One typed column of a chart dataset; only the arrays matching Type are populated
+struct VRDATAVIZ_API FChartColumn
+{
+    FName Name;
+    EChartColumnType Type = EChartColumnType::Float;
+    TArray<float> Floats;
+
+    // Text values are dictionary encoded: Labels holds each distinct value once and Codes one index into it per row,
+    // so a categorical column costs four bytes a row however long its labels are
+    TArray<int32> Codes;
+    FChartLabelDictionary Labels;
+
+    // Float values viewed in place instead of stored in Floats; the memory is kept alive by FChartDataset::ExternalStorage
+    TConstArrayView<float> ExternalFloats;
+
+    // Whole-file statistics, set by the streaming loader
+    TOptional<FChartColumnStats> Stats;
+
+    int32 Num() const { return Type == EChartColumnType::Float ? GetFloats().Num() : Codes.Num(); }
+    TConstArrayView<float> GetFloats() const { return ExternalFloats.Num() > 0 ? ExternalFloats : TConstArrayView<float>(Floats); }
+
+    // Appends one text value
+    void AddString(FStringView Value) { Codes.Add(Labels.Add(Value)); }
+    // Text of a row of a text column, without copying it
+    const FString& GetLabel(int32 Row) const { return Labels[Codes[Row]]; }
+
+    // Appends the values of a column of the same type; text codes are translated into this column's dictionary
+    void AppendValues(const FChartColumn& Source);
+
+    // Value as float (strings are parsed, missing values are NaN)
+    float GetFloat(int32 Row) const;
+    // Value as display text (floats are sanitized, integral values print without a fraction)
+    FString GetString(int32 Row) const;
+};
+
+// Row orders of a dataset's columns, kept with it by FChartSortOrder::ForColumn. Copies start empty, since a copy's
+// columns may be changed afterwards.
+struct FChartSortOrderCache
+{
+    TMap<FName, TSharedPtr<const TArray<int32>>> Orders;
+
+    FChartSortOrderCache() = default;
+    FChartSortOrderCache(const FChartSortOrderCache&) {}
+    FChartSortOrderCache& operator=(const FChartSortOrderCache&) { Orders.Reset(); return *this; }
+};
+
+// Columnar table that the loaders fill and the chart actors read directly.
+// Columns are matched by FName, so lookups are case-insensitive like DataTable column import.
+struct VRDATAVIZ_API FChartDataset
+{
+    TArray<FChartColumn> Columns;
+    int32 NumRows = 0;
+
+    // Keeps the memory behind any ExternalFloats view alive for as long as the dataset
+    TSharedPtr<const FChartDatasetStorage> ExternalStorage;
+
+    // Sorted row orders of columns, filled on the game thread once the dataset is shared and freed with it
+    mutable FChartSortOrderCache SortOrders;
+
+    int32 FindColumn(FName ColumnName) const;
+    const FChartColumn* GetColumn(FName ColumnName) const;
+
+    FChartColumn& AddColumn(FName ColumnName, EChartColumnType Type);
+
+    // Drop all rows but keep the schema
+    void ResetRows();
+    void ReserveRows(int32 NumRowsToReserve);
+
+    // Truncate every column to NumRows, and each text column's labels to NumLabels of that column when given (used to
+    // roll back a partially parsed record, labels it added included)
+    void TrimToNumRows(TConstArrayView<int32> NumLabels = TConstArrayView<int32>());
+
+    // Append the rows of a dataset with the same schema, moving its storage when possible
+    void AppendRows(FChartDataset&& Other);
+
+    // Append the rows of several same-schema datasets in order; each column is merged on its own worker
+    void AppendRows(TArrayView<FChartDataset> Parts);
+
+    // Copy only the schema (names and types) of another dataset
+    void CopySchemaFrom(const FChartDataset& Other);
+
+    // Append a copy of one row of a same-schema dataset, or overwrite an existing row with it
+    void AddRowFrom(const FChartDataset& Source, int32 SourceRow);
+    void SetRowFrom(const FChartDataset& Source, int32 SourceRow, int32 DestRow);
+
+    // Writes the whole-file range of a numeric column when its stats are known; returns false otherwise
+    bool GetColumnRange(FName ColumnName, float& OutMin, float& OutMax) const;
+    // Same for the whole-file values at fractions LowQ and HighQ (0..1) of a numeric column, from its quantile sketch
+    bool GetColumnQuantileRange(FName ColumnName, double LowQ, double HighQ, float& OutMin, float& OutMax) const;
+
+    // Rows of three columns as points, from FirstRow on; rows with a missing or non-numeric coordinate are skipped.
+    // OutRows, when given, receives the source row of each point. Returns false when one of the columns does not exist.
+    bool GatherPoints(FName XColumn, FName YColumn, FName ZColumn, TArray<FVector>& OutPoints, TArray<int32>* OutRows = nullptr, int32 FirstRow = 0) const;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Serialization/BulkData.h"
+#include "Data/ChartDataset.h"
+#include "ChartDatasetAsset.generated.h"
+
+class UDataTable;
+
+// Layout and whole-table statistics of one packed column
+USTRUCT()
+struct FChartDatasetAssetColumn
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, Category = "Column") FName Name;
+    UPROPERTY(VisibleAnywhere, Category = "Column") bool bIsString = false;
+
+    // Byte offset of the column in the bulk data: NumRows floats, or NumRows int32 indices into Dictionary for text
+    UPROPERTY() int64 Offset = 0;
+    UPROPERTY(VisibleAnywhere, Category = "Column") TArray<FString> Dictionary;
+
+    UPROPERTY(VisibleAnywhere, Category = "Column") float Min = 0.0f;
+    UPROPERTY(VisibleAnywhere, Category = "Column") float Max = 0.0f;
+    UPROPERTY(VisibleAnywhere, Category = "Column") int64 Count = 0;
+    UPROPERTY(VisibleAnywhere, Category = "Column") int64 MissingCount = 0;
+};
+
+// A chart DataTable packed into columns for packaged builds. The columns live in one bulk data payload outside the
+// export, so the asset costs a few hundred bytes until a chart asks for it; the payload is then read asynchronously
+// and numeric columns are viewed in the read buffer without a per-row copy. Statistics, quantile sketches included,
+// are computed at conversion. In the editor the asset remembers its source DataTable and is rebuilt from it whenever
+// it is cooked. Charts that still read a DataTable are converted while they are cooked (PackForCook).
+UCLASS(BlueprintType)
+class VRDATAVIZ_API UChartDatasetAsset : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(VisibleAnywhere, Category = "Dataset") int32 NumRows = 0;
+    UPROPERTY(VisibleAnywhere, Category = "Dataset") TArray<FChartDatasetAssetColumn> Columns;
+
+    // Calls OnLoaded on the game thread with the dataset (nullptr when the payload cannot be read). Charts sharing the
+    // asset share one loaded dataset while any of them holds it.
+    void LoadDataset(TFunction<void(TSharedPtr<const FChartDataset>)> OnLoaded);
+
+    virtual void Serialize(FArchive& Ar) override;
+    virtual void BeginDestroy() override;
+
+#if WITH_EDITOR
+    // Packs every row of Table: numeric and bool fields become float columns, other fields dictionary-encoded text
+    bool BuildFromDataTable(const UDataTable* Table);
+
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+
+    // Called from a chart's PreSave. When the chart is cooked reading Table and no dataset asset, packs the table into an
+    // asset inside the chart, which the chart's Serialize writes instead of the table (FChartCookedTableScope), so the
+    // cooked chart streams columns and no longer pulls the table into the cook. The chart itself is left untouched.
+    static void PackForCook(const FObjectPreSaveContext& SaveContext, UObject* Chart, const UDataTable* Table, const UChartDatasetAsset* DatasetAsset);
+#endif
+
+#if WITH_EDITORONLY_DATA
+    // Table the asset was converted from; soft, so the table itself is not cooked on the asset's account
+    UPROPERTY(EditAnywhere, Category = "Dataset")
+    TSoftObjectPtr<UDataTable> SourceTable;
+#endif
+
+private:
+    TSharedPtr<const FChartDataset> CreateDataset(uint8* Payload) const;
+    void FinishLoad(uint8* Payload);
+
+    FByteBulkData ColumnData;
+    // Quantile sketch of each column in Columns (empty for text columns), serialized after the bulk data
+    TArray<FQuantileSketch> ColumnQuantiles;
+
+    TWeakPtr<const FChartDataset> LoadedDataset;
+    TArray<TFunction<void(TSharedPtr<const FChartDataset>)>> PendingLoads;
+    TUniquePtr<IBulkDataIORequest> ReadRequest;
+};
+
+#if WITH_EDITOR
+// Wraps Super::Serialize in a chart's Serialize. While a cooking archive saves a chart that PackForCook packed, its
+// table and dataset asset properties read as no table and the packed asset; they are put back when the scope ends,
+// whatever becomes of the save.
+class VRDATAVIZ_API FChartCookedTableScope
+{
+public:
+    FChartCookedTableScope(FArchive& Ar, UObject* Chart, UDataTable*& InTable, UChartDatasetAsset*& InDatasetAsset);
+    ~FChartCookedTableScope();
+
+    FChartCookedTableScope(const FChartCookedTableScope&) = delete;
+    FChartCookedTableScope& operator=(const FChartCookedTableScope&) = delete;
+
+private:
+    UDataTable** TableSlot = nullptr;
+    UChartDatasetAsset** AssetSlot = nullptr;
+    UDataTable* Table = nullptr;
+    UChartDatasetAsset* DatasetAsset = nullptr;
+};
+#endif
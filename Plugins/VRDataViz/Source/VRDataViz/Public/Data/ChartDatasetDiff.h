@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FChartDataset;
+
+// Row-level changes between two versions of a dataset, as when a chart's source file is re-exported.
+// Rows are compared by value over every column. Rows that kept their values are matched even when they moved
+// (rows dropped from the front of a rolling window, for instance); a changed row is paired with the old row it
+// replaces when both sit in the same gap between matched rows, and counts as appended otherwise.
+struct VRDATAVIZ_API FChartDatasetDiff
+{
+    // Old row each new row continues (unchanged or modified), INDEX_NONE for appended rows
+    TArray<int32> NewToOld;
+
+    // New rows whose values differ from the old row they replace
+    TArray<int32> ModifiedRows;
+    // New rows without an old counterpart
+    TArray<int32> AppendedRows;
+    // Old rows without a new counterpart
+    TArray<int32> RemovedRows;
+
+    // Columns were added, dropped or changed type; the row lists are left empty
+    bool bSchemaChanged = false;
+    // Unchanged rows appear in a different order
+    bool bReordered = false;
+
+    bool HasChanges() const
+    {
+        return bSchemaChanged || bReordered || ModifiedRows.Num() > 0 || AppendedRows.Num() > 0 || RemovedRows.Num() > 0;
+    }
+
+    // Every old row is unchanged at its index and new rows only follow them, as when rows stream onto a file's end
+    bool IsAppendOnly() const
+    {
+        return !bSchemaChanged && !bReordered && ModifiedRows.Num() == 0 && RemovedRows.Num() == 0
+            && (AppendedRows.Num() == 0 || AppendedRows[0] == NewToOld.Num() - AppendedRows.Num());
+    }
+
+    // Row hashes are computed on the worker pool; safe to call off the game thread
+    static FChartDatasetDiff Compute(const FChartDataset& Old, const FChartDataset& New);
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/CSVTokenizer.h"
+
+struct FChartDataset;
+
+// Reads delimited text straight into an FChartDataset without going through UDataTable import.
+// The file stays UTF-8 bytes end to end; numeric columns are parsed once into float arrays.
+class VRDATAVIZ_API FChartDatasetLoader
+{
+public:
+    // Returns nullptr when the file cannot be read or has no header record. Compressed files (.csv.gz, .csv.ucz)
+    // are decoded through the streaming reader and keep every row.
+    static TSharedPtr<FChartDataset> LoadCSVFile(const FString& FilePath, const FCSVParseOptions& Options = FCSVParseOptions());
+
+    static TSharedPtr<FChartDataset> ParseCSV(TConstArrayView64<uint8> Bytes, const FCSVParseOptions& Options = FCSVParseOptions());
+
+    // Streams a file of any size in fixed-size blocks with constant memory: keeps a uniform sample of at most
+    // MaxRows rows (in file order, 0 keeps all) and stores whole-file stats on every column
+    static TSharedPtr<FChartDataset> StreamCSVFile(const FString& FilePath, int32 MaxRows, const FCSVParseOptions& Options = FCSVParseOptions());
+
+    // LoadCSVFile for files up to MaxInMemoryBytes, StreamCSVFile with MaxStreamedRows above that and for compressed files
+    static TSharedPtr<FChartDataset> LoadCSVFileBounded(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options = FCSVParseOptions());
+
+    // True when LoadDataFile would read the whole file into memory and tokenize it, so a caller holding the bytes
+    // can hand them to ParseCSV instead
+    static bool IsInMemoryCSVFile(const FString& FilePath, int64 MaxInMemoryBytes);
+
+    // Memory-maps an Arrow IPC (Feather v2) file; float32 columns are viewed in place rather than copied (see FArrowFile)
+    static TSharedPtr<FChartDataset> LoadArrowFile(const FString& FilePath);
+
+    // Binary PLY / LAS point cloud with X, Y, Z and, when present, R, G, B (0..1) and Intensity columns.
+    // Keeps a uniform sample of at most MaxRows points (0 keeps all) and whole-file stats, like StreamCSVFile.
+    static TSharedPtr<FChartDataset> LoadPointCloudFile(const FString& FilePath, int32 MaxRows);
+
+    // Every data file of a directory, or matching a file-name glob, loaded in parallel and merged into one dataset
+    // (see FPartitionedDatasetLoad); the limits apply to all shards together
+    static TSharedPtr<FChartDataset> LoadPartitionedDataset(const FString& DirectoryOrGlob, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options = FCSVParseOptions());
+
+    // Any supported data file: Arrow files are mapped whatever their size, point clouds above MaxInMemoryBytes keep
+    // MaxStreamedRows sampled points, and delimited text goes through LoadCSVFileBounded. Directories and globs
+    // go through LoadPartitionedDataset. Options.Columns projects every format: delimited text skips the other
+    // fields while tokenizing, Arrow files and point clouds drop the other columns once read.
+    static TSharedPtr<FChartDataset> LoadDataFile(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options = FCSVParseOptions());
+};
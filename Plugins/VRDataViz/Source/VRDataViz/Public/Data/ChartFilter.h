@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FChartDataset;
+
+// One bit per dataset row, 64 rows to a word. Bits past NumRows are always clear.
+struct VRDATAVIZ_API FChartRowMask
+{
+    TArray<uint64> Words;
+    int32 NumRows = 0;
+
+    void Init(int32 InNumRows, bool bValue);
+    void Reset() { Words.Reset(); NumRows = 0; }
+    // An empty (reset) mask stands for no filter: charts show every row
+    bool IsEmpty() const { return NumRows == 0; }
+
+    bool operator[](int32 Row) const { return (Words[Row >> 6] >> (Row & 63)) & 1; }
+    void SetBit(int32 Row, bool bValue);
+    int32 CountSetBits() const;
+
+    // Clears the bits of the last word that lie past NumRows
+    void ClearSlack();
+};
+
+// Row filter over a chart dataset, compiled from a small expression language such as
+//     Z > 0.5 && X in [10, 20]
+//     Region == "EU" || !(Sales <= 0)
+// Comparisons are <, <=, >, >=, ==, != against a number or quoted text, and `in [Low, High]` (inclusive) against a
+// numeric range; they combine with &&, || and ! (or `and`, `or`, `not`) and parentheses. Columns are bare words, or
+// back-quoted when their name has spaces, and are matched by FName like other dataset lookups. A missing value matches
+// no comparison. Text columns compare text exactly; against a number, their labels are read as numbers.
+class VRDATAVIZ_API FChartFilter
+{
+public:
+    // Parses Expression. A blank expression compiles to a filter that keeps every row. False on a syntax error,
+    // described in OutError.
+    static bool Compile(const FString& Expression, FChartFilter& OutFilter, FString& OutError);
+
+    bool IsEmpty() const { return Program.Num() == 0; }
+    const FString& GetExpression() const { return Expression; }
+
+    // Sets a bit for every matching row. Each comparison is evaluated as a run of 64-row words over blocks of rows,
+    // and the blocks run in parallel. False when a column is not in the dataset or a numeric column is compared with
+    // text that is not a number (OutError says which).
+    bool Evaluate(const FChartDataset& Dataset, FChartRowMask& OutMask, FString& OutError) const;
+
+private:
+    enum class EOp : uint8
+    {
+        Compare,
+        And,
+        Or,
+        Not
+    };
+
+    enum class ECompare : uint8
+    {
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+        InRange
+    };
+
+    // A postfix program: comparisons push a mask, And and Or combine the top two, Not inverts the top one
+    struct FInstruction
+    {
+        EOp Op = EOp::Compare;
+        ECompare Compare = ECompare::Equal;
+        FName Column;
+        float Low = 0.0f;
+        float High = 0.0f;
+        // Quoted operand; Low holds its numeric value when bTextIsNumber
+        FString Text;
+        bool bText = false;
+        bool bTextIsNumber = false;
+    };
+
+    class FParser;
+    struct FBoundCompare;
+
+    FString Expression;
+    TArray<FInstruction> Program;
+    // Deepest the evaluation stack gets
+    int32 MaxDepth = 0;
+};
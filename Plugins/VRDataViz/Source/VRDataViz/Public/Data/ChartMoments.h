@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Running mean, variance and covariance of 3D points (Welford's update, with Chan's formula to merge partial
+// results). Adding or removing a point is O(1), so a chart keeps its summary statistics and trend fits current as
+// rows stream in without rescanning its points.
+struct VRDATAVIZ_API FChartMoments
+{
+    int64 Count = 0;
+    FVector Mean = FVector::ZeroVector;
+    // Sums of squared deviations from the mean per axis
+    FVector M2 = FVector::ZeroVector;
+    // Sums of products of deviations between the axes
+    double CXY = 0.0;
+    double CXZ = 0.0;
+    double CYZ = 0.0;
+
+    void Add(const FVector& Point);
+    // Takes out a point that was added before
+    void Remove(const FVector& Point);
+    void Merge(const FChartMoments& Other);
+
+    // Moments of a block of points, in two passes over it (sums, then deviations from the block mean), which keeps
+    // the loops free of the per-point division of Add
+    static FChartMoments FromPoints(TConstArrayView<FVector> Points);
+
+    // Population variance and standard deviation per axis
+    FVector GetVariance() const;
+    FVector GetStdDev() const;
+
+    // Least-squares Z = Intercept + Slope * X; false when X does not vary
+    bool FitLine(double& OutIntercept, double& OutSlope) const;
+    // Least-squares Z = A + B * X + C * Y; false when X and Y are flat or collinear
+    bool FitPlane(double& OutA, double& OutB, double& OutC) const;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ChartFilter.h"
+
+enum class EChartSelectionOp : uint8
+{
+    Replace,
+    Add,
+    Remove,
+    Toggle
+};
+
+// Rows whose selection flipped in one edit: words [FirstWord, FirstWord + Flipped.Num()) of the row mask, XOR-ed
+// old against new, so a chart visits exactly the rows it has to redraw
+struct VRDATAVIZ_API FChartSelectionChange
+{
+    int32 FirstWord = 0;
+    TArray<uint64> Flipped;
+
+    template<typename FunctionType>
+    void ForEachRow(FunctionType&& Function) const
+    {
+        for (int32 Word = 0; Word < Flipped.Num(); ++Word)
+        {
+            for (uint64 Bits = Flipped[Word]; Bits; Bits &= Bits - 1)
+            {
+                Function((FirstWord + Word) * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits)));
+            }
+        }
+    }
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnChartSelectionChanged, const FChartSelectionChange&);
+
+// Selected rows of one data source, shared by every chart drawn from it so that brushing rows in one chart highlights
+// the same rows in the others (linked selection). Rows are matched by index into the source's rows, so a chart whose
+// marks stand for several rows, such as aggregated bars, maps each mark to its rows: it shows a mark selected while
+// any of its rows is, and selecting the mark selects all of them. Edits and notifications happen on the game thread.
+class VRDATAVIZ_API FChartSelection
+{
+public:
+    explicit FChartSelection(int32 InNumRows);
+
+    // The selection shared by charts of SourceKey (a file path, say) holding NumRows rows, created on first use and
+    // alive while a chart holds it. Datasets of the same source with another row count, such as a different streamed
+    // sample, get their own selection, since their rows do not line up.
+    static TSharedRef<FChartSelection> ForSource(const FString& SourceKey, int32 NumRows);
+
+    int32 GetNumRows() const { return Rows.NumRows; }
+    const FChartRowMask& GetRows() const { return Rows; }
+    bool IsSelected(int32 Row) const { return Row >= 0 && Row < Rows.NumRows && Rows[Row]; }
+    bool IsEmpty() const { return NumSelected == 0; }
+    int32 Num() const { return NumSelected; }
+
+    // Each edit notifies OnChanged once with the rows it flipped, and not at all when nothing flipped. Rows outside
+    // the selection's range are ignored.
+    void SelectRows(TConstArrayView<int32> RowIndices, EChartSelectionOp Op);
+    void SelectMask(const FChartRowMask& Mask, EChartSelectionOp Op);
+    void Clear();
+
+    FOnChartSelectionChanged OnChanged;
+
+private:
+    FChartRowMask Rows;
+    int32 NumSelected = 0;
+
+    // Swaps in the new words of the mask and notifies the span of words that actually changed
+    void Commit(TArray<uint64>&& NewWords);
+};
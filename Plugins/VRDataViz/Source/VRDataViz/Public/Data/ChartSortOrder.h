@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FChartDataset;
+
+// Row orders sorted by a column, as permutations of row indices; the columns themselves stay in place. Sorting is a
+// parallel LSD radix sort over 32- or 64-bit keys: each pass histograms one byte per block of rows on its own worker,
+// then scatters the blocks in parallel to offsets from the prefix sums, so the sort is stable and O(N) in rows.
+struct VRDATAVIZ_API FChartSortOrder
+{
+    // Indices 0..Keys.Num() - 1 ordered by ascending key. Equal keys keep their original order, -0 equals 0 and
+    // NaN sorts last.
+    static void SortIndices(TConstArrayView<float> Keys, TArray<int32>& OutOrder);
+    // Same for unsigned keys, such as Morton codes; passes over bytes no key sets are skipped
+    static void SortIndices(TConstArrayView<uint64> Keys, TArray<int32>& OutOrder);
+
+    // Rows of Dataset ordered by ColumnName: numeric columns by value, text columns alphabetically (case-insensitive)
+    // by label. Orders are kept on the dataset (FChartDataset::SortOrders) and freed with it, so charts sharing a
+    // dataset or rebuilding against it sort once. Null when the column does not exist. Game thread only.
+    static TSharedPtr<const TArray<int32>> ForColumn(const TSharedPtr<const FChartDataset>& Dataset, FName ColumnName);
+};
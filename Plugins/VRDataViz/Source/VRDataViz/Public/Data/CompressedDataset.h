@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/ChartDataset.h"
+
+// Lossless float column in independently decodable blocks of BlockValues values. Each block picks the smaller of two
+// encodings: delta-of-delta, over the values themselves for whole numbers (timestamps, counters, indices) and over
+// order-preserving float bits otherwise, where a steady or smooth series leaves deltas of deltas near zero; or XOR of
+// each value's bits with the previous one's (as in Gorilla), where values share sign, exponent and leading mantissa
+// bits. Either residual is bit-packed at one width per block rather than Gorilla's per-value prefixes, so decoding a
+// block is a branch-free unpack loop followed by a running sum or XOR, with no bit-by-bit parsing.
+class VRDATAVIZ_API FCompressedFloats
+{
+public:
+    static constexpr int32 BlockValues = 1024;
+
+    // Replaces the contents; blocks are encoded in parallel
+    void Encode(TConstArrayView<float> Values);
+    void Reset();
+
+    int32 Num() const { return NumValues; }
+    int32 GetNumBlocks() const { return Blocks.Num(); }
+
+    // Writes the values of Block (BlockValues of them, fewer in the last block) to Out
+    void DecodeBlock(int32 Block, float* Out) const;
+    // Every value, blocks decoded in parallel
+    void Decode(TArray<float>& Out) const;
+    // One value, by decoding its block
+    float GetValue(int32 Index) const;
+
+    SIZE_T GetAllocatedSize() const { return Blocks.GetAllocatedSize() + Bytes.GetAllocatedSize(); }
+
+private:
+    enum class ECodec : uint8
+    {
+        DeltaOfDelta,
+        FloatDeltaOfDelta,
+        Xor
+    };
+
+    struct FBlock
+    {
+        int64 Offset = 0;
+        ECodec Codec = ECodec::Xor;
+        // Bits per packed residual, and for XOR the trailing bits every residual has clear
+        uint8 Width = 0;
+        uint8 Shift = 0;
+        // First value (its bits, or ordered bits, unless whole numbers) and, for delta-of-delta, the first delta
+        int64 Base = 0;
+        int64 BaseDelta = 0;
+    };
+
+    int32 NumValues = 0;
+    TArray<FBlock> Blocks;
+    // Packed residuals of every block, padded so that unpacking may read eight bytes at any residual
+    TArray<uint8> Bytes;
+};
+
+// Dataset kept compressed while nothing reads it: float columns in FCompressedFloats, text codes bit-packed at the
+// width of their dictionary, labels and whole-file statistics as they were. Decompressing rebuilds an equal dataset.
+class VRDATAVIZ_API FCompressedDataset
+{
+public:
+    static TSharedRef<FCompressedDataset> Compress(const FChartDataset& Dataset);
+    TSharedRef<FChartDataset> Decompress() const;
+
+    int32 GetNumRows() const { return NumRows; }
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    struct FColumn
+    {
+        FName Name;
+        EChartColumnType Type = EChartColumnType::Float;
+        FCompressedFloats Floats;
+        uint8 CodeWidth = 0;
+        TArray<uint8> Codes;
+        FChartLabelDictionary Labels;
+        TOptional<FChartColumnStats> Stats;
+    };
+
+    int32 NumRows = 0;
+    TArray<FColumn> Columns;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Sequential byte stream feeding FCSVStreamReader: a plain file, or a decompressor reading one
+class VRDATAVIZ_API IDataByteSource
+{
+public:
+    virtual ~IDataByteSource() = default;
+
+    // Fills up to MaxBytes and returns the number written; fewer than MaxBytes only at the end of the stream.
+    // Returns INDEX_NONE on a read or decode error.
+    virtual int64 Read(uint8* Dest, int64 MaxBytes) = 0;
+};
+
+namespace DataVizByteSource
+{
+    enum class EFormat : uint8
+    {
+        Plain,
+        Gzip,           // .csv.gz, inflated as a stream
+        BlockContainer  // .csv.ucz, independently compressed blocks decoded in parallel (see BlockCompressedFile.h)
+    };
+
+    // Format from the file's leading bytes, so renamed files are still detected
+    VRDATAVIZ_API EFormat DetectFormat(const FString& FilePath);
+
+    inline bool IsCompressedFile(const FString& FilePath) { return DetectFormat(FilePath) != EFormat::Plain; }
+
+    // Opens a decoding source for any supported format; nullptr when the file cannot be opened
+    VRDATAVIZ_API TUniquePtr<IDataByteSource> OpenFile(const FString& FilePath);
+
+    // File name patterns for every supported input, including Arrow files and PLY / LAS point clouds
+    VRDATAVIZ_API const TArray<FString>& GetFilePatterns();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChartSpawnLibrary.h"
+
+// What the index knows about one data file, or about a subfolder that loads as one partitioned dataset
+struct FDataFileInfo
+{
+    FString FilePath;
+    bool bIsFolder = false;
+    int64 FileSize = 0;             // Folders: total of their shards
+    FDateTime ModificationTime;     // Folders: newest shard
+    TArray<FName> Columns;          // Folders: columns of the first shard
+    int64 EstimatedRows = INDEX_NONE; // INDEX_NONE when unknown
+    EChartType SuggestedChartType = EChartType::Scatter;
+};
+
+// Metadata of every data file under a directory, built on worker threads so listing never blocks the game thread.
+// A rescan only reads files whose size or timestamp changed. Where the DirectoryWatcher module is available
+// (non-shipping builds) the index follows file changes by itself; otherwise call Rescan.
+// All public functions are called on the game thread.
+class VRDATAVIZ_API FDataFileIndex : public TSharedFromThis<FDataFileIndex>
+{
+public:
+    // Starts the first scan and, when available, watching the directory
+    static TSharedRef<FDataFileIndex> Create(const FString& Directory);
+
+    ~FDataFileIndex();
+
+    // Reads size, columns, a row estimate and a suggested chart type; false when the file is not a readable data file
+    static bool ReadFileInfo(const FString& FilePath, FDataFileInfo& OutInfo);
+
+    // Restats the directory in the background; entries update when the scan finishes
+    void Rescan();
+
+    // Delivers directory change notifications (the watcher is only ticked by the engine in editor builds)
+    void Tick(float DeltaTime);
+
+    // Files directly in the directory, then its subfolders as partitioned datasets, each sorted by path
+    TArray<FDataFileInfo> GetEntries() const;
+
+    const FDataFileInfo* FindEntry(const FString& Path) const;
+
+    // Changes whenever the entries do
+    uint32 GetVersion() const { return Version; }
+    bool IsScanning() const { return PendingScans > 0; }
+
+    const FString& GetDirectory() const { return Directory; }
+
+private:
+    FDataFileIndex() = default;
+
+    void StartWatching();
+    void OnDirectoryChanged(const TArray<struct FFileChangeData>& Changes);
+
+    // Reads the files in Paths on a worker, then replaces (or removes, for files that are gone) their entries
+    void RefreshFiles(TArray<FString> Paths);
+    // Results land in any order; each path keeps the state read by the most recently started scan or refresh
+    void ApplyScan(uint32 ScanSerial, TMap<FString, FDataFileInfo>&& ScannedFiles);
+    void ApplyRefresh(uint32 RefreshSerial, TArray<FDataFileInfo>&& Infos, const TArray<FString>& Removed);
+    void RebuildEntries();
+
+    FString Directory;
+    TMap<FString, FDataFileInfo> Files;
+    TArray<FDataFileInfo> Entries;
+    uint32 Version = 0;
+    // Scans and refreshes draw serials from one counter, in the order they start
+    uint32 LatestSerial = 0;
+    uint32 LatestScanSerial = 0;
+    uint32 AppliedScanSerial = 0;
+    // Serial of the refresh each path was last read by, for paths refreshed after the latest applied scan started
+    TMap<FString, uint32> RefreshSerials;
+    int32 PendingScans = 0;
+    FDelegateHandle WatcherHandle;
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include <atomic>
+
+struct FChartDataset;
+class FCompressedDataset;
+
+// Counters for tuning speculative loads; printed by VRDataViz.DatasetCache.Stats
+struct FDatasetCacheStats
+{
+    int32 Requests = 0;
+    int32 Hits = 0;             // Served from a finished load
+    int32 InFlightHits = 0;     // Served by waiting for a prefetch that was still running
+    int32 Misses = 0;           // Loaded on the spot
+    int32 PrefetchesStarted = 0;
+    int32 PrefetchesCanceled = 0;
+    int32 PrefetchesUnused = 0; // Finished, then evicted or outdated before anything asked for them
+    int32 RawReuses = 0;        // Loads parsed from a file's cached bytes instead of reading it again
+    double WaitSeconds = 0.0;   // Spent waiting on in-flight prefetches
+    double MissSeconds = 0.0;   // Spent loading misses
+    int32 Compressions = 0;     // Idle datasets compressed on the worker pool to stay within the budget
+    int32 Decompressions = 0;   // Compressed datasets decoded again on the worker pool, for a prefetch or a request
+    double CompressSeconds = 0.0;   // Spent encoding on the worker pool
+    double DecompressSeconds = 0.0; // Spent decoding on the worker pool
+
+    // Share of requests that found a prefetched or cached dataset
+    float GetHitRate() const { return Requests > 0 ? static_cast<float>(Hits + InFlightHits) / Requests : 0.0f; }
+};
+
+// Loaded datasets by file, so a file the panel started reading in the background when it was selected is ready (or
+// nearly so) when a chart is placed from it. Entries remember the file's size and timestamp and are dropped once the
+// file changes. When entries exceed the byte budget, datasets no chart holds any more are first compressed
+// (FCompressedDataset) on the worker pool, least recently used first, and only once no compression is running are
+// entries evicted, so several times more loaded files stay resident. A dataset stays resident while it is compressed
+// and is swapped for the result on the game thread, unless a chart took it in the meantime. A prefetch of a compressed one decompresses it on the worker pool instead of parsing the file again, and
+// a request waits for that as for any prefetch (or starts it and waits).
+// Only one speculative load runs at a time: a prefetch for another file cancels the one still running.
+// In-memory loads projected to a few columns also keep the file's bytes (counted against the budget), so choosing other
+// columns of the same file parses them again without reading it. Streamed files keep no bytes: other columns of one
+// are streamed from disk again. Directories and globs are neither prefetched nor cached.
+// All functions are called on the game thread.
+class VRDATAVIZ_API FDatasetCache
+{
+public:
+    static FDatasetCache& Get();
+
+    // Starts loading FilePath on the worker pool unless it is cached or already loading with the same limits and
+    // columns (FCSVParseOptions::Columns; empty loads every column)
+    void Prefetch(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const TArray<FName>& Columns = TArray<FName>());
+
+    // Cancels the running prefetch, if any
+    void CancelPrefetch();
+
+    // The cached dataset, the result of a running prefetch (waiting for it) or a fresh load, as in
+    // FChartDatasetLoader::LoadDataFile; nullptr when the file cannot be loaded
+    TSharedPtr<const FChartDataset> Load(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const TArray<FName>& Columns = TArray<FName>());
+
+    void SetMaxBytes(int64 InMaxBytes);
+    void Empty();
+
+    const FDatasetCacheStats& GetStats() const { return Stats; }
+    void ResetStats() { Stats = FDatasetCacheStats(); }
+    void LogStats() const;
+
+private:
+    // Shared with the worker that fills it, so dropping the entry never frees state the worker still writes
+    struct FPendingLoad
+    {
+        std::atomic<bool> bCanceled{ false };
+        TSharedPtr<const FChartDataset> Dataset;
+        int64 AllocatedBytes = 0;
+        TSharedPtr<const TArray64<uint8>> RawBytes;
+        // Set when the worker decompresses the entry's dataset rather than loading the file
+        TSharedPtr<const FCompressedDataset> Compressed;
+        double DecompressSeconds = 0.0;
+    };
+
+    // Compression of an entry's idle dataset on the worker pool, shared with the worker like FPendingLoad
+    struct FPendingCompression
+    {
+        // Set by the worker once Compressed is written; it then asks the game thread to trim again
+        std::atomic<bool> bDone{ false };
+        // Released before the result is collected, so the entry's reference shows whether a chart took the dataset
+        TSharedPtr<const FChartDataset> Source;
+        TSharedPtr<const FCompressedDataset> Compressed;
+        double CompressSeconds = 0.0;
+    };
+
+    struct FEntry
+    {
+        FString FilePath;
+        int64 MaxInMemoryBytes = 0;
+        int32 MaxStreamedRows = 0;
+        TArray<FName> Columns;
+        int64 FileSize = 0;
+        FDateTime ModificationTime;
+
+        TSharedPtr<FPendingLoad> Pending;
+        TFuture<void> Result;
+
+        TSharedPtr<const FChartDataset> Dataset;
+        // Dataset while it is compressed, in which case Dataset is null; kept while a worker decompresses it, so a
+        // canceled decompression leaves the entry as it was
+        TSharedPtr<const FCompressedDataset> Compressed;
+        int64 AllocatedBytes = 0;
+        // Compressing did not make the dataset smaller, so it is not tried again
+        bool bIncompressible = false;
+        TSharedPtr<FPendingCompression> PendingCompression;
+        // Shared by the entries of one file
+        TSharedPtr<const TArray64<uint8>> RawBytes;
+        uint64 LastUse = 0;
+        bool bPrefetch = false;
+        bool bUsed = false;
+    };
+
+    int32 FindEntry(const FString& FilePath, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const TArray<FName>& Columns) const;
+    TSharedPtr<const TArray64<uint8>> FindRawBytes(const FString& FilePath) const;
+    void StartLoad(FEntry& Entry);
+    // Decodes the entry's compressed dataset on the worker pool, collected like a load
+    void StartDecompress(FEntry& Entry);
+    // Moves a finished background load or decompression into its entry
+    void CollectLoad(FEntry& Entry);
+    // Stops the entry's background work: a decompression is dropped and the entry stays compressed, a load drops the entry
+    void CancelLoad(int32 EntryIndex);
+    // Datasets plus each distinct raw file once
+    int64 GetCachedBytes() const;
+    void RemoveEntry(int32 EntryIndex);
+
+    // Drops entries whose file changed since they were loaded
+    void RemoveOutdated(const FString& FilePath, int64 FileSize, const FDateTime& ModificationTime);
+
+    // Collects finished loads and compressions, then starts compressing idle datasets and, once none is compressing,
+    // evicts entries, least recently used first, until the budget holds. Runs again when a compression finishes.
+    void Trim();
+    void StartCompress(FEntry& Entry);
+    // Swaps a finished compression in, unless a chart took the dataset meanwhile or it did not shrink
+    void CollectCompression(FEntry& Entry);
+    // Index of the least recently used entry passing Filter, or INDEX_NONE
+    int32 FindLeastRecentlyUsed(TFunctionRef<bool(const FEntry&)> Filter) const;
+
+    TArray<FEntry> Entries;
+    int64 MaxBytes = 512ll * 1024 * 1024;
+    uint64 UseCounter = 0;
+    FDatasetCacheStats Stats;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "Data/ChartDataset.h"
+#include "Data/CSVStreamReader.h"
+
+// Whole-file min / max / missing counts and a quantile sketch for every column of a streamed file
+class VRDATAVIZ_API FColumnStatsSink : public IChartDatasetSink
+{
+public:
+    virtual void BeginStream(const FChartDataset& Schema) override;
+    virtual void ConsumeBlock(const FChartDataset& Block, int64 FirstRow) override;
+
+    const TArray<FChartColumnStats>& GetStats() const { return Stats; }
+
+    // Stores the stats on the columns of a dataset with the streamed schema
+    void ApplyTo(FChartDataset& Dataset) const;
+
+private:
+    TArray<FChartColumnStats> Stats;
+};
+
+// Uniform random sample of at most MaxRows rows, kept in file order. Uses reservoir sampling with geometric
+// skips (Li's Algorithm L), so once the reservoir is full most rows are passed over without drawing a random number.
+// MaxRows <= 0 keeps every row.
+class VRDATAVIZ_API FReservoirSampleSink : public IChartDatasetSink
+{
+public:
+    explicit FReservoirSampleSink(int32 InMaxRows, int32 Seed = 0);
+
+    virtual void SetExpectedRows(int64 InExpectedRows) override { ExpectedRows = InExpectedRows; }
+    virtual void BeginStream(const FChartDataset& Schema) override;
+    virtual void ConsumeBlock(const FChartDataset& Block, int64 FirstRow) override;
+    virtual void EndStream(int64 TotalRows) override;
+
+    FChartDataset& GetSample() { return Sample; }
+
+private:
+    double NextUniform();
+    void AdvanceSkip();
+
+    FChartDataset Sample;
+    TArray<int64> SampleFileRows;
+    FRandomStream Stream;
+    int32 MaxRows;
+    int64 ExpectedRows = 0;
+    double SkipWeight = 0.0;
+    int64 NextReplaceRow = 0;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "HAL/CriticalSection.h"
+#include "Data/CSVTokenizer.h"
+
+struct FChartDataset;
+
+enum class EDatasetShardState : uint8
+{
+    Queued,
+    Loading,
+    Loaded,
+    Failed
+};
+
+// Snapshot of one shard of a partitioned load
+struct FDatasetShardProgress
+{
+    FString FilePath;
+    int64 FileSize = 0;
+    EDatasetShardState State = EDatasetShardState::Queued;
+    int32 NumRows = 0;
+};
+
+// Loads a partitioned dataset (a folder of part files, or a glob such as Data/part-*.csv) as one table: every shard is
+// read and parsed concurrently on the worker pool, then the shards are merged in path order. Columns are matched by
+// name; a column that is text in any shard becomes text in all of them, and shards whose columns differ are skipped.
+// Shard progress can be polled from the game thread while the load runs.
+class VRDATAVIZ_API FPartitionedDatasetLoad
+{
+public:
+    // True for a directory, or a path whose file name contains * or ?
+    static bool IsPartitionedPath(const FString& Path);
+
+    // Supported data files of a directory (including subfolders, as in year=2024/part-0.csv) or matching a
+    // file-name glob, sorted by path
+    static TArray<FString> FindShards(const FString& DirectoryOrGlob);
+
+    // Starts loading every shard in the background; returns nullptr when nothing matches.
+    // MaxInMemoryBytes and MaxStreamedRows apply to the shards together: when their total size is above the limit,
+    // each shard is streamed and keeps a share of MaxStreamedRows proportional to its size.
+    static TSharedPtr<FPartitionedDatasetLoad> Start(const FString& DirectoryOrGlob, int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options = FCSVParseOptions());
+
+    const FString& GetPath() const { return Path; }
+    TArray<FDatasetShardProgress> GetProgress() const;
+    bool IsComplete() const { return Result.IsReady(); }
+
+    // Blocks until the merge is done; nullptr when no shard could be loaded or the load was canceled
+    TSharedPtr<FChartDataset> Wait() const;
+
+    // Stops reading shards that have not finished; the load completes soon after with no dataset
+    void Cancel() { bCanceled = true; }
+
+private:
+    void SetShardState(int32 ShardIndex, EDatasetShardState State, int32 NumRows = 0);
+    TSharedPtr<FChartDataset> Run(int64 MaxInMemoryBytes, int32 MaxStreamedRows, const FCSVParseOptions& Options);
+    TSharedPtr<FChartDataset> Merge(TArray<TSharedPtr<FChartDataset>>& Parts);
+
+    FString Path;
+    mutable FCriticalSection ProgressLock;
+    TArray<FDatasetShardProgress> Shards;
+    TSharedPtr<FChartDataset> Dataset;
+    TFuture<void> Result;
+    std::atomic<bool> bCanceled{ false };
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IChartDatasetSink;
+
+// Streams binary point clouds (PLY, LAS) into the same sinks as FCSVStreamReader, decoding each vertex record
+// straight into float columns: X, Y, Z, plus R, G, B (sRGB normalized to 0..1) and Intensity when the file has them.
+// The point count comes from the header, so sinks are told the row count before the first block arrives.
+class VRDATAVIZ_API FPointCloudReader
+{
+public:
+    enum class EFormat : uint8
+    {
+        Unknown,
+        Ply, // binary_little_endian or binary_big_endian; ASCII PLY is rejected
+        Las  // LAS 1.0 - 1.4, point formats 0 - 10; LAZ is rejected
+    };
+
+    explicit FPointCloudReader(int32 InBlockRows = 256 * 1024);
+
+    // Format from the file's leading bytes
+    static EFormat DetectFormat(const FString& FilePath);
+
+    static bool IsPointCloudFile(const FString& FilePath) { return DetectFormat(FilePath) != EFormat::Unknown; }
+
+    // Column names and point count from the header alone; false when the header is unsupported
+    static bool ReadHeader(const FString& FilePath, TArray<FName>& OutColumns, int64& OutNumPoints);
+
+    // Returns false when the file cannot be read, its header is unsupported, or it ends before the stated point count
+    bool ReadFile(const FString& FilePath, TArrayView<IChartDatasetSink* const> Sinks) const;
+
+private:
+    int32 BlockRows;
+};
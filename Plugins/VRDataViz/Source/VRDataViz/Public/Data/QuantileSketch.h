@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Streaming quantile sketch (KLL): values are added in one pass, in any order, into a stack of compactors whose
+// capacities shrink geometrically below the top level. A full compactor sorts itself and promotes every other value
+// to the level above at twice the weight, so memory stays around 3 * K floats however many values are added.
+// Quantiles are within about 1.7 / K of their true rank (1% for the default K). Min and max are kept exactly.
+class VRDATAVIZ_API FQuantileSketch
+{
+public:
+    explicit FQuantileSketch(int32 InK = 200);
+
+    // NaN is ignored
+    void Add(float Value);
+    void Add(TConstArrayView<float> Values);
+    // Folds another sketch in, as if its values had been added here
+    void Merge(const FQuantileSketch& Other);
+    void Reset();
+
+    int64 Num() const { return NumValues; }
+    bool IsEmpty() const { return NumValues == 0; }
+
+    // Value at fraction Q (0..1) of the sorted values; Q of 0 and 1 give the exact min and max. NaN when empty.
+    float GetQuantile(double Q) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+    // Saves or restores the retained values, so a sketch built offline answers the same quantiles after loading
+    friend VRDATAVIZ_API FArchive& operator<<(FArchive& Ar, FQuantileSketch& Sketch);
+
+private:
+    int32 K;
+    int64 NumValues = 0;
+    float Min = TNumericLimits<float>::Max();
+    float Max = TNumericLimits<float>::Lowest();
+
+    // Values of level H each stand for 2^H added values
+    TArray<TArray<float>> Levels;
+    int32 NumRetained = 0;
+    int32 MaxRetained = 0;
+    // Picks the odd or even half to promote on each compaction
+    uint32 CoinState = 0x9E3779B9u;
+
+    int32 GetCapacity(int32 Level) const;
+    void AddLevel();
+    void Compress();
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "Data/ChartDataset.h"
+
+class UDataTable;
+
+// How the fields of one row struct are read from and written to dataset columns, built once per UScriptStruct.
+// Each field keeps its offset and a typed writer (float, int, bool, string, name, text, or text import for enums,
+// structs and other types), so filling rows is a loop per field over the rows with no property lookups by name.
+// Columns are matched to fields by the field's authored name (what DataTable CSV import uses), case-insensitively.
+class VRDATAVIZ_API FRowIngestionPlan
+{
+public:
+    // Cached per struct; safe to call from any thread
+    static TSharedRef<const FRowIngestionPlan> Get(const UScriptStruct* RowStruct);
+
+    const UScriptStruct* GetRowStruct() const { return RowStruct; }
+
+    // Writes dataset rows [FirstRow, FirstRow + Rows.Num()) into already initialized rows. Fields without a matching
+    // column, and missing numbers, keep their current value. Rows are written in parallel blocks unless a bound field
+    // needs text import, in which case call it on the game thread. Returns the number of fields that found a column.
+    int32 WriteRows(const FChartDataset& Dataset, int32 FirstRow, TArrayView<uint8* const> Rows) const;
+
+    template<typename RowType>
+    int32 WriteRows(const FChartDataset& Dataset, TArray<RowType>& OutRows) const
+    {
+        checkf(RowType::StaticStruct()->IsChildOf(RowStruct), TEXT("Rows of %s written with the plan of %s"), *RowType::StaticStruct()->GetName(), *RowStruct->GetName());
+        OutRows.SetNum(Dataset.NumRows);
+        TArray<uint8*> RowPointers;
+        RowPointers.Reserve(OutRows.Num());
+        for (RowType& Row : OutRows)
+        {
+            RowPointers.Add(reinterpret_cast<uint8*>(&Row));
+        }
+        return WriteRows(Dataset, 0, RowPointers);
+    }
+
+    // Replaces OutDataset with one column per field and one row per entry of Rows: numbers and bools as floats,
+    // everything else as its exported text
+    void ReadRows(TConstArrayView<const uint8*> Rows, FChartDataset& OutDataset) const;
+
+    // Column types that keep every field's values intact: numeric fields as floats, every other field (bools, enums,
+    // strings, names, text, imported structs) as text, so "007" or "1.50" reach an FString field as written
+    TMap<FName, EChartColumnType> GetColumnTypes() const;
+
+    // Replaces the rows of a table whose row struct is this plan's. As in DataTable CSV import, a first column that
+    // is not a field names the rows; otherwise rows are numbered. False, leaving the table alone, when any field has
+    // no matching column.
+    bool FillDataTable(const FChartDataset& Dataset, UDataTable* Table) const;
+
+private:
+    enum class EFieldKind : uint8
+    {
+        Float,
+        Double,
+        Int8,
+        Int16,
+        Int32,
+        Int64,
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        Bool,
+        Enum,
+        String,
+        Name,
+        Text,
+        ImportText
+    };
+
+    struct FFieldPlan
+    {
+        FName ColumnName;
+        int32 Offset = 0;
+        EFieldKind Kind = EFieldKind::ImportText;
+        const FProperty* Property = nullptr;
+    };
+
+    explicit FRowIngestionPlan(const UScriptStruct* InRowStruct);
+
+    static EFieldKind GetFieldKind(const FProperty* Property);
+    void WriteField(const FFieldPlan& Field, const FChartColumn& Column, int32 FirstRow, TArrayView<uint8* const> Rows) const;
+
+    const UScriptStruct* RowStruct;
+    TArray<FFieldPlan> Fields;
+    // Layout the plan was built for; an edited user-defined struct recreates its properties and is planned again
+    const FField* FirstProperty = nullptr;
+    int32 StructureSize = 0;
+};
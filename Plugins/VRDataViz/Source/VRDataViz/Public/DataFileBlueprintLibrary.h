@@ -9,9 +9,14 @@ class VRDATAVIZ_API UDataFileBlueprintLibrary : public UBlueprintFunctionLibrary
     GENERATED_BODY()
 
 public:
+    // Lists *.csv, *.csv.gz and *.csv.ucz files
     UFUNCTION(BlueprintCallable, Category = "Data|Files")
     static void GetCSVFiles(TArray<FString>& OutFilePaths, const FString& SubfolderName = TEXT("DataCharts"));
 
+    // Lists subfolders holding data files; each one loads as a single partitioned dataset
+    UFUNCTION(BlueprintCallable, Category = "Data|Files")
+    static void GetPartitionedDatasets(TArray<FString>& OutDirectoryPaths, const FString& SubfolderName = TEXT("DataCharts"));
+
     UFUNCTION(BlueprintCallable, Category = "Data|Files")
     static bool LoadTextFile(const FString& FilePath, FString& OutText);
 };
@@ -2,8 +2,27 @@
 
 #include "Blueprint/UserWidget.h"
 #include "ChartSpawnLibrary.h"
+#include "Data/ChartColumnMapping.h"
 #include "DataVizPanelWidget.generated.h"
 
+class FPartitionedDatasetLoad;
+class FDataFileIndex;
+struct FDataFileInfo;
+struct FChartDataset;
+struct FChartDatasetDiff;
+
+// Source file of a chart placed from the panel, and the version of it the chart shows
+struct FPlacedChartSource
+{
+    TWeakObjectPtr<AActor> Chart;
+    FString FilePath;
+    EChartType ChartType = EChartType::Scatter;
+    FChartColumnMapping Mapping;
+    int64 FileSize = 0;
+    FDateTime ModificationTime;
+    bool bReloading = false;
+};
+
 UCLASS()
 class VRDATAVIZ_API UDataVizPanelWidget : public UUserWidget
 {
@@ -57,11 +76,46 @@ public:
     UFUNCTION(BlueprintCallable, Category = "DataViz|Input")
     void HandleKeyboardInput();
 
+    // Primitive cap for the preview chart while it is being placed; the full build swaps in on confirm (0 = no cap)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DataViz|Preview")
+    int32 PreviewMaxPrimitives = 2000;
+
+    // Files larger than this are streamed in fixed-size blocks instead of being loaded whole. Only the mapped columns
+    // are kept, so mapping another column of a streamed file reads the whole file again.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DataViz|Loading")
+    int32 StreamingThresholdMB = 512;
+
+    // Row sample kept from a streamed file; axis ranges still cover every row
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DataViz|Loading")
+    int32 StreamingMaxRows = 100000;
+
+    // Re-read placed charts when their source file changes and patch them with the changed rows
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DataViz|Loading")
+    bool bHotReloadCharts = true;
+
+    // Start loading the selected file in the background so Place finds it parsed; moving to another file cancels it
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DataViz|Loading")
+    bool bPrefetchSelectedFile = true;
+
+    // Memory budget of the shared dataset cache that prefetched and placed files are kept in
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DataViz|Loading")
+    int32 DatasetCacheMB = 512;
+
+    // File columns drawn on each chart axis; only these are parsed, and changing them re-reads the cached file bytes.
+    // Set from the column pickers under the chart type, which list the selected file's columns.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DataViz|Loading")
+    FChartColumnMapping ColumnMapping;
+
+    // Share of chart loads served by a prefetch or the dataset cache since startup (see VRDataViz.DatasetCache.Stats)
+    UFUNCTION(BlueprintCallable, Category = "DataViz|Loading")
+    float GetPrefetchHitRate() const;
+
 private:
     UPROPERTY() class APlacementManager* PlacementMgr;
     UPROPERTY() class AActor* PreviewChart; // Actual chart actor for preview
     UPROPERTY() FString PendingFile;
     UPROPERTY() EChartType PendingType;
+    UPROPERTY() FChartColumnMapping PendingMapping;
     UPROPERTY() bool bUseXYZPlacement = false;
     UPROPERTY() FRotator PreviewRotation = FRotator::ZeroRotator;
     UPROPERTY() float PreviewScale = 1.0f;
@@ -84,7 +138,20 @@ private:
 
     // Runtime-created UMG controls
     UPROPERTY() class UComboBoxString* FileCombo;
+    UPROPERTY() class UEditableTextBox* PathBox;
+    UPROPERTY() class UTextBlock* ShardProgressText;
+    UPROPERTY() class UTextBlock* FileInfoText;
     UPROPERTY() class UComboBoxString* ChartTypeCombo;
+    UPROPERTY() class UComboBoxString* ColumnXCombo;
+    UPROPERTY() class UComboBoxString* ColumnYCombo;
+    UPROPERTY() class UComboBoxString* ColumnZCombo;
+    UPROPERTY() class UComboBoxString* ColumnValueCombo;
+    UPROPERTY() class UComboBoxString* ColumnColorCombo;
+    UPROPERTY() class UComboBoxString* ColumnSizeCombo;
+    UPROPERTY() class UWidget* ColumnZRow = nullptr;
+    UPROPERTY() class UWidget* ColumnValueRow = nullptr;
+    UPROPERTY() class UWidget* ColumnColorRow = nullptr;
+    UPROPERTY() class UWidget* ColumnSizeRow = nullptr;
     UPROPERTY() class UEditableTextBox* XBox;
     UPROPERTY() class UEditableTextBox* YBox;
     UPROPERTY() class UEditableTextBox* ZBox;
@@ -108,8 +175,14 @@ private:
     UFUNCTION()
     void RefreshFiles();
     UFUNCTION()
+    void OnFileSelected(FString Selected, ESelectInfo::Type SelectionType);
+    UFUNCTION()
+    void OnPathCommitted(const FText& Text, ETextCommit::Type CommitMethod);
+    UFUNCTION()
     void OnChartTypeChanged(FString Selected, ESelectInfo::Type SelectionType);
     UFUNCTION()
+    void OnColumnMappingChanged(FString Selected, ESelectInfo::Type SelectionType);
+    UFUNCTION()
     void OnPlace();
     UFUNCTION()
     void OnPlaceXYZ();
@@ -140,6 +213,35 @@ private:
     FTransform BuildTransformFromInputs() const;
     void UpdatePreviewTransform();
     AActor* CreatePreviewChart();
+    TSharedPtr<const FChartDataset> LoadDataset(const FString& FilePath, EChartType ChartType) const;
+    EChartType GetSelectedChartType() const;
+    void StartSelectedLoad(const FString& Selected);
+    void PopulateColumnCombos(const FDataFileInfo* Info);
+    void UpdateShardProgress();
+    void PopulateFileCombo();
     void UpdateVisualGuide();
+
+    // Background load of the selected folder or glob; LoadDataset waits on it instead of loading the shards again
+    TSharedPtr<FPartitionedDatasetLoad> PartitionLoad;
+    TArray<FName> PartitionLoadColumns;
+    bool bShardProgressFinal = false;
+
+    // Set while the column pickers are refilled, whose selection events are not user choices
+    bool bPopulatingColumnCombos = false;
+
+    // Metadata of everything under Saved/DataCharts, scanned off the game thread; the file list is rebuilt from it
+    // whenever its version changes
+    TSharedPtr<FDataFileIndex> FileIndex;
+    uint32 FileIndexVersion = 0;
+
+    // Folders and globs entered in the path box, kept in the list across index updates
+    TArray<FString> CustomPaths;
+
+    // Placed charts whose source the index tracks; when the index sees a file change, the file is re-read and diffed
+    // against the chart's dataset on the worker pool, and only the changed rows are applied to the chart
+    TArray<FPlacedChartSource> PlacedCharts;
+    void TrackPlacedChart(AActor* Chart, const FString& FilePath, EChartType ChartType, const FChartColumnMapping& Mapping);
+    void ReloadChangedCharts();
+    void FinishChartReload(TWeakObjectPtr<AActor> Chart, TSharedPtr<const FChartDataset> OldDataset, TSharedPtr<const FChartDataset> NewDataset, const FChartDatasetDiff& Diff);
 };
 
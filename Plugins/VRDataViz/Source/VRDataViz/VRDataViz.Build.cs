@@ -21,6 +21,27 @@ public class VRDataViz : ModuleRules
             "InputCore",
             "HeadMountedDisplay"
         });
+
+        // Streaming inflate for .csv.gz inputs
+        AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
+        // Finds chart DataTables for VRDataViz.ConvertChartTables, which only exists in the editor
+        if (Target.bBuildEditor)
+        {
+            PrivateDependencyModuleNames.Add("AssetRegistry");
+        }
+
+        // Keeps the data file index current without rescanning; the module is a developer tool, so shipping builds
+        // fall back to rescanning on Refresh
+        if (Target.bBuildDeveloperTools)
+        {
+            PrivateDependencyModuleNames.Add("DirectoryWatcher");
+            PrivateDefinitions.Add("WITH_DATAVIZ_DIRECTORY_WATCHER=1");
+        }
+        else
+        {
+            PrivateDefinitions.Add("WITH_DATAVIZ_DIRECTORY_WATCHER=0");
+        }
     }
 }
 